@@ -44,6 +44,101 @@
 DEAL_II_NAMESPACE_OPEN
 
 
+/**
+ * A structure that describes how AlignedVector (and the host memory of
+ * LinearAlgebra::distributed::Vector) allocates large arrays.
+ *
+ * On machines with several NUMA domains, the operating system places a page
+ * of memory on the domain of the thread that first writes into it (first
+ * touch). If a large array is initialized by a single thread, or by a
+ * parallel loop that splits the array differently than the loops that later
+ * work on it, most threads access memory of another domain and the memory
+ * bandwidth of the machine is not fully used. Furthermore, large arrays
+ * spread over many small pages of 4 kB put pressure on the TLB. This
+ * structure offers two settings to address these problems for arrays of at
+ * least @p minimum_size bytes:
+ * - With @p use_huge_pages, the memory is aligned to the size of huge pages
+ *   (2 MB) and the operating system is asked to back it by transparent huge
+ *   pages via `madvise(MADV_HUGEPAGE)`. This is only a hint: if the system
+ *   does not support transparent huge pages (or deal.II was configured on a
+ *   system without `madvise`), the memory is allocated as usual.
+ * - With @p parallel_first_touch, the pages of newly allocated memory are
+ *   written to right after the allocation by a parallel loop. The loop
+ *   works on contiguous ranges of whole pages with a grain size of the
+ *   array size divided by MultithreadInfo::n_threads(), i.e., it subdivides
+ *   the array like parallel::apply_to_subranges() does for loops that give
+ *   each thread an equal share of a range. This is useful for arrays that
+ *   are filled serially or via resize_fast() and then used in such loops,
+ *   like the data arrays of MatrixFree.
+ *   Without this setting, the pages are touched by the initialization of
+ *   the elements, which is done in parallel with a grain size of 160 kB for
+ *   AlignedVector::resize() and AlignedVector::fill(), and with the thread
+ *   partitioner of the vector for dealii::Vector and
+ *   LinearAlgebra::distributed::Vector.
+ *
+ * By default, both settings are disabled. The default policy of the program
+ * can be changed by set_default(), and the policy of an individual
+ * AlignedVector by AlignedVector::set_allocation_policy(). Objects of type
+ * AlignedVector take the default policy at the time of their construction.
+ * LinearAlgebra::distributed::Vector only uses the @p use_huge_pages
+ * setting of the default policy, as its entries are always first touched
+ * with the thread partitioner of the vector.
+ *
+ * @note set_default() is not thread-safe with respect to objects being
+ * created at the same time. It is meant to be called once at the beginning
+ * of a program.
+ */
+struct AlignedVectorAllocationPolicy
+{
+  /**
+   * Constructor. Set all settings to the given values.
+   */
+  constexpr AlignedVectorAllocationPolicy(
+    const bool        use_huge_pages       = false,
+    const bool        parallel_first_touch = false,
+    const std::size_t minimum_size         = 2097152);
+
+  /**
+   * Allocate @p size bytes of memory according to this policy and return a
+   * pointer to it in @p memptr. The memory is aligned to at least 64 bytes
+   * and needs to be released by `std::free()`.
+   */
+  void
+  allocate(void **memptr, const std::size_t size) const;
+
+  /**
+   * Set the policy used by objects created after this call.
+   */
+  static void
+  set_default(const AlignedVectorAllocationPolicy &policy);
+
+  /**
+   * Return the policy used by objects created at this point.
+   */
+  static const AlignedVectorAllocationPolicy &
+  get_default();
+
+  /**
+   * Whether to request transparent huge pages for large arrays.
+   */
+  bool use_huge_pages;
+
+  /**
+   * Whether to touch the pages of large arrays in parallel right after
+   * their allocation.
+   */
+  bool parallel_first_touch;
+
+  /**
+   * The minimal size of an array in bytes for which the two settings above
+   * take effect. Smaller arrays are allocated with an alignment of 64 bytes
+   * and not touched.
+   */
+  std::size_t minimum_size;
+};
+
+
+
 /**
  * This is a replacement class for std::vector to be used in combination with
  * VectorizedArray and derived data types. It allocates memory aligned to
@@ -101,7 +196,8 @@ public:
 
   /**
    * Move constructor. Create a new aligned vector by stealing the contents of
-   * @p vec.
+   * @p vec. Like the copy constructor, the new vector takes over the
+   * allocation policy of @p vec.
    */
   AlignedVector(AlignedVector<T> &&vec) noexcept;
 
@@ -114,7 +210,9 @@ public:
   operator=(const AlignedVector<T> &vec);
 
   /**
-   * Move assignment operator.
+   * Move assignment operator. The memory of @p vec is taken over as it is,
+   * but like the copy assignment, this object keeps its own allocation
+   * policy for memory it allocates later on.
    */
   AlignedVector &
   operator=(AlignedVector<T> &&vec) noexcept;
@@ -355,6 +453,22 @@ public:
   void
   swap(AlignedVector<T> &vec);
 
+  /**
+   * Set the policy for the memory allocated by this object from now on,
+   * see AlignedVectorAllocationPolicy. Memory that is already allocated is
+   * not moved. A copy of this object takes over the policy, whereas the
+   * assignment from another vector keeps the policy of this object. This
+   * holds for both the copy and the move variants of these operations.
+   */
+  void
+  set_allocation_policy(const AlignedVectorAllocationPolicy &policy);
+
+  /**
+   * Return the policy for the memory allocated by this object.
+   */
+  const AlignedVectorAllocationPolicy &
+  get_allocation_policy() const;
+
   /**
    * Return whether the vector is empty, i.e., its size is zero.
    */
@@ -684,6 +798,11 @@ private:
    * Pointer to the end of the allocated memory.
    */
   T *allocated_elements_end;
+
+  /**
+   * The policy used for allocating memory in reserve().
+   */
+  AlignedVectorAllocationPolicy allocation_policy;
 };
 
 
@@ -1043,6 +1162,17 @@ namespace internal
 
 
 
+inline constexpr AlignedVectorAllocationPolicy::AlignedVectorAllocationPolicy(
+  const bool        use_huge_pages,
+  const bool        parallel_first_touch,
+  const std::size_t minimum_size)
+  : use_huge_pages(use_huge_pages)
+  , parallel_first_touch(parallel_first_touch)
+  , minimum_size(minimum_size)
+{}
+
+
+
 template <typename T>
 inline AlignedVector<T>::Deleter::Deleter(AlignedVector<T> *owning_object)
   : deleter_action_object(nullptr) // encode default action by using a nullptr
@@ -1152,6 +1282,7 @@ inline AlignedVector<T>::AlignedVector()
   : elements(nullptr, Deleter(this))
   , used_elements_end(nullptr)
   , allocated_elements_end(nullptr)
+  , allocation_policy(AlignedVectorAllocationPolicy::get_default())
 {}
 
 
@@ -1161,6 +1292,7 @@ inline AlignedVector<T>::AlignedVector(const size_type size, const T &init)
   : elements(nullptr, Deleter(this))
   , used_elements_end(nullptr)
   , allocated_elements_end(nullptr)
+  , allocation_policy(AlignedVectorAllocationPolicy::get_default())
 {
   if (size > 0)
     resize(size, init);
@@ -1173,6 +1305,7 @@ inline AlignedVector<T>::AlignedVector(const AlignedVector<T> &vec)
   : elements(nullptr, Deleter(this))
   , used_elements_end(nullptr)
   , allocated_elements_end(nullptr)
+  , allocation_policy(vec.allocation_policy)
 {
   // copy the data from vec
   reserve(vec.size());
@@ -1188,7 +1321,9 @@ template <class T>
 inline AlignedVector<T>::AlignedVector(AlignedVector<T> &&vec) noexcept
   : AlignedVector<T>()
 {
-  // forward to the move operator
+  // forward to the move operator, which keeps the policy of this object, so
+  // set the policy of vec first
+  allocation_policy = vec.allocation_policy;
   *this = std::move(vec);
 }
 
@@ -1364,11 +1499,11 @@ AlignedVector<T>::reserve(const size_type new_allocated_size)
       const size_type new_size =
         std::max(new_allocated_size, 2 * old_allocated_size);
 
-      // allocate and align along 64-byte boundaries (this is enough for all
-      // levels of vectorization currently supported by deal.II)
+      // allocate and align along at least 64-byte boundaries (this is enough
+      // for all levels of vectorization currently supported by deal.II)
       T *new_data_ptr;
-      Utilities::System::posix_memalign(
-        reinterpret_cast<void **>(&new_data_ptr), 64, new_size * sizeof(T));
+      allocation_policy.allocate(reinterpret_cast<void **>(&new_data_ptr),
+                                 new_size * sizeof(T));
 
       // Now create a deleter that encodes what should happen when the object is
       // released: We need to destroy the objects that are currently alive (in
@@ -1896,6 +2031,26 @@ AlignedVector<T>::swap(AlignedVector<T> &vec)
   // Now also swap the remaining members.
   std::swap(used_elements_end, vec.used_elements_end);
   std::swap(allocated_elements_end, vec.allocated_elements_end);
+  std::swap(allocation_policy, vec.allocation_policy);
+}
+
+
+
+template <class T>
+inline void
+AlignedVector<T>::set_allocation_policy(
+  const AlignedVectorAllocationPolicy &policy)
+{
+  allocation_policy = policy;
+}
+
+
+
+template <class T>
+inline const AlignedVectorAllocationPolicy &
+AlignedVector<T>::get_allocation_policy() const
+{
+  return allocation_policy;
 }
 
 
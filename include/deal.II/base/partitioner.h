@@ -484,7 +484,132 @@ namespace Utilities
       bool
       ghost_indices_initialized() const;
 
+      /**
+       * Select whether export_to_ghosted_array_start() and
+       * import_from_ghosted_array_start() should set up persistent MPI
+       * requests with MPI_Recv_init() and MPI_Send_init() the first time they
+       * are called for a given set of arrays, and only start these requests
+       * with MPI_Startall() in subsequent calls, rather than posting new
+       * MPI_Irecv() and MPI_Isend() requests for every neighbor in every
+       * call. This removes the setup latency of the individual messages from
+       * each data exchange, which can make a difference when the exchange is
+       * done very often on small subdomains, e.g. in strong scaling
+       * experiments.
+       *
+       * Persistent requests are only used by callers that provide storage for
+       * them, see the class PersistentRequests. This is the case for
+       * LinearAlgebra::distributed::Vector::update_ghost_values() and
+       * LinearAlgebra::distributed::Vector::compress().
+       *
+       * The default is to not use persistent requests.
+       */
+      void
+      enable_persistent_requests(const bool enable = true);
+
+      /**
+       * Return whether persistent MPI requests are used for the data
+       * exchange, as set by enable_persistent_requests().
+       */
+      bool
+      persistent_requests_enabled() const;
+
+      /**
+       * Select whether the data exchange functions below should transfer
+       * arrays of type <tt>double</tt> in single precision, i.e., convert the
+       * data to <tt>float</tt> before sending it and back to <tt>double</tt>
+       * after receiving it. This halves the volume of the messages of
+       * LinearAlgebra::distributed::Vector::update_ghost_values() and
+       * LinearAlgebra::distributed::Vector::compress() for vectors of type
+       * <tt>double</tt>, which is useful for algorithms that are not
+       * sensitive to small perturbations of the ghost data, like multigrid
+       * smoothers or the preconditioners and inner solvers of
+       * flexible Krylov methods.
+       *
+       * The errors introduced by this setting are bounded as follows, with
+       * the unit roundoff $u = 2^{-24} \approx 6\cdot 10^{-8}$ of
+       * <tt>float</tt>:
+       * <ul>
+       * <li> After export_to_ghosted_array_finish(), each ghost entry $g$
+       * differs from the entry $x$ of its owner by $|g-x| \leq u|x|$.
+       * <li> After import_from_ghosted_array_finish() with
+       * VectorOperation::add, each locally owned entry differs from the
+       * exact result by at most $u$ times the sum of the absolute values of
+       * the contributions received from other processes. With
+       * VectorOperation::min and VectorOperation::max, the result differs
+       * by at most $u$ times the absolute value of the remote entry.
+       * VectorOperation::insert always uses the full precision, since it only
+       * communicates in debug mode to check the consistency of the data.
+       * </ul>
+       * These bounds hold for entries of magnitude between about
+       * $1.2\cdot 10^{-38}$ and $3.4\cdot 10^{38}$, the range of normalized
+       * <tt>float</tt> numbers. Smaller entries lose more relative accuracy
+       * or are flushed to zero, larger ones become infinite.
+       *
+       * The setting has no effect for other number types and for arrays that
+       * are not in MemorySpace::Host. It must not be changed while a data
+       * exchange is in progress. The default is to transfer the data in full
+       * precision.
+       */
+      void
+      enable_reduced_precision_communication(const bool enable = true);
+
+      /**
+       * Return whether data of type <tt>double</tt> is transferred in single
+       * precision, as set by enable_reduced_precision_communication().
+       */
+      bool
+      reduced_precision_communication_enabled() const;
+
 #ifdef DEAL_II_WITH_MPI
+      /**
+       * A set of persistent MPI requests for the data exchange between a
+       * particular temporary storage array and a particular ghost array, as
+       * set up by export_to_ghosted_array_start() or
+       * import_from_ghosted_array_start() if persistent requests have been
+       * enabled with enable_persistent_requests().
+       *
+       * Since the requests are bound to the memory locations of the arrays,
+       * objects of this class are owned by the caller of these functions,
+       * i.e., by the object that owns the arrays, and must only be used with
+       * a single partitioner. The requests are set up again automatically
+       * whenever the arrays or the communication channel change. Call clear()
+       * before the arrays are deallocated or the object is destroyed.
+       */
+      struct PersistentRequests
+      {
+        /**
+         * Free all requests and reset the object to its initial state.
+         */
+        void
+        clear();
+
+        /**
+         * The persistent requests, with the receive requests first and the
+         * send requests second.
+         */
+        std::vector<MPI_Request> requests;
+
+        /**
+         * The array the receive requests were set up for.
+         */
+        const void *receive_buffer = nullptr;
+
+        /**
+         * The array the send requests were set up for.
+         */
+        const void *send_buffer = nullptr;
+
+        /**
+         * The size of a single entry in the arrays, in bytes.
+         */
+        unsigned int number_size = 0;
+
+        /**
+         * The MPI tag the requests were set up with.
+         */
+        int mpi_tag = 0;
+      };
+
       /**
        * Start the exportation of the data in a locally owned array to the
        * range described by the ghost indices of this class.
@@ -517,6 +642,13 @@ namespace Utilities
        * communication that will be finalized in the
        * export_to_ghosted_array_finish() call.
        *
+       * @param persistent_requests Storage for persistent MPI requests bound
+       * to @p temporary_storage and @p ghost_array. If persistent requests
+       * have been enabled with enable_persistent_requests() and this argument
+       * is not a null pointer, the requests stored there are set up if
+       * necessary and started instead of posting new requests, and
+       * @p requests is filled with (copies of the handles of) these requests.
+       *
        * This functionality is used in
        * LinearAlgebra::distributed::Vector::update_ghost_values().
        */
@@ -527,7 +659,8 @@ namespace Utilities
         const ArrayView<const Number, MemorySpaceType> &locally_owned_array,
         const ArrayView<Number, MemorySpaceType> &      temporary_storage,
         const ArrayView<Number, MemorySpaceType> &      ghost_array,
-        std::vector<MPI_Request> &                      requests) const;
+        std::vector<MPI_Request> &                      requests,
+        PersistentRequests *persistent_requests = nullptr) const;
 
       /**
        * Finish the exportation of the data in a locally owned array to the
@@ -586,6 +719,11 @@ namespace Utilities
        * communication that will be finalized in the
        * export_to_ghosted_array_finish() call.
        *
+       * @param persistent_requests Storage for persistent MPI requests bound
+       * to @p ghost_array and @p temporary_storage, with the same meaning as
+       * in export_to_ghosted_array_start(). The object must be a different
+       * one than the one used for export_to_ghosted_array_start().
+       *
        * This functionality is used in
        * LinearAlgebra::distributed::Vector::compress().
        */
@@ -596,7 +734,8 @@ namespace Utilities
         const unsigned int                        communication_channel,
         const ArrayView<Number, MemorySpaceType> &ghost_array,
         const ArrayView<Number, MemorySpaceType> &temporary_storage,
-        std::vector<MPI_Request> &                requests) const;
+        std::vector<MPI_Request> &                requests,
+        PersistentRequests *persistent_requests = nullptr) const;
 
       /**
        * Finish importing the data from an array indexed by the ghost
@@ -679,6 +818,26 @@ namespace Utilities
       void
       initialize_import_indices_plain_dev() const;
 
+#ifdef DEAL_II_WITH_MPI
+      /**
+       * Set up the persistent requests in @p persistent_requests for
+       * receiving the messages from @p receive_targets into @p receive_buffer
+       * and for sending the messages to @p send_targets from @p send_buffer,
+       * unless they have already been set up for these arrays and this tag.
+       */
+      void
+      initialize_persistent_requests(
+        PersistentRequests &persistent_requests,
+        const std::vector<std::pair<unsigned int, unsigned int>>
+          &                receive_targets,
+        void *             receive_buffer,
+        const std::vector<std::pair<unsigned int, unsigned int>>
+          &                send_targets,
+        const void *       send_buffer,
+        const unsigned int number_size,
+        const int          mpi_tag) const;
+#endif
+
       /**
        * The global size of the vector over all processors
        */
@@ -793,6 +952,18 @@ namespace Utilities
        * A variable storing whether the ghost indices have been explicitly set.
        */
       bool have_ghost_indices;
+
+      /**
+       * A variable storing whether persistent MPI requests are used for the
+       * data exchange, see enable_persistent_requests().
+       */
+      bool use_persistent_requests;
+
+      /**
+       * A variable storing whether data of type double is transferred in
+       * single precision, see enable_reduced_precision_communication().
+       */
+      bool use_reduced_precision_communication;
     };
 
 
@@ -994,6 +1165,22 @@ namespace Utilities
       return have_ghost_indices;
     }
 
+
+
+    inline bool
+    Partitioner::persistent_requests_enabled() const
+    {
+      return use_persistent_requests;
+    }
+
+
+
+    inline bool
+    Partitioner::reduced_precision_communication_enabled() const
+    {
+      return use_reduced_precision_communication;
+    }
+
 #endif // ifndef DOXYGEN
 
   } // end of namespace MPI
@@ -24,6 +24,7 @@
 #include <deal.II/lac/cuda_kernels.templates.h>
 #include <deal.II/lac/la_parallel_vector.h>
 
+#include <cstring>
 #include <type_traits>
 
 
@@ -37,6 +38,80 @@ namespace Utilities
 
 #  ifdef DEAL_II_WITH_MPI
 
+    namespace internal
+    {
+      // The number type used to transfer data of type Number when reduced
+      // precision communication is enabled in the partitioner. Only double
+      // is transferred in a lower precision.
+      template <typename Number>
+      struct ReducedPrecision
+      {
+        using type = Number;
+      };
+
+      template <>
+      struct ReducedPrecision<double>
+      {
+        using type = float;
+      };
+
+      // Return whether data of type Number in the given memory space is
+      // transferred in a lower precision when reduced precision
+      // communication is enabled.
+      template <typename Number, typename MemorySpaceType>
+      constexpr bool
+      has_reduced_precision()
+      {
+        return std::is_same<MemorySpaceType, MemorySpace::Host>::value &&
+               !std::is_same<Number,
+                             typename ReducedPrecision<Number>::type>::value;
+      }
+
+      // Convert n entries starting at data to the reduced precision type
+      // and write them contiguously to the memory starting at destination,
+      // which may overlap with the data as long as it does not start behind
+      // it. The data is accessed through memcpy because the same memory
+      // holds entries of both types.
+      template <typename Number>
+      void
+      convert_to_reduced_precision(const Number *     data,
+                                   const unsigned int n,
+                                   char *             destination)
+      {
+        using ReducedNumber = typename ReducedPrecision<Number>::type;
+        for (unsigned int i = 0; i < n; ++i)
+          {
+            const ReducedNumber value = static_cast<ReducedNumber>(data[i]);
+            std::memcpy(destination + i * sizeof(ReducedNumber),
+                        &value,
+                        sizeof(ReducedNumber));
+          }
+      }
+
+      // The inverse of convert_to_reduced_precision() for the case that the
+      // entries in reduced precision are stored at the beginning of the
+      // memory of the n entries of type Number. The entries are processed
+      // backwards in order to not overwrite data that has not been read.
+      template <typename Number>
+      void
+      convert_from_reduced_precision(Number *data, const unsigned int n)
+      {
+        using ReducedNumber = typename ReducedPrecision<Number>::type;
+        const char *source  = reinterpret_cast<const char *>(data);
+        for (unsigned int i = n; i > 0;)
+          {
+            --i;
+            ReducedNumber value;
+            std::memcpy(&value,
+                        source + i * sizeof(ReducedNumber),
+                        sizeof(ReducedNumber));
+            data[i] = value;
+          }
+      }
+    } // namespace internal
+
+
+
     template <typename Number, typename MemorySpaceType>
     void
     Partitioner::export_to_ghosted_array_start(
@@ -44,7 +119,8 @@ namespace Utilities
       const ArrayView<const Number, MemorySpaceType> &locally_owned_array,
       const ArrayView<Number, MemorySpaceType> &      temporary_storage,
       const ArrayView<Number, MemorySpaceType> &      ghost_array,
-      std::vector<MPI_Request> &                      requests) const
+      std::vector<MPI_Request> &                      requests,
+      PersistentRequests *persistent_requests) const
     {
       AssertDimension(temporary_storage.size(), n_import_indices());
       AssertIndexRange(communication_channel, 200);
@@ -88,23 +164,59 @@ namespace Utilities
                            n_ghost_indices() :
                          ghost_array.data();
 
-      for (unsigned int i = 0; i < n_ghost_targets; ++i)
+      // in reduced precision, the data of all messages is stored contiguously
+      // in the lower precision at the beginning of the arrays
+      const bool use_reduced_precision =
+        use_reduced_precision_communication &&
+        internal::has_reduced_precision<Number, MemorySpaceType>();
+      const unsigned int transfer_size =
+        use_reduced_precision ?
+          sizeof(typename internal::ReducedPrecision<Number>::type) :
+          sizeof(Number);
+
+      // with persistent requests, the requests only need to be set up once
+      // for the given arrays, and are started separately for the receives
+      // here and for the sends once all the data has been packed below
+      const bool use_persistent =
+        use_persistent_requests && persistent_requests != nullptr;
+      if (use_persistent)
         {
-          // allow writing into ghost indices even though we are in a
-          // const function
-          const int ierr =
-            MPI_Irecv(ghost_array_ptr,
-                      ghost_targets_data[i].second * sizeof(Number),
-                      MPI_BYTE,
-                      ghost_targets_data[i].first,
-                      mpi_tag,
-                      communicator,
-                      &requests[i]);
-          AssertThrowMPI(ierr);
-          ghost_array_ptr += ghost_targets_data[i].second;
+          initialize_persistent_requests(*persistent_requests,
+                                         ghost_targets_data,
+                                         ghost_array_ptr,
+                                         import_targets_data,
+                                         temporary_storage.data(),
+                                         transfer_size,
+                                         mpi_tag);
+          requests = persistent_requests->requests;
+          if (n_ghost_targets > 0)
+            {
+              const int ierr = MPI_Startall(n_ghost_targets, requests.data());
+              AssertThrowMPI(ierr);
+            }
+        }
+      else
+        {
+          char *receive_ptr = reinterpret_cast<char *>(ghost_array_ptr);
+          for (unsigned int i = 0; i < n_ghost_targets; ++i)
+            {
+              // allow writing into ghost indices even though we are in a
+              // const function
+              const int ierr =
+                MPI_Irecv(receive_ptr,
+                          ghost_targets_data[i].second * transfer_size,
+                          MPI_BYTE,
+                          ghost_targets_data[i].first,
+                          mpi_tag,
+                          communicator,
+                          &requests[i]);
+              AssertThrowMPI(ierr);
+              receive_ptr += ghost_targets_data[i].second * transfer_size;
+            }
         }
 
       Number *temp_array_ptr = temporary_storage.data();
+      char *  send_ptr       = reinterpret_cast<char *>(temp_array_ptr);
 #    if defined(DEAL_II_COMPILER_CUDA_AWARE) && \
       defined(DEAL_II_MPI_WITH_CUDA_SUPPORT)
       // When using CUDAs-aware MPI, the set of local indices that are ghosts
@@ -160,17 +272,32 @@ namespace Utilities
               AssertDimension(index, import_targets_data[i].second);
             }
 
+          if (use_reduced_precision)
+            internal::convert_to_reduced_precision(
+              temp_array_ptr, import_targets_data[i].second, send_ptr);
+
           // start the send operations
+          if (!use_persistent)
+            {
+              const int ierr =
+                MPI_Isend(send_ptr,
+                          import_targets_data[i].second * transfer_size,
+                          MPI_BYTE,
+                          import_targets_data[i].first,
+                          mpi_tag,
+                          communicator,
+                          &requests[n_ghost_targets + i]);
+              AssertThrowMPI(ierr);
+            }
+          temp_array_ptr += import_targets_data[i].second;
+          send_ptr += import_targets_data[i].second * transfer_size;
+        }
+
+      if (use_persistent && n_import_targets > 0)
+        {
           const int ierr =
-            MPI_Isend(temp_array_ptr,
-                      import_targets_data[i].second * sizeof(Number),
-                      MPI_BYTE,
-                      import_targets_data[i].first,
-                      mpi_tag,
-                      communicator,
-                      &requests[n_ghost_targets + i]);
+            MPI_Startall(n_import_targets, requests.data() + n_ghost_targets);
           AssertThrowMPI(ierr);
-          temp_array_ptr += import_targets_data[i].second;
         }
     }
 
@@ -200,6 +327,22 @@ namespace Utilities
         }
       requests.resize(0);
 
+      // convert the data received in reduced precision, which starts at the
+      // same position as the data was received to
+      if (use_reduced_precision_communication &&
+          internal::has_reduced_precision<Number, MemorySpaceType>())
+        {
+          const bool use_larger_set =
+            (n_ghost_indices_in_larger_set > n_ghost_indices() &&
+             ghost_array.size() == n_ghost_indices_in_larger_set);
+          internal::convert_from_reduced_precision(
+            use_larger_set ? ghost_array.data() +
+                               n_ghost_indices_in_larger_set -
+                               n_ghost_indices() :
+                             ghost_array.data(),
+            n_ghost_indices());
+        }
+
       // in case we only sent a subset of indices, we now need to move the data
       // to the correct positions and delete the old content
       if (n_ghost_indices_in_larger_set > n_ghost_indices() &&
@@ -268,7 +411,8 @@ namespace Utilities
       const unsigned int                        communication_channel,
       const ArrayView<Number, MemorySpaceType> &ghost_array,
       const ArrayView<Number, MemorySpaceType> &temporary_storage,
-      std::vector<MPI_Request> &                requests) const
+      std::vector<MPI_Request> &                requests,
+      PersistentRequests *                      persistent_requests) const
     {
       AssertDimension(temporary_storage.size(), n_import_indices());
       AssertIndexRange(communication_channel, 200);
@@ -313,27 +457,64 @@ namespace Utilities
              ExcInternalError());
       requests.resize(n_import_targets + n_ghost_targets);
 
-      // initiate the receive operations
-      Number *temp_array_ptr = temporary_storage.data();
-      for (unsigned int i = 0; i < n_import_targets; ++i)
+      // in reduced precision, the data of all messages is stored contiguously
+      // in the lower precision at the beginning of the arrays. insert only
+      // communicates for checking the consistency of the data in debug mode,
+      // which needs the full precision
+      const bool use_reduced_precision =
+        use_reduced_precision_communication &&
+        internal::has_reduced_precision<Number, MemorySpaceType>() &&
+        vector_operation != VectorOperation::insert;
+      const unsigned int transfer_size =
+        use_reduced_precision ?
+          sizeof(typename internal::ReducedPrecision<Number>::type) :
+          sizeof(Number);
+
+      // initiate the receive operations, either by starting the persistent
+      // requests or by posting new ones
+      const bool use_persistent =
+        use_persistent_requests && persistent_requests != nullptr;
+      if (use_persistent)
         {
-          AssertThrow(
-            static_cast<std::size_t>(import_targets_data[i].second) *
-                sizeof(Number) <
-              static_cast<std::size_t>(std::numeric_limits<int>::max()),
-            ExcMessage("Index overflow: Maximum message size in MPI is 2GB. "
-                       "The number of ghost entries times the size of 'Number' "
-                       "exceeds this value. This is not supported."));
-          const int ierr =
-            MPI_Irecv(temp_array_ptr,
-                      import_targets_data[i].second * sizeof(Number),
-                      MPI_BYTE,
-                      import_targets_data[i].first,
-                      mpi_tag,
-                      communicator,
-                      &requests[i]);
-          AssertThrowMPI(ierr);
-          temp_array_ptr += import_targets_data[i].second;
+          initialize_persistent_requests(*persistent_requests,
+                                         import_targets_data,
+                                         temporary_storage.data(),
+                                         ghost_targets_data,
+                                         ghost_array.data(),
+                                         transfer_size,
+                                         mpi_tag);
+          requests = persistent_requests->requests;
+          if (n_import_targets > 0)
+            {
+              const int ierr = MPI_Startall(n_import_targets, requests.data());
+              AssertThrowMPI(ierr);
+            }
+        }
+      else
+        {
+          char *receive_ptr =
+            reinterpret_cast<char *>(temporary_storage.data());
+          for (unsigned int i = 0; i < n_import_targets; ++i)
+            {
+              AssertThrow(
+                static_cast<std::size_t>(import_targets_data[i].second) *
+                    sizeof(Number) <
+                  static_cast<std::size_t>(std::numeric_limits<int>::max()),
+                ExcMessage(
+                  "Index overflow: Maximum message size in MPI is 2GB. "
+                  "The number of ghost entries times the size of 'Number' "
+                  "exceeds this value. This is not supported."));
+              const int ierr =
+                MPI_Irecv(receive_ptr,
+                          import_targets_data[i].second * transfer_size,
+                          MPI_BYTE,
+                          import_targets_data[i].first,
+                          mpi_tag,
+                          communicator,
+                          &requests[i]);
+              AssertThrowMPI(ierr);
+              receive_ptr += import_targets_data[i].second * transfer_size;
+            }
         }
 
       // initiate the send operations
@@ -342,6 +523,7 @@ namespace Utilities
       // move the data to send to the front of the array
       AssertIndexRange(n_ghost_indices(), n_ghost_indices_in_larger_set + 1);
       Number *ghost_array_ptr = ghost_array.data();
+      char *  send_ptr        = reinterpret_cast<char *>(ghost_array_ptr);
       for (unsigned int i = 0; i < n_ghost_targets; ++i)
         {
           // in case we only sent a subset of indices, we now need to move the
@@ -417,17 +599,32 @@ namespace Utilities
           if (std::is_same<MemorySpaceType, MemorySpace::CUDA>::value)
             cudaDeviceSynchronize();
 #    endif
-          const int ierr =
-            MPI_Isend(ghost_array_ptr,
-                      ghost_targets_data[i].second * sizeof(Number),
-                      MPI_BYTE,
-                      ghost_targets_data[i].first,
-                      mpi_tag,
-                      communicator,
-                      &requests[n_import_targets + i]);
-          AssertThrowMPI(ierr);
+          if (use_reduced_precision)
+            internal::convert_to_reduced_precision(
+              ghost_array_ptr, ghost_targets_data[i].second, send_ptr);
+
+          if (!use_persistent)
+            {
+              const int ierr =
+                MPI_Isend(send_ptr,
+                          ghost_targets_data[i].second * transfer_size,
+                          MPI_BYTE,
+                          ghost_targets_data[i].first,
+                          mpi_tag,
+                          communicator,
+                          &requests[n_import_targets + i]);
+              AssertThrowMPI(ierr);
+            }
 
           ghost_array_ptr += ghost_targets_data[i].second;
+          send_ptr += ghost_targets_data[i].second * transfer_size;
+        }
+
+      if (use_persistent && n_ghost_targets > 0)
+        {
+          const int ierr =
+            MPI_Startall(n_ghost_targets, requests.data() + n_import_targets);
+          AssertThrowMPI(ierr);
         }
     }
 
@@ -581,6 +778,16 @@ namespace Utilities
             MPI_Waitall(n_import_targets, requests.data(), MPI_STATUSES_IGNORE);
           AssertThrowMPI(ierr);
 
+          // convert the data received in reduced precision. the temporary
+          // storage is owned by the caller and only holds the received data,
+          // so it can be overwritten
+          if (use_reduced_precision_communication &&
+              internal::has_reduced_precision<Number, MemorySpaceType>() &&
+              vector_operation != VectorOperation::insert)
+            internal::convert_from_reduced_precision(
+              const_cast<Number *>(temporary_storage.data()),
+              n_import_indices());
+
           const Number *read_position = temporary_storage.data();
 #    if !(defined(DEAL_II_COMPILER_CUDA_AWARE) && \
           defined(DEAL_II_MPI_WITH_CUDA_SUPPORT))
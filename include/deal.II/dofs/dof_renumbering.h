@@ -30,6 +30,12 @@
 
 DEAL_II_NAMESPACE_OPEN
 
+// forward declaration
+#ifndef DOXYGEN
+template <int dim, typename Number, typename VectorizedArrayType>
+class MatrixFree;
+#endif
+
 /**
  * Implementation of a number of renumbering algorithms for the degrees of
  * freedom on a triangulation. The functions in this namespace compute
@@ -625,6 +631,44 @@ namespace DoFRenumbering
                 const std::vector<types::global_dof_index> &starting_indices =
                   std::vector<types::global_dof_index>());
 
+  /**
+   * Renumber the degrees of freedom by nested dissection, as computed by
+   * SparsityTools::reorder_nested_dissection() on the sparsity pattern of
+   * the degrees of freedom. In contrast to the Cuthill-McKee numbering,
+   * which minimizes the bandwidth of the matrix, this numbering reduces the
+   * fill-in of sparse direct solvers such as SparseDirectUMFPACK and of
+   * incomplete factorizations such as SparseILU, and it works on the
+   * sparsity pattern directly rather than on a copy of the graph as the
+   * functions in namespace DoFRenumbering::boost do.
+   *
+   * If @p use_constraints is set to true, the hanging node constraints are
+   * taken into account for the connectivity of the degrees of freedom. For
+   * a DoFHandler built on a parallel triangulation, each process renumbers
+   * its locally owned degrees of freedom based on the couplings among them.
+   *
+   * See SparsityTools::reorder_nested_dissection() for the meaning of @p
+   * min_subgraph_size.
+   */
+  template <int dim, int spacedim>
+  void
+  nested_dissection(DoFHandler<dim, spacedim> &dof_handler,
+                    const bool                 use_constraints   = false,
+                    const unsigned int         min_subgraph_size = 64);
+
+  /**
+   * Compute the renumbering vector needed by the nested_dissection()
+   * function. This function does not perform the renumbering on the
+   * DoFHandler DoFs but only returns the renumbering vector, which has one
+   * entry per locally owned degree of freedom.
+   */
+  template <int dim, int spacedim>
+  void
+  compute_nested_dissection(
+    std::vector<types::global_dof_index> &new_dof_indices,
+    const DoFHandler<dim, spacedim> &     dof_handler,
+    const bool                            use_constraints   = false,
+    const unsigned int                    min_subgraph_size = 64);
+
   /**
    * @name Component-wise numberings
    * @{
@@ -1214,6 +1258,63 @@ namespace DoFRenumbering
    * @}
    */
 
+  /**
+   * @name Numberings for matrix-free operator evaluation
+   * @{
+   */
+
+  /**
+   * Renumber the degrees of freedom in the order in which they are accessed
+   * by the cell loop of the given MatrixFree object, in order to improve the
+   * data locality of matrix-free operator evaluation.
+   *
+   * The cells are visited in the order of the cell batches of @p matrix_free
+   * and, within each batch, in the order of the lanes of the vectorization.
+   * The locally owned degrees of freedom are numbered in the order in which
+   * they are first touched by this traversal. As a consequence,
+   * FEEvaluation::read_dof_values() and
+   * FEEvaluation::distribute_local_to_global() of consecutive cell batches
+   * access nearly contiguous ranges of the vectors, which improves the use
+   * of caches and hardware prefetchers. Degrees of freedom that are sent to
+   * other processes in the ghost exchange of the vectors created by
+   * MatrixFree::initialize_dof_vector() are placed at the beginning of the
+   * locally owned range, grouped by the process they are sent to, such that
+   * the import indices of the Utilities::MPI::Partitioner form few
+   * contiguous ranges. Degrees of freedom not touched by any cell of @p
+   * matrix_free are placed at the end in their original order.
+   *
+   * If @p matrix_free has been set up on a multigrid level, the degrees of
+   * freedom of that level are renumbered.
+   *
+   * @note The @p dof_handler must be one of the DoFHandler objects used to
+   * set up @p matrix_free. Since the index information stored in @p
+   * matrix_free refers to the old numbering, the MatrixFree object (and any
+   * AffineConstraints object and vector set up with the old numbering) must
+   * be reinitialized after calling this function.
+   */
+  template <int dim, typename Number, typename VectorizedArrayType>
+  void
+  matrix_free_data_locality(
+    DoFHandler<dim> &                                   dof_handler,
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free);
+
+  /**
+   * Compute the renumbering vector needed by the matrix_free_data_locality()
+   * function. Does not perform the renumbering on the @p DoFHandler dofs but
+   * returns the renumbering vector, which has one entry per locally owned
+   * degree of freedom.
+   */
+  template <int dim, typename Number, typename VectorizedArrayType>
+  void
+  compute_matrix_free_data_locality(
+    std::vector<types::global_dof_index> &              new_dof_indices,
+    const DoFHandler<dim> &                             dof_handler,
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free);
+
+  /**
+   * @}
+   */
+
   /**
    * @name Numberings based on properties of the finite element space
    * @{
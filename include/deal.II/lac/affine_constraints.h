@@ -18,6 +18,7 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/array_view.h>
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/index_set.h>
 #include <deal.II/base/subscriptor.h>
@@ -31,6 +32,7 @@
 #include <boost/range/iterator_range.hpp>
 
 #include <algorithm>
+#include <array>
 #include <set>
 #include <type_traits>
 #include <utility>
@@ -391,6 +393,20 @@ namespace internal
        * Data array for reorder row/column indices.
        */
       GlobalRowsFromLocal<number> global_columns;
+
+      /**
+       * Temporary arrays for the column indices and values that the cells of
+       * a batch contribute to the global matrix, stored row by row.
+       */
+      std::vector<size_type> batch_columns;
+      std::vector<number>    batch_values;
+
+      /**
+       * Temporary array for the rows that the cells of a batch contribute
+       * to, with the global row index and the range of the row's entries in
+       * batch_columns and batch_values.
+       */
+      std::vector<std::array<size_type, 3>> batch_rows;
     };
   } // namespace AffineConstraints
 } // namespace internal
@@ -766,6 +782,12 @@ public:
    * cycles in this graph of constraints are not allowed, i.e., for example
    * $u_4$ may not itself be constrained, directly or indirectly, to $u_{13}$
    * again.
+   *
+   * For large numbers of constraints, the chains are resolved with several
+   * threads: every line is then expanded on its own against the entries the
+   * other lines had before this function was called, so that the result does
+   * not depend on the number of threads. The entries of each line remain
+   * stored in its ConstraintLine object.
    */
   void
   close();
@@ -1464,6 +1486,55 @@ public:
                              VectorType &                  global_vector,
                              bool use_inhomogeneities_for_rhs = false) const;
 
+  /**
+   * Batched version of the previous function: write the local matrices and
+   * vectors of several cells into the global matrix and vector at once, for
+   * example the copy data a WorkStream copier has collected for a chunk of
+   * cells. The three ArrayView arguments hold one entry per cell;
+   * @p local_vectors may also be empty if only the matrix is to be
+   * assembled, in which case @p global_vector is not accessed.
+   *
+   * Rather than adding the contributions of each cell to the rows of the
+   * matrix separately, this function first resolves the constraints for all
+   * cells and then merges the contributions of all cells to the same global
+   * row, so that the column indices of each row of the global matrix are
+   * searched only once per batch. For matrices with a sparsity pattern, this
+   * saves most of the column lookups for degrees of freedom shared between
+   * the cells of the batch. Since contributions of different cells to the
+   * same matrix entry are summed up before they are added to the matrix, the
+   * result may differ from calling the previous function cell by cell in the
+   * last digits due to round-off.
+   *
+   * For SparseMatrix objects, the merged entries of a row are added in place
+   * during a single walk through the row of the matrix, as the previous
+   * function does for the entries of one cell. For block matrices, this
+   * function calls the previous function for each cell, so the result is the
+   * same as when calling the previous function cell by cell.
+   *
+   * The same thread-safety considerations as for the previous function
+   * apply.
+   */
+  template <typename MatrixType, typename VectorType>
+  void
+  distribute_local_to_global(
+    const ArrayView<const FullMatrix<number>> &     local_matrices,
+    const ArrayView<const Vector<number>> &         local_vectors,
+    const ArrayView<const std::vector<size_type>> &local_dof_indices,
+    MatrixType &                                   global_matrix,
+    VectorType &                                   global_vector,
+    const bool use_inhomogeneities_for_rhs = false) const;
+
+  /**
+   * Batched version of the distribute_local_to_global() function for
+   * matrices only. See the previous function for details.
+   */
+  template <typename MatrixType>
+  void
+  distribute_local_to_global(
+    const ArrayView<const FullMatrix<number>> &     local_matrices,
+    const ArrayView<const std::vector<size_type>> &local_dof_indices,
+    MatrixType &                                   global_matrix) const;
+
   /**
    * Do a similar operation as the distribute_local_to_global() function that
    * distributes writing entries into a matrix for constrained degrees of
@@ -1972,6 +2043,36 @@ private:
                              const bool use_inhomogeneities_for_rhs,
                              const std::integral_constant<bool, true>) const;
 
+  /**
+   * This function actually implements the batched local_to_global function
+   * for standard (non-block) matrices.
+   */
+  template <typename MatrixType, typename VectorType>
+  void
+  distribute_local_to_global(
+    const ArrayView<const FullMatrix<number>> &     local_matrices,
+    const ArrayView<const Vector<number>> &         local_vectors,
+    const ArrayView<const std::vector<size_type>> &local_dof_indices,
+    MatrixType &                                   global_matrix,
+    VectorType &                                   global_vector,
+    const bool                                     use_inhomogeneities_for_rhs,
+    const std::integral_constant<bool, false>) const;
+
+  /**
+   * This function implements the batched local_to_global function for block
+   * matrices by a loop over the cells of the batch.
+   */
+  template <typename MatrixType, typename VectorType>
+  void
+  distribute_local_to_global(
+    const ArrayView<const FullMatrix<number>> &     local_matrices,
+    const ArrayView<const Vector<number>> &         local_vectors,
+    const ArrayView<const std::vector<size_type>> &local_dof_indices,
+    MatrixType &                                   global_matrix,
+    VectorType &                                   global_vector,
+    const bool                                     use_inhomogeneities_for_rhs,
+    const std::integral_constant<bool, true>) const;
+
   /**
    * This function actually implements the local_to_global function for
    * standard (non-block) sparsity types.
@@ -2564,6 +2665,88 @@ AffineConstraints<number>::distribute_local_to_global(
 
 
 
+template <typename number>
+template <typename MatrixType, typename VectorType>
+inline void
+AffineConstraints<number>::distribute_local_to_global(
+  const ArrayView<const FullMatrix<number>> &     local_matrices,
+  const ArrayView<const Vector<number>> &         local_vectors,
+  const ArrayView<const std::vector<size_type>> &local_dof_indices,
+  MatrixType &                                   global_matrix,
+  VectorType &                                   global_vector,
+  const bool use_inhomogeneities_for_rhs) const
+{
+  distribute_local_to_global(
+    local_matrices,
+    local_vectors,
+    local_dof_indices,
+    global_matrix,
+    global_vector,
+    use_inhomogeneities_for_rhs,
+    std::integral_constant<
+      bool,
+      internal::AffineConstraints::IsBlockMatrix<MatrixType>::value>());
+}
+
+
+
+template <typename number>
+template <typename MatrixType>
+inline void
+AffineConstraints<number>::distribute_local_to_global(
+  const ArrayView<const FullMatrix<number>> &     local_matrices,
+  const ArrayView<const std::vector<size_type>> &local_dof_indices,
+  MatrixType &                                   global_matrix) const
+{
+  Vector<typename MatrixType::value_type> dummy(0);
+  distribute_local_to_global(
+    local_matrices,
+    ArrayView<const Vector<number>>(),
+    local_dof_indices,
+    global_matrix,
+    dummy,
+    false,
+    std::integral_constant<
+      bool,
+      internal::AffineConstraints::IsBlockMatrix<MatrixType>::value>());
+}
+
+
+
+template <typename number>
+template <typename MatrixType, typename VectorType>
+inline void
+AffineConstraints<number>::distribute_local_to_global(
+  const ArrayView<const FullMatrix<number>> &     local_matrices,
+  const ArrayView<const Vector<number>> &         local_vectors,
+  const ArrayView<const std::vector<size_type>> &local_dof_indices,
+  MatrixType &                                   global_matrix,
+  VectorType &                                   global_vector,
+  const bool                                     use_inhomogeneities_for_rhs,
+  const std::integral_constant<bool, true>) const
+{
+  AssertDimension(local_matrices.size(), local_dof_indices.size());
+  Assert(local_vectors.size() == 0 ||
+           local_vectors.size() == local_matrices.size(),
+         ExcDimensionMismatch(local_vectors.size(), local_matrices.size()));
+
+  // the function for a single cell writes into BlockSparseMatrix objects in
+  // place, so there is nothing to gain from collecting the rows of several
+  // cells for block matrices
+  const Vector<number> no_vector;
+  for (unsigned int c = 0; c < local_matrices.size(); ++c)
+    distribute_local_to_global(local_matrices[c],
+                               local_vectors.size() > 0 ? local_vectors[c] :
+                                                          no_vector,
+                               local_dof_indices[c],
+                               global_matrix,
+                               global_vector,
+                               use_inhomogeneities_for_rhs,
+                               std::integral_constant<bool, true>());
+}
+
+
+
 template <typename number>
 template <typename SparsityPatternType>
 inline void
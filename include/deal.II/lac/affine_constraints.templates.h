@@ -21,6 +21,7 @@
 #include <deal.II/base/cuda_size.h>
 #include <deal.II/base/memory_consumption.h>
 #include <deal.II/base/mpi_compute_index_owner_internal.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/table.h>
 #include <deal.II/base/thread_local_storage.h>
 
@@ -707,10 +708,197 @@ AffineConstraints<number>::close()
       largest_idx = std::max(largest_idx, entry.first);
 #endif
 
-  // replace references to dofs that are themselves constrained. note that
-  // because we may replace references to other dofs that may themselves be
-  // constrained to third ones, we have to iterate over all this until we
-  // replace no chains of constraints any more
+  // the following function sorts the entries of a line once all chains are
+  // resolved, and re-scales them if necessary. in this step, we also throw
+  // out duplicates as mentioned below. moreover, as some entries might have
+  // had zero weights, we replace them by a vector with sharp sizes.
+  const auto sort_and_merge_entries = [](ConstraintLine &line) {
+    std::sort(line.entries.begin(),
+              line.entries.end(),
+              [](const std::pair<unsigned int, number> &a,
+                 const std::pair<unsigned int, number> &b) -> bool {
+                // Let's use lexicogrpahic ordering with std::abs for number
+                // type (it might be complex valued).
+                return (a.first < b.first) ||
+                       (a.first == b.first &&
+                        std::abs(a.second) < std::abs(b.second));
+              });
+
+    // loop over the now sorted list and see whether any of the entries
+    // references the same dofs more than once in order to find how many
+    // non-duplicate entries we have. This lets us allocate the correct
+    // amount of memory for the constraint entries.
+    size_type duplicates = 0;
+    for (size_type i = 1; i < line.entries.size(); ++i)
+      if (line.entries[i].first == line.entries[i - 1].first)
+        duplicates++;
+
+    if (duplicates > 0 || line.entries.size() < line.entries.capacity())
+      {
+        typename ConstraintLine::Entries new_entries;
+
+        // if we have no duplicates, copy verbatim the entries. this way,
+        // the final size is of the vector is correct.
+        if (duplicates == 0)
+          new_entries = line.entries;
+        else
+          {
+            // otherwise, we need to go through the list and resolve the
+            // duplicates
+            new_entries.reserve(line.entries.size() - duplicates);
+            new_entries.push_back(line.entries[0]);
+            for (size_type j = 1; j < line.entries.size(); ++j)
+              if (line.entries[j].first == line.entries[j - 1].first)
+                {
+                  Assert(new_entries.back().first == line.entries[j].first,
+                         ExcInternalError());
+                  new_entries.back().second += line.entries[j].second;
+                }
+              else
+                new_entries.push_back(line.entries[j]);
+
+            Assert(new_entries.size() == line.entries.size() - duplicates,
+                   ExcInternalError());
+
+            // make sure there are really no duplicates left and that the
+            // list is still sorted
+            for (size_type j = 1; j < new_entries.size(); ++j)
+              {
+                Assert(new_entries[j].first != new_entries[j - 1].first,
+                       ExcInternalError());
+                Assert(new_entries[j].first > new_entries[j - 1].first,
+                       ExcInternalError());
+              }
+          }
+
+        // replace old list of constraints for this dof by the new one
+        line.entries.swap(new_entries);
+      }
+
+    // Finally do the following check: if the sum of weights for the
+    // constraints is close to one, but not exactly one, then rescale all
+    // the weights so that they sum up to 1. this adds a little numerical
+    // stability and avoids all sorts of problems where the actual value
+    // is close to, but not quite what we expected
+    //
+    // the case where the weights don't quite sum up happens when we
+    // compute the interpolation weights "on the fly", i.e. not from
+    // precomputed tables. in this case, the interpolation weights are
+    // also subject to round-off
+    number sum = 0.;
+    for (const std::pair<size_type, number> &entry : line.entries)
+      sum += entry.second;
+    if (std::abs(sum - number(1.)) < 1.e-13)
+      {
+        for (std::pair<size_type, number> &entry : line.entries)
+          entry.second /= sum;
+        line.inhomogeneity /= sum;
+      }
+  };
+
+  // resolve chains with several threads if there are many constraints.
+  // contrary to the loop further down, which modifies the lines in place and
+  // thus reads lines that may already be partly resolved, every line is
+  // expanded on its own here, using the unresolved entries of the other
+  // lines from a temporary copy made before the loop. since no line is
+  // read while another one is written, the lines can be processed
+  // concurrently, and the result does not depend on the number of threads
+  const bool resolve_chains_in_parallel = (lines.size() >= 4096);
+  if (resolve_chains_in_parallel)
+    {
+      std::vector<size_type> unresolved_row_starts(lines.size() + 1);
+      unresolved_row_starts[0] = 0;
+      for (size_type i = 0; i < lines.size(); ++i)
+        unresolved_row_starts[i + 1] =
+          unresolved_row_starts[i] + lines[i].entries.size();
+
+      std::vector<std::pair<size_type, number>> unresolved_entries;
+      unresolved_entries.reserve(unresolved_row_starts.back());
+      std::vector<number> unresolved_inhomogeneities(lines.size());
+      for (size_type i = 0; i < lines.size(); ++i)
+        {
+          unresolved_entries.insert(unresolved_entries.end(),
+                                    lines[i].entries.begin(),
+                                    lines[i].entries.end());
+          unresolved_inhomogeneities[i] = lines[i].inhomogeneity;
+        }
+
+      // calculate_line_index() requires a compressed index set, which we
+      // can not compress from within several threads
+      local_lines.compress();
+
+      parallel::apply_to_subranges(
+        size_type(0),
+        lines.size(),
+        [&](const size_type begin, const size_type end) {
+          for (size_type l = begin; l < end; ++l)
+            {
+              ConstraintLine &line = lines[l];
+#ifdef DEBUG
+              size_type n_replacements = 0;
+#endif
+
+              size_type entry = 0;
+              while (entry < line.entries.size())
+                if (((local_lines.size() == 0) ||
+                     (local_lines.is_element(line.entries[entry].first))) &&
+                    is_constrained(line.entries[entry].first))
+                  {
+                    const size_type dof_index = line.entries[entry].first;
+                    const number    weight    = line.entries[entry].second;
+
+                    Assert(dof_index != line.index,
+                           ExcMessage("Cycle in constraints detected!"));
+
+                    const size_type position =
+                      lines_cache[calculate_line_index(dof_index)];
+                    const ArrayView<const std::pair<size_type, number>>
+                      expansion = make_array_view(
+                        unresolved_entries,
+                        unresolved_row_starts[position],
+                        unresolved_row_starts[position + 1] -
+                          unresolved_row_starts[position]);
+
+                    // as in the sequential case, overwrite the entry by the
+                    // first entry of the expansion and append the others,
+                    // or remove it if the other DoF is only constrained to
+                    // an inhomogeneity
+                    if (expansion.size() > 0)
+                      {
+                        line.entries[entry] = std::pair<size_type, number>(
+                          expansion[0].first, expansion[0].second * weight);
+                        for (size_type i = 1; i < expansion.size(); ++i)
+                          line.entries.emplace_back(expansion[i].first,
+                                                    expansion[i].second *
+                                                      weight);
+
+#ifdef DEBUG
+                        ++n_replacements;
+                        Assert(n_replacements / 2 < largest_idx,
+                               ExcMessage("Cycle in constraints detected!"));
+                        if (n_replacements / 2 >= largest_idx)
+                          return;
+#endif
+                      }
+                    else
+                      line.entries.erase(line.entries.begin() + entry);
+
+                    line.inhomogeneity +=
+                      unresolved_inhomogeneities[position] * weight;
+                  }
+                else
+                  ++entry;
+
+              sort_and_merge_entries(line);
+            }
+        },
+        256);
+    }
+
+  // otherwise, replace references to dofs that are themselves constrained.
+  // note that because we may replace references to other dofs that may
+  // themselves be constrained to third ones, we have to iterate over all this
+  // until we replace no chains of constraints any more
   //
   // the iteration replaces references to constrained degrees of freedom by
   // second-order references. for example if x3=x0/2+x2/2 and x2=x0/2+x1/2,
@@ -720,7 +908,7 @@ AffineConstraints<number>::close()
   // efficient. also, we have to do it only once, rather than in each
   // iteration
   size_type iteration = 0;
-  while (true)
+  while (resolve_chains_in_parallel == false)
     {
       bool chained_constraint_replaced = false;
 
@@ -829,94 +1017,9 @@ AffineConstraints<number>::close()
       Assert(iteration <= lines.size(), ExcInternalError());
     }
 
-  // finally sort the entries and re-scale them if necessary. in this step,
-  // we also throw out duplicates as mentioned above. moreover, as some
-  // entries might have had zero weights, we replace them by a vector with
-  // sharp sizes.
-  for (ConstraintLine &line : lines)
-    {
-      std::sort(line.entries.begin(),
-                line.entries.end(),
-                [](const std::pair<unsigned int, number> &a,
-                   const std::pair<unsigned int, number> &b) -> bool {
-                  // Let's use lexicogrpahic ordering with std::abs for number
-                  // type (it might be complex valued).
-                  return (a.first < b.first) ||
-                         (a.first == b.first &&
-                          std::abs(a.second) < std::abs(b.second));
-                });
-
-      // loop over the now sorted list and see whether any of the entries
-      // references the same dofs more than once in order to find how many
-      // non-duplicate entries we have. This lets us allocate the correct
-      // amount of memory for the constraint entries.
-      size_type duplicates = 0;
-      for (size_type i = 1; i < line.entries.size(); ++i)
-        if (line.entries[i].first == line.entries[i - 1].first)
-          duplicates++;
-
-      if (duplicates > 0 || line.entries.size() < line.entries.capacity())
-        {
-          typename ConstraintLine::Entries new_entries;
-
-          // if we have no duplicates, copy verbatim the entries. this way,
-          // the final size is of the vector is correct.
-          if (duplicates == 0)
-            new_entries = line.entries;
-          else
-            {
-              // otherwise, we need to go through the list and resolve the
-              // duplicates
-              new_entries.reserve(line.entries.size() - duplicates);
-              new_entries.push_back(line.entries[0]);
-              for (size_type j = 1; j < line.entries.size(); ++j)
-                if (line.entries[j].first == line.entries[j - 1].first)
-                  {
-                    Assert(new_entries.back().first == line.entries[j].first,
-                           ExcInternalError());
-                    new_entries.back().second += line.entries[j].second;
-                  }
-                else
-                  new_entries.push_back(line.entries[j]);
-
-              Assert(new_entries.size() == line.entries.size() - duplicates,
-                     ExcInternalError());
-
-              // make sure there are really no duplicates left and that the
-              // list is still sorted
-              for (size_type j = 1; j < new_entries.size(); ++j)
-                {
-                  Assert(new_entries[j].first != new_entries[j - 1].first,
-                         ExcInternalError());
-                  Assert(new_entries[j].first > new_entries[j - 1].first,
-                         ExcInternalError());
-                }
-            }
-
-          // replace old list of constraints for this dof by the new one
-          line.entries.swap(new_entries);
-        }
-
-      // Finally do the following check: if the sum of weights for the
-      // constraints is close to one, but not exactly one, then rescale all
-      // the weights so that they sum up to 1. this adds a little numerical
-      // stability and avoids all sorts of problems where the actual value
-      // is close to, but not quite what we expected
-      //
-      // the case where the weights don't quite sum up happens when we
-      // compute the interpolation weights "on the fly", i.e. not from
-      // precomputed tables. in this case, the interpolation weights are
-      // also subject to round-off
-      number sum = 0.;
-      for (const std::pair<size_type, number> &entry : line.entries)
-        sum += entry.second;
-      if (std::abs(sum - number(1.)) < 1.e-13)
-        {
-          for (std::pair<size_type, number> &entry : line.entries)
-            entry.second /= sum;
-          line.inhomogeneity /= sum;
-        }
-    } // end of loop over all constraint lines
+  if (resolve_chains_in_parallel == false)
+    for (ConstraintLine &line : lines)
+      sort_and_merge_entries(line);
 
 #ifdef DEBUG
   // if in debug mode: check that no dof is constrained to another dof that
@@ -3520,6 +3623,56 @@ namespace internal
         }
     }
 
+    // add a row of values with sorted and unique column indices, e.g. the
+    // contributions of several cells to the same global row merged by the
+    // batched distribute_local_to_global(), to a matrix. the general case
+    // passes the whole row to the matrix at once
+    template <typename MatrixType, typename number>
+    inline void
+    add_sorted_matrix_row(const size_type  row,
+                          const size_type  n_values,
+                          const size_type *col_ptr,
+                          const number *   val_ptr,
+                          MatrixType &     global_matrix)
+    {
+      global_matrix.add(row, n_values, col_ptr, val_ptr, false, true);
+    }
+
+    // shortcut for deal.II sparse matrices: since the column indices are
+    // sorted, the values can be added in place during a single walk through
+    // the matrix row, without searching for the position of any column
+    template <typename number>
+    inline void
+    add_sorted_matrix_row(const size_type       row,
+                          const size_type       n_values,
+                          const size_type *     col_ptr,
+                          const number *        val_ptr,
+                          SparseMatrix<number> &sparse_matrix)
+    {
+      const SparsityPattern &sparsity = sparse_matrix.get_sparsity_pattern();
+
+      if (n_values == 0 || sparsity.n_nonzero_elements() == 0)
+        return;
+
+      typename SparseMatrix<number>::iterator matrix_values =
+        sparse_matrix.begin(row);
+
+      // for square matrices, the diagonal is stored first in each row, so
+      // jump over it and add the diagonal entry directly
+      const bool optimize_diagonal = sparsity.n_rows() == sparsity.n_cols();
+      if (optimize_diagonal)
+        ++matrix_values;
+
+      for (size_type j = 0; j < n_values; ++j)
+        if (optimize_diagonal && col_ptr[j] == row)
+          sparse_matrix.begin(row)->value() += val_ptr[j];
+        else
+          dealiiSparseMatrix::add_value(val_ptr[j],
+                                        row,
+                                        col_ptr[j],
+                                        matrix_values);
+    }
+
     // Same function to resolve all entries that will be added to the given
     // global row global_rows[i] as before, now for sparsity pattern
     template <typename number>
@@ -4054,6 +4207,198 @@ AffineConstraints<number>::distribute_local_to_global(
 
 
 
+// internal implementation for the batched distribute_local_to_global for
+// standard (non-block) matrices. resolves the constraints for all cells of the
+// batch first and collects the resulting matrix rows, and then merges the
+// contributions of the different cells to the same global row before writing
+// into the matrix. since all contributions to a row are added at once with
+// sorted column indices, each row of the matrix is only visited once per
+// batch: deal.II sparse matrices add the merged row in place during a single
+// walk through the matrix row, other matrices get the whole row in one call.
+template <typename number>
+template <typename MatrixType, typename VectorType>
+void
+AffineConstraints<number>::distribute_local_to_global(
+  const ArrayView<const FullMatrix<number>> &     local_matrices,
+  const ArrayView<const Vector<number>> &         local_vectors,
+  const ArrayView<const std::vector<size_type>> &local_dof_indices,
+  MatrixType &                                   global_matrix,
+  VectorType &                                   global_vector,
+  const bool                                     use_inhomogeneities_for_rhs,
+  const std::integral_constant<bool, false>) const
+{
+  const bool use_vectors = local_vectors.size() > 0;
+
+  AssertDimension(local_matrices.size(), local_dof_indices.size());
+  Assert(use_vectors == false || local_vectors.size() == local_matrices.size(),
+         ExcDimensionMismatch(local_vectors.size(), local_matrices.size()));
+  Assert(global_matrix.m() == global_matrix.n(), ExcNotQuadratic());
+  if (use_vectors == true)
+    AssertDimension(global_matrix.m(), global_vector.size());
+  Assert(lines.empty() || sorted == true, ExcMatrixNotClosed());
+
+  typename internal::AffineConstraints::ScratchDataAccessor<number>
+    scratch_data(this->scratch_data);
+
+  internal::AffineConstraints::GlobalRowsFromLocal<number> &global_rows =
+    scratch_data->global_rows;
+  std::vector<size_type> &batch_columns = scratch_data->batch_columns;
+  std::vector<number> &   batch_values  = scratch_data->batch_values;
+  std::vector<std::array<size_type, 3>> &batch_rows = scratch_data->batch_rows;
+  std::vector<size_type> &vector_indices = scratch_data->vector_indices;
+  std::vector<typename VectorType::value_type> &vector_values =
+    scratch_data->vector_values;
+  batch_columns.clear();
+  batch_values.clear();
+  batch_rows.clear();
+  vector_indices.clear();
+  vector_values.clear();
+
+  const Vector<number> no_vector;
+  for (unsigned int c = 0; c < local_matrices.size(); ++c)
+    {
+      const FullMatrix<number> &    local_matrix = local_matrices[c];
+      const std::vector<size_type> &dof_indices  = local_dof_indices[c];
+      const Vector<number> &local_vector =
+        use_vectors ? local_vectors[c] : no_vector;
+
+      AssertDimension(local_matrix.n(), dof_indices.size());
+      AssertDimension(local_matrix.m(), dof_indices.size());
+      if (use_vectors == true)
+        AssertDimension(local_matrix.m(), local_vector.size());
+
+      global_rows.reinit(dof_indices.size());
+      make_sorted_row_list(dof_indices, global_rows);
+      const size_type n_actual_dofs = global_rows.size();
+
+      // make room for the largest possible number of entries of this cell
+      // and shrink the arrays to the entries actually written afterwards
+      size_type n_entries = batch_columns.size();
+      batch_columns.resize(n_entries + n_actual_dofs * n_actual_dofs);
+      batch_values.resize(n_entries + n_actual_dofs * n_actual_dofs);
+
+      for (size_type i = 0; i < n_actual_dofs; ++i)
+        {
+          const size_type row     = global_rows.global_row(i);
+          size_type *     col_ptr = batch_columns.data() + n_entries;
+          number *        val_ptr = batch_values.data() + n_entries;
+          internal::AffineConstraints::resolve_matrix_row(global_rows,
+                                                          global_rows,
+                                                          i,
+                                                          0,
+                                                          n_actual_dofs,
+                                                          local_matrix,
+                                                          col_ptr,
+                                                          val_ptr);
+          const size_type n_values =
+            col_ptr - (batch_columns.data() + n_entries);
+          if (n_values > 0)
+            {
+              batch_rows.push_back({{row, n_entries, n_entries + n_values}});
+              n_entries += n_values;
+            }
+
+          if (use_vectors == true)
+            {
+              const typename VectorType::value_type val = resolve_vector_entry(
+                i, global_rows, local_vector, dof_indices, local_matrix);
+              AssertIsFinite(val);
+
+              if (val != typename VectorType::value_type())
+                {
+                  vector_indices.push_back(row);
+                  vector_values.push_back(val);
+                }
+            }
+        }
+      batch_columns.resize(n_entries);
+      batch_values.resize(n_entries);
+
+      internal::AffineConstraints::set_matrix_diagonals(
+        global_rows,
+        dof_indices,
+        local_matrix,
+        *this,
+        global_matrix,
+        global_vector,
+        use_inhomogeneities_for_rhs);
+    }
+
+  // sort the rows of all cells by their global index, keeping the order of
+  // the cells for contributions to the same row, and write each row into the
+  // matrix. the column indices of each cell's row are sorted already; if
+  // several cells contribute to a row, merge their entries and sum up
+  // duplicate columns before calling the matrix.
+  std::stable_sort(batch_rows.begin(),
+                   batch_rows.end(),
+                   [](const std::array<size_type, 3> &a,
+                      const std::array<size_type, 3> &b) {
+                     return a[0] < b[0];
+                   });
+
+  std::vector<size_type> &cols = scratch_data->columns;
+  std::vector<number> &   vals = scratch_data->values;
+  std::vector<std::pair<size_type, number>> merged_entries;
+  for (auto row = batch_rows.begin(); row != batch_rows.end();)
+    {
+      auto end_row = row + 1;
+      while (end_row != batch_rows.end() && (*end_row)[0] == (*row)[0])
+        ++end_row;
+
+      if (end_row == row + 1)
+        internal::AffineConstraints::add_sorted_matrix_row(
+          (*row)[0],
+          (*row)[2] - (*row)[1],
+          batch_columns.data() + (*row)[1],
+          batch_values.data() + (*row)[1],
+          global_matrix);
+      else
+        {
+          merged_entries.clear();
+          for (auto r = row; r != end_row; ++r)
+            for (size_type k = (*r)[1]; k < (*r)[2]; ++k)
+              merged_entries.emplace_back(batch_columns[k], batch_values[k]);
+          std::stable_sort(merged_entries.begin(),
+                           merged_entries.end(),
+                           [](const std::pair<size_type, number> &a,
+                              const std::pair<size_type, number> &b) {
+                             return a.first < b.first;
+                           });
+
+          cols.clear();
+          vals.clear();
+          for (const auto &entry : merged_entries)
+            if (cols.empty() == false && cols.back() == entry.first)
+              vals.back() += entry.second;
+            else
+              {
+                cols.push_back(entry.first);
+                vals.push_back(entry.second);
+              }
+          internal::AffineConstraints::add_sorted_matrix_row(
+            (*row)[0], cols.size(), cols.data(), vals.data(), global_matrix);
+        }
+      row = end_row;
+    }
+
+  if (use_vectors == true && vector_indices.size() > 0)
+    {
+      // see the non-batched function for why we do a bulk update only if the
+      // types are equal
+      if (std::is_same<typename VectorType::value_type, number>::value)
+        global_vector.add(vector_indices,
+                          *reinterpret_cast<std::vector<number> *>(
+                            &vector_values));
+      else
+        for (size_type row_n = 0; row_n < vector_indices.size(); ++row_n)
+          global_vector(vector_indices[row_n]) +=
+            static_cast<typename VectorType::value_type>(
+              vector_values[row_n]);
+    }
+}
+
+
+
 // similar function as above, but now specialized for block matrices. See the
 // other function for additional comments.
 template <typename number>
@@ -0,0 +1,501 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_assembly_scatter_plan_h
+#define dealii_assembly_scatter_plan_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/smartpointer.h>
+#include <deal.II/base/subscriptor.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/block_sparse_matrix.h>
+#include <deal.II/lac/block_sparsity_pattern.h>
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+/*! @addtogroup Matrix1
+ *@{
+ */
+
+/**
+ * A precomputed plan for writing local matrices and vectors into a global
+ * matrix and vector, for problems in which the same mesh, constraints and
+ * sparsity pattern are assembled many times, as in time-dependent or
+ * nonlinear problems.
+ *
+ * AffineConstraints::distribute_local_to_global() has to sort the global
+ * indices of each cell, resolve the constraints and search the column
+ * indices in the matrix rows every time it is called. This class does all
+ * of this work once per cell, the first time the cell is assembled, and
+ * stores for each entry of the global matrix touched by the cell which local
+ * entries with which weights contribute to it. If the plan was set up with
+ * the SparsityPattern or BlockSparsityPattern of the matrix, it also stores
+ * the position of the entry in the value array of the matrix, and all later
+ * assemblies of SparseMatrix and BlockSparseMatrix objects add directly into
+ * the value array. For other matrix types, like the matrices of the
+ * PETScWrappers and TrilinosWrappers namespaces, the plan adds the entries
+ * of each row with a single call to their add() function with sorted column
+ * indices; in parallel computations, only the locally owned cells are
+ * assembled and the plan only covers these.
+ *
+ * The result is the same as calling
+ * AffineConstraints::distribute_local_to_global() with the same arguments,
+ * up to round-off due to a different order of summation.
+ *
+ * Cells are identified by an index, typically the active cell index:
+ * @code
+ *   AssemblyScatterPlan<double> scatter_plan;
+ *   scatter_plan.reinit(constraints, sparsity_pattern,
+ *                       triangulation.n_active_cells());
+ *
+ *   // in every assembly:
+ *   for (const auto &cell : dof_handler.active_cell_iterators())
+ *     {
+ *       ... // compute cell_matrix and cell_rhs
+ *       cell->get_dof_indices(local_dof_indices);
+ *       scatter_plan.distribute_local_to_global(cell->active_cell_index(),
+ *                                               cell_matrix,
+ *                                               cell_rhs,
+ *                                               local_dof_indices,
+ *                                               system_matrix,
+ *                                               system_rhs);
+ *     }
+ * @endcode
+ * The plan stores the indices and weights for each cell and is hence only
+ * valid as long as the mesh, the numbering of the degrees of freedom, the
+ * constraints and the sparsity pattern do not change. In debug mode, it is
+ * checked that the degrees of freedom passed for a cell are the ones the
+ * plan was recorded with.
+ *
+ * The functions of this class are not thread-safe since they record the plan
+ * of a cell the first time it is assembled and write into the global
+ * objects. Like other functions that write into global matrices and vectors,
+ * they need to be called from the copier of WorkStream::run() or from a
+ * sequential loop.
+ */
+template <typename number>
+class AssemblyScatterPlan : public Subscriptor
+{
+public:
+  /**
+   * Declare the type for container size.
+   */
+  using size_type = types::global_dof_index;
+
+  /**
+   * Constructor. Use reinit() to set up the object.
+   */
+  AssemblyScatterPlan();
+
+  /**
+   * Set up the object for the given constraints and sparsity pattern, and
+   * for cell indices between zero and @p n_cells. All previously recorded
+   * cells are deleted. Both @p constraints and @p sparsity_pattern need to
+   * stay alive as long as this object is used.
+   */
+  void
+  reinit(const AffineConstraints<number> &constraints,
+         const SparsityPattern &          sparsity_pattern,
+         const unsigned int               n_cells);
+
+  /**
+   * Same as above, for block matrices.
+   */
+  void
+  reinit(const AffineConstraints<number> &constraints,
+         const BlockSparsityPattern &     sparsity_pattern,
+         const unsigned int               n_cells);
+
+  /**
+   * Same as above for matrices whose sparsity pattern is not a
+   * SparsityPattern or BlockSparsityPattern, like the matrices of the
+   * PETScWrappers and TrilinosWrappers namespaces. The plan then stores the
+   * global row and column indices of the entries instead of their positions
+   * in the value array.
+   */
+  void
+  reinit(const AffineConstraints<number> &constraints,
+         const unsigned int               n_cells);
+
+  /**
+   * Delete all data.
+   */
+  void
+  clear();
+
+  /**
+   * Write the local matrix and vector of the cell with index @p cell into
+   * the global matrix and vector. The arguments after @p cell are the same as
+   * for AffineConstraints::distribute_local_to_global(). If the cell has not
+   * been assembled before, its plan is recorded from @p local_dof_indices
+   * first; otherwise, @p local_dof_indices is only used for checking in
+   * debug mode.
+   */
+  template <typename MatrixType, typename VectorType>
+  void
+  distribute_local_to_global(const unsigned int            cell,
+                             const FullMatrix<number> &    local_matrix,
+                             const Vector<number> &        local_vector,
+                             const std::vector<size_type> &local_dof_indices,
+                             MatrixType &                  global_matrix,
+                             VectorType &                  global_vector,
+                             const bool use_inhomogeneities_for_rhs = false);
+
+  /**
+   * Same as above, for assembling the matrix only.
+   */
+  template <typename MatrixType>
+  void
+  distribute_local_to_global(const unsigned int            cell,
+                             const FullMatrix<number> &    local_matrix,
+                             const std::vector<size_type> &local_dof_indices,
+                             MatrixType &                  global_matrix);
+
+  /**
+   * Return whether the plan of the cell with index @p cell has been recorded.
+   */
+  bool
+  is_recorded(const unsigned int cell) const;
+
+  /**
+   * Return an estimate for the memory consumption of this object in bytes.
+   */
+  std::size_t
+  memory_consumption() const;
+
+private:
+  /**
+   * The data recorded for a single cell.
+   */
+  struct CellPlan
+  {
+    /**
+     * Constructor.
+     */
+    CellPlan();
+
+    /**
+     * Return an estimate for the memory consumption of this object in
+     * bytes.
+     */
+    std::size_t
+    memory_consumption() const;
+
+    /**
+     * Whether the plan of this cell has been recorded.
+     */
+    bool is_recorded;
+
+    /**
+     * The global degrees of freedom the plan was recorded with.
+     */
+    std::vector<size_type> dof_indices;
+
+    /**
+     * The global row and column indices of the matrix entries the cell
+     * contributes to, sorted by rows and then columns. Only filled if the
+     * plan was not set up with a sparsity pattern.
+     */
+    std::vector<size_type> rows;
+    std::vector<size_type> columns;
+
+    /**
+     * The positions of the matrix entries the cell contributes to in the
+     * value array of the matrix, or of the respective block for block
+     * matrices. Only filled if the plan was set up with a sparsity pattern.
+     */
+    std::vector<std::size_t> positions;
+
+    /**
+     * For block matrices, the index <tt>block_row * n_block_cols +
+     * block_col</tt> of the block each entry belongs to.
+     */
+    std::vector<unsigned int> blocks;
+
+    /**
+     * For each matrix entry, the range of its contributions in the arrays
+     * local_entries and weights. Empty if no degree of freedom of the cell is
+     * constrained, in which case each matrix entry has exactly one
+     * contribution with weight one.
+     */
+    std::vector<unsigned int> entry_starts;
+
+    /**
+     * The indices <tt>i * n_dofs_per_cell + j</tt> of the local matrix
+     * entries that contribute to the matrix entries, and their weights.
+     */
+    std::vector<unsigned int> local_entries;
+    std::vector<number>       weights;
+
+    /**
+     * The global rows of the vector entries the cell contributes to, and
+     * for each of them the range of its contributions in the arrays
+     * vector_local_rows and vector_weights.
+     */
+    std::vector<size_type>    vector_rows;
+    std::vector<unsigned int> vector_starts;
+    std::vector<unsigned int> vector_local_rows;
+    std::vector<number>       vector_weights;
+
+    /**
+     * The local indices of the constrained degrees of freedom of the cell,
+     * which get an entry on the diagonal of the global matrix.
+     */
+    std::vector<unsigned int> constrained_local_dofs;
+
+    /**
+     * The local indices and values of the inhomogeneities of the cell.
+     */
+    std::vector<std::pair<unsigned int, number>> inhomogeneities;
+  };
+
+  /**
+   * Record the plan of the cell with index @p cell.
+   */
+  void
+  record(const unsigned int cell, const std::vector<size_type> &dof_indices);
+
+  /**
+   * Compute the values of the matrix entries of the plan @p plan into
+   * #entry_values.
+   */
+  void
+  compute_entry_values(const CellPlan &          plan,
+                       const FullMatrix<number> &local_matrix);
+
+  /**
+   * Add the contributions of a cell into a SparseMatrix.
+   */
+  void
+  add_matrix_entries(const CellPlan &          plan,
+                     const FullMatrix<number> &local_matrix,
+                     SparseMatrix<number> &    global_matrix);
+
+  /**
+   * Add the contributions of a cell into a BlockSparseMatrix.
+   */
+  void
+  add_matrix_entries(const CellPlan &           plan,
+                     const FullMatrix<number> & local_matrix,
+                     BlockSparseMatrix<number> &global_matrix);
+
+  /**
+   * Add the contributions of a cell into a matrix of any other type, one
+   * row at a time.
+   */
+  template <typename MatrixType>
+  void
+  add_matrix_entries(const CellPlan &          plan,
+                     const FullMatrix<number> &local_matrix,
+                     MatrixType &              global_matrix);
+
+  /**
+   * Pointer to the constraints.
+   */
+  SmartPointer<const AffineConstraints<number>, AssemblyScatterPlan<number>>
+    constraints;
+
+  /**
+   * Pointers to the sparsity pattern the plan was set up with, if any.
+   */
+  SmartPointer<const SparsityPattern, AssemblyScatterPlan<number>>
+    sparsity_pattern;
+  SmartPointer<const BlockSparsityPattern, AssemblyScatterPlan<number>>
+    block_sparsity_pattern;
+
+  /**
+   * The plans of all cells.
+   */
+  std::vector<CellPlan> cell_plans;
+
+  /**
+   * Temporary arrays for the values of the matrix entries of a cell, the
+   * local vector with the inhomogeneities applied, and the value arrays of
+   * the blocks of a block matrix.
+   */
+  std::vector<number>   entry_values;
+  std::vector<number>   local_rhs;
+  std::vector<number *> block_values;
+};
+
+/*@}*/
+
+#ifndef DOXYGEN
+/*---------------------- Inline functions -----------------------------------*/
+
+
+
+template <typename number>
+inline bool
+AssemblyScatterPlan<number>::is_recorded(const unsigned int cell) const
+{
+  AssertIndexRange(cell, cell_plans.size());
+  return cell_plans[cell].is_recorded;
+}
+
+
+
+template <typename number>
+template <typename MatrixType>
+inline void
+AssemblyScatterPlan<number>::add_matrix_entries(
+  const CellPlan &          plan,
+  const FullMatrix<number> &local_matrix,
+  MatrixType &              global_matrix)
+{
+  Assert(sparsity_pattern == nullptr && block_sparsity_pattern == nullptr,
+         ExcMessage("The scatter plan was set up with a sparsity pattern, "
+                    "but the matrix is neither a SparseMatrix nor a "
+                    "BlockSparseMatrix with that sparsity pattern."));
+  compute_entry_values(plan, local_matrix);
+
+  // the entries are sorted by rows and columns, so add one row at a time
+  const std::size_t n_entries = plan.rows.size();
+  for (std::size_t k = 0; k < n_entries;)
+    {
+      const size_type row = plan.rows[k];
+      std::size_t     end = k + 1;
+      while (end < n_entries && plan.rows[end] == row)
+        ++end;
+      global_matrix.add(row,
+                        end - k,
+                        plan.columns.data() + k,
+                        entry_values.data() + k,
+                        false,
+                        true);
+      k = end;
+    }
+}
+
+
+
+template <typename number>
+template <typename MatrixType, typename VectorType>
+inline void
+AssemblyScatterPlan<number>::distribute_local_to_global(
+  const unsigned int            cell,
+  const FullMatrix<number> &    local_matrix,
+  const Vector<number> &        local_vector,
+  const std::vector<size_type> &local_dof_indices,
+  MatrixType &                  global_matrix,
+  VectorType &                  global_vector,
+  const bool                    use_inhomogeneities_for_rhs)
+{
+  AssertIndexRange(cell, cell_plans.size());
+  AssertDimension(local_matrix.m(), local_dof_indices.size());
+  AssertDimension(local_matrix.n(), local_dof_indices.size());
+
+  if (cell_plans[cell].is_recorded == false)
+    record(cell, local_dof_indices);
+  const CellPlan &plan = cell_plans[cell];
+  Assert(plan.dof_indices == local_dof_indices,
+         ExcMessage("The degrees of freedom of this cell differ from the ones "
+                    "the scatter plan was recorded with."));
+
+  add_matrix_entries(plan, local_matrix, global_matrix);
+
+  const bool use_vectors = (local_vector.size() > 0);
+  if (use_vectors)
+    {
+      AssertDimension(local_vector.size(), local_dof_indices.size());
+
+      // eliminate the columns of the inhomogeneously constrained degrees of
+      // freedom from the local vector
+      const unsigned int n_dofs = local_dof_indices.size();
+      local_rhs.resize(n_dofs);
+      for (unsigned int i = 0; i < n_dofs; ++i)
+        {
+          number value = local_vector(i);
+          for (const auto &inhomogeneity : plan.inhomogeneities)
+            value -=
+              local_matrix(i, inhomogeneity.first) * inhomogeneity.second;
+          local_rhs[i] = value;
+        }
+
+      for (unsigned int r = 0; r < plan.vector_rows.size(); ++r)
+        {
+          number value = number();
+          for (unsigned int k = plan.vector_starts[r];
+               k < plan.vector_starts[r + 1];
+               ++k)
+            value +=
+              plan.vector_weights[k] * local_rhs[plan.vector_local_rows[k]];
+          AssertIsFinite(value);
+          if (value != number())
+            global_vector(plan.vector_rows[r]) +=
+              static_cast<typename VectorType::value_type>(value);
+        }
+    }
+
+  // put entries on the diagonal of the constrained degrees of freedom in the
+  // same way as AffineConstraints::distribute_local_to_global() does
+  if (plan.constrained_local_dofs.size() > 0)
+    {
+      number average_diagonal = number();
+      for (unsigned int i = 0; i < local_matrix.m(); ++i)
+        average_diagonal += std::abs(local_matrix(i, i));
+      average_diagonal /= static_cast<number>(local_matrix.m());
+      if (average_diagonal == static_cast<number>(0.))
+        {
+          average_diagonal = static_cast<number>(local_matrix.l1_norm()) /
+                             static_cast<number>(local_matrix.m());
+          if (average_diagonal == static_cast<number>(0.))
+            average_diagonal = static_cast<number>(1.);
+        }
+
+      for (const unsigned int i : plan.constrained_local_dofs)
+        {
+          const size_type global_row = plan.dof_indices[i];
+          number          diagonal   = average_diagonal;
+          if (std::abs(local_matrix(i, i)) != 0.)
+            diagonal = static_cast<number>(std::abs(local_matrix(i, i)));
+          global_matrix.add(global_row, global_row, diagonal);
+          if (use_vectors && use_inhomogeneities_for_rhs)
+            global_vector(global_row) +=
+              diagonal * constraints->get_inhomogeneity(global_row);
+        }
+    }
+}
+
+
+
+template <typename number>
+template <typename MatrixType>
+inline void
+AssemblyScatterPlan<number>::distribute_local_to_global(
+  const unsigned int            cell,
+  const FullMatrix<number> &    local_matrix,
+  const std::vector<size_type> &local_dof_indices,
+  MatrixType &                  global_matrix)
+{
+  Vector<number> dummy(0);
+  distribute_local_to_global(
+    cell, local_matrix, dummy, local_dof_indices, global_matrix, dummy);
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
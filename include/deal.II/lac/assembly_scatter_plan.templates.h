@@ -0,0 +1,381 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_assembly_scatter_plan_templates_h
+#define dealii_assembly_scatter_plan_templates_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/memory_consumption.h>
+
+#include <deal.II/lac/assembly_scatter_plan.h>
+
+#include <algorithm>
+#include <tuple>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+template <typename number>
+AssemblyScatterPlan<number>::CellPlan::CellPlan()
+  : is_recorded(false)
+{}
+
+
+
+template <typename number>
+std::size_t
+AssemblyScatterPlan<number>::CellPlan::memory_consumption() const
+{
+  return (MemoryConsumption::memory_consumption(dof_indices) +
+          MemoryConsumption::memory_consumption(rows) +
+          MemoryConsumption::memory_consumption(columns) +
+          MemoryConsumption::memory_consumption(positions) +
+          MemoryConsumption::memory_consumption(blocks) +
+          MemoryConsumption::memory_consumption(entry_starts) +
+          MemoryConsumption::memory_consumption(local_entries) +
+          MemoryConsumption::memory_consumption(weights) +
+          MemoryConsumption::memory_consumption(vector_rows) +
+          MemoryConsumption::memory_consumption(vector_starts) +
+          MemoryConsumption::memory_consumption(vector_local_rows) +
+          MemoryConsumption::memory_consumption(vector_weights) +
+          MemoryConsumption::memory_consumption(constrained_local_dofs) +
+          MemoryConsumption::memory_consumption(inhomogeneities));
+}
+
+
+
+template <typename number>
+AssemblyScatterPlan<number>::AssemblyScatterPlan()
+  : constraints(nullptr, typeid(*this).name())
+  , sparsity_pattern(nullptr, typeid(*this).name())
+  , block_sparsity_pattern(nullptr, typeid(*this).name())
+{}
+
+
+
+template <typename number>
+void
+AssemblyScatterPlan<number>::reinit(
+  const AffineConstraints<number> &constraints,
+  const SparsityPattern &          sparsity_pattern,
+  const unsigned int               n_cells)
+{
+  Assert(sparsity_pattern.is_compressed(),
+         ExcMessage("The sparsity pattern must be compressed."));
+  reinit(constraints, n_cells);
+  this->sparsity_pattern = &sparsity_pattern;
+}
+
+
+
+template <typename number>
+void
+AssemblyScatterPlan<number>::reinit(
+  const AffineConstraints<number> &constraints,
+  const BlockSparsityPattern &     sparsity_pattern,
+  const unsigned int               n_cells)
+{
+  Assert(sparsity_pattern.is_compressed(),
+         ExcMessage("The sparsity pattern must be compressed."));
+  reinit(constraints, n_cells);
+  this->block_sparsity_pattern = &sparsity_pattern;
+}
+
+
+
+template <typename number>
+void
+AssemblyScatterPlan<number>::reinit(
+  const AffineConstraints<number> &constraints,
+  const unsigned int               n_cells)
+{
+  Assert(constraints.is_closed(),
+         ExcMessage("The constraints must be closed before they can be "
+                    "used for setting up a scatter plan."));
+  clear();
+  this->constraints = &constraints;
+  cell_plans.resize(n_cells);
+}
+
+
+
+template <typename number>
+void
+AssemblyScatterPlan<number>::clear()
+{
+  constraints            = nullptr;
+  sparsity_pattern       = nullptr;
+  block_sparsity_pattern = nullptr;
+  cell_plans.clear();
+  entry_values.clear();
+  local_rhs.clear();
+  block_values.clear();
+}
+
+
+
+template <typename number>
+std::size_t
+AssemblyScatterPlan<number>::memory_consumption() const
+{
+  std::size_t memory = sizeof(*this) +
+                       MemoryConsumption::memory_consumption(entry_values) +
+                       MemoryConsumption::memory_consumption(local_rhs) +
+                       MemoryConsumption::memory_consumption(block_values);
+  for (const CellPlan &plan : cell_plans)
+    memory += plan.memory_consumption();
+  return memory;
+}
+
+
+
+template <typename number>
+void
+AssemblyScatterPlan<number>::record(const unsigned int            cell,
+                                    const std::vector<size_type> &dof_indices)
+{
+  Assert(constraints != nullptr, ExcNotInitialized());
+
+  CellPlan &plan   = cell_plans[cell];
+  plan             = CellPlan();
+  plan.dof_indices = dof_indices;
+
+  // list the global degrees of freedom each local one is distributed to,
+  // along with the weights, and collect the constrained ones
+  const unsigned int n_dofs = dof_indices.size();
+  std::vector<std::vector<std::pair<size_type, number>>> targets(n_dofs);
+  for (unsigned int i = 0; i < n_dofs; ++i)
+    if (constraints->is_constrained(dof_indices[i]))
+      {
+        targets[i] = *constraints->get_constraint_entries(dof_indices[i]);
+        plan.constrained_local_dofs.push_back(i);
+        if (constraints->is_inhomogeneously_constrained(dof_indices[i]))
+          plan.inhomogeneities.emplace_back(
+            i, constraints->get_inhomogeneity(dof_indices[i]));
+      }
+    else
+      targets[i].emplace_back(dof_indices[i], number(1.));
+
+  // expand all local matrix entries into contributions to global entries
+  // and sort them by rows and columns
+  std::vector<std::tuple<size_type, size_type, unsigned int, number>>
+    contributions;
+  contributions.reserve(n_dofs * n_dofs);
+  for (unsigned int i = 0; i < n_dofs; ++i)
+    for (const auto &row_target : targets[i])
+      for (unsigned int j = 0; j < n_dofs; ++j)
+        for (const auto &column_target : targets[j])
+          contributions.emplace_back(row_target.first,
+                                     column_target.first,
+                                     i * n_dofs + j,
+                                     row_target.second * column_target.second);
+  std::sort(contributions.begin(),
+            contributions.end(),
+            [](const auto &a, const auto &b) {
+              return std::make_tuple(std::get<0>(a),
+                                     std::get<1>(a),
+                                     std::get<2>(a)) <
+                     std::make_tuple(std::get<0>(b),
+                                     std::get<1>(b),
+                                     std::get<2>(b));
+            });
+
+  // merge the contributions to the same global entry. if each entry gets
+  // exactly one contribution with unit weight, which is the case for cells
+  // without constraints, we do not need to store the weights and ranges
+  bool has_weights = false;
+  for (std::size_t k = 0; k < contributions.size();)
+    {
+      const size_type row    = std::get<0>(contributions[k]);
+      const size_type column = std::get<1>(contributions[k]);
+      std::size_t     end    = k + 1;
+      while (end < contributions.size() &&
+             std::get<0>(contributions[end]) == row &&
+             std::get<1>(contributions[end]) == column)
+        ++end;
+      if (end > k + 1 || std::get<3>(contributions[k]) != number(1.))
+        has_weights = true;
+
+      if (sparsity_pattern != nullptr)
+        {
+          const size_type position = (*sparsity_pattern)(row, column);
+          Assert(position != SparsityPattern::invalid_entry,
+                 ExcMessage("The entry (" + std::to_string(row) + "," +
+                            std::to_string(column) +
+                            ") the cell writes into does not exist in the "
+                            "sparsity pattern."));
+          plan.positions.push_back(position);
+        }
+      else if (block_sparsity_pattern != nullptr)
+        {
+          const std::pair<unsigned int, size_type> block_row =
+            block_sparsity_pattern->get_row_indices().global_to_local(row);
+          const std::pair<unsigned int, size_type> block_column =
+            block_sparsity_pattern->get_column_indices().global_to_local(
+              column);
+          const size_type position =
+            block_sparsity_pattern->block(block_row.first, block_column.first)(
+              block_row.second, block_column.second);
+          Assert(position != SparsityPattern::invalid_entry,
+                 ExcMessage("The entry (" + std::to_string(row) + "," +
+                            std::to_string(column) +
+                            ") the cell writes into does not exist in the "
+                            "sparsity pattern."));
+          plan.positions.push_back(position);
+          plan.blocks.push_back(block_row.first *
+                                  block_sparsity_pattern->n_block_cols() +
+                                block_column.first);
+        }
+      else
+        {
+          plan.rows.push_back(row);
+          plan.columns.push_back(column);
+        }
+
+      plan.entry_starts.push_back(plan.local_entries.size());
+      for (; k < end; ++k)
+        {
+          plan.local_entries.push_back(std::get<2>(contributions[k]));
+          plan.weights.push_back(std::get<3>(contributions[k]));
+        }
+    }
+  plan.entry_starts.push_back(plan.local_entries.size());
+  if (has_weights == false)
+    {
+      plan.entry_starts.clear();
+      plan.weights.clear();
+    }
+
+  // do the same for the vector entries
+  std::vector<std::tuple<size_type, unsigned int, number>> vector_entries;
+  for (unsigned int i = 0; i < n_dofs; ++i)
+    for (const auto &row_target : targets[i])
+      vector_entries.emplace_back(row_target.first, i, row_target.second);
+  std::sort(vector_entries.begin(),
+            vector_entries.end(),
+            [](const auto &a, const auto &b) {
+              return std::make_pair(std::get<0>(a), std::get<1>(a)) <
+                     std::make_pair(std::get<0>(b), std::get<1>(b));
+            });
+  for (std::size_t k = 0; k < vector_entries.size(); ++k)
+    {
+      if (k == 0 || std::get<0>(vector_entries[k]) !=
+                      std::get<0>(vector_entries[k - 1]))
+        {
+          plan.vector_rows.push_back(std::get<0>(vector_entries[k]));
+          plan.vector_starts.push_back(k);
+        }
+      plan.vector_local_rows.push_back(std::get<1>(vector_entries[k]));
+      plan.vector_weights.push_back(std::get<2>(vector_entries[k]));
+    }
+  plan.vector_starts.push_back(vector_entries.size());
+
+  plan.is_recorded = true;
+}
+
+
+
+template <typename number>
+void
+AssemblyScatterPlan<number>::compute_entry_values(
+  const CellPlan &          plan,
+  const FullMatrix<number> &local_matrix)
+{
+  const std::size_t n_entries = (plan.entry_starts.empty() ?
+                                   plan.local_entries.size() :
+                                   plan.entry_starts.size() - 1);
+  entry_values.resize(n_entries);
+  if (n_entries == 0)
+    return;
+
+  const number *local_values = &local_matrix(0, 0);
+  if (plan.entry_starts.empty())
+    for (std::size_t k = 0; k < n_entries; ++k)
+      entry_values[k] = local_values[plan.local_entries[k]];
+  else
+    for (std::size_t k = 0; k < n_entries; ++k)
+      {
+        number value = number();
+        for (unsigned int q = plan.entry_starts[k];
+             q < plan.entry_starts[k + 1];
+             ++q)
+          value += plan.weights[q] * local_values[plan.local_entries[q]];
+        entry_values[k] = value;
+      }
+}
+
+
+
+template <typename number>
+void
+AssemblyScatterPlan<number>::add_matrix_entries(
+  const CellPlan &          plan,
+  const FullMatrix<number> &local_matrix,
+  SparseMatrix<number> &    global_matrix)
+{
+  Assert(sparsity_pattern != nullptr &&
+           &global_matrix.get_sparsity_pattern() == sparsity_pattern,
+         ExcMessage("The scatter plan was not set up with the sparsity "
+                    "pattern of this matrix."));
+
+  number *const values = global_matrix.val.get();
+  if (plan.entry_starts.empty())
+    {
+      // no constraints on this cell: add the local entries directly
+      if (plan.local_entries.empty())
+        return;
+      const number *local_values = &local_matrix(0, 0);
+      for (std::size_t k = 0; k < plan.local_entries.size(); ++k)
+        values[plan.positions[k]] += local_values[plan.local_entries[k]];
+    }
+  else
+    {
+      compute_entry_values(plan, local_matrix);
+      for (std::size_t k = 0; k < entry_values.size(); ++k)
+        values[plan.positions[k]] += entry_values[k];
+    }
+}
+
+
+
+template <typename number>
+void
+AssemblyScatterPlan<number>::add_matrix_entries(
+  const CellPlan &           plan,
+  const FullMatrix<number> & local_matrix,
+  BlockSparseMatrix<number> &global_matrix)
+{
+  Assert(block_sparsity_pattern != nullptr &&
+           &global_matrix.get_sparsity_pattern() == block_sparsity_pattern,
+         ExcMessage("The scatter plan was not set up with the sparsity "
+                    "pattern of this matrix."));
+
+  const unsigned int n_block_cols = global_matrix.n_block_cols();
+  block_values.resize(global_matrix.n_block_rows() * n_block_cols);
+  for (unsigned int r = 0; r < global_matrix.n_block_rows(); ++r)
+    for (unsigned int c = 0; c < n_block_cols; ++c)
+      block_values[r * n_block_cols + c] = global_matrix.block(r, c).val.get();
+
+  compute_entry_values(plan, local_matrix);
+  for (std::size_t k = 0; k < entry_values.size(); ++k)
+    block_values[plan.blocks[k]][plan.positions[k]] += entry_values[k];
+}
+
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -1390,6 +1390,21 @@ namespace LinearAlgebra
        * operations. This class uses persistent MPI communicators.
        */
       mutable std::vector<MPI_Request> update_ghost_values_requests;
+
+      /**
+       * Persistent MPI requests for the compress() operations, bound to the
+       * ghost entries and the import data of this vector. Only used if
+       * persistent requests are enabled in the partitioner, see
+       * Utilities::MPI::Partitioner::enable_persistent_requests().
+       */
+      Utilities::MPI::Partitioner::PersistentRequests
+        compress_persistent_requests;
+
+      /**
+       * Persistent MPI requests for the update_ghost_values() operations.
+       */
+      mutable Utilities::MPI::Partitioner::PersistentRequests
+        update_ghost_values_persistent_requests;
 #endif
 
       /**
@@ -19,6 +19,7 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/aligned_vector.h>
 #include <deal.II/base/cuda.h>
 #include <deal.II/base/cuda_size.h>
 
@@ -134,11 +135,16 @@ namespace LinearAlgebra
         {
           if (comm_shared == MPI_COMM_SELF)
             {
+              // use the allocation policy of AlignedVector, except for the
+              // first touch that is done when zeroing the vector entries in
+              // reinit() with the thread partitioner of the vector
+              AlignedVectorAllocationPolicy policy =
+                AlignedVectorAllocationPolicy::get_default();
+              policy.parallel_first_touch = false;
+
               Number *new_val;
-              Utilities::System::posix_memalign(
-                reinterpret_cast<void **>(&new_val),
-                64,
-                sizeof(Number) * new_alloc_size);
+              policy.allocate(reinterpret_cast<void **>(&new_val),
+                              sizeof(Number) * new_alloc_size);
               data.values = {new_val, [](Number *data) { std::free(data); }};
 
               allocated_size = new_alloc_size;
@@ -477,18 +483,33 @@ namespace LinearAlgebra
     Vector<Number, MemorySpaceType>::clear_mpi_requests()
     {
 #ifdef DEAL_II_WITH_MPI
+      // requests of an ongoing operation might be copies of persistent
+      // requests, which are freed together with the persistent requests
+      const auto is_persistent =
+        [](const MPI_Request &                                    request,
+           const Utilities::MPI::Partitioner::PersistentRequests &persistent) {
+          return std::find(persistent.requests.begin(),
+                           persistent.requests.end(),
+                           request) != persistent.requests.end();
+        };
+
       for (auto &compress_request : compress_requests)
-        {
-          const int ierr = MPI_Request_free(&compress_request);
-          AssertThrowMPI(ierr);
-        }
+        if (!is_persistent(compress_request, compress_persistent_requests))
+          {
+            const int ierr = MPI_Request_free(&compress_request);
+            AssertThrowMPI(ierr);
+          }
       compress_requests.clear();
+      compress_persistent_requests.clear();
       for (auto &update_ghost_values_request : update_ghost_values_requests)
-        {
-          const int ierr = MPI_Request_free(&update_ghost_values_request);
-          AssertThrowMPI(ierr);
-        }
+        if (!is_persistent(update_ghost_values_request,
+                           update_ghost_values_persistent_requests))
+          {
+            const int ierr = MPI_Request_free(&update_ghost_values_request);
+            AssertThrowMPI(ierr);
+          }
       update_ghost_values_requests.clear();
+      update_ghost_values_persistent_requests.clear();
 #endif
     }
 
@@ -1044,7 +1065,8 @@ namespace LinearAlgebra
               partitioner->n_ghost_indices()),
             ArrayView<Number, MemorySpace::CUDA>(
               import_data.values_dev.get(), partitioner->n_import_indices()),
-            compress_requests);
+            compress_requests,
+            &compress_persistent_requests);
         }
       else
 #  endif
@@ -1057,7 +1079,8 @@ namespace LinearAlgebra
               partitioner->n_ghost_indices()),
             ArrayView<Number, MemorySpace::Host>(
               import_data.values.get(), partitioner->n_import_indices()),
-            compress_requests);
+            compress_requests,
+            &compress_persistent_requests);
         }
 #else
       (void)communication_channel;
@@ -1219,7 +1242,8 @@ namespace LinearAlgebra
         ArrayView<Number, MemorySpace::Host>(
           data.values.get() + partitioner->locally_owned_size(),
           partitioner->n_ghost_indices()),
-        update_ghost_values_requests);
+        update_ghost_values_requests,
+        &update_ghost_values_persistent_requests);
 #  else
       partitioner->export_to_ghosted_array_start<Number, MemorySpace::CUDA>(
         communication_channel,
@@ -1230,7 +1254,8 @@ namespace LinearAlgebra
         ArrayView<Number, MemorySpace::CUDA>(
           data.values_dev.get() + partitioner->locally_owned_size(),
           partitioner->n_ghost_indices()),
-        update_ghost_values_requests);
+        update_ghost_values_requests,
+        &update_ghost_values_persistent_requests);
 #  endif
 
 #else
@@ -1419,6 +1444,9 @@ namespace LinearAlgebra
 
       std::swap(compress_requests, v.compress_requests);
       std::swap(update_ghost_values_requests, v.update_ghost_values_requests);
+      std::swap(compress_persistent_requests, v.compress_persistent_requests);
+      std::swap(update_ghost_values_persistent_requests,
+                v.update_ghost_values_persistent_requests);
       std::swap(comm_sm, v.comm_sm);
 #endif
 
@@ -19,12 +19,16 @@
 #include <deal.II/base/config.h>
 
 #include <deal.II/base/exceptions.h>
+#include <deal.II/base/memory_space.h>
+#include <deal.II/base/parallel.h>
 
 #include <deal.II/lac/vector_memory.h>
 
 #include <array>
 #include <functional>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -41,6 +45,15 @@ namespace internal
 template <typename Number>
 class Vector;
 
+namespace LinearAlgebra
+{
+  namespace distributed
+  {
+    template <typename Number, typename MemorySpace>
+    class Vector;
+  } // namespace distributed
+} // namespace LinearAlgebra
+
 class PreconditionIdentity;
 
 template <typename Range  = Vector<double>,
@@ -371,6 +384,217 @@ public:
 };
 
 
+namespace internal
+{
+  namespace LinearOperatorImplementation
+  {
+    /**
+     * A linear combination $\sum_k a_k u_k$ of vectors, given by the
+     * coefficients $a_k$ and pointers to the vectors $u_k$.
+     */
+    template <typename VectorType>
+    using LinearCombination = std::vector<
+      std::pair<typename VectorType::value_type, const VectorType *>>;
+
+    /**
+     * Set $v = s v + \sum_k a_k u_k$ in a single sweep over the locally
+     * owned elements of the vectors. If $s$ is zero, the previous content
+     * of @p v is not read.
+     */
+    template <typename VectorType>
+    void
+    add_linear_combination(VectorType &                          v,
+                           const typename VectorType::value_type s,
+                           const LinearCombination<VectorType> & terms)
+    {
+      using Number = typename VectorType::value_type;
+
+      const std::size_t           n = v.locally_owned_size();
+      std::vector<Number>         coefficients;
+      std::vector<const Number *> sources;
+      coefficients.reserve(terms.size());
+      sources.reserve(terms.size());
+      for (const auto &term : terms)
+        {
+          AssertDimension(term.second->locally_owned_size(), n);
+          coefficients.push_back(term.first);
+          sources.push_back(term.second->begin());
+        }
+
+      Number *const values = v.begin();
+      dealii::parallel::apply_to_subranges(
+        std::size_t(0),
+        n,
+        [&](const std::size_t begin, const std::size_t end) {
+          for (std::size_t i = begin; i < end; ++i)
+            {
+              Number result = (s == Number() ? Number() : s * values[i]);
+              for (unsigned int k = 0; k < sources.size(); ++k)
+                result += coefficients[k] * sources[k][i];
+              values[i] = result;
+            }
+        },
+        VectorImplementation::minimum_parallel_grain_size);
+
+      if (v.has_ghost_elements())
+        v.update_ghost_values();
+    }
+
+    /**
+     * A helper class that computes linear combinations of vectors for the
+     * vector space operations of LinearOperator and PackagedOperation.
+     *
+     * The generic version of this class does not support any vector type,
+     * and these operations are then composed of the elementary operations
+     * of the vector class, one sweep over the vector for each of them. The
+     * class is specialized for vector classes whose elements can be accessed
+     * directly, for which a whole linear combination is computed in a single
+     * sweep.
+     */
+    template <typename VectorType>
+    class LinearCombinationHelper
+    {
+    public:
+      /**
+       * Whether linear combinations of vectors of this type are supported.
+       */
+      static constexpr bool is_supported = false;
+
+      /**
+       * Set $v = s v + \sum_k a_k u_k$. Not implemented for the generic
+       * version of this class.
+       */
+      static void
+      apply(VectorType &,
+            const typename VectorType::value_type,
+            const LinearCombination<VectorType> &)
+      {
+        Assert(false, ExcInternalError());
+      }
+    };
+
+    /**
+     * Specialization of LinearCombinationHelper for dealii::Vector.
+     */
+    template <typename Number>
+    class LinearCombinationHelper<dealii::Vector<Number>>
+    {
+    public:
+      static constexpr bool is_supported = true;
+
+      static void
+      apply(dealii::Vector<Number> &                          v,
+            const Number                                      s,
+            const LinearCombination<dealii::Vector<Number>> &terms)
+      {
+        add_linear_combination(v, s, terms);
+      }
+    };
+
+    /**
+     * Specialization of LinearCombinationHelper for
+     * LinearAlgebra::distributed::Vector in host memory.
+     */
+    template <typename Number>
+    class LinearCombinationHelper<
+      dealii::LinearAlgebra::distributed::Vector<Number, MemorySpace::Host>>
+    {
+    public:
+      using VectorType =
+        dealii::LinearAlgebra::distributed::Vector<Number, MemorySpace::Host>;
+
+      static constexpr bool is_supported = true;
+
+      static void
+      apply(VectorType &                         v,
+            const Number                         s,
+            const LinearCombination<VectorType> &terms)
+      {
+        add_linear_combination(v, s, terms);
+      }
+    };
+
+    /**
+     * Add @p number times a result to @p v, where @p apply and
+     * @p apply_add store the result in, or add it to, a vector that is
+     * initialized by @p reinit_vector. Specialization for vector types
+     * without support for linear combinations: @p v is scaled before and
+     * after adding the result.
+     */
+    template <typename VectorType,
+              typename ApplyFunction,
+              typename ApplyAddFunction,
+              typename ReinitFunction>
+    void
+    add_scaled_result(VectorType &                          v,
+                      const typename VectorType::value_type number,
+                      const ApplyFunction &,
+                      const ApplyAddFunction &apply_add,
+                      const ReinitFunction &,
+                      std::false_type)
+    {
+      v /= number;
+      apply_add(v);
+      v *= number;
+    }
+
+    /**
+     * Same as above, for vector types with support for linear combinations:
+     * the result is stored in a temporary vector and added to @p v in a
+     * single sweep.
+     */
+    template <typename VectorType,
+              typename ApplyFunction,
+              typename ApplyAddFunction,
+              typename ReinitFunction>
+    void
+    add_scaled_result(VectorType &                          v,
+                      const typename VectorType::value_type number,
+                      const ApplyFunction &                 apply,
+                      const ApplyAddFunction &,
+                      const ReinitFunction &reinit_vector,
+                      std::true_type)
+    {
+      GrowingVectorMemory<VectorType>            vector_memory;
+      typename VectorMemory<VectorType>::Pointer i(vector_memory);
+      reinit_vector(*i, /*bool omit_zeroing_entries =*/true);
+      apply(*i);
+
+      LinearCombinationHelper<VectorType>::apply(
+        v,
+        typename VectorType::value_type(1.),
+        LinearCombination<VectorType>(1, {number, i.get()}));
+    }
+
+    /**
+     * Add @p number times a result to @p v in the way supported by the
+     * vector type, see the functions above.
+     */
+    template <typename VectorType,
+              typename ApplyFunction,
+              typename ApplyAddFunction,
+              typename ReinitFunction>
+    void
+    add_scaled_result(VectorType &                          v,
+                      const typename VectorType::value_type number,
+                      const ApplyFunction &                 apply,
+                      const ApplyAddFunction &              apply_add,
+                      const ReinitFunction &                reinit_vector)
+    {
+      add_scaled_result(
+        v,
+        number,
+        apply,
+        apply_add,
+        reinit_vector,
+        std::integral_constant<
+          bool,
+          LinearCombinationHelper<VectorType>::is_supported>());
+    }
+  } // namespace LinearOperatorImplementation
+} // namespace internal
+
+
 /**
  * @name Vector space operations
  */
@@ -513,9 +737,12 @@ operator*(typename Range::value_type                    number,
       };
 
       return_op.vmult_add = [number, op](Range &v, const Domain &u) {
-        v /= number;
-        op.vmult_add(v, u);
-        v *= number;
+        internal::LinearOperatorImplementation::add_scaled_result(
+          v,
+          number,
+          [&](Range &x) { op.vmult(x, u); },
+          [&](Range &x) { op.vmult_add(x, u); },
+          op.reinit_range_vector);
       };
 
       return_op.Tvmult = [number, op](Domain &v, const Range &u) {
@@ -524,9 +751,12 @@ operator*(typename Range::value_type                    number,
       };
 
       return_op.Tvmult_add = [number, op](Domain &v, const Range &u) {
-        v /= number;
-        op.Tvmult_add(v, u);
-        v *= number;
+        internal::LinearOperatorImplementation::add_scaled_result(
+          v,
+          number,
+          [&](Domain &x) { op.Tvmult(x, u); },
+          [&](Domain &x) { op.Tvmult_add(x, u); },
+          op.reinit_domain_vector);
       };
 
       return return_op;
@@ -20,9 +20,11 @@
 
 #include <deal.II/base/exceptions.h>
 
+#include <deal.II/lac/linear_operator.h>
 #include <deal.II/lac/vector_memory.h>
 
 #include <functional>
+#include <vector>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -176,6 +178,11 @@ public:
       v.reinit(u, omit_zeroing_entries);
     };
 
+    linear_combination.clear();
+    if (internal::LinearOperatorImplementation::LinearCombinationHelper<
+          Range>::is_supported)
+      linear_combination.emplace_back(typename Range::value_type(1.), &u);
+
     return *this;
   }
 
@@ -274,9 +281,80 @@ public:
    * content of the vector is set to 0.
    */
   std::function<void(Range &v, bool omit_zeroing_entries)> reinit_vector;
+
+  /**
+   * If the result of the PackagedOperation is a linear combination of
+   * vectors, and the @p Range vector type supports computing such
+   * combinations in a single sweep over the vectors (which is the case for
+   * Vector and LinearAlgebra::distributed::Vector), the coefficients and
+   * the vectors of this combination. The vector space operations below
+   * then collect the terms of their arguments, so that an expression like
+   * <code>a*u + b*v - w</code> is computed in one sweep instead of one
+   * sweep for every operation. Empty for all other PackagedOperation
+   * objects.
+   *
+   * If apply() or apply_add() of an object are changed by hand, this
+   * member needs to be cleared.
+   */
+  internal::LinearOperatorImplementation::LinearCombination<Range>
+    linear_combination;
 };
 
 
+namespace internal
+{
+  namespace PackagedOperationImplementation
+  {
+    /**
+     * Create a PackagedOperation object that computes the linear combination
+     * @p terms in a single sweep, with vectors initialized by
+     * @p reinit_vector.
+     */
+    template <typename Range>
+    PackagedOperation<Range>
+    linear_combination_operation(
+      const std::function<void(Range &, bool)> &                reinit_vector,
+      const LinearOperatorImplementation::LinearCombination<Range> &terms)
+    {
+      using Helper =
+        LinearOperatorImplementation::LinearCombinationHelper<Range>;
+
+      PackagedOperation<Range> return_comp;
+
+      return_comp.reinit_vector      = reinit_vector;
+      return_comp.linear_combination = terms;
+
+      return_comp.apply = [terms](Range &v) {
+        Helper::apply(v, typename Range::value_type(), terms);
+      };
+
+      return_comp.apply_add = [terms](Range &v) {
+        Helper::apply(v, typename Range::value_type(1.), terms);
+      };
+
+      return return_comp;
+    }
+
+
+
+    /**
+     * Return the linear combination @p terms with all coefficients
+     * multiplied by @p number.
+     */
+    template <typename Range>
+    LinearOperatorImplementation::LinearCombination<Range>
+    scale(const LinearOperatorImplementation::LinearCombination<Range> &terms,
+          const typename Range::value_type                             number)
+    {
+      LinearOperatorImplementation::LinearCombination<Range> result = terms;
+      for (auto &term : result)
+        term.first *= number;
+      return result;
+    }
+  } // namespace PackagedOperationImplementation
+} // namespace internal
+
+
 /**
  * @name Vector space operations
  */
@@ -295,10 +373,53 @@ PackagedOperation<Range>
 operator+(const PackagedOperation<Range> &first_comp,
           const PackagedOperation<Range> &second_comp)
 {
+  using Helper =
+    internal::LinearOperatorImplementation::LinearCombinationHelper<Range>;
+  using LinearCombination =
+    internal::LinearOperatorImplementation::LinearCombination<Range>;
+
+  // if both operations are linear combinations of vectors, collect the terms
+  // of both and compute them in one sweep
+  if (!first_comp.linear_combination.empty() &&
+      !second_comp.linear_combination.empty())
+    {
+      LinearCombination terms = first_comp.linear_combination;
+      terms.insert(terms.end(),
+                   second_comp.linear_combination.begin(),
+                   second_comp.linear_combination.end());
+      return internal::PackagedOperationImplementation::
+        linear_combination_operation<Range>(first_comp.reinit_vector, terms);
+    }
+
   PackagedOperation<Range> return_comp;
 
   return_comp.reinit_vector = first_comp.reinit_vector;
 
+  // if only one of them is a linear combination, compute the other one first
+  // and add the linear combination in one sweep
+  if (!first_comp.linear_combination.empty() ||
+      !second_comp.linear_combination.empty())
+    {
+      const PackagedOperation<Range> other =
+        (first_comp.linear_combination.empty() ? first_comp : second_comp);
+      const LinearCombination        terms =
+        (first_comp.linear_combination.empty() ?
+           second_comp.linear_combination :
+           first_comp.linear_combination);
+
+      return_comp.apply = [other, terms](Range &v) {
+        other.apply(v);
+        Helper::apply(v, typename Range::value_type(1.), terms);
+      };
+
+      return_comp.apply_add = [other, terms](Range &v) {
+        other.apply_add(v);
+        Helper::apply(v, typename Range::value_type(1.), terms);
+      };
+
+      return return_comp;
+    }
+
   // ensure to have valid PackagedOperation objects by catching first_comp and
   // second_comp by value
 
@@ -328,10 +449,75 @@ PackagedOperation<Range>
 operator-(const PackagedOperation<Range> &first_comp,
           const PackagedOperation<Range> &second_comp)
 {
+  using Helper =
+    internal::LinearOperatorImplementation::LinearCombinationHelper<Range>;
+  using LinearCombination =
+    internal::LinearOperatorImplementation::LinearCombination<Range>;
+  using Number = typename Range::value_type;
+
+  // if both operations are linear combinations of vectors, collect the terms
+  // of both and compute them in one sweep
+  if (!first_comp.linear_combination.empty() &&
+      !second_comp.linear_combination.empty())
+    {
+      LinearCombination terms = first_comp.linear_combination;
+      const LinearCombination second_terms =
+        internal::PackagedOperationImplementation::scale<Range>(
+          second_comp.linear_combination, Number(-1.));
+      terms.insert(terms.end(), second_terms.begin(), second_terms.end());
+      return internal::PackagedOperationImplementation::
+        linear_combination_operation<Range>(first_comp.reinit_vector, terms);
+    }
+
   PackagedOperation<Range> return_comp;
 
   return_comp.reinit_vector = first_comp.reinit_vector;
 
+  // if only the first operation is a linear combination, compute the second
+  // one and combine the negation of its result with the linear combination
+  // in one sweep
+  if (!first_comp.linear_combination.empty())
+    {
+      const LinearCombination terms = first_comp.linear_combination;
+      const LinearCombination negative_terms =
+        internal::PackagedOperationImplementation::scale<Range>(terms,
+                                                                Number(-1.));
+
+      return_comp.apply = [second_comp, terms](Range &v) {
+        second_comp.apply(v);
+        Helper::apply(v, Number(-1.), terms);
+      };
+
+      return_comp.apply_add = [second_comp, negative_terms](Range &v) {
+        Helper::apply(v, Number(-1.), negative_terms);
+        second_comp.apply_add(v);
+        v *= -1.;
+      };
+
+      return return_comp;
+    }
+
+  // if only the second operation is a linear combination, compute the first
+  // one and subtract the linear combination in one sweep
+  if (!second_comp.linear_combination.empty())
+    {
+      const LinearCombination negative_terms =
+        internal::PackagedOperationImplementation::scale<Range>(
+          second_comp.linear_combination, Number(-1.));
+
+      return_comp.apply = [first_comp, negative_terms](Range &v) {
+        first_comp.apply(v);
+        Helper::apply(v, Number(1.), negative_terms);
+      };
+
+      return_comp.apply_add = [first_comp, negative_terms](Range &v) {
+        first_comp.apply_add(v);
+        Helper::apply(v, Number(1.), negative_terms);
+      };
+
+      return return_comp;
+    }
+
   // ensure to have valid PackagedOperation objects by catching first_comp and
   // second_comp by value
 
@@ -364,6 +550,14 @@ PackagedOperation<Range>
 operator*(const PackagedOperation<Range> &comp,
           typename Range::value_type      number)
 {
+  // a linear combination of vectors is scaled by scaling its coefficients
+  if (number != 0. && !comp.linear_combination.empty())
+    return internal::PackagedOperationImplementation::
+      linear_combination_operation<Range>(
+        comp.reinit_vector,
+        internal::PackagedOperationImplementation::scale<Range>(
+          comp.linear_combination, number));
+
   PackagedOperation<Range> return_comp;
 
   return_comp.reinit_vector = comp.reinit_vector;
@@ -383,9 +577,12 @@ operator*(const PackagedOperation<Range> &comp,
       };
 
       return_comp.apply_add = [comp, number](Range &v) {
-        v /= number;
-        comp.apply_add(v);
-        v *= number;
+        internal::LinearOperatorImplementation::add_scaled_result(
+          v,
+          number,
+          comp.apply,
+          comp.apply_add,
+          comp.reinit_vector);
       };
     }
 
@@ -530,6 +727,10 @@ template <typename Range,
 PackagedOperation<Range>
 operator+(const Range &u, const Range &v)
 {
+  if (internal::LinearOperatorImplementation::LinearCombinationHelper<
+        Range>::is_supported)
+    return PackagedOperation<Range>(u) + PackagedOperation<Range>(v);
+
   PackagedOperation<Range> return_comp;
 
   // ensure to have valid PackagedOperation objects by catching op by value
@@ -575,6 +776,10 @@ template <typename Range,
 PackagedOperation<Range>
 operator-(const Range &u, const Range &v)
 {
+  if (internal::LinearOperatorImplementation::LinearCombinationHelper<
+        Range>::is_supported)
+    return PackagedOperation<Range>(u) - PackagedOperation<Range>(v);
+
   PackagedOperation<Range> return_comp;
 
   // ensure to have valid PackagedOperation objects by catching op by value
@@ -1575,6 +1575,10 @@ public:
  *                  operation_after_matrix_vector_product);
  * }
  * @endcode
+ * The operators derived from MatrixFreeOperators::Base, such as
+ * MatrixFreeOperators::LaplaceOperator, provide this interface out of the
+ * box.
+ *
  * In terms of the Chebyshev iteration, the operation before the loop will
  * set `dst` to zero, whereas the operation after the loop performs the
  * iteration leading to $x^{n+1}$ described above, modifying the `dst` and
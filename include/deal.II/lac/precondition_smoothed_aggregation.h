@@ -0,0 +1,372 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_precondition_smoothed_aggregation_h
+#define dealii_precondition_smoothed_aggregation_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/subscriptor.h>
+
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include <memory>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+/*! @addtogroup Preconditioners
+ *@{
+ */
+
+/**
+ * A smoothed-aggregation algebraic multigrid preconditioner for symmetric
+ * positive definite matrices stored as SparseMatrix. In contrast to
+ * TrilinosWrappers::PreconditionAMG or PETScWrappers::PreconditionBoomerAMG,
+ * this class does not rely on an external library and works directly on the
+ * deal.II matrix and vector classes, which makes it a natural choice for
+ * serial computations and for the coarse level of geometric multigrid
+ * methods, e.g. in combination with MGCoarseGridIterativeSolver.
+ *
+ * <h3>Setup</h3>
+ *
+ * The hierarchy is built from the algebraic information of the matrix alone:
+ * <ol>
+ * <li> Two unknowns $i$ and $j$ are called strongly connected if $|a_{ij}|
+ * \geq \theta \sqrt{|a_{ii} a_{jj}|}$ with the threshold $\theta$ given by
+ * AdditionalData::strong_threshold.
+ * <li> The unknowns are grouped into aggregates of strongly connected
+ * unknowns with the greedy three-phase algorithm by Vanek, Mandel, and
+ * Brezina. Unknowns without strong connections, like rows of Dirichlet
+ * boundary conditions, are not assigned to any aggregate and are only
+ * treated by the smoother.
+ * <li> The tentative prolongator $T$ interpolates the constant vector on
+ * each aggregate, scaled such that its columns are orthonormal. This
+ * captures the near null space of scalar elliptic operators.
+ * <li> The tentative prolongator is improved by one step of damped Jacobi,
+ * $P = (I - \frac{\omega}{\lambda_\text{max}} D^{-1}A)T$, where
+ * $\lambda_\text{max}$ is an estimate of the largest eigenvalue of
+ * $D^{-1}A$ and $\omega$ is given by AdditionalData::prolongator_damping.
+ * <li> The coarse matrix is computed by the Galerkin product $P^TAP$.
+ * </ol>
+ * These steps are repeated until the matrix has at most
+ * AdditionalData::coarse_size rows or AdditionalData::max_levels levels have
+ * been created. The matrix on the coarsest level is inverted by Gaussian
+ * elimination.
+ *
+ * <h3>Application</h3>
+ *
+ * The vmult() function applies one V-cycle with zero initial guess. On each
+ * level, AdditionalData::smoothing_steps sweeps of damped Jacobi with
+ * relaxation parameter AdditionalData::smoother_damping$/\lambda_\text{max}$
+ * are used both before and after the coarse grid correction. The V-cycle is
+ * hence a symmetric operator and can be used as a preconditioner for
+ * SolverCG. The matrix-vector products and vector updates are run in
+ * parallel using the task-based threading of SparseMatrix and Vector.
+ *
+ * <h3>Reuse of the setup</h3>
+ *
+ * Sequences of matrices with the same sparsity pattern but different
+ * entries, as they appear in the iterations of Newton's method or in time
+ * stepping with variable coefficients, can use update_matrix_values(). That
+ * function keeps the aggregates, the tentative prolongators, and the
+ * sparsity patterns of all levels and only recomputes the numerical values
+ * of the hierarchy, which avoids the graph algorithms and memory allocations
+ * of the full setup.
+ *
+ * <h3>Usage</h3>
+ *
+ * @code
+ * PreconditionSmoothedAggregation<double> amg;
+ * amg.initialize(system_matrix);
+ *
+ * SolverControl            solver_control(1000, 1e-12);
+ * SolverCG<Vector<double>> solver(solver_control);
+ * solver.solve(system_matrix, solution, system_rhs, amg);
+ *
+ * // next Newton step, same sparsity pattern
+ * amg.update_matrix_values(system_matrix);
+ * @endcode
+ *
+ * The template argument @p number selects the precision of the
+ * hierarchy, independently of the number type of the matrix passed to
+ * initialize() and of the vectors passed to vmult(). Using @p float
+ * halves the memory transfer in the application of the preconditioner.
+ *
+ * @note The vmult() function uses temporary vectors stored inside this
+ * class. Calling it concurrently on the same object from several threads is
+ * not allowed.
+ */
+template <typename number>
+class PreconditionSmoothedAggregation : public Subscriptor
+{
+public:
+  /**
+   * Declare type for container size.
+   */
+  using size_type = types::global_dof_index;
+
+  /**
+   * Parameters of the setup and of the V-cycle.
+   */
+  struct AdditionalData
+  {
+    /**
+     * Constructor.
+     */
+    AdditionalData(const double       strong_threshold    = 0.08,
+                   const unsigned int smoothing_steps     = 2,
+                   const double       smoother_damping    = 4. / 3.,
+                   const double       prolongator_damping = 4. / 3.,
+                   const unsigned int coarse_size         = 200,
+                   const unsigned int max_levels          = 20);
+
+    /**
+     * Threshold $\theta$ of the strength-of-connection criterion. Larger
+     * values result in smaller aggregates and thus slower coarsening, but
+     * typically better convergence for anisotropic problems.
+     */
+    double strong_threshold;
+
+    /**
+     * Number of Jacobi sweeps before and after the coarse grid correction
+     * on each level.
+     */
+    unsigned int smoothing_steps;
+
+    /**
+     * Relaxation parameter of the Jacobi smoother, relative to the inverse
+     * of the estimated largest eigenvalue of $D^{-1}A$.
+     */
+    double smoother_damping;
+
+    /**
+     * Damping $\omega$ of the Jacobi step applied to the tentative
+     * prolongator, relative to the inverse of the estimated largest
+     * eigenvalue of $D^{-1}A$.
+     */
+    double prolongator_damping;
+
+    /**
+     * Coarsening stops as soon as a level has at most this many rows.
+     */
+    unsigned int coarse_size;
+
+    /**
+     * Maximal number of levels in the hierarchy, including the level of
+     * the original matrix.
+     */
+    unsigned int max_levels;
+  };
+
+  /**
+   * Constructor. Does nothing, so you have to call initialize() afterwards.
+   */
+  PreconditionSmoothedAggregation() = default;
+
+  /**
+   * Build the multigrid hierarchy for the given matrix.
+   *
+   * A copy of the matrix is stored on the finest level, which refers to the
+   * sparsity pattern of @p matrix. That sparsity pattern hence needs to
+   * stay alive as long as this object is used.
+   */
+  template <typename somenumber>
+  void
+  initialize(const SparseMatrix<somenumber> &matrix,
+             const AdditionalData &          data = AdditionalData());
+
+  /**
+   * Recompute the numerical values of the hierarchy for a matrix with new
+   * entries, keeping the aggregates and sparsity patterns from the last call
+   * to initialize(). The matrix must be based on the same SparsityPattern
+   * object as the one passed to initialize().
+   */
+  template <typename somenumber>
+  void
+  update_matrix_values(const SparseMatrix<somenumber> &matrix);
+
+  /**
+   * Release all memory and return to a state just like after having called
+   * the default constructor.
+   */
+  void
+  clear();
+
+  /**
+   * Apply one V-cycle with zero initial guess to @p src and store the
+   * result in @p dst.
+   */
+  template <typename somenumber>
+  void
+  vmult(Vector<somenumber> &dst, const Vector<somenumber> &src) const;
+
+  /**
+   * Apply the transpose of the preconditioner. Since the V-cycle is
+   * symmetric, this is the same as vmult().
+   */
+  template <typename somenumber>
+  void
+  Tvmult(Vector<somenumber> &dst, const Vector<somenumber> &src) const;
+
+  /**
+   * Return the number of levels of the hierarchy.
+   */
+  unsigned int
+  n_levels() const;
+
+  /**
+   * Return the number of rows of the matrix on the given level, with level
+   * zero being the original matrix.
+   */
+  size_type
+  n_rows(const unsigned int level) const;
+
+  /**
+   * Return the operator complexity, i.e., the number of nonzero entries of
+   * the matrices on all levels divided by the number of nonzero entries of
+   * the original matrix.
+   */
+  double
+  operator_complexity() const;
+
+  /**
+   * Determine an estimate for the memory consumption (in bytes) of this
+   * object.
+   */
+  std::size_t
+  memory_consumption() const;
+
+private:
+  /**
+   * The data stored for each level of the hierarchy. The prolongation and
+   * coarse matrices refer to the sparsity patterns stored in the same
+   * object, so levels are kept by pointer.
+   */
+  struct Level
+  {
+    /**
+     * Sparsity pattern of the matrix on this level. Unused on the finest
+     * level whose matrix refers to the pattern of the user.
+     */
+    SparsityPattern sparsity;
+
+    /**
+     * The matrix on this level.
+     */
+    SparseMatrix<number> matrix;
+
+    /**
+     * Sparsity pattern and entries of the tentative prolongator from the
+     * next coarser level to this level.
+     */
+    SparsityPattern      tentative_sparsity;
+    SparseMatrix<number> tentative_prolongation;
+
+    /**
+     * Sparsity pattern and entries of the smoothed prolongator from the next
+     * coarser level to this level.
+     */
+    SparsityPattern      prolongation_sparsity;
+    SparseMatrix<number> prolongation;
+
+    /**
+     * Sparsity pattern and entries of the product of the matrix with the
+     * prolongator, used to compute the Galerkin coarse matrix.
+     */
+    SparsityPattern      product_sparsity;
+    SparseMatrix<number> product;
+
+    /**
+     * Inverse of the diagonal of the matrix.
+     */
+    Vector<number> diagonal_inverse;
+
+    /**
+     * Estimate of the largest eigenvalue of the Jacobi-preconditioned
+     * matrix.
+     */
+    double max_eigenvalue;
+
+    /**
+     * Temporary vectors of the V-cycle.
+     */
+    mutable Vector<number> rhs;
+    mutable Vector<number> solution;
+    mutable Vector<number> residual;
+  };
+
+  /**
+   * Compute the inverse diagonal and the eigenvalue estimate of the given
+   * level and resize its temporary vectors.
+   */
+  void
+  setup_smoother(Level &level);
+
+  /**
+   * Compute the smoothed prolongator of the given level and the matrix of
+   * the next coarser level. If @p rebuild_sparsity is false, the sparsity
+   * patterns from a previous call are reused.
+   */
+  void
+  compute_coarse_level(const unsigned int level, const bool rebuild_sparsity);
+
+  /**
+   * Compute the inverse of the matrix on the coarsest level if it is small
+   * enough.
+   */
+  void
+  setup_coarse_solver();
+
+  /**
+   * Run the damped Jacobi smoother on the given level.
+   */
+  void
+  smooth(const Level &level, const bool zero_initial_guess) const;
+
+  /**
+   * Recursively apply the V-cycle starting on the given level, using the
+   * vectors Level::rhs and Level::solution.
+   */
+  void
+  v_cycle(const unsigned int level) const;
+
+  /**
+   * The parameters of the setup.
+   */
+  AdditionalData additional_data;
+
+  /**
+   * The levels of the hierarchy, with the original matrix on level zero.
+   */
+  std::vector<std::unique_ptr<Level>> levels;
+
+  /**
+   * Inverse of the matrix on the coarsest level. Empty if the coarsest
+   * level is too large to be inverted, in which case the smoother is used
+   * on that level.
+   */
+  FullMatrix<number> coarse_inverse;
+};
+
+/*@}*/
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
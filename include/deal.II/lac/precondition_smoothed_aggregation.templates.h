@@ -0,0 +1,586 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_precondition_smoothed_aggregation_templates_h
+#define dealii_precondition_smoothed_aggregation_templates_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
+
+#include <deal.II/lac/precondition_smoothed_aggregation.h>
+
+#include <algorithm>
+#include <cmath>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace internal
+{
+  namespace PreconditionSmoothedAggregationImplementation
+  {
+    /**
+     * Group the rows of the given matrix into aggregates with the greedy
+     * three-phase algorithm of smoothed aggregation multigrid, see the
+     * documentation of PreconditionSmoothedAggregation. On return,
+     * @p aggregate_of contains the aggregate of each row, or
+     * numbers::invalid_unsigned_int for rows without strong connections. The
+     * return value is the number of aggregates.
+     */
+    template <typename number>
+    unsigned int
+    compute_aggregates(const SparseMatrix<number> &matrix,
+                       const double                strong_threshold,
+                       std::vector<unsigned int> & aggregate_of)
+    {
+      using size_type   = types::global_dof_index;
+      const size_type n = matrix.m();
+
+      const double threshold_sqr = strong_threshold * strong_threshold;
+      const auto   for_each_strong_entry =
+        [&](const size_type row, const auto &function) {
+          const double diag = std::abs(matrix.diag_element(row));
+          for (auto entry = matrix.begin(row); entry != matrix.end(row);
+               ++entry)
+            {
+              const size_type col = entry->column();
+              if (col == row)
+                continue;
+              const double value = std::abs(entry->value());
+              if (value * value >
+                  threshold_sqr * diag * std::abs(matrix.diag_element(col)))
+                function(col, value);
+            }
+        };
+
+      // build the graph of strong connections in compressed row storage,
+      // first counting the entries and then filling them on each subrange
+      // of rows in parallel
+      std::vector<size_type> row_starts(n + 1);
+      parallel::apply_to_subranges(
+        size_type(0),
+        n,
+        [&](const size_type begin, const size_type end) {
+          for (size_type row = begin; row < end; ++row)
+            for_each_strong_entry(row, [&](const size_type, const double) {
+              ++row_starts[row + 1];
+            });
+        },
+        internal::SparseMatrixImplementation::minimum_parallel_grain_size);
+      for (size_type row = 0; row < n; ++row)
+        row_starts[row + 1] += row_starts[row];
+
+      std::vector<unsigned int> strong_columns(row_starts.back());
+      std::vector<float>        strong_values(row_starts.back());
+      parallel::apply_to_subranges(
+        size_type(0),
+        n,
+        [&](const size_type begin, const size_type end) {
+          for (size_type row = begin; row < end; ++row)
+            {
+              size_type index = row_starts[row];
+              for_each_strong_entry(row,
+                                    [&](const size_type col,
+                                        const double    value) {
+                                      strong_columns[index] = col;
+                                      strong_values[index]  = value;
+                                      ++index;
+                                    });
+            }
+        },
+        internal::SparseMatrixImplementation::minimum_parallel_grain_size);
+
+      aggregate_of.clear();
+      aggregate_of.resize(n, numbers::invalid_unsigned_int);
+      unsigned int n_aggregates = 0;
+
+      // phase 1: rows whose strong neighbors are all still free form a new
+      // aggregate together with their neighbors
+      for (size_type row = 0; row < n; ++row)
+        if (aggregate_of[row] == numbers::invalid_unsigned_int &&
+            row_starts[row] < row_starts[row + 1] &&
+            std::all_of(strong_columns.begin() + row_starts[row],
+                        strong_columns.begin() + row_starts[row + 1],
+                        [&](const unsigned int col) {
+                          return aggregate_of[col] ==
+                                 numbers::invalid_unsigned_int;
+                        }))
+          {
+            aggregate_of[row] = n_aggregates;
+            for (size_type j = row_starts[row]; j < row_starts[row + 1]; ++j)
+              aggregate_of[strong_columns[j]] = n_aggregates;
+            ++n_aggregates;
+          }
+
+      // phase 2: the remaining rows join the aggregate of phase 1 they are
+      // most strongly connected to
+      const std::vector<unsigned int> aggregates_phase_1 = aggregate_of;
+      for (size_type row = 0; row < n; ++row)
+        if (aggregate_of[row] == numbers::invalid_unsigned_int)
+          {
+            float strongest = 0;
+            for (size_type j = row_starts[row]; j < row_starts[row + 1]; ++j)
+              if (aggregates_phase_1[strong_columns[j]] !=
+                    numbers::invalid_unsigned_int &&
+                  strong_values[j] > strongest)
+                {
+                  strongest         = strong_values[j];
+                  aggregate_of[row] = aggregates_phase_1[strong_columns[j]];
+                }
+          }
+
+      // phase 3: rows without connection to any aggregate of phase 1 form
+      // aggregates with their free strong neighbors
+      for (size_type row = 0; row < n; ++row)
+        if (aggregate_of[row] == numbers::invalid_unsigned_int &&
+            row_starts[row] < row_starts[row + 1])
+          {
+            aggregate_of[row] = n_aggregates;
+            for (size_type j = row_starts[row]; j < row_starts[row + 1]; ++j)
+              if (aggregate_of[strong_columns[j]] ==
+                  numbers::invalid_unsigned_int)
+                aggregate_of[strong_columns[j]] = n_aggregates;
+            ++n_aggregates;
+          }
+
+      return n_aggregates;
+    }
+
+
+
+    /**
+     * Fill the tentative prolongator that interpolates a constant on each
+     * aggregate, scaled to orthonormal columns.
+     */
+    template <typename number>
+    void
+    build_tentative_prolongation(
+      const std::vector<unsigned int> &aggregate_of,
+      const unsigned int               n_aggregates,
+      SparsityPattern &                sparsity,
+      SparseMatrix<number> &           prolongation)
+    {
+      using size_type   = types::global_dof_index;
+      const size_type n = aggregate_of.size();
+
+      std::vector<unsigned int> aggregate_sizes(n_aggregates);
+      sparsity.reinit(n, n_aggregates, 1);
+      for (size_type row = 0; row < n; ++row)
+        if (aggregate_of[row] != numbers::invalid_unsigned_int)
+          {
+            sparsity.add(row, aggregate_of[row]);
+            ++aggregate_sizes[aggregate_of[row]];
+          }
+      sparsity.compress();
+
+      prolongation.reinit(sparsity);
+      for (size_type row = 0; row < n; ++row)
+        if (aggregate_of[row] != numbers::invalid_unsigned_int)
+          prolongation.set(row,
+                           aggregate_of[row],
+                           1. / std::sqrt(static_cast<double>(
+                                  aggregate_sizes[aggregate_of[row]])));
+    }
+  } // namespace PreconditionSmoothedAggregationImplementation
+} // namespace internal
+
+
+
+template <typename number>
+PreconditionSmoothedAggregation<number>::AdditionalData::AdditionalData(
+  const double       strong_threshold,
+  const unsigned int smoothing_steps,
+  const double       smoother_damping,
+  const double       prolongator_damping,
+  const unsigned int coarse_size,
+  const unsigned int max_levels)
+  : strong_threshold(strong_threshold)
+  , smoothing_steps(smoothing_steps)
+  , smoother_damping(smoother_damping)
+  , prolongator_damping(prolongator_damping)
+  , coarse_size(coarse_size)
+  , max_levels(max_levels)
+{}
+
+
+
+template <typename number>
+template <typename somenumber>
+void
+PreconditionSmoothedAggregation<number>::initialize(
+  const SparseMatrix<somenumber> &matrix,
+  const AdditionalData &          data)
+{
+  AssertDimension(matrix.m(), matrix.n());
+  Assert(data.smoothing_steps > 0,
+         ExcMessage("At least one smoothing step is needed."));
+  Assert(data.max_levels > 0,
+         ExcMessage("At least one level is needed."));
+
+  clear();
+  additional_data = data;
+
+  levels.emplace_back(std::make_unique<Level>());
+  levels[0]->matrix.reinit(matrix.get_sparsity_pattern());
+  levels[0]->matrix.copy_from(matrix);
+
+  while (true)
+    {
+      Level &fine = *levels.back();
+      setup_smoother(fine);
+
+      if (fine.matrix.m() <= additional_data.coarse_size ||
+          levels.size() == additional_data.max_levels)
+        break;
+
+      std::vector<unsigned int> aggregate_of;
+      const unsigned int        n_aggregates = internal::
+        PreconditionSmoothedAggregationImplementation::compute_aggregates(
+          fine.matrix, additional_data.strong_threshold, aggregate_of);
+
+      // stop if the matrix does not contain connections that allow for
+      // coarsening
+      if (n_aggregates == 0 || n_aggregates == fine.matrix.m())
+        break;
+
+      internal::PreconditionSmoothedAggregationImplementation::
+        build_tentative_prolongation(aggregate_of,
+                                     n_aggregates,
+                                     fine.tentative_sparsity,
+                                     fine.tentative_prolongation);
+
+      levels.emplace_back(std::make_unique<Level>());
+      compute_coarse_level(levels.size() - 2, true);
+    }
+
+  setup_coarse_solver();
+}
+
+
+
+template <typename number>
+template <typename somenumber>
+void
+PreconditionSmoothedAggregation<number>::update_matrix_values(
+  const SparseMatrix<somenumber> &matrix)
+{
+  Assert(levels.size() > 0, ExcNotInitialized());
+  Assert(&matrix.get_sparsity_pattern() ==
+           &levels[0]->matrix.get_sparsity_pattern(),
+         ExcMessage("The matrix passed to update_matrix_values() must use "
+                    "the same sparsity pattern as the one passed to "
+                    "initialize()."));
+
+  levels[0]->matrix.copy_from(matrix);
+  for (unsigned int l = 0; l < levels.size(); ++l)
+    {
+      setup_smoother(*levels[l]);
+      if (l + 1 < levels.size())
+        compute_coarse_level(l, false);
+    }
+
+  setup_coarse_solver();
+}
+
+
+
+template <typename number>
+void
+PreconditionSmoothedAggregation<number>::clear()
+{
+  levels.clear();
+  coarse_inverse.reinit(0, 0);
+}
+
+
+
+template <typename number>
+void
+PreconditionSmoothedAggregation<number>::setup_smoother(Level &level)
+{
+  const size_type n = level.matrix.m();
+  level.diagonal_inverse.reinit(n);
+  level.rhs.reinit(n);
+  level.solution.reinit(n);
+  level.residual.reinit(n);
+
+  // the largest eigenvalue of D^{-1}A is bounded by the Gershgorin circles
+  double gershgorin_bound = 0;
+  for (size_type row = 0; row < n; ++row)
+    {
+      const number diag = level.matrix.diag_element(row);
+      Assert(diag != number(),
+             ExcMessage("Smoothed aggregation requires a matrix with "
+                        "nonzero diagonal entries."));
+      level.diagonal_inverse(row) = number(1.) / diag;
+
+      double row_sum = 0;
+      for (auto entry = level.matrix.begin(row);
+           entry != level.matrix.end(row);
+           ++entry)
+        row_sum += std::abs(entry->value());
+      gershgorin_bound = std::max(gershgorin_bound, row_sum / std::abs(diag));
+    }
+
+  // the bound is often pessimistic, so improve it by a few steps of the power
+  // method, starting from an oscillating vector that is rich in the
+  // eigenvectors of large eigenvalues. as the power method approaches the
+  // eigenvalue from below, add a safety factor.
+  Vector<number> &vector = level.solution;
+  Vector<number> &result = level.residual;
+  for (size_type i = 0; i < n; ++i)
+    vector(i) = (i % 2 == 0 ? 1. : -1.) * (1. + 0.1 * (i % 7));
+  vector /= vector.l2_norm();
+  double eigenvalue = 0;
+  for (unsigned int it = 0; it < 10; ++it)
+    {
+      level.matrix.vmult(result, vector);
+      result.scale(level.diagonal_inverse);
+      eigenvalue = result.l2_norm();
+      if (eigenvalue == 0.)
+        break;
+      vector.equ(1. / eigenvalue, result);
+    }
+  level.max_eigenvalue = std::min(1.1 * eigenvalue, gershgorin_bound);
+  if (level.max_eigenvalue == 0.)
+    level.max_eigenvalue = 1.;
+}
+
+
+
+template <typename number>
+void
+PreconditionSmoothedAggregation<number>::compute_coarse_level(
+  const unsigned int level,
+  const bool         rebuild_sparsity)
+{
+  AssertIndexRange(level + 1, levels.size());
+  Level &fine   = *levels[level];
+  Level &coarse = *levels[level + 1];
+
+  // the matrix-matrix products either set up new sparsity patterns in the
+  // objects stored on the levels or add into the existing entries
+  if (rebuild_sparsity)
+    {
+      fine.prolongation.reinit(fine.prolongation_sparsity);
+      fine.product.reinit(fine.product_sparsity);
+      coarse.matrix.reinit(coarse.sparsity);
+    }
+  else
+    {
+      fine.prolongation = 0;
+      fine.product      = 0;
+      coarse.matrix     = 0;
+    }
+
+  // P = T - omega / lambda_max D^{-1} A T, where the product A T contains
+  // all entries of T because A has a nonzero diagonal
+  fine.matrix.mmult(fine.prolongation,
+                    fine.tentative_prolongation,
+                    Vector<number>(),
+                    rebuild_sparsity);
+  const double factor =
+    -additional_data.prolongator_damping / fine.max_eigenvalue;
+  parallel::apply_to_subranges(
+    size_type(0),
+    fine.prolongation.m(),
+    [&](const size_type begin, const size_type end) {
+      for (size_type row = begin; row < end; ++row)
+        {
+          const number scaling = factor * fine.diagonal_inverse(row);
+          for (auto entry = fine.prolongation.begin(row);
+               entry != fine.prolongation.end(row);
+               ++entry)
+            entry->value() *= scaling;
+          for (auto entry = fine.tentative_prolongation.begin(row);
+               entry != fine.tentative_prolongation.end(row);
+               ++entry)
+            fine.prolongation.add(row, entry->column(), entry->value());
+        }
+    },
+    internal::SparseMatrixImplementation::minimum_parallel_grain_size);
+
+  // Galerkin coarse matrix P^T (A P)
+  fine.matrix.mmult(fine.product,
+                    fine.prolongation,
+                    Vector<number>(),
+                    rebuild_sparsity);
+  fine.prolongation.Tmmult(coarse.matrix,
+                           fine.product,
+                           Vector<number>(),
+                           rebuild_sparsity);
+}
+
+
+
+template <typename number>
+void
+PreconditionSmoothedAggregation<number>::setup_coarse_solver()
+{
+  const SparseMatrix<number> &matrix = levels.back()->matrix;
+  if (matrix.m() <= additional_data.coarse_size)
+    {
+      coarse_inverse.copy_from(matrix);
+      coarse_inverse.gauss_jordan();
+    }
+  else
+    coarse_inverse.reinit(0, 0);
+}
+
+
+
+template <typename number>
+void
+PreconditionSmoothedAggregation<number>::smooth(
+  const Level &level,
+  const bool   zero_initial_guess) const
+{
+  const number relaxation =
+    additional_data.smoother_damping / level.max_eigenvalue;
+  for (unsigned int step = 0; step < additional_data.smoothing_steps; ++step)
+    if (step == 0 && zero_initial_guess)
+      {
+        level.solution.equ(relaxation, level.rhs);
+        level.solution.scale(level.diagonal_inverse);
+      }
+    else
+      {
+        level.matrix.residual(level.residual, level.solution, level.rhs);
+        level.residual.scale(level.diagonal_inverse);
+        level.solution.add(relaxation, level.residual);
+      }
+}
+
+
+
+template <typename number>
+void
+PreconditionSmoothedAggregation<number>::v_cycle(const unsigned int l) const
+{
+  const Level &level = *levels[l];
+
+  if (l + 1 == levels.size())
+    {
+      if (coarse_inverse.m() > 0)
+        coarse_inverse.vmult(level.solution, level.rhs);
+      else
+        {
+          smooth(level, true);
+          smooth(level, false);
+        }
+      return;
+    }
+
+  const Level &coarse = *levels[l + 1];
+
+  smooth(level, true);
+  level.matrix.residual(level.residual, level.solution, level.rhs);
+  level.prolongation.Tvmult(coarse.rhs, level.residual);
+  v_cycle(l + 1);
+  level.prolongation.vmult_add(level.solution, coarse.solution);
+  smooth(level, false);
+}
+
+
+
+template <typename number>
+template <typename somenumber>
+void
+PreconditionSmoothedAggregation<number>::vmult(
+  Vector<somenumber> &      dst,
+  const Vector<somenumber> &src) const
+{
+  Assert(levels.size() > 0, ExcNotInitialized());
+  AssertDimension(dst.size(), levels[0]->matrix.m());
+  AssertDimension(src.size(), levels[0]->matrix.m());
+
+  levels[0]->rhs = src;
+  v_cycle(0);
+  dst = levels[0]->solution;
+}
+
+
+
+template <typename number>
+template <typename somenumber>
+void
+PreconditionSmoothedAggregation<number>::Tvmult(
+  Vector<somenumber> &      dst,
+  const Vector<somenumber> &src) const
+{
+  vmult(dst, src);
+}
+
+
+
+template <typename number>
+unsigned int
+PreconditionSmoothedAggregation<number>::n_levels() const
+{
+  return levels.size();
+}
+
+
+
+template <typename number>
+typename PreconditionSmoothedAggregation<number>::size_type
+PreconditionSmoothedAggregation<number>::n_rows(const unsigned int level) const
+{
+  AssertIndexRange(level, levels.size());
+  return levels[level]->matrix.m();
+}
+
+
+
+template <typename number>
+double
+PreconditionSmoothedAggregation<number>::operator_complexity() const
+{
+  Assert(levels.size() > 0, ExcNotInitialized());
+  std::size_t n_nonzero = 0;
+  for (const auto &level : levels)
+    n_nonzero += level->matrix.n_nonzero_elements();
+  return static_cast<double>(n_nonzero) /
+         levels[0]->matrix.n_nonzero_elements();
+}
+
+
+
+template <typename number>
+std::size_t
+PreconditionSmoothedAggregation<number>::memory_consumption() const
+{
+  std::size_t memory = MemoryConsumption::memory_consumption(coarse_inverse);
+  for (const auto &level : levels)
+    memory += level->sparsity.memory_consumption() +
+              level->matrix.memory_consumption() +
+              level->tentative_sparsity.memory_consumption() +
+              level->tentative_prolongation.memory_consumption() +
+              level->prolongation_sparsity.memory_consumption() +
+              level->prolongation.memory_consumption() +
+              level->product_sparsity.memory_consumption() +
+              level->product.memory_consumption() +
+              level->diagonal_inverse.memory_consumption() +
+              level->rhs.memory_consumption() +
+              level->solution.memory_consumption() +
+              level->residual.memory_consumption();
+  return memory;
+}
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
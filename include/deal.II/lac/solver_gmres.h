@@ -21,6 +21,9 @@
 #include <deal.II/base/config.h>
 
 #include <deal.II/base/logstream.h>
+#include <deal.II/base/memory_space.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/subscriptor.h>
 
 #include <deal.II/lac/full_matrix.h>
@@ -37,9 +40,51 @@
 
 DEAL_II_NAMESPACE_OPEN
 
+// forward declarations
+#ifndef DOXYGEN
+namespace LinearAlgebra
+{
+  namespace distributed
+  {
+    template <typename, typename>
+    class Vector;
+  } // namespace distributed
+} // namespace LinearAlgebra
+#endif
+
 /*!@addtogroup Solvers */
 /*@{*/
 
+namespace LinearAlgebra
+{
+  /**
+   * The algorithm used to orthogonalize a new vector against the basis of
+   * the Krylov space in SolverGMRES and SolverFGMRES.
+   */
+  enum class OrthogonalizationStrategy
+  {
+    /**
+     * Use the modified Gram-Schmidt algorithm. The inner products with the
+     * basis vectors are computed one after the other, each on the vector
+     * already updated by the previous projections. This is numerically
+     * stable, but needs as many global reductions as there are basis
+     * vectors.
+     */
+    modified_gram_schmidt,
+
+    /**
+     * Use the classical Gram-Schmidt algorithm. All inner products with the
+     * basis vectors are computed from the same vector, which allows to
+     * compute them in a single sweep through the vectors and with a single
+     * global reduction. As the classical algorithm loses orthogonality
+     * faster than the modified one, the orthogonalization is repeated once
+     * loss of orthogonality is detected, or in every step if
+     * re-orthogonalization is forced (the so-called CGS2 algorithm).
+     */
+    classical_gram_schmidt
+  };
+} // namespace LinearAlgebra
+
 namespace internal
 {
   /**
@@ -105,6 +150,189 @@ namespace internal
        */
       std::vector<typename VectorMemory<VectorType>::Pointer> data;
     };
+
+
+
+    /**
+     * Operations on a block of vectors as needed by the classical
+     * Gram-Schmidt algorithm. This general implementation uses the interface
+     * of the vector class and computes one inner product after the other.
+     * Specializations for vector classes that give access to the locally
+     * owned entries compute all inner products in a single sweep through the
+     * vectors and with a single global reduction.
+     */
+    template <typename VectorType>
+    struct BlockOperations
+    {
+      /**
+       * Compute the inner products of @p vv with the first @p n vectors in
+       * @p orthogonal_vectors and store them in the first @p n entries of
+       * @p h. Return the square of the norm of @p vv.
+       */
+      static double
+      multi_dot(const TmpVectors<VectorType> &orthogonal_vectors,
+                const unsigned int            n,
+                const VectorType &            vv,
+                Vector<double> &              h)
+      {
+        for (unsigned int i = 0; i < n; ++i)
+          h(i) = vv * orthogonal_vectors[i];
+        return vv * vv;
+      }
+
+      /**
+       * Subtract the linear combination of the first @p n vectors in @p
+       * orthogonal_vectors with the coefficients in @p h from @p vv. Return
+       * the square of the norm of the updated vector.
+       */
+      static double
+      subtract_and_norm_sqr(const TmpVectors<VectorType> &orthogonal_vectors,
+                            const unsigned int            n,
+                            const Vector<double> &        h,
+                            VectorType &                  vv)
+      {
+        Assert(n > 0, ExcInternalError());
+        for (unsigned int i = 0; i < n - 1; ++i)
+          vv.add(-h(i), orthogonal_vectors[i]);
+        return vv.add_and_dot(-h(n - 1), orthogonal_vectors[n - 1], vv);
+      }
+    };
+
+
+
+    /**
+     * Specialization of the block operations for
+     * LinearAlgebra::distributed::Vector on the host. The locally owned
+     * range is processed in chunks small enough to stay in cache while all
+     * basis vectors are visited, such that @p vv is read only once. The
+     * chunks are distributed among threads, and the partial sums of the
+     * chunks are added in a fixed order to make the result independent of
+     * the number of threads.
+     */
+    template <typename Number>
+    struct BlockOperations<
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::Host>>
+    {
+      using VectorType =
+        LinearAlgebra::distributed::Vector<Number, MemorySpace::Host>;
+
+      static constexpr unsigned int chunk_size = 512;
+
+      /**
+       * Call @p kernel with the range of each chunk of the locally owned
+       * range of length @p size and a pointer to the @p n_sums partial sums
+       * of that chunk, and return the sums over all chunks.
+       */
+      template <typename Kernel>
+      static std::vector<double>
+      run_on_chunks(const unsigned int size,
+                    const unsigned int n_sums,
+                    const Kernel &     kernel)
+      {
+        const unsigned int  n_chunks = (size + chunk_size - 1) / chunk_size;
+        std::vector<double> partial_sums(n_chunks * n_sums);
+        dealii::parallel::apply_to_subranges(
+          0U,
+          n_chunks,
+          [&](const unsigned int chunk_begin, const unsigned int chunk_end) {
+            for (unsigned int c = chunk_begin; c < chunk_end; ++c)
+              kernel(c * chunk_size,
+                     std::min(size, (c + 1) * chunk_size),
+                     partial_sums.data() + c * n_sums);
+          },
+          std::max<unsigned int>(
+            1,
+            internal::VectorImplementation::minimum_parallel_grain_size /
+              chunk_size));
+
+        std::vector<double> sums(n_sums);
+        for (unsigned int c = 0; c < n_chunks; ++c)
+          for (unsigned int k = 0; k < n_sums; ++k)
+            sums[k] += partial_sums[c * n_sums + k];
+        return sums;
+      }
+
+      static double
+      multi_dot(const TmpVectors<VectorType> &orthogonal_vectors,
+                const unsigned int            n,
+                const VectorType &            vv,
+                Vector<double> &              h)
+      {
+        const Number *      vv_ptr = vv.begin();
+        std::vector<double> sums   = run_on_chunks(
+          vv.locally_owned_size(),
+          n + 1,
+          [&](const unsigned int start, const unsigned int end, double *sum) {
+            for (unsigned int i = 0; i < n; ++i)
+              {
+                const Number *v_ptr = orthogonal_vectors[i].begin();
+                for (unsigned int j = start; j < end; ++j)
+                  sum[i] += vv_ptr[j] * v_ptr[j];
+              }
+            for (unsigned int j = start; j < end; ++j)
+              sum[n] += vv_ptr[j] * vv_ptr[j];
+          });
+        Utilities::MPI::sum(sums, vv.get_mpi_communicator(), sums);
+        for (unsigned int i = 0; i < n; ++i)
+          h(i) = sums[i];
+        return sums[n];
+      }
+
+      static double
+      subtract_and_norm_sqr(const TmpVectors<VectorType> &orthogonal_vectors,
+                            const unsigned int            n,
+                            const Vector<double> &        h,
+                            VectorType &                  vv)
+      {
+        if (vv.has_ghost_elements())
+          vv.zero_out_ghost_values();
+
+        Number *     vv_ptr   = vv.begin();
+        const double norm_sqr = run_on_chunks(
+          vv.locally_owned_size(),
+          1,
+          [&](const unsigned int start, const unsigned int end, double *sum) {
+            for (unsigned int i = 0; i < n; ++i)
+              {
+                const Number *v_ptr = orthogonal_vectors[i].begin();
+                const Number  h_i   = h(i);
+                for (unsigned int j = start; j < end; ++j)
+                  vv_ptr[j] -= h_i * v_ptr[j];
+              }
+            for (unsigned int j = start; j < end; ++j)
+              *sum += vv_ptr[j] * vv_ptr[j];
+          })[0];
+        return Utilities::MPI::sum(norm_sqr, vv.get_mpi_communicator());
+      }
+    };
+
+
+
+    /**
+     * Orthogonalize the vector @p vv against the @p dim (orthogonal) vectors
+     * given by the first argument using the classical Gram-Schmidt
+     * algorithm. The factors used for orthogonalization are stored in @p h
+     * and the norm of the orthogonalized vector is returned.
+     *
+     * If @p reorthogonalize is true, the orthogonalization is done twice.
+     * Otherwise, loss of orthogonality is checked in every step by comparing
+     * the norm of @p vv before and after the orthogonalization, which is
+     * available at no additional cost. Once loss of orthogonality is
+     * detected, the flag is set to true and all subsequent steps use
+     * re-orthogonalization. In that case, the signal @p
+     * reorthogonalize_signal is called if it is connected.
+     */
+    template <typename VectorType>
+    double
+    iterated_classical_gram_schmidt(
+      const TmpVectors<VectorType> &            orthogonal_vectors,
+      const unsigned int                        dim,
+      const unsigned int                        accumulated_iterations,
+      VectorType &                              vv,
+      Vector<double> &                          h,
+      bool &                                    reorthogonalize,
+      const boost::signals2::signal<void(int)> &reorthogonalize_signal =
+        boost::signals2::signal<void(int)>());
   } // namespace SolverGMRESImplementation
 } // namespace internal
 
@@ -150,6 +378,19 @@ namespace internal
  * off between memory consumption and convergence speed, since a longer basis
  * means minimization over a larger space.
  *
+ *
+ * <h3>Orthogonalization of the Arnoldi basis</h3>
+ *
+ * Each new vector is orthogonalized against the Arnoldi basis with the
+ * algorithm selected by AdditionalData::orthogonalization_strategy. The
+ * modified Gram-Schmidt algorithm, the default, computes one inner product
+ * after the other, each of which is a global reduction in parallel. The
+ * classical Gram-Schmidt algorithm computes all inner products with the
+ * same vector, which is done in a single sweep through the basis and with a
+ * single global reduction for LinearAlgebra::distributed::Vector. Since the
+ * classical algorithm is less stable, the orthogonalization is repeated as
+ * soon as loss of orthogonality is detected.
+ *
  * For the requirements on matrices and vectors in order to work with this
  * class, see the documentation of the Solver base class.
  *
@@ -185,12 +426,17 @@ public:
      * Constructor. By default, set the number of temporary vectors to 30,
      * i.e. do a restart every 28 iterations. Also set preconditioning from
      * left, the residual of the stopping criterion to the default residual,
-     * and re-orthogonalization only if necessary.
+     * re-orthogonalization only if necessary, and the modified Gram-Schmidt
+     * algorithm for orthogonalization.
      */
-    explicit AdditionalData(const unsigned int max_n_tmp_vectors     = 30,
-                            const bool         right_preconditioning = false,
-                            const bool         use_default_residual  = true,
-                            const bool force_re_orthogonalization    = false);
+    explicit AdditionalData(
+      const unsigned int max_n_tmp_vectors          = 30,
+      const bool         right_preconditioning      = false,
+      const bool         use_default_residual       = true,
+      const bool         force_re_orthogonalization = false,
+      const LinearAlgebra::OrthogonalizationStrategy
+        orthogonalization_strategy =
+          LinearAlgebra::OrthogonalizationStrategy::modified_gram_schmidt);
 
     /**
      * Maximum number of temporary vectors. This parameter controls the size
@@ -218,9 +464,19 @@ public:
      * Flag to force re-orthogonalization of orthonormal basis in every step.
      * If set to false, the solver automatically checks for loss of
      * orthogonality every 5 iterations and enables re-orthogonalization only
-     * if necessary.
+     * if necessary. With the classical Gram-Schmidt algorithm, loss of
+     * orthogonality is checked in every iteration.
      */
     bool force_re_orthogonalization;
+
+    /**
+     * Strategy to orthogonalize the new vectors against the Arnoldi basis.
+     * The classical Gram-Schmidt algorithm needs a single global reduction
+     * per orthogonalization sweep rather than one per basis vector, which
+     * makes it the better choice in parallel computations and for long
+     * Arnoldi bases. See LinearAlgebra::OrthogonalizationStrategy.
+     */
+    LinearAlgebra::OrthogonalizationStrategy orthogonalization_strategy;
   };
 
   /**
@@ -466,16 +722,28 @@ public:
   struct AdditionalData
   {
     /**
-     * Constructor. By default, set the maximum basis size to 30.
+     * Constructor. By default, set the maximum basis size to 30 and use the
+     * modified Gram-Schmidt algorithm for orthogonalization.
      */
-    explicit AdditionalData(const unsigned int max_basis_size = 30)
+    explicit AdditionalData(
+      const unsigned int max_basis_size = 30,
+      const LinearAlgebra::OrthogonalizationStrategy
+        orthogonalization_strategy =
+          LinearAlgebra::OrthogonalizationStrategy::modified_gram_schmidt)
       : max_basis_size(max_basis_size)
+      , orthogonalization_strategy(orthogonalization_strategy)
     {}
 
     /**
      * Maximum basis size.
      */
     unsigned int max_basis_size;
+
+    /**
+     * Strategy to orthogonalize the new vectors against the basis. See
+     * LinearAlgebra::OrthogonalizationStrategy.
+     */
+    LinearAlgebra::OrthogonalizationStrategy orthogonalization_strategy;
   };
 
   /**
@@ -582,6 +850,67 @@ namespace internal
       return x.real() < y.real() ||
              (x.real() == y.real() && x.imag() < y.imag());
     }
+
+
+
+    template <typename VectorType>
+    double
+    iterated_classical_gram_schmidt(
+      const TmpVectors<VectorType> &            orthogonal_vectors,
+      const unsigned int                        dim,
+      const unsigned int                        accumulated_iterations,
+      VectorType &                              vv,
+      Vector<double> &                          h,
+      bool &                                    reorthogonalize,
+      const boost::signals2::signal<void(int)> &reorthogonalize_signal)
+    {
+      Assert(dim > 0, ExcInternalError());
+
+      const double norm_sqr_start =
+        BlockOperations<VectorType>::multi_dot(orthogonal_vectors,
+                                               dim,
+                                               vv,
+                                               h);
+      double norm_vv = std::sqrt(std::max(
+        BlockOperations<VectorType>::subtract_and_norm_sqr(orthogonal_vectors,
+                                                           dim,
+                                                           h,
+                                                           vv),
+        0.));
+
+      // Check for loss of orthogonality with the same criterion as in the
+      // modified Gram-Schmidt algorithm, see there. Since both norms are
+      // computed along with the other vector operations, the check can be
+      // done in every step.
+      if (reorthogonalize == false)
+        {
+          if (norm_vv >
+              10. * std::sqrt(norm_sqr_start) *
+                std::sqrt(std::numeric_limits<
+                          typename VectorType::value_type>::epsilon()))
+            return norm_vv;
+
+          reorthogonalize = true;
+          if (!reorthogonalize_signal.empty())
+            reorthogonalize_signal(accumulated_iterations);
+        }
+
+      Vector<double> h_correction(dim);
+      BlockOperations<VectorType>::multi_dot(orthogonal_vectors,
+                                             dim,
+                                             vv,
+                                             h_correction);
+      norm_vv = std::sqrt(std::max(
+        BlockOperations<VectorType>::subtract_and_norm_sqr(orthogonal_vectors,
+                                                           dim,
+                                                           h_correction,
+                                                           vv),
+        0.));
+      for (unsigned int i = 0; i < dim; ++i)
+        h(i) += h_correction(i);
+
+      return norm_vv;
+    }
   } // namespace SolverGMRESImplementation
 } // namespace internal
 
@@ -592,11 +921,13 @@ inline SolverGMRES<VectorType>::AdditionalData::AdditionalData(
   const unsigned int max_n_tmp_vectors,
   const bool         right_preconditioning,
   const bool         use_default_residual,
-  const bool         force_re_orthogonalization)
+  const bool         force_re_orthogonalization,
+  const LinearAlgebra::OrthogonalizationStrategy orthogonalization_strategy)
   : max_n_tmp_vectors(max_n_tmp_vectors)
   , right_preconditioning(right_preconditioning)
   , use_default_residual(use_default_residual)
   , force_re_orthogonalization(force_re_orthogonalization)
+  , orthogonalization_strategy(orthogonalization_strategy)
 {
   Assert(3 <= max_n_tmp_vectors,
          ExcMessage("SolverGMRES needs at least three "
@@ -943,13 +1274,25 @@ SolverGMRES<VectorType>::solve(const MatrixType &        A,
 
           dim = inner_iteration + 1;
 
-          const double s         = modified_gram_schmidt(tmp_vectors,
+          const double s =
+            (additional_data.orthogonalization_strategy ==
+                 LinearAlgebra::OrthogonalizationStrategy::
+                   classical_gram_schmidt ?
+               internal::SolverGMRESImplementation::
+                 iterated_classical_gram_schmidt(tmp_vectors,
                                                  dim,
                                                  accumulated_iterations,
                                                  vv,
                                                  h,
                                                  re_orthogonalize,
-                                                 re_orthogonalize_signal);
+                                                 re_orthogonalize_signal) :
+               modified_gram_schmidt(tmp_vectors,
+                                     dim,
+                                     accumulated_iterations,
+                                     vv,
+                                     h,
+                                     re_orthogonalize,
+                                     re_orthogonalize_signal));
           h(inner_iteration + 1) = s;
 
           // s=0 is a lucky breakdown, the solver will reach convergence,
@@ -1216,6 +1559,11 @@ SolverFGMRES<VectorType>::solve(const MatrixType &        A,
   Vector<double> projected_rhs;
   Vector<double> y;
 
+  // Orthogonalization coefficients and re-orthogonalization state of the
+  // classical Gram-Schmidt algorithm
+  Vector<double> h;
+  bool           re_orthogonalize = false;
+
   // Iteration starts here
   double res = std::numeric_limits<double>::lowest();
 
@@ -1247,10 +1595,29 @@ SolverFGMRES<VectorType>::solve(const MatrixType &        A,
           A.vmult(*aux, z[j]);
 
           // Gram-Schmidt
-          H(0, j) = *aux * v[0];
-          for (unsigned int i = 1; i <= j; ++i)
-            H(i, j) = aux->add_and_dot(-H(i - 1, j), v[i - 1], v[i]);
-          H(j + 1, j) = a = std::sqrt(aux->add_and_dot(-H(j, j), v[j], *aux));
+          if (additional_data.orthogonalization_strategy ==
+              LinearAlgebra::OrthogonalizationStrategy::classical_gram_schmidt)
+            {
+              h.reinit(j + 1);
+              a = internal::SolverGMRESImplementation::
+                iterated_classical_gram_schmidt(v,
+                                                j + 1,
+                                                accumulated_iterations,
+                                                *aux,
+                                                h,
+                                                re_orthogonalize);
+              for (unsigned int i = 0; i <= j; ++i)
+                H(i, j) = h(i);
+              H(j + 1, j) = a;
+            }
+          else
+            {
+              H(0, j) = *aux * v[0];
+              for (unsigned int i = 1; i <= j; ++i)
+                H(i, j) = aux->add_and_dot(-H(i - 1, j), v[i - 1], v[i]);
+              H(j + 1, j) = a =
+                std::sqrt(aux->add_and_dot(-H(j, j), v[j], *aux));
+            }
 
           // Compute projected solution
 
@@ -0,0 +1,627 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_solver_pipelined_cg_h
+#define dealii_solver_pipelined_cg_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/logstream.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/numbers.h>
+#include <deal.II/base/parallel.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/solver.h>
+#include <deal.II/lac/solver_control.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+namespace internal
+{
+  namespace SolverPipelinedCGImplementation
+  {
+    /**
+     * A set of scalar values, typically the local contributions to a number
+     * of inner products, that are summed over all processes of an MPI
+     * communicator with a single non-blocking reduction. The reduction is
+     * started by start() and must be completed by finish() before the
+     * values can be accessed.
+     */
+    template <typename Number>
+    class NonBlockingSum
+    {
+    public:
+      /**
+       * Constructor.
+       */
+      NonBlockingSum()
+#ifdef DEAL_II_WITH_MPI
+        : request(MPI_REQUEST_NULL)
+#endif
+      {}
+
+      /**
+       * Destructor. Waits for a reduction that is still in flight, as the
+       * buffer must not be released before.
+       */
+      ~NonBlockingSum()
+      {
+        finish();
+      }
+
+      /**
+       * Start the summation of @p values over all processes in @p comm.
+       */
+      void
+      start(const MPI_Comm &comm)
+      {
+#ifdef DEAL_II_WITH_MPI
+        Assert(request == MPI_REQUEST_NULL,
+               ExcMessage("A reduction is still in progress."));
+        if (Utilities::MPI::job_supports_mpi() &&
+            Utilities::MPI::n_mpi_processes(comm) > 1)
+          {
+            const int ierr =
+              MPI_Iallreduce(MPI_IN_PLACE,
+                             values.data(),
+                             values.size(),
+                             Utilities::MPI::mpi_type_id_for_type<Number>,
+                             MPI_SUM,
+                             comm,
+                             &request);
+            AssertThrowMPI(ierr);
+          }
+#else
+        (void)comm;
+#endif
+      }
+
+      /**
+       * Wait for the summation to complete and return the summed values.
+       */
+      const std::vector<Number> &
+      finish()
+      {
+#ifdef DEAL_II_WITH_MPI
+        if (request != MPI_REQUEST_NULL)
+          {
+            const int ierr = MPI_Wait(&request, MPI_STATUS_IGNORE);
+            AssertThrowMPI(ierr);
+          }
+#endif
+        return values;
+      }
+
+      /**
+       * The values to be summed, holding the local contributions before and
+       * the global sums after the reduction.
+       */
+      std::vector<Number> values;
+
+    private:
+#ifdef DEAL_II_WITH_MPI
+      /**
+       * The request of the reduction in progress, or MPI_REQUEST_NULL.
+       */
+      MPI_Request request;
+#endif
+    };
+
+
+
+    /**
+     * Vector operations of the pipelined and s-step variants of the
+     * conjugate gradient method. This general implementation relies on the
+     * interface of the vector class and computes the inner products with
+     * blocking reductions. Specializations for vector classes that give
+     * access to the locally owned entries merge the vector updates into a
+     * single sweep and postpone the reduction.
+     */
+    template <typename VectorType>
+    struct VectorOperations
+    {
+      using Number = typename VectorType::value_type;
+
+      /**
+       * Compute the inner products (r,u), (w,u), (r,r) of the pipelined CG
+       * method into @p sums.
+       */
+      static void
+      start_dot_products(const VectorType &      r,
+                         const VectorType &      u,
+                         const VectorType &      w,
+                         NonBlockingSum<Number> &sums)
+      {
+        sums.values = {r * u, w * u, r * r};
+      }
+
+      /**
+       * Perform the vector updates of one iteration of the pipelined CG
+       * method and start the inner products for the next iteration.
+       */
+      static void
+      update_and_start_dot_products(const Number            alpha,
+                                    const Number            beta,
+                                    const VectorType &      m,
+                                    const VectorType &      n,
+                                    VectorType &            z,
+                                    VectorType &            q,
+                                    VectorType &            s,
+                                    VectorType &            p,
+                                    VectorType &            x,
+                                    VectorType &            r,
+                                    VectorType &            u,
+                                    VectorType &            w,
+                                    NonBlockingSum<Number> &sums)
+      {
+        z.sadd(beta, 1., n);
+        q.sadd(beta, 1., m);
+        s.sadd(beta, 1., w);
+        p.sadd(beta, 1., u);
+        x.add(alpha, p);
+        r.add(-alpha, s);
+        u.add(-alpha, q);
+        w.add(-alpha, z);
+        start_dot_products(r, u, w, sums);
+      }
+
+      /**
+       * Compute the inner products between all vectors in @p left and
+       * @p right, with the entry `i * right.size() + j` of @p sums holding
+       * the product of `left[i]` and `right[j]`. Products with `j < i` are
+       * skipped if @p symmetric is set.
+       */
+      static void
+      start_gram_matrix(const std::vector<const VectorType *> &left,
+                        const std::vector<const VectorType *> &right,
+                        const bool                             symmetric,
+                        NonBlockingSum<Number> &               sums)
+      {
+        sums.values.assign(left.size() * right.size(), Number());
+        for (unsigned int i = 0; i < left.size(); ++i)
+          for (unsigned int j = (symmetric ? i : 0); j < right.size(); ++j)
+            sums.values[i * right.size() + j] = *left[i] * *right[j];
+      }
+    };
+
+
+
+    /**
+     * Specialization of the vector operations for
+     * LinearAlgebra::distributed::Vector on the host.
+     */
+    template <typename Number>
+    struct VectorOperations<
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::Host>>
+    {
+      using VectorType =
+        LinearAlgebra::distributed::Vector<Number, MemorySpace::Host>;
+
+      /**
+       * Number of vector entries processed as one unit by
+       * run_on_chunks(). Small enough that the vector entries of a chunk
+       * stay in the L1 cache between the updates and the inner products.
+       */
+      static constexpr unsigned int chunk_size = 512;
+
+      /**
+       * Split the locally owned range of length @p size into chunks of
+       * chunk_size entries and call @p kernel with the range of each chunk
+       * and a pointer to @p n_sums partial sums of that chunk, running the
+       * chunks in parallel for long vectors. The partial sums are then added
+       * into @p sums in the order of the chunks, which makes the result
+       * independent of the number of threads.
+       */
+      template <typename Kernel>
+      static void
+      run_on_chunks(const unsigned int   size,
+                    const unsigned int   n_sums,
+                    const Kernel &       kernel,
+                    std::vector<Number> &sums)
+      {
+        const unsigned int  n_chunks = (size + chunk_size - 1) / chunk_size;
+        std::vector<Number> partial_sums(n_chunks * n_sums, Number());
+        dealii::parallel::apply_to_subranges(
+          0U,
+          n_chunks,
+          [&](const unsigned int chunk_begin, const unsigned int chunk_end) {
+            for (unsigned int c = chunk_begin; c < chunk_end; ++c)
+              kernel(c * chunk_size,
+                     std::min(size, (c + 1) * chunk_size),
+                     partial_sums.data() + c * n_sums);
+          },
+          std::max<unsigned int>(
+            1,
+            internal::VectorImplementation::minimum_parallel_grain_size /
+              chunk_size));
+
+        sums.assign(n_sums, Number());
+        for (unsigned int c = 0; c < n_chunks; ++c)
+          for (unsigned int k = 0; k < n_sums; ++k)
+            sums[k] += partial_sums[c * n_sums + k];
+      }
+
+      static void
+      start_dot_products(const VectorType &      r,
+                         const VectorType &      u,
+                         const VectorType &      w,
+                         NonBlockingSum<Number> &sums)
+      {
+        const Number *r_ptr = r.begin();
+        const Number *u_ptr = u.begin();
+        const Number *w_ptr = w.begin();
+        run_on_chunks(
+          r.locally_owned_size(),
+          3,
+          [&](const unsigned int begin, const unsigned int end, Number *sum) {
+            for (unsigned int i = begin; i < end; ++i)
+              {
+                const Number u_conj =
+                  numbers::NumberTraits<Number>::conjugate(u_ptr[i]);
+                sum[0] += r_ptr[i] * u_conj;
+                sum[1] += w_ptr[i] * u_conj;
+                sum[2] +=
+                  r_ptr[i] * numbers::NumberTraits<Number>::conjugate(r_ptr[i]);
+              }
+          },
+          sums.values);
+        sums.start(r.get_mpi_communicator());
+      }
+
+      static void
+      update_and_start_dot_products(const Number            alpha,
+                                    const Number            beta,
+                                    const VectorType &      m,
+                                    const VectorType &      n,
+                                    VectorType &            z,
+                                    VectorType &            q,
+                                    VectorType &            s,
+                                    VectorType &            p,
+                                    VectorType &            x,
+                                    VectorType &            r,
+                                    VectorType &            u,
+                                    VectorType &            w,
+                                    NonBlockingSum<Number> &sums)
+      {
+        for (VectorType *v : {&z, &q, &s, &p, &x, &r, &u, &w})
+          if (v->has_ghost_elements())
+            v->zero_out_ghost_values();
+
+        const Number *m_ptr = m.begin();
+        const Number *n_ptr = n.begin();
+        Number *      z_ptr = z.begin();
+        Number *      q_ptr = q.begin();
+        Number *      s_ptr = s.begin();
+        Number *      p_ptr = p.begin();
+        Number *      x_ptr = x.begin();
+        Number *      r_ptr = r.begin();
+        Number *      u_ptr = u.begin();
+        Number *      w_ptr = w.begin();
+        run_on_chunks(
+          r.locally_owned_size(),
+          3,
+          [&](const unsigned int begin, const unsigned int end, Number *sum) {
+            for (unsigned int i = begin; i < end; ++i)
+              {
+                const Number z_i = n_ptr[i] + beta * z_ptr[i];
+                const Number q_i = m_ptr[i] + beta * q_ptr[i];
+                const Number s_i = w_ptr[i] + beta * s_ptr[i];
+                const Number p_i = u_ptr[i] + beta * p_ptr[i];
+                z_ptr[i]         = z_i;
+                q_ptr[i]         = q_i;
+                s_ptr[i]         = s_i;
+                p_ptr[i]         = p_i;
+                x_ptr[i] += alpha * p_i;
+                const Number r_i = r_ptr[i] - alpha * s_i;
+                const Number u_i = u_ptr[i] - alpha * q_i;
+                const Number w_i = w_ptr[i] - alpha * z_i;
+                r_ptr[i]         = r_i;
+                u_ptr[i]         = u_i;
+                w_ptr[i]         = w_i;
+
+                const Number u_conj =
+                  numbers::NumberTraits<Number>::conjugate(u_i);
+                sum[0] += r_i * u_conj;
+                sum[1] += w_i * u_conj;
+                sum[2] += r_i * numbers::NumberTraits<Number>::conjugate(r_i);
+              }
+          },
+          sums.values);
+        sums.start(r.get_mpi_communicator());
+      }
+
+      static void
+      start_gram_matrix(const std::vector<const VectorType *> &left,
+                        const std::vector<const VectorType *> &right,
+                        const bool                             symmetric,
+                        NonBlockingSum<Number> &               sums)
+      {
+        Assert(left.size() > 0 && right.size() > 0, ExcInternalError());
+        const unsigned int n_left  = left.size();
+        const unsigned int n_right = right.size();
+
+        // work on chunks of the vectors that fit into caches in order to
+        // read every vector entry only once from main memory
+        run_on_chunks(
+          left[0]->locally_owned_size(),
+          n_left * n_right,
+          [&](const unsigned int begin, const unsigned int end, Number *sum) {
+            for (unsigned int i = 0; i < n_left; ++i)
+              for (unsigned int j = (symmetric ? i : 0); j < n_right; ++j)
+                {
+                  const Number *a = left[i]->begin();
+                  const Number *b = right[j]->begin();
+                  for (unsigned int k = begin; k < end; ++k)
+                    sum[i * n_right + j] +=
+                      a[k] * numbers::NumberTraits<Number>::conjugate(b[k]);
+                }
+          },
+          sums.values);
+        sums.start(left[0]->get_mpi_communicator());
+      }
+    };
+  } // namespace SolverPipelinedCGImplementation
+} // namespace internal
+
+
+
+/*!@addtogroup Solvers */
+/*@{*/
+
+/**
+ * This class implements the pipelined preconditioned conjugate gradient
+ * method by P. Ghysels and W. Vanroose, "Hiding global synchronization
+ * latency in the preconditioned Conjugate Gradient algorithm", Parallel
+ * Computing 40(7), pp. 224-238, 2014. In exact arithmetic, the iterates are
+ * the same as the ones of SolverCG.
+ *
+ * The classical conjugate gradient method needs two global reductions per
+ * iteration, for the search direction product and for the residual norm,
+ * that separate the matrix-vector product and the preconditioner from the
+ * vector updates. On large parallel machines, the latency of these
+ * reductions eventually dominates the run time. The pipelined variant
+ * reformulates the recurrences with four additional auxiliary vectors such
+ * that all inner products of an iteration, including the residual norm used
+ * for the convergence test, are computed in a single reduction. That
+ * reduction is started before and completed after the application of the
+ * preconditioner and the matrix-vector product of the same iteration, so its
+ * latency can be hidden behind the work on the operator.
+ *
+ * For LinearAlgebra::distributed::Vector, the inner products are summed with
+ * a non-blocking `MPI_Iallreduce`, and the eight vector updates of an
+ * iteration are merged with the computation of the local inner products into
+ * a single sweep through memory. That sweep runs in parallel on chunks of the
+ * vectors, whose partial inner products are summed in a fixed order. Other
+ * vector types are supported through the generic vector interface, with
+ * blocking inner products.
+ *
+ * The price for the pipelining is a larger memory footprint of ten vectors
+ * and a reduced numerical stability in terms of the attainable accuracy,
+ * because the residual is updated by a recurrence rather than computed from
+ * its definition. Thus, this method is most useful for moderate tolerances
+ * on a large number of MPI processes.
+ *
+ * The convergence test is based on the norm of the unpreconditioned
+ * residual as in SolverCG. As the norm is computed along with the other
+ * inner products, it refers to the iterate before the update of the current
+ * iteration.
+ */
+template <typename VectorType = Vector<double>>
+class SolverPipelinedCG : public SolverBase<VectorType>
+{
+public:
+  /**
+   * Declare type for container size.
+   */
+  using size_type = types::global_dof_index;
+
+  /**
+   * Standardized data struct to pipe additional data to the solver.
+   * Here, it doesn't store anything but just exists for consistency
+   * with the other solver classes.
+   */
+  struct AdditionalData
+  {};
+
+  /**
+   * Constructor.
+   */
+  SolverPipelinedCG(SolverControl &           cn,
+                    VectorMemory<VectorType> &mem,
+                    const AdditionalData &    data = AdditionalData());
+
+  /**
+   * Constructor. Use an object of type GrowingVectorMemory as a default to
+   * allocate memory.
+   */
+  SolverPipelinedCG(SolverControl &       cn,
+                    const AdditionalData &data = AdditionalData());
+
+  /**
+   * Virtual destructor.
+   */
+  virtual ~SolverPipelinedCG() override = default;
+
+  /**
+   * Solve the linear system $Ax=b$ for x.
+   */
+  template <typename MatrixType, typename PreconditionerType>
+  void
+  solve(const MatrixType &        A,
+        VectorType &              x,
+        const VectorType &        b,
+        const PreconditionerType &preconditioner);
+
+protected:
+  /**
+   * Additional parameters.
+   */
+  AdditionalData additional_data;
+};
+
+/*@}*/
+
+/*------------------------- Implementation ----------------------------*/
+
+#ifndef DOXYGEN
+
+template <typename VectorType>
+SolverPipelinedCG<VectorType>::SolverPipelinedCG(
+  SolverControl &           cn,
+  VectorMemory<VectorType> &mem,
+  const AdditionalData &    data)
+  : SolverBase<VectorType>(cn, mem)
+  , additional_data(data)
+{}
+
+
+
+template <typename VectorType>
+SolverPipelinedCG<VectorType>::SolverPipelinedCG(SolverControl &       cn,
+                                                 const AdditionalData &data)
+  : SolverBase<VectorType>(cn)
+  , additional_data(data)
+{}
+
+
+
+template <typename VectorType>
+template <typename MatrixType, typename PreconditionerType>
+void
+SolverPipelinedCG<VectorType>::solve(const MatrixType &        A,
+                                     VectorType &              x,
+                                     const VectorType &        b,
+                                     const PreconditionerType &preconditioner)
+{
+  using number = typename VectorType::value_type;
+  using Operations =
+    internal::SolverPipelinedCGImplementation::VectorOperations<VectorType>;
+
+  SolverControl::State conv = SolverControl::iterate;
+
+  LogStream::Prefix prefix("pipelined_cg");
+
+  // Memory allocation, using the notation of the paper by Ghysels and
+  // Vanroose
+  typename VectorMemory<VectorType>::Pointer r_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer u_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer w_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer m_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer n_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer z_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer q_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer s_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer p_pointer(this->memory);
+
+  VectorType &r = *r_pointer;
+  VectorType &u = *u_pointer;
+  VectorType &w = *w_pointer;
+  VectorType &m = *m_pointer;
+  VectorType &n = *n_pointer;
+  VectorType &z = *z_pointer;
+  VectorType &q = *q_pointer;
+  VectorType &s = *s_pointer;
+  VectorType &p = *p_pointer;
+
+  // the vectors r, u, w, m, n are overwritten before they are used; the
+  // search directions are multiplied by beta=0 in the first iteration and
+  // must hence not contain invalid numbers
+  r.reinit(x, true);
+  u.reinit(x, true);
+  w.reinit(x, true);
+  m.reinit(x, true);
+  n.reinit(x, true);
+  z.reinit(x);
+  q.reinit(x);
+  s.reinit(x);
+  p.reinit(x);
+
+  // compute residual. if vector is zero, then short-circuit the full
+  // computation
+  if (!x.all_zero())
+    {
+      A.vmult(r, x);
+      r.sadd(-1., 1., b);
+    }
+  else
+    r.equ(1., b);
+
+  preconditioner.vmult(u, r);
+  A.vmult(w, u);
+
+  internal::SolverPipelinedCGImplementation::NonBlockingSum<number> sums;
+  Operations::start_dot_products(r, u, w, sums);
+
+  int    it        = 0;
+  double res       = 0;
+  number gamma_old = number();
+  number alpha     = number();
+
+  while (true)
+    {
+      // apply preconditioner and matrix while the reduction is in flight
+      preconditioner.vmult(m, w);
+      A.vmult(n, m);
+
+      const std::vector<number> &values = sums.finish();
+      const number               gamma  = values[0];
+      const number               delta  = values[1];
+      res                               = std::sqrt(std::abs(values[2]));
+
+      conv = this->iteration_status(it, res, x);
+      if (conv != SolverControl::iterate)
+        break;
+
+      number beta = number();
+      if (it > 0)
+        {
+          Assert(std::abs(gamma_old) != 0., ExcDivideByZero());
+          beta = gamma / gamma_old;
+          Assert(std::abs(alpha) != 0., ExcDivideByZero());
+          const number denominator = delta - beta * gamma / alpha;
+          Assert(std::abs(denominator) != 0., ExcDivideByZero());
+          alpha = gamma / denominator;
+        }
+      else
+        {
+          Assert(std::abs(delta) != 0., ExcDivideByZero());
+          alpha = gamma / delta;
+        }
+      gamma_old = gamma;
+
+      Operations::update_and_start_dot_products(
+        alpha, beta, m, n, z, q, s, p, x, r, u, w, sums);
+      ++it;
+    }
+
+  // in case of failure: throw exception
+  if (conv != SolverControl::success)
+    AssertThrow(false, SolverControl::NoConvergence(it, res));
+  // otherwise exit as normal
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -0,0 +1,375 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_solver_s_step_cg_h
+#define dealii_solver_s_step_cg_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/logstream.h>
+#include <deal.II/base/numbers.h>
+
+#include <deal.II/lac/solver.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/solver_pipelined_cg.h>
+
+#include <cmath>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+/*!@addtogroup Solvers */
+/*@{*/
+
+/**
+ * This class implements the s-step (or communication-avoiding) variant of
+ * the preconditioned conjugate gradient method as described, e.g., in
+ * A. T. Chronopoulos and C. W. Gear, "s-step iterative methods for
+ * symmetric linear systems", Journal of Computational and Applied
+ * Mathematics 25(2), pp. 153-168, 1989, and E. Carson, "Communication-avoiding
+ * Krylov subspace methods in theory and practice", PhD thesis, UC Berkeley,
+ * 2015. In exact arithmetic, the iterates are the same as the ones of
+ * SolverCG.
+ *
+ * Rather than performing two global reductions in each iteration, the
+ * method first builds a basis of the Krylov subspaces spanned by the
+ * current search direction and the preconditioned residual with $s$ and
+ * $s-1$ applications of the preconditioned operator, respectively. A single
+ * phase of global reductions then computes all inner products between the
+ * $2s+1$ basis vectors, from which the next $s$ iterations of the conjugate
+ * gradient method are carried out on small coefficient vectors without
+ * further communication. For LinearAlgebra::distributed::Vector, the inner
+ * products are computed by a cache-blocked loop over the basis vectors.
+ *
+ * The reduced number of global reductions comes at the price of about
+ * twice the number of matrix-vector products and preconditioner
+ * applications compared to SolverCG, and of $4s+5$ auxiliary vectors.
+ * Furthermore, the monomial basis becomes ill-conditioned quickly, which
+ * limits the step size @p s to small values, say up to 4 or 5. Thus, this
+ * method is most useful when the cost of the operator is small compared to
+ * the latency of global reductions, e.g. on coarse levels of a multigrid
+ * hierarchy on many MPI processes.
+ *
+ * The convergence test is based on the norm of the unpreconditioned
+ * residual, which is computed from the inner products of the basis in each
+ * inner iteration. This class only supports real-valued vectors.
+ */
+template <typename VectorType = Vector<double>>
+class SolverSStepCG : public SolverBase<VectorType>
+{
+public:
+  /**
+   * Declare type for container size.
+   */
+  using size_type = types::global_dof_index;
+
+  /**
+   * Standardized data struct to pipe additional data to the solver.
+   */
+  struct AdditionalData
+  {
+    /**
+     * Constructor. By default, four iterations are performed per global
+     * reduction.
+     */
+    explicit AdditionalData(const unsigned int s = 4)
+      : s(s)
+    {}
+
+    /**
+     * The number of conjugate gradient iterations between two global
+     * reductions.
+     */
+    unsigned int s;
+  };
+
+  /**
+   * Constructor.
+   */
+  SolverSStepCG(SolverControl &           cn,
+                VectorMemory<VectorType> &mem,
+                const AdditionalData &    data = AdditionalData());
+
+  /**
+   * Constructor. Use an object of type GrowingVectorMemory as a default to
+   * allocate memory.
+   */
+  SolverSStepCG(SolverControl &       cn,
+                const AdditionalData &data = AdditionalData());
+
+  /**
+   * Virtual destructor.
+   */
+  virtual ~SolverSStepCG() override = default;
+
+  /**
+   * Solve the linear system $Ax=b$ for x.
+   */
+  template <typename MatrixType, typename PreconditionerType>
+  void
+  solve(const MatrixType &        A,
+        VectorType &              x,
+        const VectorType &        b,
+        const PreconditionerType &preconditioner);
+
+protected:
+  /**
+   * Additional parameters.
+   */
+  AdditionalData additional_data;
+};
+
+/*@}*/
+
+/*------------------------- Implementation ----------------------------*/
+
+#ifndef DOXYGEN
+
+template <typename VectorType>
+SolverSStepCG<VectorType>::SolverSStepCG(SolverControl &           cn,
+                                         VectorMemory<VectorType> &mem,
+                                         const AdditionalData &    data)
+  : SolverBase<VectorType>(cn, mem)
+  , additional_data(data)
+{}
+
+
+
+template <typename VectorType>
+SolverSStepCG<VectorType>::SolverSStepCG(SolverControl &       cn,
+                                         const AdditionalData &data)
+  : SolverBase<VectorType>(cn)
+  , additional_data(data)
+{}
+
+
+
+template <typename VectorType>
+template <typename MatrixType, typename PreconditionerType>
+void
+SolverSStepCG<VectorType>::solve(const MatrixType &        A,
+                                 VectorType &              x,
+                                 const VectorType &        b,
+                                 const PreconditionerType &preconditioner)
+{
+  using number = typename VectorType::value_type;
+  using Operations =
+    internal::SolverPipelinedCGImplementation::VectorOperations<VectorType>;
+  static_assert(numbers::NumberTraits<number>::is_complex == false,
+                "SolverSStepCG only supports real-valued vectors.");
+
+  const unsigned int s = additional_data.s;
+  AssertThrow(s > 0, ExcMessage("The step size s must be positive."));
+
+  SolverControl::State conv = SolverControl::iterate;
+
+  LogStream::Prefix prefix("s_step_cg");
+
+  // The basis consists of the search direction p and its images under the
+  // preconditioned operator MA in the first s+1 slots and of the
+  // preconditioned residual u = Mr and its images in the remaining s slots.
+  // Along with each basis vector z, we keep M^{-1}z, which is the residual r
+  // for u and the matrix-vector product A z' for the images of z'. The
+  // vector M^{-1}p is propagated through the recurrence of p.
+  const unsigned int n_basis = 2 * s + 1;
+  std::vector<typename VectorMemory<VectorType>::Pointer> basis_pointers;
+  std::vector<typename VectorMemory<VectorType>::Pointer> basis_tilde_pointers;
+  std::vector<VectorType *>                               basis(n_basis);
+  std::vector<VectorType *>                               basis_tilde(n_basis);
+  basis_pointers.reserve(n_basis);
+  basis_tilde_pointers.reserve(n_basis);
+  for (unsigned int i = 0; i < n_basis; ++i)
+    {
+      basis_pointers.emplace_back(this->memory);
+      basis_tilde_pointers.emplace_back(this->memory);
+      basis[i]       = basis_pointers.back().get();
+      basis_tilde[i] = basis_tilde_pointers.back().get();
+      basis[i]->reinit(x, true);
+      basis_tilde[i]->reinit(x, true);
+    }
+
+  typename VectorMemory<VectorType>::Pointer r_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer u_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer p_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer p_tilde_pointer(this->memory);
+  VectorType &r       = *r_pointer;
+  VectorType &u       = *u_pointer;
+  VectorType &p       = *p_pointer;
+  VectorType &p_tilde = *p_tilde_pointer;
+  r.reinit(x, true);
+  u.reinit(x, true);
+  p.reinit(x, true);
+  p_tilde.reinit(x, true);
+
+  // compute residual. if vector is zero, then short-circuit the full
+  // computation
+  if (!x.all_zero())
+    {
+      A.vmult(r, x);
+      r.sadd(-1., 1., b);
+    }
+  else
+    r.equ(1., b);
+
+  int    it  = 0;
+  double res = r.l2_norm();
+  conv       = this->iteration_status(0, res, x);
+  if (conv != SolverControl::iterate)
+    return;
+
+  preconditioner.vmult(u, r);
+  p       = u;
+  p_tilde = r;
+
+  std::vector<const VectorType *> basis_const(basis.begin(), basis.end());
+  std::vector<const VectorType *> basis_tilde_const(basis_tilde.begin(),
+                                                    basis_tilde.end());
+
+  // inner products (M^{-1}z_i, z_j) and (M^{-1}z_i, M^{-1}z_j) of the basis
+  internal::SolverPipelinedCGImplementation::NonBlockingSum<number> gram,
+    gram_tilde;
+  std::vector<number> G(n_basis * n_basis), H(n_basis * n_basis);
+
+  // coefficients of the current vectors in terms of the basis
+  std::vector<number> c_p(n_basis), c_u(n_basis), c_x(n_basis),
+    c_tmp(n_basis);
+
+  const auto quadratic_form = [&](const std::vector<number> &matrix,
+                                  const std::vector<number> &v,
+                                  const std::vector<number> &w) {
+    number result = number();
+    for (unsigned int i = 0; i < n_basis; ++i)
+      for (unsigned int j = 0; j < n_basis; ++j)
+        result += v[i] * matrix[i * n_basis + j] * w[j];
+    return result;
+  };
+
+  // apply the preconditioned operator MA in terms of the basis, i.e., shift
+  // the coefficients of both Krylov sequences by one
+  const auto apply_shift = [&](const std::vector<number> &in,
+                               std::vector<number> &      out) {
+    std::fill(out.begin(), out.end(), number());
+    for (unsigned int j = 0; j < s; ++j)
+      out[j + 1] = in[j];
+    for (unsigned int j = s + 1; j < n_basis - 1; ++j)
+      out[j + 1] = in[j];
+    Assert(in[s] == number() && in[n_basis - 1] == number(),
+           ExcInternalError());
+  };
+
+  const auto combine = [&](const std::vector<VectorType *> &vectors,
+                           const std::vector<number> &      coefficients,
+                           VectorType &                     result) {
+    result.equ(coefficients[0], *vectors[0]);
+    for (unsigned int i = 1; i < n_basis; ++i)
+      if (coefficients[i] != number())
+        result.add(coefficients[i], *vectors[i]);
+  };
+
+  while (conv == SolverControl::iterate)
+    {
+      // build the Krylov basis
+      *basis[0]           = p;
+      *basis_tilde[0]     = p_tilde;
+      *basis[s + 1]       = u;
+      *basis_tilde[s + 1] = r;
+      for (unsigned int j = 0; j < s; ++j)
+        {
+          A.vmult(*basis_tilde[j + 1], *basis[j]);
+          preconditioner.vmult(*basis[j + 1], *basis_tilde[j + 1]);
+        }
+      for (unsigned int j = s + 1; j < n_basis - 1; ++j)
+        {
+          A.vmult(*basis_tilde[j + 1], *basis[j]);
+          preconditioner.vmult(*basis[j + 1], *basis_tilde[j + 1]);
+        }
+
+      // single phase of global reductions for the s iterations
+      Operations::start_gram_matrix(basis_tilde_const, basis_const, true, gram);
+      Operations::start_gram_matrix(basis_tilde_const,
+                                    basis_tilde_const,
+                                    true,
+                                    gram_tilde);
+      const std::vector<number> &gram_values       = gram.finish();
+      const std::vector<number> &gram_tilde_values = gram_tilde.finish();
+      for (unsigned int i = 0; i < n_basis; ++i)
+        for (unsigned int j = i; j < n_basis; ++j)
+          {
+            G[i * n_basis + j] = G[j * n_basis + i] =
+              gram_values[i * n_basis + j];
+            H[i * n_basis + j] = H[j * n_basis + i] =
+              gram_tilde_values[i * n_basis + j];
+          }
+
+      std::fill(c_p.begin(), c_p.end(), number());
+      std::fill(c_u.begin(), c_u.end(), number());
+      std::fill(c_x.begin(), c_x.end(), number());
+      c_p[0]     = 1.;
+      c_u[s + 1] = 1.;
+
+      number gamma = quadratic_form(G, c_u, c_u);
+      for (unsigned int j = 0; j < s; ++j)
+        {
+          apply_shift(c_p, c_tmp);
+          const number delta = quadratic_form(G, c_p, c_tmp);
+          Assert(std::abs(delta) != 0., ExcDivideByZero());
+          const number alpha = gamma / delta;
+
+          for (unsigned int i = 0; i < n_basis; ++i)
+            {
+              c_x[i] += alpha * c_p[i];
+              c_u[i] -= alpha * c_tmp[i];
+            }
+
+          ++it;
+          res  = std::sqrt(std::abs(quadratic_form(H, c_u, c_u)));
+          conv = this->iteration_status(it, res, x);
+          if (conv != SolverControl::iterate)
+            break;
+
+          const number gamma_new = quadratic_form(G, c_u, c_u);
+          Assert(std::abs(gamma) != 0., ExcDivideByZero());
+          const number beta = gamma_new / gamma;
+          gamma             = gamma_new;
+          for (unsigned int i = 0; i < n_basis; ++i)
+            c_p[i] = c_u[i] + beta * c_p[i];
+        }
+
+      // recover the vectors from their coefficients
+      for (unsigned int i = 0; i < n_basis; ++i)
+        if (c_x[i] != number())
+          x.add(c_x[i], *basis[i]);
+      if (conv != SolverControl::iterate)
+        break;
+      combine(basis, c_u, u);
+      combine(basis_tilde, c_u, r);
+      combine(basis, c_p, p);
+      combine(basis_tilde, c_p, p_tilde);
+    }
+
+  // in case of failure: throw exception
+  if (conv != SolverControl::success)
+    AssertThrow(false, SolverControl::NoConvergence(it, res));
+  // otherwise exit as normal
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
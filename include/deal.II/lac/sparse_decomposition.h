@@ -93,6 +93,11 @@ DEAL_II_NAMESPACE_OPEN
  * <code>*use_this_sparsity</code> is used to store the decomposed matrix. For
  * restrictions on the sparsity see section `Fill-in' above).
  *
+ * 5/ The forward and backward substitutions of the vmult() functions of
+ * derived classes work on one row after the other by default. Through
+ * <code>triangular_solve</code>, they can instead work on many rows in
+ * parallel, see the TriangularSolve enum.
+ *
  *
  * <h3>Particular implementations</h3>
  *
@@ -134,6 +139,42 @@ public:
   virtual void
   clear() override;
 
+  /**
+   * The ways in which the forward and backward substitutions with the
+   * triangular factors in the vmult() functions of derived classes are
+   * done. The transposed solves of the Tvmult() functions are always done
+   * one row after the other.
+   */
+  enum class TriangularSolve
+  {
+    /**
+     * Work on one row after the other.
+     */
+    sequential,
+    /**
+     * Group the rows into levels such that the rows of one level only
+     * depend on rows of earlier levels, and work on the rows of each level
+     * in parallel. The levels are computed from the sparsity pattern in
+     * initialize(). The result is exactly the one of the sequential
+     * substitution, but the speedup depends on the number of rows per
+     * level, i.e. on the numbering of the unknowns: a numbering in which
+     * many rows do not couple to rows with a smaller index, such as the one
+     * produced by DoFRenumbering::nested_dissection(), gives few and large
+     * levels, whereas the Cuthill-McKee numbering gives many small ones.
+     */
+    level_scheduled,
+    /**
+     * Replace each substitution by a fixed number of Jacobi iterations with
+     * the triangular factor, starting from the solution with the diagonal
+     * only. All rows of an iteration are worked on in parallel,
+     * independently of the numbering of the unknowns. The result is an
+     * approximation of the sequential substitution, which is exact if the
+     * number of iterations is at least the number of levels, and which
+     * gives a weaker preconditioner than the exact one otherwise.
+     */
+    jacobi_approximation
+  };
+
   /**
    * Parameters for SparseDecomposition.
    */
@@ -143,10 +184,13 @@ public:
     /**
      * Constructor. For the parameters' description, see below.
      */
-    AdditionalData(const double           strengthen_diagonal   = 0,
-                   const unsigned int     extra_off_diagonals   = 0,
-                   const bool             use_previous_sparsity = false,
-                   const SparsityPattern *use_this_sparsity     = nullptr);
+    AdditionalData(
+      const double           strengthen_diagonal   = 0,
+      const unsigned int     extra_off_diagonals   = 0,
+      const bool             use_previous_sparsity = false,
+      const SparsityPattern *use_this_sparsity     = nullptr,
+      const TriangularSolve  triangular_solve    = TriangularSolve::sequential,
+      const unsigned int     n_jacobi_iterations = 3);
 
     /**
      * <code>strengthen_diag</code> times the sum of absolute row entries is
@@ -189,6 +233,18 @@ public:
      * matrix.
      */
     const SparsityPattern *use_this_sparsity;
+
+    /**
+     * The way the triangular solves in vmult() are done. The default is to
+     * work on one row after the other.
+     */
+    TriangularSolve triangular_solve;
+
+    /**
+     * The number of Jacobi iterations per triangular solve if
+     * <code>triangular_solve</code> is TriangularSolve::jacobi_approximation.
+     */
+    unsigned int n_jacobi_iterations;
   };
 
   /**
@@ -318,11 +374,60 @@ protected:
   std::vector<const size_type *> prebuilt_lower_bound;
 
   /**
-   * Fills the #prebuilt_lower_bound array.
+   * Fills the #prebuilt_lower_bound array and, if the triangular solves are
+   * level scheduled, computes the levels of rows.
    */
   void
   prebuild_lower_bound();
 
+  /**
+   * Solve with the lower triangular factor, given by the entries left of
+   * the diagonal, in place: for each row, subtract the products of these
+   * entries with the entries of @p dst of their columns from the entry of
+   * the row, and multiply the result by <code>inverse_diagonal(row)</code>.
+   * The rows are worked on in the way given by #triangular_solve.
+   */
+  template <typename somenumber, typename InverseDiagonal>
+  void
+  lower_triangular_solve(Vector<somenumber> &   dst,
+                         const InverseDiagonal &inverse_diagonal) const;
+
+  /**
+   * The same as lower_triangular_solve() for the upper triangular factor,
+   * given by the entries right of the diagonal.
+   */
+  template <typename somenumber, typename InverseDiagonal>
+  void
+  upper_triangular_solve(Vector<somenumber> &   dst,
+                         const InverseDiagonal &inverse_diagonal) const;
+
+  /**
+   * The way the triangular solves are done, as given to initialize().
+   */
+  TriangularSolve triangular_solve;
+
+  /**
+   * The number of Jacobi iterations of
+   * TriangularSolve::jacobi_approximation.
+   */
+  unsigned int n_jacobi_iterations;
+
+  /**
+   * For level scheduled triangular solves, the rows of the lower triangular
+   * factor sorted by level, and the positions in this array at which each
+   * level starts. The last entry of the second array is the number of rows.
+   */
+  std::vector<size_type> lower_level_rows;
+  std::vector<size_type> lower_level_start;
+
+  /**
+   * The same as #lower_level_rows and #lower_level_start for the upper
+   * triangular factor, whose levels are worked on from the last row
+   * upwards.
+   */
+  std::vector<size_type> upper_level_rows;
+  std::vector<size_type> upper_level_start;
+
 private:
   /**
    * In general this pointer is zero except for the case that no
@@ -415,11 +520,15 @@ SparseLUDecomposition<number>::AdditionalData::AdditionalData(
   const double           strengthen_diag,
   const unsigned int     extra_off_diag,
   const bool             use_prev_sparsity,
-  const SparsityPattern *use_this_spars)
+  const SparsityPattern *use_this_spars,
+  const TriangularSolve  triangular_solve,
+  const unsigned int     n_jacobi_iterations)
   : strengthen_diagonal(strengthen_diag)
   , extra_off_diagonals(extra_off_diag)
   , use_previous_sparsity(use_prev_sparsity)
   , use_this_sparsity(use_this_spars)
+  , triangular_solve(triangular_solve)
+  , n_jacobi_iterations(n_jacobi_iterations)
 {}
 
 
@@ -21,13 +21,16 @@
 #include <deal.II/base/config.h>
 
 #include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/template_constraints.h>
 #include <deal.II/base/utilities.h>
 
 #include <deal.II/lac/sparse_decomposition.h>
+#include <deal.II/lac/vector.h>
 
 #include <algorithm>
 #include <cstring>
+#include <numeric>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -35,6 +38,8 @@ template <typename number>
 SparseLUDecomposition<number>::SparseLUDecomposition()
   : SparseMatrix<number>()
   , strengthen_diagonal(0)
+  , triangular_solve(TriangularSolve::sequential)
+  , n_jacobi_iterations(3)
   , own_sparsity(nullptr)
 {}
 
@@ -57,6 +62,11 @@ SparseLUDecomposition<number>::clear()
   std::vector<const size_type *> tmp;
   tmp.swap(prebuilt_lower_bound);
 
+  lower_level_rows.clear();
+  lower_level_start.clear();
+  upper_level_rows.clear();
+  upper_level_start.clear();
+
   SparseMatrix<number>::clear();
 
   if (own_sparsity != nullptr)
@@ -134,6 +144,9 @@ SparseLUDecomposition<number>::initialize(
     tmp.swap(prebuilt_lower_bound);
   }
   SparseMatrix<number>::reinit(*sparsity_pattern_to_use);
+
+  triangular_solve    = data.triangular_solve;
+  n_jacobi_iterations = data.n_jacobi_iterations;
 }
 
 
@@ -157,6 +170,239 @@ SparseLUDecomposition<number>::prebuild_lower_bound()
                                &column_numbers[rowstart_indices[row + 1]],
                                row);
     }
+
+  lower_level_rows.clear();
+  lower_level_start.clear();
+  upper_level_rows.clear();
+  upper_level_start.clear();
+  if (triangular_solve != TriangularSolve::level_scheduled)
+    return;
+
+  // the level of a row is one more than the largest level of the rows whose
+  // solution it needs, i.e., the columns of its entries left of the diagonal
+  // for the lower factor and right of the diagonal for the upper factor.
+  // sort the rows by level with a counting sort
+  std::vector<size_type> row_level(N);
+
+  const auto sort_by_level = [&](std::vector<size_type> &rows,
+                                 std::vector<size_type> &level_start) {
+    const size_type n_levels =
+      (N == 0 ? 0 : *std::max_element(row_level.begin(), row_level.end()) + 1);
+    level_start.assign(n_levels + 1, 0);
+    for (size_type row = 0; row < N; ++row)
+      ++level_start[row_level[row] + 1];
+    std::partial_sum(level_start.begin(),
+                     level_start.end(),
+                     level_start.begin());
+
+    std::vector<size_type> next_position(level_start.begin(),
+                                         level_start.end() - 1);
+    rows.resize(N);
+    for (size_type row = 0; row < N; ++row)
+      rows[next_position[row_level[row]]++] = row;
+  };
+
+  for (size_type row = 0; row < N; ++row)
+    {
+      size_type level = 0;
+      for (const size_type *col = &column_numbers[rowstart_indices[row] + 1];
+           col != prebuilt_lower_bound[row];
+           ++col)
+        level = std::max(level, row_level[*col] + 1);
+      row_level[row] = level;
+    }
+  sort_by_level(lower_level_rows, lower_level_start);
+
+  for (size_type r = 0; r < N; ++r)
+    {
+      const size_type row   = N - 1 - r;
+      size_type       level = 0;
+      for (const size_type *col = prebuilt_lower_bound[row];
+           col != &column_numbers[rowstart_indices[row + 1]];
+           ++col)
+        level = std::max(level, row_level[*col] + 1);
+      row_level[row] = level;
+    }
+  sort_by_level(upper_level_rows, upper_level_start);
+}
+
+
+
+template <typename number>
+template <typename somenumber, typename InverseDiagonal>
+void
+SparseLUDecomposition<number>::lower_triangular_solve(
+  Vector<somenumber> &   dst,
+  const InverseDiagonal &inverse_diagonal) const
+{
+  AssertDimension(dst.size(), this->m());
+
+  const size_type          N = this->m();
+  const std::size_t *const rowstart_indices =
+    this->get_sparsity_pattern().rowstart.get();
+  const size_type *const column_numbers =
+    this->get_sparsity_pattern().colnums.get();
+  const number *const values = this->SparseMatrix<number>::val.get();
+
+  // the entries left of the diagonal are the ones between the diagonal
+  // entry, which is stored first, and the first entry right of the diagonal
+  const auto solve_row = [&](const size_type           row,
+                             somenumber                dst_row,
+                             const Vector<somenumber> &solution) {
+    const size_type *const rowstart =
+      &column_numbers[rowstart_indices[row] + 1];
+    const number *luval = values + (rowstart - column_numbers);
+    for (const size_type *col = rowstart; col != prebuilt_lower_bound[row];
+         ++col, ++luval)
+      dst_row -= *luval * solution(*col);
+    return static_cast<somenumber>(dst_row * inverse_diagonal(row));
+  };
+
+  switch (triangular_solve)
+    {
+      case TriangularSolve::sequential:
+        for (size_type row = 0; row < N; ++row)
+          dst(row) = solve_row(row, dst(row), dst);
+        break;
+
+      case TriangularSolve::level_scheduled:
+        Assert(lower_level_start.size() > 0, ExcInternalError());
+        for (size_type level = 0; level + 1 < lower_level_start.size();
+             ++level)
+          parallel::apply_to_subranges(
+            lower_level_start[level],
+            lower_level_start[level + 1],
+            [&](const size_type begin, const size_type end) {
+              for (size_type i = begin; i < end; ++i)
+                {
+                  const size_type row = lower_level_rows[i];
+                  dst(row)            = solve_row(row, dst(row), dst);
+                }
+            },
+            256);
+        break;
+
+      case TriangularSolve::jacobi_approximation:
+        {
+          const Vector<somenumber> rhs(dst);
+          Vector<somenumber>       previous(N);
+          parallel::apply_to_subranges(
+            size_type(0),
+            N,
+            [&](const size_type begin, const size_type end) {
+              for (size_type row = begin; row < end; ++row)
+                dst(row) = rhs(row) * inverse_diagonal(row);
+            },
+            1024);
+          for (unsigned int it = 0; it < n_jacobi_iterations; ++it)
+            {
+              previous.swap(dst);
+              parallel::apply_to_subranges(
+                size_type(0),
+                N,
+                [&](const size_type begin, const size_type end) {
+                  for (size_type row = begin; row < end; ++row)
+                    dst(row) = solve_row(row, rhs(row), previous);
+                },
+                256);
+            }
+          break;
+        }
+
+      default:
+        Assert(false, ExcNotImplemented());
+    }
+}
+
+
+
+template <typename number>
+template <typename somenumber, typename InverseDiagonal>
+void
+SparseLUDecomposition<number>::upper_triangular_solve(
+  Vector<somenumber> &   dst,
+  const InverseDiagonal &inverse_diagonal) const
+{
+  AssertDimension(dst.size(), this->m());
+
+  const size_type          N = this->m();
+  const std::size_t *const rowstart_indices =
+    this->get_sparsity_pattern().rowstart.get();
+  const size_type *const column_numbers =
+    this->get_sparsity_pattern().colnums.get();
+  const number *const values = this->SparseMatrix<number>::val.get();
+
+  // the entries right of the diagonal run from the first one after the
+  // diagonal to the end of the row
+  const auto solve_row = [&](const size_type           row,
+                             somenumber                dst_row,
+                             const Vector<somenumber> &solution) {
+    const size_type *const rowend =
+      &column_numbers[rowstart_indices[row + 1]];
+    const number *luval = values + (prebuilt_lower_bound[row] - column_numbers);
+    for (const size_type *col = prebuilt_lower_bound[row]; col != rowend;
+         ++col, ++luval)
+      dst_row -= *luval * solution(*col);
+    return static_cast<somenumber>(dst_row * inverse_diagonal(row));
+  };
+
+  switch (triangular_solve)
+    {
+      case TriangularSolve::sequential:
+        for (size_type r = 0; r < N; ++r)
+          {
+            const size_type row = N - 1 - r;
+            dst(row)            = solve_row(row, dst(row), dst);
+          }
+        break;
+
+      case TriangularSolve::level_scheduled:
+        Assert(upper_level_start.size() > 0, ExcInternalError());
+        for (size_type level = 0; level + 1 < upper_level_start.size();
+             ++level)
+          parallel::apply_to_subranges(
+            upper_level_start[level],
+            upper_level_start[level + 1],
+            [&](const size_type begin, const size_type end) {
+              for (size_type i = begin; i < end; ++i)
+                {
+                  const size_type row = upper_level_rows[i];
+                  dst(row)            = solve_row(row, dst(row), dst);
+                }
+            },
+            256);
+        break;
+
+      case TriangularSolve::jacobi_approximation:
+        {
+          const Vector<somenumber> rhs(dst);
+          Vector<somenumber>       previous(N);
+          parallel::apply_to_subranges(
+            size_type(0),
+            N,
+            [&](const size_type begin, const size_type end) {
+              for (size_type row = begin; row < end; ++row)
+                dst(row) = rhs(row) * inverse_diagonal(row);
+            },
+            1024);
+          for (unsigned int it = 0; it < n_jacobi_iterations; ++it)
+            {
+              previous.swap(dst);
+              parallel::apply_to_subranges(
+                size_type(0),
+                N,
+                [&](const size_type begin, const size_type end) {
+                  for (size_type row = begin; row < end; ++row)
+                    dst(row) = solve_row(row, rhs(row), previous);
+                },
+                256);
+            }
+          break;
+        }
+
+      default:
+        Assert(false, ExcNotImplemented());
+    }
 }
 
 template <typename number>
@@ -239,7 +485,11 @@ std::size_t
 SparseLUDecomposition<number>::memory_consumption() const
 {
   return (SparseMatrix<number>::memory_consumption() +
-          MemoryConsumption::memory_consumption(prebuilt_lower_bound));
+          MemoryConsumption::memory_consumption(prebuilt_lower_bound) +
+          MemoryConsumption::memory_consumption(lower_level_rows) +
+          MemoryConsumption::memory_consumption(lower_level_start) +
+          MemoryConsumption::memory_consumption(upper_level_rows) +
+          MemoryConsumption::memory_consumption(upper_level_start));
 }
 
 
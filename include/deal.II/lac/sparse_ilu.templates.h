@@ -20,6 +20,7 @@
 
 #  include <deal.II/base/config.h>
 
+#  include <deal.II/lac/sparse_decomposition.templates.h>
 #  include <deal.II/lac/sparse_ilu.h>
 #  include <deal.II/lac/vector.h>
 
@@ -143,12 +144,6 @@ SparseILU<number>::vmult(Vector<somenumber> &      dst,
          ExcDimensionMismatch(dst.size(), src.size()));
   Assert(dst.size() == this->m(), ExcDimensionMismatch(dst.size(), this->m()));
 
-  const size_type          N = dst.size();
-  const std::size_t *const rowstart_indices =
-    this->get_sparsity_pattern().rowstart.get();
-  const size_type *const column_numbers =
-    this->get_sparsity_pattern().colnums.get();
-
   // solve LUx=b in two steps:
   // first Ly = b, then
   //       Ux = y
@@ -158,60 +153,17 @@ SparseILU<number>::vmult(Vector<somenumber> &      dst,
   // one, there holds
   // y_i = b_i
   //       - sum_{j=0}^{i-1} L_{ij}y_j
-  // we split the y_i = b_i off and
-  // perform it at the outset of the
-  // loop
   dst = src;
-  for (size_type row = 0; row < N; ++row)
-    {
-      // get start of this row. skip the
-      // diagonal element
-      const size_type *const rowstart =
-        &column_numbers[rowstart_indices[row] + 1];
-      // find the position where the part
-      // right of the diagonal starts
-      const size_type *const first_after_diagonal =
-        this->prebuilt_lower_bound[row];
-
-      somenumber    dst_row = dst(row);
-      const number *luval =
-        this->SparseMatrix<number>::val.get() + (rowstart - column_numbers);
-      for (const size_type *col = rowstart; col != first_after_diagonal;
-           ++col, ++luval)
-        dst_row -= *luval * dst(*col);
-      dst(row) = dst_row;
-    }
-
-  // now the backward solve. same
-  // procedure, but we need not set
-  // dst before, since this is already
-  // done.
-  //
-  // note that we need to scale now,
-  // since the diagonal is not equal to
-  // one now
-  for (int row = N - 1; row >= 0; --row)
-    {
-      // get end of this row
-      const size_type *const rowend =
-        &column_numbers[rowstart_indices[row + 1]];
-      // find the position where the part
-      // right of the diagonal starts
-      const size_type *const first_after_diagonal =
-        this->prebuilt_lower_bound[row];
-
-      somenumber    dst_row = dst(row);
-      const number *luval   = this->SparseMatrix<number>::val.get() +
-                            (first_after_diagonal - column_numbers);
-      for (const size_type *col = first_after_diagonal; col != rowend;
-           ++col, ++luval)
-        dst_row -= *luval * dst(*col);
-
-      // scale by the diagonal element.
-      // note that the diagonal element
-      // was stored inverted
-      dst(row) = dst_row * this->diag_element(row);
-    }
+  this->lower_triangular_solve(dst, [](const size_type) { return number(1.); });
+
+  // now the backward solve. note
+  // that we need to scale now,
+  // since the diagonal is not equal
+  // to one now. the diagonal
+  // element was stored inverted
+  this->upper_triangular_solve(dst, [this](const size_type row) {
+    return this->diag_element(row);
+  });
 }
 
 
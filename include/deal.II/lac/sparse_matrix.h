@@ -46,6 +46,8 @@ template <typename Matrix>
 class BlockMatrixBase;
 template <typename number>
 class SparseILU;
+template <typename number>
+class AssemblyScatterPlan;
 #    ifdef DEAL_II_WITH_MPI
 namespace Utilities
 {
@@ -1772,6 +1774,10 @@ private:
   template <typename>
   friend class SparseILU;
 
+  // To allow it to add into the value array directly.
+  template <typename>
+  friend class AssemblyScatterPlan;
+
   // To allow it calling private prepare_add() and prepare_set().
   template <typename>
   friend class BlockMatrixBase;
@@ -21,6 +21,7 @@
 
 #include <deal.II/base/memory_consumption.h>
 
+#include <deal.II/lac/sparse_decomposition.templates.h>
 #include <deal.II/lac/sparse_mic.h>
 #include <deal.II/lac/vector.h>
 
@@ -159,39 +160,20 @@ SparseMIC<number>::vmult(Vector<somenumber> &      dst,
   // strictly lower- and upper- diagonal parts of the system.
   //
   // Solve (X-L)X{-1}(X-U) x = b in 3 steps:
-  dst = src;
-  for (size_type row = 0; row < N; ++row)
-    {
-      // Now: (X-L)u = b
+  const auto inverse_diagonal = [this](const size_type row) {
+    return inv_diag[row];
+  };
 
-      // get start of this row. skip
-      // the diagonal element
-      for (typename SparseMatrix<number>::const_iterator p =
-             this->begin(row) + 1;
-           (p != this->end(row)) && (p->column() < row);
-           ++p)
-        dst(row) -= p->value() * dst(p->column());
-
-      dst(row) *= inv_diag[row];
-    }
+  // Now: (X-L)u = b
+  dst = src;
+  this->lower_triangular_solve(dst, inverse_diagonal);
 
   // Now: v = Xu
   for (size_type row = 0; row < N; ++row)
     dst(row) *= diag[row];
 
   // x = (X-U)v
-  for (int row = N - 1; row >= 0; --row)
-    {
-      // get end of this row
-      for (typename SparseMatrix<number>::const_iterator p =
-             this->begin(row) + 1;
-           p != this->end(row);
-           ++p)
-        if (p->column() > static_cast<size_type>(row))
-          dst(row) -= p->value() * dst(p->column());
-
-      dst(row) *= inv_diag[row];
-    }
+  this->upper_triangular_solve(dst, inverse_diagonal);
 }
 
 
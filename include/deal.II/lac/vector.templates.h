@@ -248,8 +248,8 @@ void
 Vector<Number>::reinit(const Vector<Number2> &v,
                        const bool             omit_zeroing_entries)
 {
-  do_reinit(v.size(), omit_zeroing_entries, false);
   thread_loop_partitioner = v.thread_loop_partitioner;
+  do_reinit(v.size(), omit_zeroing_entries, false);
 }
 
 
@@ -977,8 +977,6 @@ Vector<Number>::do_reinit(const size_type new_size,
       else
         {
           values.resize_fast(new_size);
-          if (!omit_zeroing_entries)
-            values.fill();
         }
     }
   else
@@ -986,13 +984,23 @@ Vector<Number>::do_reinit(const size_type new_size,
       // otherwise size() < new_size and we must allocate
       AlignedVector<Number> new_values;
       new_values.resize_fast(new_size);
-      if (!omit_zeroing_entries)
-        new_values.fill();
       new_values.swap(values);
     }
 
   if (reset_partitioner)
     maybe_reset_thread_partitioner();
+
+  // zero the entries with the thread partitioner of the other vector
+  // operations: for newly allocated memory, this is the first touch that
+  // places the pages close to the threads that work on them later
+  if (!omit_zeroing_entries && new_size > 0)
+    {
+      internal::VectorOperations::Vector_set<Number> setter(Number(), begin());
+      internal::VectorOperations::parallel_for(setter,
+                                               0,
+                                               new_size,
+                                               thread_loop_partitioner);
+    }
 }
 
 
@@ -21,6 +21,7 @@
 
 #include <deal.II/base/logstream.h>
 #include <deal.II/base/smartpointer.h>
+#include <deal.II/base/thread_local_storage.h>
 #include <deal.II/base/thread_management.h>
 
 #include <deal.II/lac/vector.h>
@@ -308,6 +309,24 @@ public:
  * GrowingVectorMemory object whenever needed without the performance penalty
  * of creating a new memory pool every time. A drawback of this policy is that
  * vectors once allocated are only released at the end of the program run.
+ *
+ * Access to this global pool is guarded by a mutex. If many threads request
+ * and return vectors at the same time, for example because each of them
+ * runs small local solves on its own cells or patches, they all wait for
+ * this mutex. For such uses, a GrowingVectorMemory object can be created
+ * with <code>use_thread_local_pool = true</code>, in which case it draws
+ * from a pool that belongs to the thread alloc() is called on and needs no
+ * synchronization. A vector that is returned on another thread than the one
+ * it was requested on goes into the pool of the returning thread. The unused
+ * vectors of a thread-local pool are handed out in the reverse order in
+ * which they were returned: in the typical pattern of iterative solvers,
+ * the vector returned last has the size needed next, so that reinitializing
+ * it does not allocate memory, and its memory is likely still in cache. The
+ * counters of a GrowingVectorMemory object itself are not synchronized in
+ * this mode, so every thread should create its own object, which is cheap.
+ *
+ * The pools keep statistics on how many requests could be served by an
+ * unused vector, see get_statistics().
  */
 template <typename VectorType = dealii::Vector<double>>
 class GrowingVectorMemory : public VectorMemory<VectorType>
@@ -319,11 +338,44 @@ public:
   using size_type = types::global_dof_index;
 
   /**
-   * Constructor.  The argument allows to preallocate a certain number of
-   * vectors. The default is not to do this.
+   * Statistics on the use of a memory pool.
+   */
+  struct Statistics
+  {
+    /**
+     * Constructor. Sets all counters to zero.
+     */
+    Statistics();
+
+    /**
+     * The number of calls to alloc() that were served by an unused vector
+     * of the pool.
+     */
+    std::size_t n_hits;
+
+    /**
+     * The number of calls to alloc() that had to create a new vector.
+     */
+    std::size_t n_misses;
+
+    /**
+     * The largest amount of memory, in bytes, held at any one time by the
+     * unused vectors of the pool, as measured when the vectors were
+     * returned to the pool.
+     */
+    std::size_t peak_bytes;
+  };
+
+  /**
+   * Constructor.  The first argument allows to preallocate a certain number
+   * of vectors. The default is not to do this. If @p use_thread_local_pool
+   * is true, the vectors are drawn from the pool of the thread that calls
+   * alloc() rather than from the pool shared by all threads, see the class
+   * documentation.
    */
-  GrowingVectorMemory(const size_type initial_size   = 0,
-                      const bool      log_statistics = false);
+  GrowingVectorMemory(const size_type initial_size          = 0,
+                      const bool      log_statistics        = false,
+                      const bool      use_thread_local_pool = false);
 
   /**
    * Destructor. The destructor also checks that all vectors that have been
@@ -375,17 +427,31 @@ public:
   free(const VectorType *const) override;
 
   /**
-   * Release all vectors that are not currently in use.
+   * Release all vectors that are not currently in use. This includes the
+   * thread-local pools of all threads, so this function must not be called
+   * while other threads request or return vectors.
    */
   static void
   release_unused_memory();
 
   /**
-   * Memory consumed by this class and all currently allocated vectors.
+   * Memory consumed by this class and all currently allocated vectors. If
+   * the current object uses thread-local pools, this is the memory of the
+   * unused vectors in the pool of the calling thread.
    */
   virtual std::size_t
   memory_consumption() const;
 
+  /**
+   * Return the statistics of the pool the current object draws from. For
+   * the pool shared by all threads, they include the use of the pool
+   * through all GrowingVectorMemory objects for the same vector type. For
+   * thread-local pools, they are the ones of the pool of the calling
+   * thread.
+   */
+  Statistics
+  get_statistics() const;
+
 private:
   /**
    * A type that describes this entries of an array that represents
@@ -424,6 +490,49 @@ private:
      * Pointer to the storage object
      */
     std::vector<entry_type> *data;
+
+    /**
+     * The memory of the unused vectors in #data.
+     */
+    std::size_t unused_bytes;
+
+    /**
+     * The statistics of this pool.
+     */
+    Statistics statistics;
+  };
+
+  /**
+   * The memory pool of one thread. It only stores the unused vectors: the
+   * ones in use are owned by the places that requested them until they are
+   * returned.
+   */
+  struct ThreadLocalPool
+  {
+    /**
+     * Standard constructor creating an empty pool.
+     */
+    ThreadLocalPool();
+
+    /**
+     * The pool owns its vectors and can therefore not be copied.
+     */
+    ThreadLocalPool(const ThreadLocalPool &) = delete;
+
+    /**
+     * The unused vectors, in the order in which they were returned.
+     */
+    std::vector<std::unique_ptr<VectorType>> unused_vectors;
+
+    /**
+     * The memory of the vectors in #unused_vectors.
+     */
+    std::size_t unused_bytes;
+
+    /**
+     * The statistics of this pool.
+     */
+    Statistics statistics;
   };
 
   /**
@@ -432,6 +541,12 @@ private:
   static Pool &
   get_pool();
 
+  /**
+   * Return the thread-local pools of all threads.
+   */
+  static Threads::ThreadLocalStorage<ThreadLocalPool> &
+  get_thread_local_pools();
+
   /**
    * Overall number of allocations. Only used for bookkeeping and to generate
    * output at the end of an object's lifetime.
@@ -449,6 +564,11 @@ private:
    */
   bool log_statistics;
 
+  /**
+   * Whether the current object draws from thread-local pools.
+   */
+  bool use_thread_local_pool;
+
   /**
    * Mutex to synchronize access to internal data of this object from multiple
    * threads.
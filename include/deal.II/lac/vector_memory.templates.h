@@ -23,6 +23,7 @@
 
 #include <deal.II/lac/vector_memory.h>
 
+#include <algorithm>
 #include <memory>
 
 DEAL_II_NAMESPACE_OPEN
@@ -38,14 +39,37 @@ GrowingVectorMemory<VectorType>::get_pool()
 
 
 
+template <typename VectorType>
+Threads::ThreadLocalStorage<
+  typename GrowingVectorMemory<VectorType>::ThreadLocalPool> &
+GrowingVectorMemory<VectorType>::get_thread_local_pools()
+{
+  static Threads::ThreadLocalStorage<
+    GrowingVectorMemory<VectorType>::ThreadLocalPool>
+    pools;
+  return pools;
+}
+
+
+
 template <typename VectorType>
 Threads::Mutex GrowingVectorMemory<VectorType>::mutex;
 
 
 
+template <typename VectorType>
+inline GrowingVectorMemory<VectorType>::Statistics::Statistics()
+  : n_hits(0)
+  , n_misses(0)
+  , peak_bytes(0)
+{}
+
+
+
 template <typename VectorType>
 inline GrowingVectorMemory<VectorType>::Pool::Pool()
   : data(nullptr)
+  , unused_bytes(0)
 {}
 
 
@@ -78,22 +102,48 @@ GrowingVectorMemory<VectorType>::Pool::initialize(const size_type size)
         {
           i->first  = false;
           i->second = std::make_unique<VectorType>();
+          unused_bytes += MemoryConsumption::memory_consumption(*i->second);
         }
+      statistics.peak_bytes = std::max(statistics.peak_bytes, unused_bytes);
     }
 }
 
 
+
+template <typename VectorType>
+inline GrowingVectorMemory<VectorType>::ThreadLocalPool::ThreadLocalPool()
+  : unused_bytes(0)
+{}
+
+
 template <typename VectorType>
 inline GrowingVectorMemory<VectorType>::GrowingVectorMemory(
   const size_type initial_size,
-  const bool      log_statistics)
+  const bool      log_statistics,
+  const bool      use_thread_local_pool)
 
   : total_alloc(0)
   , current_alloc(0)
   , log_statistics(log_statistics)
+  , use_thread_local_pool(use_thread_local_pool)
 {
-  std::lock_guard<std::mutex> lock(mutex);
-  get_pool().initialize(initial_size);
+  if (use_thread_local_pool)
+    {
+      ThreadLocalPool &pool = get_thread_local_pools().get();
+      while (pool.unused_vectors.size() < initial_size)
+        {
+          pool.unused_vectors.emplace_back(std::make_unique<VectorType>());
+          pool.unused_bytes +=
+            MemoryConsumption::memory_consumption(*pool.unused_vectors.back());
+        }
+      pool.statistics.peak_bytes =
+        std::max(pool.statistics.peak_bytes, pool.unused_bytes);
+    }
+  else
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      get_pool().initialize(initial_size);
+    }
 }
 
 
@@ -106,8 +156,17 @@ inline GrowingVectorMemory<VectorType>::~GrowingVectorMemory()
     {
       deallog << "GrowingVectorMemory:Overall allocated vectors: "
               << total_alloc << std::endl;
-      deallog << "GrowingVectorMemory:Maximum allocated vectors: "
-              << get_pool().data->size() << std::endl;
+      if (use_thread_local_pool)
+        {
+          const Statistics statistics = get_statistics();
+          deallog << "GrowingVectorMemory:Vectors reused from thread pool: "
+                  << statistics.n_hits << std::endl;
+          deallog << "GrowingVectorMemory:Vectors created in thread pool: "
+                  << statistics.n_misses << std::endl;
+        }
+      else
+        deallog << "GrowingVectorMemory:Maximum allocated vectors: "
+                << get_pool().data->size() << std::endl;
     }
 }
 
@@ -117,6 +176,26 @@ template <typename VectorType>
 inline VectorType *
 GrowingVectorMemory<VectorType>::alloc()
 {
+  if (use_thread_local_pool)
+    {
+      ++total_alloc;
+      ++current_alloc;
+
+      // hand out the vector returned last, if there is one
+      ThreadLocalPool &pool = get_thread_local_pools().get();
+      if (pool.unused_vectors.empty() == false)
+        {
+          ++pool.statistics.n_hits;
+          VectorType *v = pool.unused_vectors.back().release();
+          pool.unused_vectors.pop_back();
+          pool.unused_bytes -= MemoryConsumption::memory_consumption(*v);
+          return v;
+        }
+
+      ++pool.statistics.n_misses;
+      return new VectorType();
+    }
+
   std::lock_guard<std::mutex> lock(mutex);
 
   ++total_alloc;
@@ -130,11 +209,15 @@ GrowingVectorMemory<VectorType>::alloc()
       if (i->first == false)
         {
           i->first = true;
+          ++get_pool().statistics.n_hits;
+          get_pool().unused_bytes -=
+            MemoryConsumption::memory_consumption(*i->second);
           return i->second.get();
         }
     }
 
   // no free vector found, so let's just allocate a new one
+  ++get_pool().statistics.n_misses;
   get_pool().data->emplace_back(true, std::make_unique<VectorType>());
 
   return get_pool().data->back().second.get();
@@ -146,6 +229,20 @@ template <typename VectorType>
 inline void
 GrowingVectorMemory<VectorType>::free(const VectorType *const v)
 {
+  if (use_thread_local_pool)
+    {
+      Assert(current_alloc > 0,
+             typename VectorMemory<VectorType>::ExcNotAllocatedHere());
+      --current_alloc;
+
+      ThreadLocalPool &pool = get_thread_local_pools().get();
+      pool.unused_vectors.emplace_back(const_cast<VectorType *>(v));
+      pool.unused_bytes += MemoryConsumption::memory_consumption(*v);
+      pool.statistics.peak_bytes =
+        std::max(pool.statistics.peak_bytes, pool.unused_bytes);
+      return;
+    }
+
   std::lock_guard<std::mutex> lock(mutex);
 
   for (typename std::vector<entry_type>::iterator i = get_pool().data->begin();
@@ -156,6 +253,10 @@ GrowingVectorMemory<VectorType>::free(const VectorType *const v)
         {
           i->first = false;
           --current_alloc;
+          get_pool().unused_bytes += MemoryConsumption::memory_consumption(*v);
+          get_pool().statistics.peak_bytes =
+            std::max(get_pool().statistics.peak_bytes,
+                     get_pool().unused_bytes);
           return;
         }
     }
@@ -168,10 +269,15 @@ template <typename VectorType>
 inline void
 GrowingVectorMemory<VectorType>::release_unused_memory()
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  {
+    std::lock_guard<std::mutex> lock(mutex);
 
-  if (get_pool().data != nullptr)
-    get_pool().data->clear();
+    if (get_pool().data != nullptr)
+      get_pool().data->clear();
+    get_pool().unused_bytes = 0;
+  }
+
+  get_thread_local_pools().clear();
 }
 
 
@@ -180,6 +286,15 @@ template <typename VectorType>
 inline std::size_t
 GrowingVectorMemory<VectorType>::memory_consumption() const
 {
+  if (use_thread_local_pool)
+    {
+      const ThreadLocalPool &pool   = get_thread_local_pools().get();
+      std::size_t            result = sizeof(*this);
+      for (const auto &v : pool.unused_vectors)
+        result += sizeof(v) + MemoryConsumption::memory_consumption(*v);
+      return result;
+    }
+
   std::lock_guard<std::mutex> lock(mutex);
 
   std::size_t                                            result = sizeof(*this);
@@ -189,12 +304,25 @@ GrowingVectorMemory<VectorType>::memory_consumption() const
          get_pool().data->begin();
        i != end;
        ++i)
-    result += sizeof(*i) + MemoryConsumption::memory_consumption(i->second);
+    result += sizeof(*i) + MemoryConsumption::memory_consumption(*i->second);
 
   return result;
 }
 
 
+
+template <typename VectorType>
+inline typename GrowingVectorMemory<VectorType>::Statistics
+GrowingVectorMemory<VectorType>::get_statistics() const
+{
+  if (use_thread_local_pool)
+    return get_thread_local_pools().get().statistics;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  return get_pool().statistics;
+}
+
+
 DEAL_II_NAMESPACE_CLOSE
 
 #endif
@@ -262,6 +262,15 @@ namespace internal
       compute_cell_index_compression(
         const std::vector<unsigned char> &irregular_cells);
 
+      /**
+       * Sets up the compressed index storage @p dof_indices_compressed for
+       * the cells of type `IndexStorageVariants::interleaved`, provided
+       * that the element has several degrees of freedom on some geometric
+       * entity. Run at the end of compute_cell_index_compression().
+       */
+      void
+      compute_compressed_interleaved_indices();
+
       /**
        * Finds possible compression for the face indices that we can apply for
        * increased efficiency. Run at the end of reorder_cells.
@@ -555,6 +564,44 @@ namespace internal
        */
       std::vector<unsigned int> dof_indices_interleaved;
 
+      /**
+       * Compressed index storage for cells of type
+       * `IndexStorageVariants::interleaved`. For elements with more than one
+       * degree of freedom per geometric entity (vertex, line, quad, hex) and
+       * component, the indices on each entity are usually numbered
+       * consecutively in the same way on all cells. Rather than keeping one
+       * index per degree of freedom as in @p dof_indices_interleaved, this
+       * array only stores the first index of each entity group, interleaved
+       * over the lanes of the cell batch. The index of degree of freedom
+       * `i` on lane `v` is then given by
+       * `dof_indices_compressed[dof_indices_compressed_start[cell] +
+       * compressed_dof_groups[i] * n_lanes + v] + compressed_dof_offsets[i]`.
+       */
+      std::vector<unsigned int> dof_indices_compressed;
+
+      /**
+       * The position of the data of each cell batch in
+       * @p dof_indices_compressed. Batches that do not follow the common
+       * pattern of @p compressed_dof_offsets hold
+       * numbers::invalid_unsigned_int and are read through
+       * @p dof_indices_interleaved. Empty if no cell could be compressed.
+       */
+      std::vector<unsigned int> dof_indices_compressed_start;
+
+      /**
+       * For each degree of freedom on a cell, the index of the entity group
+       * (geometric entity and component) it belongs to in the compressed
+       * storage @p dof_indices_compressed.
+       */
+      std::vector<unsigned int> compressed_dof_groups;
+
+      /**
+       * For each degree of freedom on a cell, the offset of its index
+       * relative to the first index stored for its entity group in
+       * @p dof_indices_compressed.
+       */
+      std::vector<unsigned int> compressed_dof_offsets;
+
       /**
        * Compressed index storage for faster access than through @p
        * dof_indices used according to the description in IndexStorageVariants.
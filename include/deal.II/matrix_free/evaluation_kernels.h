@@ -769,6 +769,289 @@ namespace internal
 
 
 
+  /**
+   * Evaluation kernels for wedge elements whose shape functions are the
+   * product of shape functions on a triangle and on a line, using the data
+   * stored in MatrixFreeFunctions::WedgeShapeData. The triangle direction is
+   * applied as a dense matrix on each layer of the line, followed by the
+   * one-dimensional interpolation along the line. This reduces the cost per
+   * component from the $\mathcal O(k^6)$ of the dense tensor_none kernels to
+   * $\mathcal O(k^5)$ for polynomial degree $k$.
+   */
+  template <int dim, typename Number>
+  struct FEEvaluationImplWedge
+  {
+    static void
+    evaluate(const unsigned int                     n_components,
+             const EvaluationFlags::EvaluationFlags evaluation_flag,
+             const Number *                         values_dofs_actual,
+             FEEvaluationData<dim, Number, false> & fe_eval);
+
+    static void
+    integrate(const unsigned int                     n_components,
+              const EvaluationFlags::EvaluationFlags integration_flag,
+              Number *                               values_dofs_actual,
+              FEEvaluationData<dim, Number, false> & fe_eval,
+              const bool                             add_into_values_array);
+
+    /**
+     * Interpolate along the line: the input holds @p n_dofs_line layers of
+     * @p n_q_points_triangle values, the output @p n_q_points_line layers.
+     * For @p contract_over_rows equal to false, the transpose operation is
+     * applied.
+     */
+    template <bool contract_over_rows, bool add>
+    static void
+    apply_line(const Number *     shape,
+               const unsigned int n_dofs_line,
+               const unsigned int n_q_points_line,
+               const unsigned int n_q_points_triangle,
+               const Number *     in,
+               Number *           out)
+    {
+      const unsigned int n_in  = contract_over_rows ? n_dofs_line :
+                                                      n_q_points_line;
+      const unsigned int n_out = contract_over_rows ? n_q_points_line :
+                                                      n_dofs_line;
+      for (unsigned int o = 0; o < n_out; ++o)
+        {
+          Number *out_layer = out + o * n_q_points_triangle;
+          if (add == false)
+            for (unsigned int qt = 0; qt < n_q_points_triangle; ++qt)
+              out_layer[qt] = Number();
+          for (unsigned int i = 0; i < n_in; ++i)
+            {
+              const Number  weight = contract_over_rows ?
+                                       shape[i * n_q_points_line + o] :
+                                       shape[o * n_q_points_line + i];
+              const Number *in_layer = in + i * n_q_points_triangle;
+              for (unsigned int qt = 0; qt < n_q_points_triangle; ++qt)
+                out_layer[qt] += weight * in_layer[qt];
+            }
+        }
+    }
+  };
+
+
+
+  template <int dim, typename Number>
+  inline void
+  FEEvaluationImplWedge<dim, Number>::evaluate(
+    const unsigned int                     n_components,
+    const EvaluationFlags::EvaluationFlags evaluation_flag,
+    const Number *                         values_dofs_actual,
+    FEEvaluationData<dim, Number, false> & fe_eval)
+  {
+    const auto &wedge_data = fe_eval.get_shape_info().wedge_data;
+
+    const unsigned int n_dofs =
+      fe_eval.get_shape_info().dofs_per_component_on_cell;
+    const unsigned int n_q_points  = fe_eval.get_shape_info().n_q_points;
+    const unsigned int n_dofs_tri  = wedge_data.n_dofs_triangle;
+    const unsigned int n_dofs_line = wedge_data.n_dofs_line;
+    const unsigned int n_q_tri     = wedge_data.n_q_points_triangle;
+    const unsigned int n_q_line    = wedge_data.n_q_points_line;
+
+    AssertDimension(n_dofs, n_dofs_tri * n_dofs_line);
+    AssertDimension(n_q_points, n_q_tri * n_q_line);
+    Assert(n_dofs + n_dofs_line * n_q_tri <= fe_eval.get_scratch_data().size(),
+           ExcInternalError());
+
+    if (evaluation_flag & EvaluationFlags::hessians)
+      Assert(false, ExcNotImplemented());
+
+    Number *values_dofs = fe_eval.get_scratch_data().begin();
+    Number *temp        = values_dofs + n_dofs;
+
+    using Eval =
+      EvaluatorTensorProduct<evaluate_general, 1, 0, 0, Number, Number>;
+    const Eval eval_values(wedge_data.triangle_values.data(),
+                           nullptr,
+                           nullptr,
+                           n_dofs_tri,
+                           n_q_tri);
+    const Eval eval_grad_x(wedge_data.triangle_gradients.data(),
+                           nullptr,
+                           nullptr,
+                           n_dofs_tri,
+                           n_q_tri);
+    const Eval eval_grad_y(wedge_data.triangle_gradients.data() +
+                             n_dofs_tri * n_q_tri,
+                           nullptr,
+                           nullptr,
+                           n_dofs_tri,
+                           n_q_tri);
+
+    for (unsigned int c = 0; c < n_components; ++c)
+      {
+        for (unsigned int i = 0; i < n_dofs; ++i)
+          values_dofs[i] =
+            values_dofs_actual[c * n_dofs + wedge_data.dof_numbering[i]];
+
+        Number *values_quad    = fe_eval.begin_values() + c * n_q_points;
+        Number *gradients_quad =
+          fe_eval.begin_gradients() + c * dim * n_q_points;
+
+        // values and z derivative share the triangle interpolation
+        for (unsigned int l = 0; l < n_dofs_line; ++l)
+          eval_values.template values<0, true, false>(values_dofs +
+                                                        l * n_dofs_tri,
+                                                      temp + l * n_q_tri);
+        if (evaluation_flag & EvaluationFlags::values)
+          apply_line<true, false>(wedge_data.line_values.data(),
+                                  n_dofs_line,
+                                  n_q_line,
+                                  n_q_tri,
+                                  temp,
+                                  values_quad);
+        if (evaluation_flag & EvaluationFlags::gradients)
+          {
+            apply_line<true, false>(wedge_data.line_gradients.data(),
+                                    n_dofs_line,
+                                    n_q_line,
+                                    n_q_tri,
+                                    temp,
+                                    gradients_quad + 2 * n_q_points);
+
+            for (unsigned int d = 0; d < 2; ++d)
+              {
+                const Eval &eval = d == 0 ? eval_grad_x : eval_grad_y;
+                for (unsigned int l = 0; l < n_dofs_line; ++l)
+                  eval.template values<0, true, false>(values_dofs +
+                                                         l * n_dofs_tri,
+                                                       temp + l * n_q_tri);
+                apply_line<true, false>(wedge_data.line_values.data(),
+                                        n_dofs_line,
+                                        n_q_line,
+                                        n_q_tri,
+                                        temp,
+                                        gradients_quad + d * n_q_points);
+              }
+          }
+      }
+  }
+
+
+
+  template <int dim, typename Number>
+  inline void
+  FEEvaluationImplWedge<dim, Number>::integrate(
+    const unsigned int                     n_components,
+    const EvaluationFlags::EvaluationFlags integration_flag,
+    Number *                               values_dofs_actual,
+    FEEvaluationData<dim, Number, false> & fe_eval,
+    const bool                             add_into_values_array)
+  {
+    AssertThrow(!(integration_flag & EvaluationFlags::hessians),
+                ExcNotImplemented());
+
+    const auto &wedge_data = fe_eval.get_shape_info().wedge_data;
+
+    const unsigned int n_dofs =
+      fe_eval.get_shape_info().dofs_per_component_on_cell;
+    const unsigned int n_q_points  = fe_eval.get_shape_info().n_q_points;
+    const unsigned int n_dofs_tri  = wedge_data.n_dofs_triangle;
+    const unsigned int n_dofs_line = wedge_data.n_dofs_line;
+    const unsigned int n_q_tri     = wedge_data.n_q_points_triangle;
+    const unsigned int n_q_line    = wedge_data.n_q_points_line;
+
+    AssertDimension(n_dofs, n_dofs_tri * n_dofs_line);
+    AssertDimension(n_q_points, n_q_tri * n_q_line);
+    Assert(n_dofs + n_dofs_line * n_q_tri <= fe_eval.get_scratch_data().size(),
+           ExcInternalError());
+
+    Number *values_dofs = fe_eval.get_scratch_data().begin();
+    Number *temp        = values_dofs + n_dofs;
+
+    using Eval =
+      EvaluatorTensorProduct<evaluate_general, 1, 0, 0, Number, Number>;
+    const Eval eval_values(wedge_data.triangle_values.data(),
+                           nullptr,
+                           nullptr,
+                           n_dofs_tri,
+                           n_q_tri);
+    const Eval eval_grad_x(wedge_data.triangle_gradients.data(),
+                           nullptr,
+                           nullptr,
+                           n_dofs_tri,
+                           n_q_tri);
+    const Eval eval_grad_y(wedge_data.triangle_gradients.data() +
+                             n_dofs_tri * n_q_tri,
+                           nullptr,
+                           nullptr,
+                           n_dofs_tri,
+                           n_q_tri);
+
+    for (unsigned int c = 0; c < n_components; ++c)
+      {
+        Number *values_quad    = fe_eval.begin_values() + c * n_q_points;
+        Number *gradients_quad =
+          fe_eval.begin_gradients() + c * dim * n_q_points;
+
+        for (unsigned int i = 0; i < n_dofs; ++i)
+          values_dofs[i] = Number();
+
+        // values and z derivative share the triangle integration
+        if (integration_flag & EvaluationFlags::values)
+          apply_line<false, false>(wedge_data.line_values.data(),
+                                   n_dofs_line,
+                                   n_q_line,
+                                   n_q_tri,
+                                   values_quad,
+                                   temp);
+        if (integration_flag & EvaluationFlags::gradients)
+          {
+            if (integration_flag & EvaluationFlags::values)
+              apply_line<false, true>(wedge_data.line_gradients.data(),
+                                      n_dofs_line,
+                                      n_q_line,
+                                      n_q_tri,
+                                      gradients_quad + 2 * n_q_points,
+                                      temp);
+            else
+              apply_line<false, false>(wedge_data.line_gradients.data(),
+                                       n_dofs_line,
+                                       n_q_line,
+                                       n_q_tri,
+                                       gradients_quad + 2 * n_q_points,
+                                       temp);
+          }
+        if (integration_flag &
+            (EvaluationFlags::values | EvaluationFlags::gradients))
+          for (unsigned int l = 0; l < n_dofs_line; ++l)
+            eval_values.template values<0, false, true>(temp + l * n_q_tri,
+                                                        values_dofs +
+                                                          l * n_dofs_tri);
+
+        if (integration_flag & EvaluationFlags::gradients)
+          for (unsigned int d = 0; d < 2; ++d)
+            {
+              const Eval &eval = d == 0 ? eval_grad_x : eval_grad_y;
+              apply_line<false, false>(wedge_data.line_values.data(),
+                                       n_dofs_line,
+                                       n_q_line,
+                                       n_q_tri,
+                                       gradients_quad + d * n_q_points,
+                                       temp);
+              for (unsigned int l = 0; l < n_dofs_line; ++l)
+                eval.template values<0, false, true>(temp + l * n_q_tri,
+                                                     values_dofs +
+                                                       l * n_dofs_tri);
+            }
+
+        if (add_into_values_array)
+          for (unsigned int i = 0; i < n_dofs; ++i)
+            values_dofs_actual[c * n_dofs + wedge_data.dof_numbering[i]] +=
+              values_dofs[i];
+        else
+          for (unsigned int i = 0; i < n_dofs; ++i)
+            values_dofs_actual[c * n_dofs + wedge_data.dof_numbering[i]] =
+              values_dofs[i];
+      }
+  }
+
+
+
   template <int dim, int fe_degree, int n_q_points_1d, typename Number>
   inline void
   FEEvaluationImpl<
@@ -781,6 +1064,15 @@ namespace internal
                       const Number *                         values_dofs_actual,
                       FEEvaluationData<dim, Number, false> & fe_eval)
   {
+    if (fe_eval.get_shape_info().wedge_data.n_dofs_line > 0)
+      {
+        FEEvaluationImplWedge<dim, Number>::evaluate(n_components,
+                                                     evaluation_flag,
+                                                     values_dofs_actual,
+                                                     fe_eval);
+        return;
+      }
+
     const std::size_t n_dofs =
       fe_eval.get_shape_info().dofs_per_component_on_cell;
     const std::size_t n_q_points = fe_eval.get_shape_info().n_q_points;
@@ -851,6 +1143,16 @@ namespace internal
                        FEEvaluationData<dim, Number, false> &fe_eval,
                        const bool add_into_values_array)
   {
+    if (fe_eval.get_shape_info().wedge_data.n_dofs_line > 0)
+      {
+        FEEvaluationImplWedge<dim, Number>::integrate(n_components,
+                                                      integration_flag,
+                                                      values_dofs_actual,
+                                                      fe_eval,
+                                                      add_into_values_array);
+        return;
+      }
+
     // TODO: implement hessians
     AssertThrow(!(integration_flag & EvaluationFlags::hessians),
                 ExcNotImplemented());
@@ -3352,6 +3352,58 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
                             IndexStorageVariants::interleaved &&
       (has_hn_constraints == false))
     {
+      // Compressed storage with one index per geometric entity and lane,
+      // expand the indices of each degree of freedom on the fly
+      if (is_face == false &&
+          this->dof_info->dof_indices_compressed_start.empty() == false &&
+          this->dof_info->dof_indices_compressed_start[this->cell] !=
+            numbers::invalid_unsigned_int)
+        {
+          const unsigned int *group_starts =
+            this->dof_info->dof_indices_compressed.data() +
+            this->dof_info->dof_indices_compressed_start[this->cell];
+          const unsigned int first_dof =
+            this->dof_info
+              ->component_dof_indices_offset[this->active_fe_index]
+                                            [this->first_selected_component];
+          const unsigned int *groups =
+            this->dof_info->compressed_dof_groups.data() + first_dof;
+          const unsigned int *offsets =
+            this->dof_info->compressed_dof_offsets.data() + first_dof;
+
+          unsigned int dof_indices[n_lanes];
+          const auto   expand_indices = [&](const unsigned int i) {
+            const unsigned int *starts = group_starts + groups[i] * n_lanes;
+            DEAL_II_OPENMP_SIMD_PRAGMA
+            for (unsigned int v = 0; v < n_lanes; ++v)
+              dof_indices[v] = starts[v] + offsets[i];
+          };
+
+          if (n_components == 1 || this->n_fe_components == 1)
+            for (unsigned int i = 0; i < dofs_per_component; ++i)
+              {
+                expand_indices(i);
+                for (unsigned int comp = 0; comp < n_components; ++comp)
+                  operation.process_dof_gather(dof_indices,
+                                               *src[comp],
+                                               0,
+                                               values_dofs[comp][i],
+                                               vector_selector);
+              }
+          else
+            for (unsigned int comp = 0; comp < n_components; ++comp)
+              for (unsigned int i = 0; i < dofs_per_component; ++i)
+                {
+                  expand_indices(comp * dofs_per_component + i);
+                  operation.process_dof_gather(dof_indices,
+                                               *src[0],
+                                               0,
+                                               values_dofs[comp][i],
+                                               vector_selector);
+                }
+          return;
+        }
+
       const unsigned int *dof_indices =
         this->dof_info->dof_indices_interleaved.data() +
         this->dof_info->row_starts[this->cell * this->n_fe_components * n_lanes]
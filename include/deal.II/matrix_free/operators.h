@@ -33,6 +33,10 @@
 
 #include <deal.II/multigrid/mg_constrained_dofs.h>
 
+#include <algorithm>
+#include <cstring>
+#include <functional>
+
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -115,6 +119,15 @@ namespace MatrixFreeOperators
    * inverse_diagonal_entries and/or diagonal_entries. In case of a
    * non-symmetric operator, Tapply_add() should be additionally implemented.
    *
+   * The matrix-vector product can also be invoked with two functions that are
+   * run on sub-ranges of the locally owned vector entries before and after
+   * the operator touches them, see the vmult() variant with four arguments.
+   * This is the interface used by PreconditionChebyshev to merge its vector
+   * updates into the operator evaluation. In order to actually schedule the
+   * operations close to the cell integrals, a derived class should override
+   * apply_add_with_operations() and forward the two functions to
+   * MatrixFree::cell_loop(), as done by MassOperator and LaplaceOperator.
+   *
    * Currently, the only supported vectors are
    * LinearAlgebra::distributed::Vector and
    * LinearAlgebra::distributed::BlockVector.
@@ -314,6 +327,31 @@ namespace MatrixFreeOperators
     void
     vmult(VectorType &dst, const VectorType &src) const;
 
+    /**
+     * Matrix-vector multiplication that additionally runs the two given
+     * functions on sub-ranges of the locally owned entries of the vectors,
+     * given as half-open intervals in local index space. The function
+     * @p operation_before_matrix_vector_product is run on a range before the
+     * operator accesses the entries of @p src and @p dst in that range, and
+     * @p operation_after_matrix_vector_product once the operator does not
+     * access those entries any more. The entries of @p dst are set to zero
+     * before the first function is called on a range, and the result on the
+     * constrained degrees of freedom is completed before the second function
+     * is called.
+     *
+     * This interface is detected by PreconditionChebyshev, which merges its
+     * vector updates into the matrix-vector product for better cache usage.
+     *
+     * @note Only implemented for a single block.
+     */
+    void
+    vmult(VectorType &      dst,
+          const VectorType &src,
+          const std::function<void(const unsigned int, const unsigned int)>
+            &operation_before_matrix_vector_product,
+          const std::function<void(const unsigned int, const unsigned int)>
+            &operation_after_matrix_vector_product) const;
+
     /**
      * Transpose matrix-vector multiplication.
      */
@@ -423,6 +461,27 @@ namespace MatrixFreeOperators
     virtual void
     apply_add(VectorType &dst, const VectorType &src) const = 0;
 
+    /**
+     * Apply operator to @p src and add result in @p dst, running the
+     * operations @p operation_before_loop and @p operation_after_loop on
+     * sub-ranges of the locally owned vector entries as described for
+     * MatrixFree::cell_loop().
+     *
+     * The default implementation runs @p operation_before_loop on all
+     * locally owned entries, calls apply_add() and then runs
+     * @p operation_after_loop on all locally owned entries. Derived classes
+     * should pass the operations to MatrixFree::cell_loop() instead in order
+     * to benefit from the data locality.
+     */
+    virtual void
+    apply_add_with_operations(
+      VectorType &      dst,
+      const VectorType &src,
+      const std::function<void(const unsigned int, const unsigned int)>
+        &operation_before_loop,
+      const std::function<void(const unsigned int, const unsigned int)>
+        &operation_after_loop) const;
+
     /**
      * Apply transpose operator to @p src and add result in @p dst.
      *
@@ -806,6 +865,19 @@ namespace MatrixFreeOperators
     virtual void
     apply_add(VectorType &dst, const VectorType &src) const override;
 
+    /**
+     * Same as above, running the given operations on sub-ranges of the
+     * vectors inside MatrixFree::cell_loop().
+     */
+    virtual void
+    apply_add_with_operations(
+      VectorType &      dst,
+      const VectorType &src,
+      const std::function<void(const unsigned int, const unsigned int)>
+        &operation_before_loop,
+      const std::function<void(const unsigned int, const unsigned int)>
+        &operation_after_loop) const override;
+
     /**
      * For this operator, there is just a cell contribution.
      */
@@ -956,6 +1028,19 @@ namespace MatrixFreeOperators
     virtual void
     apply_add(VectorType &dst, const VectorType &src) const override;
 
+    /**
+     * Same as above, running the given operations on sub-ranges of the
+     * vectors inside MatrixFree::cell_loop().
+     */
+    virtual void
+    apply_add_with_operations(
+      VectorType &      dst,
+      const VectorType &src,
+      const std::function<void(const unsigned int, const unsigned int)>
+        &operation_before_loop,
+      const std::function<void(const unsigned int, const unsigned int)>
+        &operation_after_loop) const override;
+
     /**
      * Applies the Laplace operator on a cell.
      */
@@ -1404,6 +1489,89 @@ namespace MatrixFreeOperators
 
 
 
+  template <int dim, typename VectorType, typename VectorizedArrayType>
+  void
+  Base<dim, VectorType, VectorizedArrayType>::vmult(
+    VectorType &      dst,
+    const VectorType &src,
+    const std::function<void(const unsigned int, const unsigned int)>
+      &operation_before_matrix_vector_product,
+    const std::function<void(const unsigned int, const unsigned int)>
+      &operation_after_matrix_vector_product) const
+  {
+    using Number =
+      typename Base<dim, VectorType, VectorizedArrayType>::value_type;
+    AssertDimension(dst.size(), src.size());
+    AssertDimension(BlockHelper::n_blocks(dst), BlockHelper::n_blocks(src));
+    AssertDimension(BlockHelper::n_blocks(dst), selected_rows.size());
+    Assert(BlockHelper::n_blocks(dst) == 1,
+           ExcMessage("The matrix-vector product with operations on "
+                      "sub-ranges of the vectors is only implemented for "
+                      "a single block."));
+    adjust_ghost_range_if_necessary(src, false);
+    adjust_ghost_range_if_necessary(dst, true);
+
+    auto &dst_block = BlockHelper::subblock(dst, 0);
+    auto &src_block = BlockHelper::subblock(const_cast<VectorType &>(src), 0);
+
+    // set zero Dirichlet values on the input vector (and remember the src
+    // values because we need to reset them at the end)
+    const std::vector<unsigned int> &edge_indices = edge_constrained_indices[0];
+    for (unsigned int i = 0; i < edge_indices.size(); ++i)
+      {
+        edge_constrained_values[0][i] =
+          std::pair<Number, Number>(src_block.local_element(edge_indices[i]),
+                                    Number(0.));
+        src_block.local_element(edge_indices[i]) = 0.;
+      }
+
+    const std::vector<unsigned int> &constrained_dofs =
+      data->get_constrained_dofs(selected_rows[0]);
+
+    const auto operation_before_loop = [&](const unsigned int start_range,
+                                           const unsigned int end_range) {
+      if (end_range > start_range)
+        std::memset(dst_block.begin() + start_range,
+                    0,
+                    sizeof(Number) * (end_range - start_range));
+      if (operation_before_matrix_vector_product)
+        operation_before_matrix_vector_product(start_range, end_range);
+    };
+
+    // the constrained entries are not touched by the operator, so the
+    // identity on those entries can be applied on the same sub-range as the
+    // operation after the matrix-vector product. Both index lists are sorted.
+    const auto operation_after_loop = [&](const unsigned int start_range,
+                                          const unsigned int end_range) {
+      for (auto it = std::lower_bound(constrained_dofs.begin(),
+                                      constrained_dofs.end(),
+                                      start_range);
+           it != constrained_dofs.end() && *it < end_range;
+           ++it)
+        dst_block.local_element(*it) += src_block.local_element(*it);
+      for (auto it = std::lower_bound(edge_indices.begin(),
+                                      edge_indices.end(),
+                                      start_range);
+           it != edge_indices.end() && *it < end_range;
+           ++it)
+        {
+          const auto &values =
+            edge_constrained_values[0][it - edge_indices.begin()];
+          src_block.local_element(*it) = values.first;
+          dst_block.local_element(*it) = values.second + values.first;
+        }
+      if (operation_after_matrix_vector_product)
+        operation_after_matrix_vector_product(start_range, end_range);
+    };
+
+    apply_add_with_operations(dst,
+                              src,
+                              operation_before_loop,
+                              operation_after_loop);
+  }
+
+
+
   template <int dim, typename VectorType, typename VectorizedArrayType>
   void
   Base<dim, VectorType, VectorizedArrayType>::vmult_add(
@@ -1719,6 +1887,27 @@ namespace MatrixFreeOperators
 
 
 
+  template <int dim, typename VectorType, typename VectorizedArrayType>
+  void
+  Base<dim, VectorType, VectorizedArrayType>::apply_add_with_operations(
+    VectorType &      dst,
+    const VectorType &src,
+    const std::function<void(const unsigned int, const unsigned int)>
+      &operation_before_loop,
+    const std::function<void(const unsigned int, const unsigned int)>
+      &operation_after_loop) const
+  {
+    const unsigned int locally_owned_size =
+      BlockHelper::subblock(dst, 0).locally_owned_size();
+    if (operation_before_loop)
+      operation_before_loop(0U, locally_owned_size);
+    apply_add(dst, src);
+    if (operation_after_loop)
+      operation_after_loop(0U, locally_owned_size);
+  }
+
+
+
   template <int dim, typename VectorType, typename VectorizedArrayType>
   void
   Base<dim, VectorType, VectorizedArrayType>::precondition_Jacobi(
@@ -2037,6 +2226,39 @@ namespace MatrixFreeOperators
 
 
 
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename VectorType,
+            typename VectorizedArrayType>
+  void
+  MassOperator<dim,
+               fe_degree,
+               n_q_points_1d,
+               n_components,
+               VectorType,
+               VectorizedArrayType>::
+    apply_add_with_operations(
+      VectorType &      dst,
+      const VectorType &src,
+      const std::function<void(const unsigned int, const unsigned int)>
+        &operation_before_loop,
+      const std::function<void(const unsigned int, const unsigned int)>
+        &operation_after_loop) const
+  {
+    Base<dim, VectorType, VectorizedArrayType>::data->cell_loop(
+      &MassOperator::local_apply_cell,
+      this,
+      dst,
+      src,
+      operation_before_loop,
+      operation_after_loop,
+      this->selected_rows[0]);
+  }
+
+
+
   template <int dim,
             int fe_degree,
             int n_q_points_1d,
@@ -2231,6 +2453,39 @@ namespace MatrixFreeOperators
       &LaplaceOperator::local_apply_cell, this, dst, src);
   }
 
+
+
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename VectorType,
+            typename VectorizedArrayType>
+  void
+  LaplaceOperator<dim,
+                  fe_degree,
+                  n_q_points_1d,
+                  n_components,
+                  VectorType,
+                  VectorizedArrayType>::
+    apply_add_with_operations(
+      VectorType &      dst,
+      const VectorType &src,
+      const std::function<void(const unsigned int, const unsigned int)>
+        &operation_before_loop,
+      const std::function<void(const unsigned int, const unsigned int)>
+        &operation_after_loop) const
+  {
+    Base<dim, VectorType, VectorizedArrayType>::data->cell_loop(
+      &LaplaceOperator::local_apply_cell,
+      this,
+      dst,
+      src,
+      operation_before_loop,
+      operation_after_loop,
+      this->selected_rows[0]);
+  }
+
   namespace Implementation
   {
     template <typename VectorizedArrayType>
@@ -321,6 +321,94 @@ namespace internal
 
 
 
+    /**
+     * This struct stores a factorized view of shape functions on a wedge
+     * (prism) that can be written as the product of a shape function on a
+     * triangle and a shape function on a line, such as the Lagrange
+     * polynomials of FE_WedgeP. If additionally the quadrature formula is the
+     * tensor product of a triangle and a line quadrature formula (like
+     * QGaussWedge), FEEvaluation can evaluate and integrate by first applying
+     * the dense triangle matrices on each layer of the line and then the 1D
+     * matrices along the line, rather than multiplying with the full
+     * (dofs_per_cell x n_q_points) matrix of ElementType::tensor_none.
+     *
+     * Degrees of freedom are processed in the order <code>i_line *
+     * n_dofs_triangle + i_triangle</code>, quadrature points in the order
+     * <code>q_line * n_q_points_triangle + q_triangle</code>, matching the
+     * layout of QGaussWedge.
+     *
+     * @ingroup matrixfree
+     */
+    template <typename Number>
+    struct WedgeShapeData
+    {
+      /**
+       * Empty constructor. Sets all sizes to zero, which marks the
+       * factorization as unavailable.
+       */
+      WedgeShapeData();
+
+      /**
+       * Return the memory consumption of this class in bytes.
+       */
+      std::size_t
+      memory_consumption() const;
+
+      /**
+       * Number of shape functions of the triangle factor.
+       */
+      unsigned int n_dofs_triangle;
+
+      /**
+       * Number of shape functions of the line factor. A value of zero
+       * indicates that no factorization has been detected.
+       */
+      unsigned int n_dofs_line;
+
+      /**
+       * Number of quadrature points of the triangle factor.
+       */
+      unsigned int n_q_points_triangle;
+
+      /**
+       * Number of quadrature points of the line factor.
+       */
+      unsigned int n_q_points_line;
+
+      /**
+       * For each index <code>i_line * n_dofs_triangle + i_triangle</code>,
+       * the index of the respective shape function of the finite element.
+       */
+      std::vector<unsigned int> dof_numbering;
+
+      /**
+       * Shape values of the triangle factor with the quadrature points
+       * running fastest, <tt>n_dofs_triangle * n_q_points_triangle</tt>
+       * entries.
+       */
+      AlignedVector<Number> triangle_values;
+
+      /**
+       * Shape gradients of the triangle factor for the two directions of the
+       * triangle, stored one direction after the other in the layout of
+       * triangle_values.
+       */
+      AlignedVector<Number> triangle_gradients;
+
+      /**
+       * Shape values of the line factor with the quadrature points running
+       * fastest, <tt>n_dofs_line * n_q_points_line</tt> entries.
+       */
+      AlignedVector<Number> line_values;
+
+      /**
+       * Shape gradients of the line factor in the layout of line_values.
+       */
+      AlignedVector<Number> line_gradients;
+    };
+
+
+
     /**
      * This struct stores a tensor (Kronecker) product view of the finite
      * element and quadrature formula used for evaluation. It is based on a
@@ -413,6 +501,13 @@ namespace internal
        */
       std::vector<UnivariateShapeData<Number>> data;
 
+      /**
+       * Factorized representation of wedge elements. Only filled for
+       * ElementType::tensor_none with a wedge element and a quadrature
+       * formula that both have triangle-times-line product structure.
+       */
+      WedgeShapeData<Number> wedge_data;
+
       /**
        * Grants access to univariate shape function data of given
        * dimension and vector component. Rows identify dimensions and
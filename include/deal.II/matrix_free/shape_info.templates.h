@@ -63,6 +63,16 @@ namespace internal
 
 
 
+    template <typename Number>
+    WedgeShapeData<Number>::WedgeShapeData()
+      : n_dofs_triangle(0)
+      , n_dofs_line(0)
+      , n_q_points_triangle(0)
+      , n_q_points_line(0)
+    {}
+
+
+
     template <typename Number>
     Number
     get_first_array_element(const Number a)
@@ -172,6 +182,242 @@ namespace internal
 
 
 
+    template <int dim, int spacedim, typename Number>
+    void
+    compute_wedge_shape_data(const FiniteElement<dim, spacedim> &,
+                             const Quadrature<dim> &,
+                             WedgeShapeData<Number> &)
+    {
+      // no wedges in dim != 3
+    }
+
+
+
+    template <typename Number>
+    void
+    compute_wedge_shape_data(const FiniteElement<3, 3> &fe,
+                             const Quadrature<3> &      quad,
+                             WedgeShapeData<Number> &   wedge_data)
+    {
+      wedge_data = WedgeShapeData<Number>();
+
+      if (fe.reference_cell() != ReferenceCells::Wedge)
+        return;
+
+      const double       tol        = 1e-12;
+      const unsigned int n_dofs     = fe.n_dofs_per_cell();
+      const unsigned int n_q_points = quad.size();
+
+      // the quadrature formula must consist of layers of a triangle
+      // quadrature formula at the points of a line quadrature formula, with
+      // the triangle index running fastest
+      unsigned int n_q_points_triangle = 1;
+      while (n_q_points_triangle < n_q_points &&
+             std::abs(quad.point(n_q_points_triangle)[2] - quad.point(0)[2]) <
+               tol)
+        ++n_q_points_triangle;
+      if (n_q_points % n_q_points_triangle != 0)
+        return;
+      const unsigned int n_q_points_line = n_q_points / n_q_points_triangle;
+
+      for (unsigned int ql = 0, q = 0; ql < n_q_points_line; ++ql)
+        for (unsigned int qt = 0; qt < n_q_points_triangle; ++qt, ++q)
+          if (std::abs(quad.point(q)[0] - quad.point(qt)[0]) > tol ||
+              std::abs(quad.point(q)[1] - quad.point(qt)[1]) > tol ||
+              std::abs(quad.point(q)[2] -
+                       quad.point(ql * n_q_points_triangle)[2]) > tol)
+            return;
+
+      // Tabulate the shape functions in the quadrature points. If a shape
+      // function is the product of a triangle and a line factor, its values
+      // arranged as a matrix of line times triangle points have rank one,
+      // and the two factors are, up to scaling, the row and the column
+      // through the entry of largest magnitude. We deliberately do not use
+      // the support points, which FE_WedgeP only provides for degree one.
+      Table<2, double> values(n_dofs, n_q_points);
+      for (unsigned int i = 0; i < n_dofs; ++i)
+        for (unsigned int q = 0; q < n_q_points; ++q)
+          values(i, q) = fe.shape_value(i, quad.point(q));
+
+      // scale a factor such that its first entry of largest magnitude (up
+      // to roundoff) is one and return the index of that entry
+      const auto normalize = [](std::vector<double> &factor) {
+        unsigned int index = 0;
+        for (unsigned int j = 1; j < factor.size(); ++j)
+          if (std::abs(factor[j]) > std::abs(factor[index]) * (1. + 1e-10))
+            index = j;
+        const double scaling = factor[index];
+        for (double &entry : factor)
+          entry /= scaling;
+        return index;
+      };
+
+      const auto find_or_insert =
+        [tol](std::vector<std::vector<double>> &factors,
+              const std::vector<double> &       factor) -> unsigned int {
+        for (unsigned int f = 0; f < factors.size(); ++f)
+          {
+            bool same = true;
+            for (unsigned int j = 0; j < factor.size(); ++j)
+              if (std::abs(factors[f][j] - factor[j]) > 1e3 * tol)
+                same = false;
+            if (same)
+              return f;
+          }
+        factors.push_back(factor);
+        return factors.size() - 1;
+      };
+
+      std::vector<std::vector<double>> triangle_factors, line_factors;
+      std::vector<unsigned int> triangle_index(n_dofs), line_index(n_dofs);
+      std::vector<double>       scaling(n_dofs);
+      for (unsigned int i = 0; i < n_dofs; ++i)
+        {
+          unsigned int q_max = 0;
+          for (unsigned int q = 1; q < n_q_points; ++q)
+            if (std::abs(values(i, q)) > std::abs(values(i, q_max)))
+              q_max = q;
+          if (std::abs(values(i, q_max)) < tol)
+            return;
+
+          const unsigned int  ql_max = q_max / n_q_points_triangle;
+          const unsigned int  qt_max = q_max % n_q_points_triangle;
+          std::vector<double> triangle_factor(n_q_points_triangle);
+          std::vector<double> line_factor(n_q_points_line);
+          for (unsigned int qt = 0; qt < n_q_points_triangle; ++qt)
+            triangle_factor[qt] = values(i, ql_max * n_q_points_triangle + qt);
+          for (unsigned int ql = 0; ql < n_q_points_line; ++ql)
+            line_factor[ql] = values(i, ql * n_q_points_triangle + qt_max);
+
+          const unsigned int qt_ref = normalize(triangle_factor);
+          const unsigned int ql_ref = normalize(line_factor);
+          scaling[i] = values(i, ql_ref * n_q_points_triangle + qt_ref);
+          triangle_index[i] = find_or_insert(triangle_factors, triangle_factor);
+          line_index[i]     = find_or_insert(line_factors, line_factor);
+        }
+
+      const unsigned int n_dofs_triangle = triangle_factors.size();
+      const unsigned int n_dofs_line     = line_factors.size();
+      if (n_dofs_triangle * n_dofs_line != n_dofs)
+        return;
+
+      // the intermediate result after the triangle step must fit into the
+      // scratch data of FEEvaluation next to one component of the degrees
+      // of freedom
+      if (n_q_points_line < n_dofs_line)
+        return;
+
+      std::vector<unsigned int> dof_numbering(n_dofs,
+                                              numbers::invalid_unsigned_int);
+      for (unsigned int i = 0; i < n_dofs; ++i)
+        {
+          const unsigned int index =
+            line_index[i] * n_dofs_triangle + triangle_index[i];
+          if (dof_numbering[index] != numbers::invalid_unsigned_int)
+            return;
+          dof_numbering[index] = i;
+        }
+
+      // Distribute the scaling of the shape functions onto the two factors,
+      // choosing the first triangle factor to be unscaled. Then, compute
+      // the gradients of the factors by dividing the gradient of the wedge
+      // shape function by the value of the other factor at the point where
+      // the latter is largest.
+      Table<3, double> triangle_shapes(n_dofs_triangle, n_q_points_triangle, 3);
+      Table<3, double> line_shapes(n_dofs_line, n_q_points_line, 2);
+      for (unsigned int t = 0; t < n_dofs_triangle; ++t)
+        for (unsigned int qt = 0; qt < n_q_points_triangle; ++qt)
+          triangle_shapes(t, qt, 0) = triangle_factors[t][qt] *
+                                      scaling[dof_numbering[t]] /
+                                      scaling[dof_numbering[0]];
+      for (unsigned int l = 0; l < n_dofs_line; ++l)
+        for (unsigned int ql = 0; ql < n_q_points_line; ++ql)
+          line_shapes(l, ql, 0) =
+            line_factors[l][ql] * scaling[dof_numbering[l * n_dofs_triangle]];
+
+      std::vector<double> line_0(n_q_points_line);
+      std::vector<double> triangle_0(n_q_points_triangle);
+      for (unsigned int ql = 0; ql < n_q_points_line; ++ql)
+        line_0[ql] = line_shapes(0, ql, 0);
+      for (unsigned int qt = 0; qt < n_q_points_triangle; ++qt)
+        triangle_0[qt] = triangle_shapes(0, qt, 0);
+      const unsigned int ql_0         = normalize(line_0);
+      const unsigned int qt_0         = normalize(triangle_0);
+      const double       line_ref     = line_shapes(0, ql_0, 0);
+      const double       triangle_ref = triangle_shapes(0, qt_0, 0);
+
+      for (unsigned int t = 0; t < n_dofs_triangle; ++t)
+        for (unsigned int qt = 0; qt < n_q_points_triangle; ++qt)
+          {
+            const Tensor<1, 3> grad =
+              fe.shape_grad(dof_numbering[t],
+                            quad.point(ql_0 * n_q_points_triangle + qt));
+            triangle_shapes(t, qt, 1) = grad[0] / line_ref;
+            triangle_shapes(t, qt, 2) = grad[1] / line_ref;
+          }
+      for (unsigned int l = 0; l < n_dofs_line; ++l)
+        for (unsigned int ql = 0; ql < n_q_points_line; ++ql)
+          line_shapes(l, ql, 1) =
+            fe.shape_grad(dof_numbering[l * n_dofs_triangle],
+                          quad.point(ql * n_q_points_triangle + qt_0))[2] /
+            triangle_ref;
+
+      // verify that the product of the factors indeed reproduces the shape
+      // functions and their gradients in all quadrature points
+      for (unsigned int l = 0; l < n_dofs_line; ++l)
+        for (unsigned int t = 0; t < n_dofs_triangle; ++t)
+          for (unsigned int ql = 0; ql < n_q_points_line; ++ql)
+            for (unsigned int qt = 0; qt < n_q_points_triangle; ++qt)
+              {
+                const unsigned int i = dof_numbering[l * n_dofs_triangle + t];
+                const unsigned int q = ql * n_q_points_triangle + qt;
+                const double       value = fe.shape_value(i, quad.point(q));
+                const Tensor<1, 3> grad  = fe.shape_grad(i, quad.point(q));
+                const double       tv    = triangle_shapes(t, qt, 0);
+                const double       lv    = line_shapes(l, ql, 0);
+                if (std::abs(value - tv * lv) > 1e3 * tol ||
+                    std::abs(grad[0] - triangle_shapes(t, qt, 1) * lv) >
+                      1e3 * tol ||
+                    std::abs(grad[1] - triangle_shapes(t, qt, 2) * lv) >
+                      1e3 * tol ||
+                    std::abs(grad[2] - tv * line_shapes(l, ql, 1)) >
+                      1e3 * tol)
+                  return;
+              }
+
+      wedge_data.n_dofs_triangle     = n_dofs_triangle;
+      wedge_data.n_dofs_line         = n_dofs_line;
+      wedge_data.n_q_points_triangle = n_q_points_triangle;
+      wedge_data.n_q_points_line     = n_q_points_line;
+      wedge_data.dof_numbering       = dof_numbering;
+
+      const unsigned int size_triangle = n_dofs_triangle * n_q_points_triangle;
+      wedge_data.triangle_values.resize_fast(size_triangle);
+      wedge_data.triangle_gradients.resize_fast(2 * size_triangle);
+      for (unsigned int t = 0; t < n_dofs_triangle; ++t)
+        for (unsigned int qt = 0; qt < n_q_points_triangle; ++qt)
+          {
+            const unsigned int index = t * n_q_points_triangle + qt;
+            wedge_data.triangle_values[index] = triangle_shapes(t, qt, 0);
+            wedge_data.triangle_gradients[index] = triangle_shapes(t, qt, 1);
+            wedge_data.triangle_gradients[size_triangle + index] =
+              triangle_shapes(t, qt, 2);
+          }
+
+      wedge_data.line_values.resize_fast(n_dofs_line * n_q_points_line);
+      wedge_data.line_gradients.resize_fast(n_dofs_line * n_q_points_line);
+      for (unsigned int l = 0; l < n_dofs_line; ++l)
+        for (unsigned int ql = 0; ql < n_q_points_line; ++ql)
+          {
+            wedge_data.line_values[l * n_q_points_line + ql] =
+              line_shapes(l, ql, 0);
+            wedge_data.line_gradients[l * n_q_points_line + ql] =
+              line_shapes(l, ql, 1);
+          }
+    }
+
+
+
     template <int dim_to, int dim, int spacedim>
     std::unique_ptr<FiniteElement<dim_to, dim_to>>
     create_fe(const FiniteElement<dim, spacedim> &fe)
@@ -425,6 +671,8 @@ namespace internal
 
           univariate_shape_data.nodal_at_cell_boundaries = true;
 
+          compute_wedge_shape_data(fe, quad, wedge_data);
+
           // TODO: setup face_to_cell_index_nodal, face_to_cell_index_hermite,
           //  face_orientations
 
@@ -1167,6 +1415,22 @@ namespace internal
       std::size_t memory = sizeof(*this);
       for (const auto &univariate_shape_data : data)
         memory += univariate_shape_data.memory_consumption();
+      memory += wedge_data.memory_consumption();
+      return memory;
+    }
+
+
+
+    template <typename Number>
+    std::size_t
+    WedgeShapeData<Number>::memory_consumption() const
+    {
+      std::size_t memory = sizeof(*this);
+      memory += MemoryConsumption::memory_consumption(dof_numbering);
+      memory += MemoryConsumption::memory_consumption(triangle_values);
+      memory += MemoryConsumption::memory_consumption(triangle_gradients);
+      memory += MemoryConsumption::memory_consumption(line_values);
+      memory += MemoryConsumption::memory_consumption(line_gradients);
       return memory;
     }
 
@@ -18,12 +18,26 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/parallel.h>
+#include <deal.II/base/smartpointer.h>
+#include <deal.II/base/subscriptor.h>
+#include <deal.II/base/timer.h>
+#include <deal.II/base/utilities.h>
+
 #include <deal.II/grid/tria.h>
 
 #include <deal.II/matrix_free/fe_evaluation.h>
 #include <deal.II/matrix_free/matrix_free.h>
 #include <deal.II/matrix_free/vector_access_internal.h>
 
+#include <array>
+#include <fstream>
+#include <sstream>
+
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -157,6 +171,335 @@ namespace MatrixFreeTools
     const unsigned int first_selected_component = 0);
 
 
+  /**
+   * A block-Jacobi preconditioner with the cell blocks of a matrix-free
+   * operator, as typically used for discontinuous Galerkin discretizations
+   * of convection-diffusion problems where the inverse mass matrix of
+   * MatrixFreeOperators::CellwiseInverseMassMatrix is not a good enough
+   * approximation.
+   *
+   * The dense cell matrices are computed in initialize() by applying the
+   * local cell integral operation @p cell_operation (and optionally the
+   * face integral operation @p face_operation, see below) to the unit
+   * vectors on all cells of a cell batch at once, in the same way as in
+   * compute_matrix(). Rather than assembling them into a global sparse
+   * matrix, the matrices are factorized by an LU decomposition with
+   * partial pivoting that works on all lanes of a VectorizedArray at once,
+   * selecting the pivot separately for each lane. The function vmult()
+   * then applies the inverse of the cell blocks within a
+   * MatrixFree::cell_loop() with forward and backward substitution, again
+   * for all cells of a batch at once.
+   *
+   * For discontinuous elements, the diagonal block of the operator also
+   * contains the contributions of the face integrals that couple the
+   * unknowns of a cell with themselves. These are added by the face
+   * operation, which is called for each face of each cell in the
+   * cell-centric way with an FEFaceEvaluation object initialized by
+   * FEFaceEvaluation::reinit(cell, face) whose degrees of freedom contain
+   * the unit vector of the cell. It must evaluate the face integral of the
+   * interior side assuming a zero solution on the exterior side, and leave
+   * the integrated result in the degrees of freedom of the FEFaceEvaluation
+   * object, i.e., call FEFaceEvaluation::integrate() but not
+   * distribute_local_to_global(). This requires to set
+   * MatrixFree::AdditionalData::mapping_update_flags_faces_by_cells.
+   *
+   * For continuous elements, the blocks overlap and vmult() adds the
+   * contributions of the cells, i.e., it applies an additive Schwarz method
+   * with cell subdomains.
+   */
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d            = fe_degree + 1,
+            int n_components             = 1,
+            typename Number              = double,
+            typename VectorizedArrayType = VectorizedArray<Number>>
+  class CellwiseBlockJacobi : public Subscriptor
+  {
+  public:
+    using FEEvalType = FEEvaluation<dim,
+                                    fe_degree,
+                                    n_q_points_1d,
+                                    n_components,
+                                    Number,
+                                    VectorizedArrayType>;
+
+    using FEFaceEvalType = FEFaceEvaluation<dim,
+                                            fe_degree,
+                                            n_q_points_1d,
+                                            n_components,
+                                            Number,
+                                            VectorizedArrayType>;
+
+    /**
+     * Compute and factorize the cell blocks of the operator given by @p
+     * cell_operation and, if not empty, @p face_operation.
+     *
+     * The parameters @p dof_no, @p quad_no, and @p first_selected_component
+     * are passed to the constructor of the FEEvaluation and FEFaceEvaluation
+     * objects that are internally set up.
+     */
+    void
+    initialize(
+      const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+      const std::function<void(FEEvalType &)> &           cell_operation,
+      const std::function<void(FEFaceEvalType &)> &       face_operation =
+        std::function<void(FEFaceEvalType &)>(),
+      const unsigned int dof_no                   = 0,
+      const unsigned int quad_no                  = 0,
+      const unsigned int first_selected_component = 0);
+
+    /**
+     * Apply the inverse of the cell blocks to @p src and write the result
+     * into @p dst.
+     */
+    template <typename VectorType>
+    void
+    vmult(VectorType &dst, const VectorType &src) const;
+
+    /**
+     * Apply the inverse of the block of the cell batch @p cell to the
+     * degrees of freedom in @p in_array, in the numbering of FEEvaluation,
+     * and write the result to @p out_array. The two arrays may be the same.
+     * This allows to use the cell blocks within user-defined loops.
+     */
+    void
+    apply_inverse(const unsigned int         cell,
+                  const VectorizedArrayType *in_array,
+                  VectorizedArrayType *      out_array) const;
+
+    /**
+     * Return the memory consumption of this object in bytes.
+     */
+    std::size_t
+    memory_consumption() const;
+
+  private:
+    /**
+     * Pointer to the MatrixFree object passed to initialize().
+     */
+    SmartPointer<const MatrixFree<dim, Number, VectorizedArrayType>>
+      matrix_free;
+
+    /**
+     * The parameters passed to initialize().
+     */
+    unsigned int dof_no;
+    unsigned int quad_no;
+    unsigned int first_selected_component;
+
+    /**
+     * The number of degrees of freedom per cell, i.e., the size of the
+     * blocks.
+     */
+    unsigned int n_dofs_per_cell;
+
+    /**
+     * The LU factors of the blocks of all cell batches, stored row-wise in
+     * consecutive chunks of size n_dofs_per_cell^2. The unit diagonal of L is
+     * not stored, and the diagonal entries hold the inverse of the diagonal
+     * of U.
+     */
+    AlignedVector<VectorizedArrayType> lu_factors;
+
+    /**
+     * The row interchanges of the LU factorization for each cell batch and
+     * each lane, in the format of LAPACK's getrf: row @p k was interchanged
+     * with row <tt>pivots[(cell * n_dofs_per_cell + k) * n_lanes + v]</tt>
+     * in lane @p v.
+     */
+    std::vector<unsigned int> pivots;
+  };
+
+
+  /**
+   * A class that selects the fastest loop parameters of
+   * MatrixFree::AdditionalData for a given operator on the present machine.
+   * The user registers a set of candidate configurations, e.g. via
+   * add_default_candidates(), and then calls tune() with two functions: one
+   * that re-initializes the MatrixFree object (and everything depending on
+   * it) with a given configuration, and one that runs the operator of
+   * interest, typically a MatrixFree::cell_loop() or MatrixFree::loop(). Each
+   * candidate is timed over a number of repetitions after a warm-up run, the
+   * minimal time over the repetitions (of the maximum over all MPI ranks) is
+   * used to compare the candidates, and the fastest one is returned.
+   *
+   * Since the best choice depends on the machine and on the problem size but
+   * rarely changes between runs, the result can be stored in a cache file.
+   * The entries of the cache are keyed by the host name of the first MPI
+   * rank, the number of threads and MPI ranks, the width of the
+   * vectorization and a user-provided problem key, such as the number of
+   * degrees of freedom. Only the first rank reads and writes the file and
+   * broadcasts the cached configuration to the other ranks, so the file
+   * needs to be accessible on the node of the first rank only. The cached
+   * parameters are MatrixFree::AdditionalData::tasks_parallel_scheme,
+   * MatrixFree::AdditionalData::tasks_block_size,
+   * MatrixFree::AdditionalData::overlap_communication_computation,
+   * MatrixFree::AdditionalData::cell_vectorization_categories_strict and
+   * whether MatrixFree::AdditionalData::cell_vectorization_category is used.
+   * In the latter case, the categories are taken from the first candidate
+   * that sets them; all other fields are taken from the first candidate.
+   *
+   * A typical use looks as follows:
+   * @code
+   * MatrixFreeTools::LoopParameterTuner<dim, double> tuner(MPI_COMM_WORLD);
+   * tuner.add_default_candidates(additional_data);
+   * additional_data = tuner.tune(
+   *   [&](const auto &data) {
+   *     matrix_free.reinit(mapping, dof_handler, constraints, quad, data);
+   *     matrix_free.initialize_dof_vector(src);
+   *     matrix_free.initialize_dof_vector(dst);
+   *   },
+   *   [&]() { laplace_operator.vmult(dst, src); },
+   *   "tuning_cache.txt",
+   *   std::to_string(dof_handler.n_dofs()));
+   * @endcode
+   */
+  template <int dim,
+            typename Number,
+            typename VectorizedArrayType = VectorizedArray<Number>>
+  class LoopParameterTuner
+  {
+  public:
+    using AdditionalData =
+      typename MatrixFree<dim, Number, VectorizedArrayType>::AdditionalData;
+
+    /**
+     * Constructor. The timings are synchronized over the ranks of the
+     * communicator @p comm, which must be the communicator of the MatrixFree
+     * object.
+     */
+    LoopParameterTuner(const MPI_Comm &   comm          = MPI_COMM_SELF,
+                       const unsigned int n_repetitions = 10);
+
+    /**
+     * Add a candidate configuration.
+     */
+    void
+    add_candidate(const AdditionalData &additional_data);
+
+    /**
+     * Add the cross product of the task parallel schemes
+     * MatrixFree::AdditionalData::partition_partition and
+     * MatrixFree::AdditionalData::partition_color (or only
+     * MatrixFree::AdditionalData::none if a single thread is used), the given
+     * @p block_sizes, and enabled/disabled overlap of communication and
+     * computation. If @p base sets
+     * MatrixFree::AdditionalData::cell_vectorization_category, the
+     * categories are additionally tried in strict and non-strict mode as well
+     * as not at all, since grouping cells by category restricts the
+     * vectorization and its benefit depends on the operator. All other
+     * settings are taken from @p base.
+     */
+    void
+    add_default_candidates(
+      const AdditionalData &           base,
+      const std::vector<unsigned int> &block_sizes = {0, 8, 32, 128});
+
+    /**
+     * Return the candidates registered so far.
+     */
+    const std::vector<AdditionalData> &
+    get_candidates() const;
+
+    /**
+     * Run the tuning. For each candidate, @p reinit is called with the
+     * configuration, and @p run_operator is executed once for warm-up and
+     * then the given number of repetitions. Return the fastest configuration,
+     * which is also the configuration the last call to @p reinit was made
+     * with, so that the user objects are ready to use.
+     *
+     * If @p cache_file is non-empty and contains an entry for the present
+     * machine and @p problem_key, no timings are taken and the cached
+     * configuration is returned after calling @p reinit with it. Otherwise,
+     * the result of the tuning is appended to the file by the first rank of
+     * the communicator. The @p problem_key must not contain white space and
+     * must be the same on all ranks.
+     */
+    AdditionalData
+    tune(const std::function<void(const AdditionalData &)> &reinit,
+         const std::function<void()> &                      run_operator,
+         const std::string &                                cache_file  = "",
+         const std::string &                                problem_key = "");
+
+    /**
+     * Return the timings of the candidates in seconds as measured by the
+     * last call to tune(). Empty if the last result was found in the cache.
+     */
+    const std::vector<double> &
+    get_timings() const;
+
+    /**
+     * Return the key under which the results for @p problem_key are stored
+     * in the cache file on the present machine. The host name is the one of
+     * the first rank of the communicator, so this function must be called
+     * on all ranks.
+     */
+    std::string
+    get_cache_key(const std::string &problem_key) const;
+
+  private:
+    /**
+     * The parameters stored in the cache file, in the order
+     * tasks_parallel_scheme, tasks_block_size,
+     * overlap_communication_computation,
+     * cell_vectorization_categories_strict, and whether
+     * cell_vectorization_category is used.
+     */
+    using CachedParameters = std::array<unsigned int, 5>;
+
+    /**
+     * Extract the cached parameters from @p additional_data.
+     */
+    static CachedParameters
+    get_parameters(const AdditionalData &additional_data);
+
+    /**
+     * Write the cached @p parameters to @p additional_data.
+     */
+    void
+    set_parameters(const CachedParameters &parameters,
+                   AdditionalData &        additional_data) const;
+
+    /**
+     * Look up @p key in @p cache_file and, if found, write the parameters to
+     * @p parameters. Return whether an entry was found.
+     */
+    static bool
+    read_from_cache(const std::string &cache_file,
+                    const std::string &key,
+                    CachedParameters & parameters);
+
+    /**
+     * Append the @p parameters under @p key to @p cache_file.
+     */
+    static void
+    write_to_cache(const std::string &     cache_file,
+                   const std::string &     key,
+                   const CachedParameters &parameters);
+
+    /**
+     * The communicator used for synchronizing the timings.
+     */
+    const MPI_Comm comm;
+
+    /**
+     * Number of timed runs per candidate.
+     */
+    const unsigned int n_repetitions;
+
+    /**
+     * The candidate configurations.
+     */
+    std::vector<AdditionalData> candidates;
+
+    /**
+     * The timings of the last call to tune().
+     */
+    std::vector<double> timings;
+  };
+
+
+
   // implementations
 
 #ifndef DOXYGEN
@@ -1142,6 +1485,532 @@ namespace MatrixFreeTools
       first_selected_component);
   }
 
+
+
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename Number,
+            typename VectorizedArrayType>
+  void
+  CellwiseBlockJacobi<dim,
+                      fe_degree,
+                      n_q_points_1d,
+                      n_components,
+                      Number,
+                      VectorizedArrayType>::
+    initialize(
+      const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+      const std::function<void(FEEvalType &)> &           cell_operation,
+      const std::function<void(FEFaceEvalType &)> &       face_operation,
+      const unsigned int                                  dof_no,
+      const unsigned int                                  quad_no,
+      const unsigned int first_selected_component)
+  {
+    constexpr unsigned int n_lanes = VectorizedArrayType::size();
+
+    this->matrix_free              = &matrix_free;
+    this->dof_no                   = dof_no;
+    this->quad_no                  = quad_no;
+    this->first_selected_component = first_selected_component;
+
+    {
+      FEEvalType phi(matrix_free, dof_no, quad_no, first_selected_component);
+      n_dofs_per_cell = phi.dofs_per_cell;
+    }
+    const unsigned int n      = n_dofs_per_cell;
+    const unsigned int n_sqr  = n * n;
+    const unsigned int n_cell = matrix_free.n_cell_batches();
+    lu_factors.resize_fast(n_cell * n_sqr);
+    pivots.resize(n_cell * n * n_lanes);
+
+    // the cell batches are independent of each other and do not access any
+    // vector, so work on them in parallel on sub-ranges of batches
+    parallel::apply_to_subranges(
+      0U,
+      n_cell,
+      [&](const unsigned int begin, const unsigned int end) {
+        FEEvalType phi(matrix_free,
+                       std::make_pair(begin, end),
+                       dof_no,
+                       quad_no,
+                       first_selected_component);
+        std::unique_ptr<FEFaceEvalType> phi_face;
+        if (face_operation)
+          phi_face = std::make_unique<FEFaceEvalType>(
+            matrix_free, true, dof_no, quad_no, first_selected_component);
+
+        for (unsigned int cell = begin; cell < end; ++cell)
+          {
+            VectorizedArrayType *matrix = lu_factors.begin() + cell * n_sqr;
+
+            phi.reinit(cell);
+            for (unsigned int j = 0; j < n; ++j)
+              {
+                for (unsigned int i = 0; i < n; ++i)
+                  phi.begin_dof_values()[i] = static_cast<Number>(i == j);
+
+                cell_operation(phi);
+
+                for (unsigned int i = 0; i < n; ++i)
+                  matrix[i * n + j] = phi.begin_dof_values()[i];
+              }
+
+            if (face_operation)
+              for (unsigned int face = 0;
+                   face < GeometryInfo<dim>::faces_per_cell;
+                   ++face)
+                {
+                  phi_face->reinit(cell, face);
+                  for (unsigned int j = 0; j < n; ++j)
+                    {
+                      for (unsigned int i = 0; i < n; ++i)
+                        phi_face->begin_dof_values()[i] =
+                          static_cast<Number>(i == j);
+
+                      face_operation(*phi_face);
+
+                      for (unsigned int i = 0; i < n; ++i)
+                        matrix[i * n + j] += phi_face->begin_dof_values()[i];
+                    }
+                }
+
+            // fill the unused lanes with the identity matrix to keep the
+            // factorization below well-defined
+            for (unsigned int v = matrix_free.n_active_entries_per_cell_batch(
+                   cell);
+                 v < n_lanes;
+                 ++v)
+              for (unsigned int i = 0; i < n; ++i)
+                for (unsigned int j = 0; j < n; ++j)
+                  matrix[i * n + j][v] = (i == j) ? 1. : 0.;
+
+            // LU factorization with partial pivoting, selecting the pivot
+            // row separately for each lane
+            unsigned int *pivot = pivots.data() + cell * n * n_lanes;
+            for (unsigned int k = 0; k < n; ++k)
+              {
+                for (unsigned int v = 0; v < n_lanes; ++v)
+                  {
+                    unsigned int p = k;
+                    for (unsigned int i = k + 1; i < n; ++i)
+                      if (std::abs(matrix[i * n + k][v]) >
+                          std::abs(matrix[p * n + k][v]))
+                        p = i;
+                    Assert(matrix[p * n + k][v] != Number(),
+                           ExcMessage("The block of cell batch " +
+                                      std::to_string(cell) + ", lane " +
+                                      std::to_string(v) + " is singular."));
+                    pivot[k * n_lanes + v] = p;
+                    if (p != k)
+                      for (unsigned int j = 0; j < n; ++j)
+                        std::swap(matrix[k * n + j][v], matrix[p * n + j][v]);
+                  }
+
+                const VectorizedArrayType inverse_diagonal =
+                  Number(1.) / matrix[k * n + k];
+                matrix[k * n + k] = inverse_diagonal;
+                for (unsigned int i = k + 1; i < n; ++i)
+                  {
+                    const VectorizedArrayType factor =
+                      matrix[i * n + k] * inverse_diagonal;
+                    matrix[i * n + k] = factor;
+                    for (unsigned int j = k + 1; j < n; ++j)
+                      matrix[i * n + j] -= factor * matrix[k * n + j];
+                  }
+              }
+          }
+      },
+      1);
+  }
+
+
+
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename Number,
+            typename VectorizedArrayType>
+  void
+  CellwiseBlockJacobi<dim,
+                      fe_degree,
+                      n_q_points_1d,
+                      n_components,
+                      Number,
+                      VectorizedArrayType>::
+    apply_inverse(const unsigned int         cell,
+                  const VectorizedArrayType *in_array,
+                  VectorizedArrayType *      out_array) const
+  {
+    constexpr unsigned int n_lanes = VectorizedArrayType::size();
+    const unsigned int     n       = n_dofs_per_cell;
+    AssertIndexRange(cell * n * n, lu_factors.size());
+
+    const VectorizedArrayType *matrix = lu_factors.begin() + cell * n * n;
+    const unsigned int *       pivot  = pivots.data() + cell * n * n_lanes;
+
+    if (in_array != out_array)
+      std::copy(in_array, in_array + n, out_array);
+
+    for (unsigned int k = 0; k < n; ++k)
+      for (unsigned int v = 0; v < n_lanes; ++v)
+        if (pivot[k * n_lanes + v] != k)
+          std::swap(out_array[k][v], out_array[pivot[k * n_lanes + v]][v]);
+
+    // forward substitution with the unit lower triangular factor
+    for (unsigned int i = 1; i < n; ++i)
+      {
+        VectorizedArrayType sum = out_array[i];
+        for (unsigned int j = 0; j < i; ++j)
+          sum -= matrix[i * n + j] * out_array[j];
+        out_array[i] = sum;
+      }
+
+    // backward substitution with the upper triangular factor, whose
+    // diagonal is stored in inverted form
+    for (int i = n - 1; i >= 0; --i)
+      {
+        VectorizedArrayType sum = out_array[i];
+        for (unsigned int j = i + 1; j < n; ++j)
+          sum -= matrix[i * n + j] * out_array[j];
+        out_array[i] = sum * matrix[i * n + i];
+      }
+  }
+
+
+
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename Number,
+            typename VectorizedArrayType>
+  template <typename VectorType>
+  void
+  CellwiseBlockJacobi<dim,
+                      fe_degree,
+                      n_q_points_1d,
+                      n_components,
+                      Number,
+                      VectorizedArrayType>::vmult(VectorType &      dst,
+                                                  const VectorType &src) const
+  {
+    Assert(matrix_free != nullptr, ExcNotInitialized());
+
+    matrix_free->template cell_loop<VectorType, VectorType>(
+      [&](const auto &, auto &dst, const auto &src, const auto range) {
+        FEEvalType phi(
+          *matrix_free, range, dof_no, quad_no, first_selected_component);
+        for (unsigned int cell = range.first; cell < range.second; ++cell)
+          {
+            phi.reinit(cell);
+            phi.read_dof_values(src);
+            apply_inverse(cell, phi.begin_dof_values(), phi.begin_dof_values());
+            phi.distribute_local_to_global(dst);
+          }
+      },
+      dst,
+      src,
+      true);
+  }
+
+
+
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename Number,
+            typename VectorizedArrayType>
+  std::size_t
+  CellwiseBlockJacobi<dim,
+                      fe_degree,
+                      n_q_points_1d,
+                      n_components,
+                      Number,
+                      VectorizedArrayType>::memory_consumption() const
+  {
+    return lu_factors.memory_consumption() +
+           MemoryConsumption::memory_consumption(pivots);
+  }
+
+
+
+
+  template <int dim, typename Number, typename VectorizedArrayType>
+  LoopParameterTuner<dim, Number, VectorizedArrayType>::LoopParameterTuner(
+    const MPI_Comm &   comm,
+    const unsigned int n_repetitions)
+    : comm(comm)
+    , n_repetitions(n_repetitions)
+  {
+    Assert(n_repetitions > 0, ExcMessage("Need at least one repetition."));
+  }
+
+
+
+  template <int dim, typename Number, typename VectorizedArrayType>
+  void
+  LoopParameterTuner<dim, Number, VectorizedArrayType>::add_candidate(
+    const AdditionalData &additional_data)
+  {
+    candidates.push_back(additional_data);
+  }
+
+
+
+  template <int dim, typename Number, typename VectorizedArrayType>
+  void
+  LoopParameterTuner<dim, Number, VectorizedArrayType>::add_default_candidates(
+    const AdditionalData &           base,
+    const std::vector<unsigned int> &block_sizes)
+  {
+    std::vector<typename AdditionalData::TasksParallelScheme> schemes;
+    if (MultithreadInfo::n_threads() > 1)
+      schemes = {AdditionalData::partition_partition,
+                 AdditionalData::partition_color};
+    else
+      schemes = {AdditionalData::none};
+
+    // 0: no categories, 1: non-strict categories, 2: strict categories
+    std::vector<unsigned int> category_variants;
+    if (base.cell_vectorization_category.empty())
+      category_variants = {0};
+    else
+      category_variants = {base.cell_vectorization_categories_strict ? 2u : 1u,
+                           base.cell_vectorization_categories_strict ? 1u : 2u,
+                           0};
+
+    for (const unsigned int categories : category_variants)
+      for (const bool overlap : {true, false})
+        for (const auto scheme : schemes)
+          for (const unsigned int block_size : block_sizes)
+            {
+              // the block size is not used without threads
+              if (scheme == AdditionalData::none &&
+                  block_size != block_sizes[0])
+                continue;
+
+              AdditionalData data                    = base;
+              data.tasks_parallel_scheme             = scheme;
+              data.tasks_block_size                  = block_size;
+              data.overlap_communication_computation = overlap;
+              if (categories == 0)
+                data.cell_vectorization_category.clear();
+              else
+                data.cell_vectorization_categories_strict = categories == 2;
+              candidates.push_back(data);
+            }
+  }
+
+
+
+  template <int dim, typename Number, typename VectorizedArrayType>
+  const std::vector<
+    typename LoopParameterTuner<dim, Number, VectorizedArrayType>::
+      AdditionalData> &
+  LoopParameterTuner<dim, Number, VectorizedArrayType>::get_candidates() const
+  {
+    return candidates;
+  }
+
+
+
+  template <int dim, typename Number, typename VectorizedArrayType>
+  const std::vector<double> &
+  LoopParameterTuner<dim, Number, VectorizedArrayType>::get_timings() const
+  {
+    return timings;
+  }
+
+
+
+  template <int dim, typename Number, typename VectorizedArrayType>
+  std::string
+  LoopParameterTuner<dim, Number, VectorizedArrayType>::get_cache_key(
+    const std::string &problem_key) const
+  {
+    // the cache is only accessed by the first rank, so its host name
+    // identifies the machine on all ranks
+    std::ostringstream key;
+    key << Utilities::MPI::broadcast(comm, Utilities::System::get_hostname())
+        << ":threads=" << MultithreadInfo::n_threads()
+        << ":ranks=" << Utilities::MPI::n_mpi_processes(comm)
+        << ":lanes=" << VectorizedArrayType::size() << ":dim=" << dim
+        << ":number=" << sizeof(Number) << ':' << problem_key;
+    return key.str();
+  }
+
+
+
+  template <int dim, typename Number, typename VectorizedArrayType>
+  typename LoopParameterTuner<dim, Number, VectorizedArrayType>::AdditionalData
+  LoopParameterTuner<dim, Number, VectorizedArrayType>::tune(
+    const std::function<void(const AdditionalData &)> &reinit,
+    const std::function<void()> &                      run_operator,
+    const std::string &                                cache_file,
+    const std::string &                                problem_key)
+  {
+    Assert(candidates.size() > 0,
+           ExcMessage("No candidate configurations have been added."));
+    Assert(problem_key.find_first_of(" \t\n") == std::string::npos,
+           ExcMessage("The problem key must not contain white space."));
+
+    timings.clear();
+
+    const std::string key = get_cache_key(problem_key);
+
+    AdditionalData result = candidates[0];
+    if (!cache_file.empty())
+      {
+        // only the first rank reads the file and sends the parameters to the
+        // other ranks, such that all ranks agree on the configuration and on
+        // whether to enter the collective timing loop below
+        std::array<unsigned int, std::tuple_size<CachedParameters>::value + 1>
+                         buffer = {};
+        CachedParameters parameters;
+        if (Utilities::MPI::this_mpi_process(comm) == 0 &&
+            read_from_cache(cache_file, key, parameters))
+          {
+            buffer[0] = 1;
+            std::copy(parameters.begin(), parameters.end(), buffer.begin() + 1);
+          }
+        Utilities::MPI::broadcast(buffer.data(), buffer.size(), 0, comm);
+
+        if (buffer[0] == 1)
+          {
+            std::copy(buffer.begin() + 1, buffer.end(), parameters.begin());
+            set_parameters(parameters, result);
+            reinit(result);
+            return result;
+          }
+      }
+
+    unsigned int best_index = 0;
+    for (unsigned int c = 0; c < candidates.size(); ++c)
+      {
+        reinit(candidates[c]);
+
+        // warm-up run, e.g. to fault in the pages of the vectors
+        run_operator();
+
+        double min_time = std::numeric_limits<double>::max();
+        for (unsigned int i = 0; i < n_repetitions; ++i)
+          {
+            Timer timer;
+            run_operator();
+            min_time =
+              std::min(min_time, Utilities::MPI::max(timer.wall_time(), comm));
+          }
+        timings.push_back(min_time);
+
+        if (min_time < timings[best_index])
+          best_index = c;
+      }
+
+    result = candidates[best_index];
+    if (best_index + 1 != candidates.size())
+      reinit(result);
+
+    if (!cache_file.empty() && Utilities::MPI::this_mpi_process(comm) == 0)
+      write_to_cache(cache_file, key, get_parameters(result));
+
+    return result;
+  }
+
+
+
+  template <int dim, typename Number, typename VectorizedArrayType>
+  typename LoopParameterTuner<dim, Number, VectorizedArrayType>::
+    CachedParameters
+    LoopParameterTuner<dim, Number, VectorizedArrayType>::get_parameters(
+      const AdditionalData &additional_data)
+  {
+    return {{static_cast<unsigned int>(additional_data.tasks_parallel_scheme),
+             additional_data.tasks_block_size,
+             additional_data.overlap_communication_computation,
+             additional_data.cell_vectorization_categories_strict,
+             !additional_data.cell_vectorization_category.empty()}};
+  }
+
+
+
+  template <int dim, typename Number, typename VectorizedArrayType>
+  void
+  LoopParameterTuner<dim, Number, VectorizedArrayType>::set_parameters(
+    const CachedParameters &parameters,
+    AdditionalData &        additional_data) const
+  {
+    additional_data.tasks_parallel_scheme =
+      static_cast<typename AdditionalData::TasksParallelScheme>(parameters[0]);
+    additional_data.tasks_block_size                     = parameters[1];
+    additional_data.overlap_communication_computation    = parameters[2] != 0;
+    additional_data.cell_vectorization_categories_strict = parameters[3] != 0;
+
+    additional_data.cell_vectorization_category.clear();
+    if (parameters[4] != 0)
+      for (const auto &candidate : candidates)
+        if (!candidate.cell_vectorization_category.empty())
+          {
+            additional_data.cell_vectorization_category =
+              candidate.cell_vectorization_category;
+            break;
+          }
+  }
+
+
+
+  template <int dim, typename Number, typename VectorizedArrayType>
+  bool
+  LoopParameterTuner<dim, Number, VectorizedArrayType>::read_from_cache(
+    const std::string &cache_file,
+    const std::string &key,
+    CachedParameters & parameters)
+  {
+    std::ifstream file(cache_file);
+    if (!file)
+      return false;
+
+    // use the last entry with a matching key, which is the most recent one
+    bool        found = false;
+    std::string line;
+    while (std::getline(file, line))
+      {
+        std::istringstream entry(line);
+        std::string        entry_key;
+        CachedParameters   entry_parameters = {};
+        entry >> entry_key;
+        for (unsigned int &parameter : entry_parameters)
+          entry >> parameter;
+        if (entry && entry_key == key &&
+            entry_parameters[0] <= AdditionalData::color)
+          {
+            parameters = entry_parameters;
+            found      = true;
+          }
+      }
+    return found;
+  }
+
+
+
+  template <int dim, typename Number, typename VectorizedArrayType>
+  void
+  LoopParameterTuner<dim, Number, VectorizedArrayType>::write_to_cache(
+    const std::string &     cache_file,
+    const std::string &     key,
+    const CachedParameters &parameters)
+  {
+    std::ofstream file(cache_file, std::ios::app);
+    AssertThrow(file, ExcIO());
+    file << key;
+    for (const unsigned int parameter : parameters)
+      file << ' ' << parameter;
+    file << std::endl;
+  }
+
 #endif // DOXYGEN
 
 } // namespace MatrixFreeTools
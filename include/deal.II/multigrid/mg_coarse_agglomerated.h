@@ -0,0 +1,578 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_mg_coarse_agglomerated_h
+#define dealii_mg_coarse_agglomerated_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/index_set.h>
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/sparse_direct.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/multigrid/mg_base.h>
+
+#include <limits>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+/*!@addtogroup mg */
+/*@{*/
+
+/**
+ * Coarse grid solver that agglomerates a distributed coarse problem onto a
+ * few processes and solves it there with the sparse direct solver
+ * SparseDirectUMFPACK.
+ *
+ * On large numbers of processes, the coarsest level of a multigrid
+ * hierarchy, e.g. with MGTransferGlobalCoarsening, often holds only a few
+ * thousand unknowns spread over all processes. An iterative coarse solver
+ * like MGCoarseGridIterativeSolver then performs many global reductions
+ * with hardly any work in between, so its run time is dominated by
+ * latency. This class instead
+ * <ol>
+ * <li> splits the processes into groups of consecutive ranks, where the
+ * size of the groups is the agglomeration factor,
+ * <li> gathers the matrix rows of each group on the first process of the
+ * group, the solver process, and exchanges them among the solver processes,
+ * such that each solver process holds the complete coarse matrix and
+ * factorizes it once in initialize(),
+ * <li> in each call to operator(), gathers the right hand side of each group
+ * on its solver process, exchanges the parts among the solver processes,
+ * solves with the stored factorization, and scatters the solution back to
+ * the processes of the group.
+ * </ol>
+ * Each application hence costs three collective operations on small
+ * communicators instead of the many global reductions of a Krylov solver.
+ * The solves on the solver processes are redundant, which is cheap for the
+ * small problems this class is meant for.
+ *
+ * By default, the agglomeration factor is chosen from the size of the
+ * coarse problem such that the solver processes hold about
+ * AdditionalData::n_dofs_per_solver_process unknowns of the right hand side
+ * before the exchange among them, i.e., a coarse problem smaller than this
+ * number is gathered on a single process.
+ *
+ * The class requires that the locally owned unknowns of each process form a
+ * contiguous range and that these ranges are ordered by the MPI rank, as it
+ * is the case for the unknowns enumerated by DoFHandler.
+ *
+ * A typical use with a matrix assembled for the coarse level, e.g. by
+ * MatrixFreeTools::compute_matrix(), reads
+ * @code
+ * MGCoarseGridAgglomeratedDirect<double> coarse_grid_solver;
+ * coarse_grid_solver.initialize(coarse_matrix,
+ *                               dof_handler.locally_owned_mg_dofs(0),
+ *                               dof_handler.get_communicator());
+ * Multigrid<VectorType> mg(mg_matrix, coarse_grid_solver, transfer,
+ *                          mg_smoother, mg_smoother);
+ * @endcode
+ */
+template <typename Number>
+class MGCoarseGridAgglomeratedDirect
+  : public MGCoarseGridBase<LinearAlgebra::distributed::Vector<Number>>
+{
+public:
+  /**
+   * The vector type the coarse grid solver operates on.
+   */
+  using VectorType = LinearAlgebra::distributed::Vector<Number>;
+
+  /**
+   * Parameters controlling the agglomeration.
+   */
+  struct AdditionalData
+  {
+    /**
+     * Constructor.
+     */
+    AdditionalData(const unsigned int n_dofs_per_solver_process = 20000,
+                   const unsigned int agglomeration_factor      = 0);
+
+    /**
+     * Number of unknowns each solver process should collect from its group
+     * if the agglomeration factor is chosen automatically.
+     */
+    unsigned int n_dofs_per_solver_process;
+
+    /**
+     * Number of processes per group. If zero, the factor is determined
+     * from the size of the problem and @p n_dofs_per_solver_process.
+     */
+    unsigned int agglomeration_factor;
+  };
+
+  /**
+   * Constructor. Does nothing, so you have to call initialize() afterwards.
+   */
+  MGCoarseGridAgglomeratedDirect() = default;
+
+  /**
+   * The copy constructor is deleted, as objects of this class own the
+   * communicators they free in the destructor.
+   */
+  MGCoarseGridAgglomeratedDirect(const MGCoarseGridAgglomeratedDirect &) =
+    delete;
+
+  /**
+   * The copy assignment operator is deleted, see the copy constructor.
+   */
+  MGCoarseGridAgglomeratedDirect &
+  operator=(const MGCoarseGridAgglomeratedDirect &) = delete;
+
+  /**
+   * Destructor. Frees the communicators.
+   */
+  ~MGCoarseGridAgglomeratedDirect() override;
+
+  /**
+   * Gather the rows of @p matrix on the solver processes and compute their
+   * factorization. Each process passes the rows it owns according to @p
+   * locally_owned_dofs, which also defines the layout of the vectors passed
+   * to operator(). The class @p MatrixType needs to provide access to these
+   * rows through `begin(row)` and `end(row)`, like SparseMatrix or
+   * TrilinosWrappers::SparseMatrix do.
+   */
+  template <typename MatrixType>
+  void
+  initialize(const MatrixType &    matrix,
+             const IndexSet &      locally_owned_dofs,
+             const MPI_Comm &      communicator,
+             const AdditionalData &data = AdditionalData());
+
+  /**
+   * Release the communicators and the temporary vectors. The factorization
+   * is replaced by the next call to initialize().
+   */
+  void
+  clear();
+
+  /**
+   * Solve the coarse problem with right hand side @p src on the solver
+   * processes and return the solution in @p dst.
+   */
+  void
+  operator()(const unsigned int level,
+             VectorType &       dst,
+             const VectorType & src) const override;
+
+  /**
+   * Return the number of processes per group that was selected in
+   * initialize().
+   */
+  unsigned int
+  get_agglomeration_factor() const;
+
+  /**
+   * Return the number of processes that hold the factorization.
+   */
+  unsigned int
+  n_solver_processes() const;
+
+private:
+  /**
+   * The communicator passed to initialize().
+   */
+  MPI_Comm communicator;
+
+  /**
+   * Communicator of the processes within a group, with the solver process
+   * as rank zero.
+   */
+  MPI_Comm group_communicator;
+
+  /**
+   * Communicator of all solver processes, or MPI_COMM_NULL on the other
+   * processes.
+   */
+  MPI_Comm solver_communicator;
+
+  /**
+   * Whether the two communicators above were created by this class and need
+   * to be freed.
+   */
+  bool owns_communicators = false;
+
+  /**
+   * The number of processes per group.
+   */
+  unsigned int agglomeration_factor = 0;
+
+  /**
+   * The number of groups, i.e., of solver processes.
+   */
+  unsigned int n_groups = 0;
+
+  /**
+   * Number of locally owned unknowns.
+   */
+  unsigned int n_locally_owned = 0;
+
+  /**
+   * Number of unknowns and their offsets for the processes in the group,
+   * only set on the solver process.
+   */
+  std::vector<int> group_counts;
+  std::vector<int> group_offsets;
+
+  /**
+   * Number of unknowns and their offsets for the groups, only set on the
+   * solver processes.
+   */
+  std::vector<int> solver_counts;
+  std::vector<int> solver_offsets;
+
+  /**
+   * The factorization of the complete coarse matrix, only set on the solver
+   * processes.
+   */
+  SparseDirectUMFPACK direct_solver;
+
+  /**
+   * Temporary vectors for the right hand side and the solution of the
+   * complete coarse problem, only used on the solver processes.
+   */
+  mutable Vector<double> rhs;
+  mutable Vector<double> solution;
+
+  /**
+   * Temporary buffers for the data of this process and of the group.
+   */
+  mutable std::vector<double> local_buffer;
+  mutable std::vector<double> group_buffer;
+};
+
+/*@}*/
+
+#ifndef DOXYGEN
+/* ------------- Functions for MGCoarseGridAgglomeratedDirect ------------ */
+
+template <typename Number>
+MGCoarseGridAgglomeratedDirect<Number>::AdditionalData::AdditionalData(
+  const unsigned int n_dofs_per_solver_process,
+  const unsigned int agglomeration_factor)
+  : n_dofs_per_solver_process(n_dofs_per_solver_process)
+  , agglomeration_factor(agglomeration_factor)
+{}
+
+
+
+template <typename Number>
+MGCoarseGridAgglomeratedDirect<Number>::~MGCoarseGridAgglomeratedDirect()
+{
+  clear();
+}
+
+
+
+template <typename Number>
+void
+MGCoarseGridAgglomeratedDirect<Number>::clear()
+{
+  if (owns_communicators)
+    {
+      Utilities::MPI::free_communicator(group_communicator);
+      if (solver_communicator != MPI_COMM_NULL)
+        Utilities::MPI::free_communicator(solver_communicator);
+      owns_communicators = false;
+    }
+  group_counts.clear();
+  group_offsets.clear();
+  solver_counts.clear();
+  solver_offsets.clear();
+  rhs.reinit(0);
+  solution.reinit(0);
+  agglomeration_factor = 0;
+  n_groups             = 0;
+  n_locally_owned      = 0;
+}
+
+
+
+template <typename Number>
+template <typename MatrixType>
+void
+MGCoarseGridAgglomeratedDirect<Number>::initialize(
+  const MatrixType &    matrix,
+  const IndexSet &      locally_owned_dofs,
+  const MPI_Comm &      communicator,
+  const AdditionalData &data)
+{
+  clear();
+
+  const types::global_dof_index n_global = locally_owned_dofs.size();
+  AssertThrow(n_global < static_cast<types::global_dof_index>(
+                           std::numeric_limits<int>::max()),
+              ExcMessage("The coarse problem is too large to be "
+                         "agglomerated."));
+  AssertThrow(locally_owned_dofs.is_contiguous(),
+              ExcMessage("The locally owned unknowns must form a contiguous "
+                         "range."));
+
+  this->communicator = communicator;
+  n_locally_owned    = locally_owned_dofs.n_elements();
+
+  const unsigned int n_procs = Utilities::MPI::n_mpi_processes(communicator);
+  const unsigned int my_rank = Utilities::MPI::this_mpi_process(communicator);
+  if (data.agglomeration_factor > 0)
+    agglomeration_factor = std::min(data.agglomeration_factor, n_procs);
+  else
+    {
+      Assert(data.n_dofs_per_solver_process > 0,
+             ExcMessage("The number of unknowns per solver process must be "
+                        "positive."));
+      const types::global_dof_index n_solver_processes =
+        std::min<types::global_dof_index>(
+          std::max<types::global_dof_index>(
+            (n_global + data.n_dofs_per_solver_process - 1) /
+              data.n_dofs_per_solver_process,
+            1),
+          n_procs);
+      agglomeration_factor =
+        (n_procs + n_solver_processes - 1) / n_solver_processes;
+    }
+  n_groups = (n_procs + agglomeration_factor - 1) / agglomeration_factor;
+
+  const bool is_solver_process = my_rank % agglomeration_factor == 0;
+
+#ifdef DEAL_II_WITH_MPI
+  if (n_procs > 1)
+    {
+      // the unknowns must be ordered by rank such that the data gathered
+      // along the ranks has the global order
+      const types::global_dof_index my_size  = n_locally_owned;
+      types::global_dof_index       my_start = 0;
+
+      int ierr = MPI_Exscan(&my_size,
+                            &my_start,
+                            1,
+                            DEAL_II_DOF_INDEX_MPI_TYPE,
+                            MPI_SUM,
+                            communicator);
+      AssertThrowMPI(ierr);
+      if (my_rank == 0)
+        my_start = 0;
+      AssertThrow(Utilities::MPI::min(static_cast<unsigned int>(
+                                        n_locally_owned == 0 ||
+                                        locally_owned_dofs.nth_index_in_set(
+                                          0) == my_start),
+                                      communicator) == 1,
+                  ExcMessage("The locally owned ranges must be ordered by "
+                             "the MPI rank."));
+
+      ierr = MPI_Comm_split(communicator,
+                            my_rank / agglomeration_factor,
+                            my_rank,
+                            &group_communicator);
+      AssertThrowMPI(ierr);
+      ierr = MPI_Comm_split(communicator,
+                            is_solver_process ? 0 : MPI_UNDEFINED,
+                            my_rank,
+                            &solver_communicator);
+      AssertThrowMPI(ierr);
+      owns_communicators = true;
+    }
+  else
+#endif
+    {
+      group_communicator  = communicator;
+      solver_communicator = communicator;
+    }
+
+  // collect the locally owned rows as pairs of indices and values
+  std::vector<types::global_dof_index> indices;
+  std::vector<double>                  values;
+  for (const auto row : locally_owned_dofs)
+    for (auto entry = matrix.begin(row); entry != matrix.end(row); ++entry)
+      {
+        indices.push_back(row);
+        indices.push_back(entry->column());
+        values.push_back(entry->value());
+      }
+
+  // gather the rows of the group and the number of unknowns of each process
+  // on the solver process
+  const std::vector<std::vector<types::global_dof_index>> group_indices =
+    Utilities::MPI::gather(group_communicator, indices);
+  const std::vector<std::vector<double>> group_values =
+    Utilities::MPI::gather(group_communicator, values);
+  const std::vector<unsigned int> group_sizes =
+    Utilities::MPI::gather(group_communicator, n_locally_owned);
+
+  if (is_solver_process)
+    {
+      group_counts.assign(group_sizes.begin(), group_sizes.end());
+      group_offsets.resize(group_counts.size());
+      int n_group_dofs = 0;
+      for (unsigned int p = 0; p < group_counts.size(); ++p)
+        {
+          group_offsets[p] = n_group_dofs;
+          n_group_dofs += group_counts[p];
+        }
+      group_buffer.resize(n_group_dofs);
+
+      indices.clear();
+      values.clear();
+      for (unsigned int p = 0; p < group_indices.size(); ++p)
+        {
+          indices.insert(indices.end(),
+                         group_indices[p].begin(),
+                         group_indices[p].end());
+          values.insert(values.end(),
+                        group_values[p].begin(),
+                        group_values[p].end());
+        }
+
+      // exchange the rows among the solver processes
+      const std::vector<std::vector<types::global_dof_index>> all_indices =
+        Utilities::MPI::all_gather(solver_communicator, indices);
+      const std::vector<std::vector<double>> all_values =
+        Utilities::MPI::all_gather(solver_communicator, values);
+      const std::vector<int> all_sizes =
+        Utilities::MPI::all_gather(solver_communicator, n_group_dofs);
+
+      solver_counts = all_sizes;
+      solver_offsets.resize(solver_counts.size());
+      int offset = 0;
+      for (unsigned int p = 0; p < solver_counts.size(); ++p)
+        {
+          solver_offsets[p] = offset;
+          offset += solver_counts[p];
+        }
+      AssertDimension(offset, n_global);
+
+      DynamicSparsityPattern dsp(n_global, n_global);
+      for (const auto &process_indices : all_indices)
+        for (unsigned int i = 0; i < process_indices.size(); i += 2)
+          dsp.add(process_indices[i], process_indices[i + 1]);
+      SparsityPattern sparsity;
+      sparsity.copy_from(dsp);
+
+      SparseMatrix<double> coarse_matrix(sparsity);
+      for (unsigned int p = 0; p < all_indices.size(); ++p)
+        for (unsigned int i = 0; i < all_values[p].size(); ++i)
+          coarse_matrix.add(all_indices[p][2 * i],
+                            all_indices[p][2 * i + 1],
+                            all_values[p][i]);
+
+      // the factorization keeps its own copy of the matrix
+      direct_solver.initialize(coarse_matrix);
+      rhs.reinit(n_global);
+      solution.reinit(n_global);
+    }
+  local_buffer.resize(n_locally_owned);
+}
+
+
+
+template <typename Number>
+void
+MGCoarseGridAgglomeratedDirect<Number>::operator()(const unsigned int,
+                                                   VectorType &      dst,
+                                                   const VectorType &src) const
+{
+  AssertDimension(src.locally_owned_size(), n_locally_owned);
+  AssertDimension(dst.locally_owned_size(), n_locally_owned);
+
+#ifdef DEAL_II_WITH_MPI
+  if (owns_communicators)
+    {
+      std::copy(src.begin(), src.end(), local_buffer.begin());
+
+      const bool is_solver_process = solver_communicator != MPI_COMM_NULL;
+
+      int ierr = MPI_Gatherv(local_buffer.data(),
+                             n_locally_owned,
+                             MPI_DOUBLE,
+                             group_buffer.data(),
+                             group_counts.data(),
+                             group_offsets.data(),
+                             MPI_DOUBLE,
+                             0,
+                             group_communicator);
+      AssertThrowMPI(ierr);
+
+      double *group_solution = nullptr;
+      if (is_solver_process)
+        {
+          ierr = MPI_Allgatherv(group_buffer.data(),
+                                group_buffer.size(),
+                                MPI_DOUBLE,
+                                rhs.begin(),
+                                solver_counts.data(),
+                                solver_offsets.data(),
+                                MPI_DOUBLE,
+                                solver_communicator);
+          AssertThrowMPI(ierr);
+
+          direct_solver.vmult(solution, rhs);
+          group_solution =
+            solution.begin() +
+            solver_offsets[Utilities::MPI::this_mpi_process(
+              solver_communicator)];
+        }
+
+      ierr = MPI_Scatterv(group_solution,
+                          group_counts.data(),
+                          group_offsets.data(),
+                          MPI_DOUBLE,
+                          local_buffer.data(),
+                          n_locally_owned,
+                          MPI_DOUBLE,
+                          0,
+                          group_communicator);
+      AssertThrowMPI(ierr);
+
+      std::copy(local_buffer.begin(), local_buffer.end(), dst.begin());
+      return;
+    }
+#endif
+
+  std::copy(src.begin(), src.end(), rhs.begin());
+  direct_solver.vmult(solution, rhs);
+  std::copy(solution.begin(), solution.end(), dst.begin());
+}
+
+
+
+template <typename Number>
+unsigned int
+MGCoarseGridAgglomeratedDirect<Number>::get_agglomeration_factor() const
+{
+  return agglomeration_factor;
+}
+
+
+
+template <typename Number>
+unsigned int
+MGCoarseGridAgglomeratedDirect<Number>::n_solver_processes() const
+{
+  return n_groups;
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -280,6 +280,14 @@ public:
 
   /**
    * Perform prolongation.
+   *
+   * The exchange of the ghost values of the coarse vector is overlapped with
+   * the prolongation on the cells whose coarse degrees of freedom are all
+   * owned by the present process. The remaining cells are processed once the
+   * exchange has finished. If @p src is used in place (see
+   * enable_inplace_operations_if_possible()) and its ghost values are already
+   * set, no exchange is performed, all cells are processed in order, and the
+   * ghost values are left untouched.
    */
   void
   prolongate_and_add(
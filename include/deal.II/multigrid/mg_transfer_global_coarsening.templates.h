@@ -46,6 +46,8 @@
 #include <deal.II/multigrid/mg_tools.h>
 #include <deal.II/multigrid/mg_transfer_global_coarsening.h>
 
+#include <algorithm>
+
 DEAL_II_NAMESPACE_OPEN
 
 namespace
@@ -2498,7 +2500,13 @@ MGTwoLevelTransfer<dim, LinearAlgebra::distributed::Vector<Number>>::
   if (use_src_inplace == false)
     vec_coarse.copy_locally_owned_data_from(src);
 
-  vec_coarse_ptr->update_ghost_values();
+  // if the ghost values of the given vector are already set, we can use them
+  // as they are and leave them untouched; otherwise start the ghost exchange
+  // of the coarse vector and overlap it with the work on the cells that only
+  // read locally owned coarse entries, see below
+  const bool src_ghosts_set = use_src_inplace && src.has_ghost_elements();
+  if (src_ghosts_set == false)
+    vec_coarse_ptr->update_ghost_values_start();
 
   if (fine_element_is_continuous && (use_dst_inplace == false))
     *vec_fine_ptr = Number(0.);
@@ -2506,117 +2514,170 @@ MGTwoLevelTransfer<dim, LinearAlgebra::distributed::Vector<Number>>::
   AlignedVector<VectorizedArrayType> evaluation_data_fine;
   AlignedVector<VectorizedArrayType> evaluation_data_coarse;
 
-  const unsigned int *           indices_fine = level_dof_indices_fine.data();
-  const Number *                 weights      = nullptr;
-  const VectorizedArray<Number> *weights_compressed = nullptr;
+  // the position of a batch of coarse cells within the index and weight
+  // arrays, used to defer the batches that need ghost values
+  struct CellBatch
+  {
+    const MGTransferScheme *       scheme;
+    unsigned int                   cell_counter;
+    unsigned int                   n_lanes_filled;
+    const unsigned int *           indices_fine;
+    const Number *                 weights;
+    const VectorizedArray<Number> *weights_compressed;
+  };
+
+  const auto process_cell_batch = [&](const CellBatch &batch) {
+    const MGTransferScheme &scheme         = *batch.scheme;
+    const unsigned int      n_lanes_filled = batch.n_lanes_filled;
+    const unsigned int *    indices_fine   = batch.indices_fine;
+    const Number *          weights        = batch.weights;
+
+    const bool needs_interpolation =
+      (scheme.prolongation_matrix.size() == 0 &&
+       scheme.prolongation_matrix_1d.size() == 0) == false;
+
+    evaluation_data_fine.resize(scheme.n_dofs_per_cell_fine);
+    evaluation_data_coarse.resize(scheme.n_dofs_per_cell_fine);
+
+    CellTransferFactory cell_transfer(scheme.degree_fine,
+                                      scheme.degree_coarse);
+
+    const unsigned int n_scalar_dofs_fine =
+      scheme.n_dofs_per_cell_fine / n_components;
+    const unsigned int n_scalar_dofs_coarse =
+      scheme.n_dofs_per_cell_coarse / n_components;
+
+    // read from src vector (similar to FEEvaluation::read_dof_values())
+    internal::VectorReader<Number, VectorizedArrayType> reader;
+    constraint_info.read_write_operation(reader,
+                                         *vec_coarse_ptr,
+                                         evaluation_data_coarse,
+                                         batch.cell_counter,
+                                         n_lanes_filled,
+                                         scheme.n_dofs_per_cell_coarse,
+                                         true);
+    constraint_info.apply_hanging_node_constraints(batch.cell_counter,
+                                                   n_lanes_filled,
+                                                   false,
+                                                   evaluation_data_coarse);
+
+    // ---------------------------- coarse -------------------------------
+    if (needs_interpolation)
+      for (int c = n_components - 1; c >= 0; --c)
+        {
+          CellProlongator<dim, VectorizedArrayType> cell_prolongator(
+            scheme.prolongation_matrix,
+            scheme.prolongation_matrix_1d,
+            evaluation_data_coarse.begin() + c * n_scalar_dofs_coarse,
+            evaluation_data_fine.begin() + c * n_scalar_dofs_fine);
+
+          if (scheme.prolongation_matrix_1d.size() > 0)
+            cell_transfer.run(cell_prolongator);
+          else
+            cell_prolongator.run_full(n_scalar_dofs_fine,
+                                      n_scalar_dofs_coarse);
+        }
+    else
+      evaluation_data_fine = evaluation_data_coarse; // TODO
+    // ------------------------------ fine -------------------------------
+
+    // weight and write into dst vector
+    if (fine_element_is_continuous && this->weights_compressed.size() > 0)
+      internal::weight_fe_q_dofs_by_entity<dim, -1, Number>(
+        batch.weights_compressed,
+        n_components,
+        scheme.degree_fine + 1,
+        evaluation_data_fine.begin());
+
+    for (unsigned int v = 0; v < n_lanes_filled; ++v)
+      {
+        if (fine_element_is_continuous && this->weights_compressed.size() == 0)
+          for (unsigned int i = 0; i < scheme.n_dofs_per_cell_fine; ++i)
+            vec_fine_ptr->local_element(indices_fine[i]) +=
+              evaluation_data_fine[i][v] * weights[i];
+        else
+          for (unsigned int i = 0; i < scheme.n_dofs_per_cell_fine; ++i)
+            vec_fine_ptr->local_element(indices_fine[i]) +=
+              evaluation_data_fine[i][v];
+
+        indices_fine += scheme.n_dofs_per_cell_fine;
+
+        if (fine_element_is_continuous)
+          weights += scheme.n_dofs_per_cell_fine;
+      }
+  };
+
+  CellBatch batch;
+  batch.indices_fine       = level_dof_indices_fine.data();
+  batch.weights            = nullptr;
+  batch.weights_compressed = nullptr;
 
   if (fine_element_is_continuous)
     {
-      weights            = this->weights.data();
-      weights_compressed = this->weights_compressed.data();
+      batch.weights            = this->weights.data();
+      batch.weights_compressed = this->weights_compressed.data();
     }
 
-  unsigned int cell_counter = 0;
+  // cell batches whose coarse degrees of freedom (including the ones
+  // constraining them) are all locally owned are processed while the ghost
+  // values are in flight, the others are deferred until the exchange has
+  // finished
+  const unsigned int n_owned_coarse =
+    vec_coarse_ptr->get_partitioner()->locally_owned_size();
+  std::vector<CellBatch> deferred_batches;
+
+  batch.cell_counter = 0;
 
   for (const auto &scheme : schemes)
     {
       if (scheme.n_coarse_cells == 0)
         continue;
 
-      const bool needs_interpolation =
-        (scheme.prolongation_matrix.size() == 0 &&
-         scheme.prolongation_matrix_1d.size() == 0) == false;
-
-      evaluation_data_fine.resize(scheme.n_dofs_per_cell_fine);
-      evaluation_data_coarse.resize(scheme.n_dofs_per_cell_fine);
-
-      CellTransferFactory cell_transfer(scheme.degree_fine,
-                                        scheme.degree_coarse);
-
-      const unsigned int n_scalar_dofs_fine =
-        scheme.n_dofs_per_cell_fine / n_components;
-      const unsigned int n_scalar_dofs_coarse =
-        scheme.n_dofs_per_cell_coarse / n_components;
+      batch.scheme = &scheme;
 
       for (unsigned int cell = 0; cell < scheme.n_coarse_cells; cell += n_lanes)
         {
-          const unsigned int n_lanes_filled =
-            (cell + n_lanes > scheme.n_coarse_cells) ?
-              (scheme.n_coarse_cells - cell) :
-              n_lanes;
-
-          // read from src vector (similar to FEEvaluation::read_dof_values())
-          internal::VectorReader<Number, VectorizedArrayType> reader;
-          constraint_info.read_write_operation(reader,
-                                               *vec_coarse_ptr,
-                                               evaluation_data_coarse,
-                                               cell_counter,
-                                               n_lanes_filled,
-                                               scheme.n_dofs_per_cell_coarse,
-                                               true);
-          constraint_info.apply_hanging_node_constraints(
-            cell_counter, n_lanes_filled, false, evaluation_data_coarse);
-
-          cell_counter += n_lanes_filled;
-
-          // ---------------------------- coarse -------------------------------
-          if (needs_interpolation)
-            for (int c = n_components - 1; c >= 0; --c)
-              {
-                CellProlongator<dim, VectorizedArrayType> cell_prolongator(
-                  scheme.prolongation_matrix,
-                  scheme.prolongation_matrix_1d,
-                  evaluation_data_coarse.begin() + c * n_scalar_dofs_coarse,
-                  evaluation_data_fine.begin() + c * n_scalar_dofs_fine);
-
-                if (scheme.prolongation_matrix_1d.size() > 0)
-                  cell_transfer.run(cell_prolongator);
-                else
-                  cell_prolongator.run_full(n_scalar_dofs_fine,
-                                            n_scalar_dofs_coarse);
-              }
+          batch.n_lanes_filled = (cell + n_lanes > scheme.n_coarse_cells) ?
+                                   (scheme.n_coarse_cells - cell) :
+                                   n_lanes;
+
+          const auto &row_starts = constraint_info.row_starts;
+          const auto  begin      = constraint_info.dof_indices.begin() +
+                             row_starts[batch.cell_counter].first;
+          const auto end =
+            constraint_info.dof_indices.begin() +
+            row_starts[batch.cell_counter + batch.n_lanes_filled].first;
+          if (src_ghosts_set ||
+              std::all_of(begin, end, [&](const unsigned int i) {
+                return i < n_owned_coarse;
+              }))
+            process_cell_batch(batch);
           else
-            evaluation_data_fine = evaluation_data_coarse; // TODO
-          // ------------------------------ fine -------------------------------
+            deferred_batches.push_back(batch);
 
-          // weight and write into dst vector
+          batch.cell_counter += batch.n_lanes_filled;
+          batch.indices_fine +=
+            batch.n_lanes_filled * scheme.n_dofs_per_cell_fine;
+          if (fine_element_is_continuous)
+            batch.weights += batch.n_lanes_filled * scheme.n_dofs_per_cell_fine;
           if (fine_element_is_continuous && this->weights_compressed.size() > 0)
-            {
-              internal::weight_fe_q_dofs_by_entity<dim, -1, Number>(
-                weights_compressed,
-                n_components,
-                scheme.degree_fine + 1,
-                evaluation_data_fine.begin());
-              weights_compressed += Utilities::pow(3, dim);
-            }
-
-          for (unsigned int v = 0; v < n_lanes_filled; ++v)
-            {
-              if (fine_element_is_continuous &&
-                  this->weights_compressed.size() == 0)
-                for (unsigned int i = 0; i < scheme.n_dofs_per_cell_fine; ++i)
-                  vec_fine_ptr->local_element(indices_fine[i]) +=
-                    evaluation_data_fine[i][v] * weights[i];
-              else
-                for (unsigned int i = 0; i < scheme.n_dofs_per_cell_fine; ++i)
-                  vec_fine_ptr->local_element(indices_fine[i]) +=
-                    evaluation_data_fine[i][v];
-
-              indices_fine += scheme.n_dofs_per_cell_fine;
-
-              if (fine_element_is_continuous)
-                weights += scheme.n_dofs_per_cell_fine;
-            }
+            batch.weights_compressed += Utilities::pow(3, dim);
         }
     }
 
+  if (src_ghosts_set == false)
+    vec_coarse_ptr->update_ghost_values_finish();
+
+  for (const CellBatch &deferred_batch : deferred_batches)
+    process_cell_batch(deferred_batch);
+
   if (fine_element_is_continuous || use_dst_inplace == false)
     vec_fine_ptr->compress(VectorOperation::add);
 
   if (use_dst_inplace == false)
     dst += this->vec_fine;
 
-  if (use_src_inplace)
+  if (use_src_inplace && src_ghosts_set == false)
     vec_coarse_ptr->zero_out_ghost_values();
 }
 
@@ -0,0 +1,706 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_mg_vertex_patch_relaxation_h
+#define dealii_mg_vertex_patch_relaxation_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/geometry_info.h>
+#include <deal.II/base/graph_coloring.h>
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
+#include <deal.II/base/smartpointer.h>
+#include <deal.II/base/subscriptor.h>
+#include <deal.II/base/table.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/lac/diagonal_matrix.h>
+#include <deal.II/lac/tensor_product_matrix.h>
+
+#include <array>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+/*!@addtogroup mg */
+/*@{*/
+
+/**
+ * A relaxation method for matrix-free operators that solves local problems
+ * on vertex patches, i.e., on the $2^d$ cells around each interior vertex of
+ * the mesh, with homogeneous Dirichlet conditions on the boundary of the
+ * patch. The corrections of all patches are added with a damping factor,
+ * giving an additive overlapping Schwarz method. Such smoothers are much
+ * more robust than point smoothers for high polynomial degrees.
+ *
+ * The class is meant to be used as a smoother within multigrid via
+ * mg::SmootherRelaxation, for example on the levels of a
+ * MGTransferGlobalCoarsening hierarchy:
+ * @code
+ * using SmootherType =
+ *   MGVertexPatchRelaxation<dim, LevelMatrixType, VectorType>;
+ * mg::SmootherRelaxation<SmootherType, VectorType> mg_smoother;
+ * MGLevelObject<typename SmootherType::AdditionalData> smoother_data(
+ *   min_level, max_level);
+ * mg_smoother.initialize(mg_matrices, smoother_data);
+ * @endcode
+ * The operator @p MatrixType must provide the function get_matrix_free()
+ * returning a (shared) pointer to the MatrixFree object, as the classes
+ * derived from MatrixFreeOperators::Base do, and vmult() for the computation
+ * of residuals. The patches are built from the active cells of the
+ * underlying DoFHandler if the MatrixFree object has been set up for the
+ * active cells, and from the cells of the respective level otherwise.
+ *
+ * <h3>Patch inverses</h3>
+ *
+ * The local problems are not extracted from the operator. Instead, the
+ * patch matrices are set up for the operator
+ * $-\nabla \cdot (a \nabla u) + c u$ with constant coefficients given by
+ * AdditionalData::laplace_coefficient and AdditionalData::mass_coefficient,
+ * discretized on the Cartesian patch with the extents of the cells in the
+ * coordinate directions. This gives a sum of Kronecker products of 1D mass
+ * and stiffness matrices whose inverse is applied by the fast
+ * diagonalization method of TensorProductMatrixSymmetricSum. The patch
+ * matrices are exact for axis-parallel meshes and an approximation on
+ * general meshes. Patches with the same cell extents share the same
+ * TensorProductMatrixSymmetricSum object.
+ *
+ * The present implementation supports continuous scalar elements with
+ * tensor-product shape functions, i.e., FE_Q, on meshes where each interior
+ * vertex is surrounded by $2^d$ cells in the standard orientation, such as
+ * the meshes from GridGenerator::hyper_cube() and
+ * GridGenerator::subdivided_hyper_rectangle(). Vertices with another number
+ * of adjacent cells, or cells owned by other MPI processes, are skipped, as
+ * are patches with unknowns that are not locally owned. On adaptively
+ * refined meshes, patches whose cells are not all on the same refinement
+ * level are skipped too, so that no unknown constrained by a hanging node is
+ * part of a patch. The unknowns not inside any patch, like those on Neumann
+ * boundaries, next to processor boundaries, or next to hanging nodes, are
+ * relaxed by point-Jacobi with the inverse diagonal given by
+ * AdditionalData::diagonal_inverse, or left unchanged if none is given.
+ * Since the patch matrices use constant coefficients on Cartesian patches,
+ * they are only an approximation of the local problems of operators with
+ * variable coefficients or on deformed cells, which makes the smoother less
+ * effective in these cases.
+ *
+ * <h3>Thread parallelism</h3>
+ *
+ * The patches are colored with GraphColoring::make_graph_coloring() such
+ * that patches of the same color do not share unknowns. The patches of one
+ * color are then processed in parallel with parallel::apply_to_subranges(),
+ * and the colors one after the other.
+ */
+template <int dim, typename MatrixType, typename VectorType>
+class MGVertexPatchRelaxation : public Subscriptor
+{
+public:
+  /**
+   * Declare type for container size.
+   */
+  using size_type = types::global_dof_index;
+
+  /**
+   * The number type of the vectors.
+   */
+  using Number = typename VectorType::value_type;
+
+  /**
+   * Standardized data struct to pipe additional parameters to the
+   * relaxation.
+   */
+  struct AdditionalData
+  {
+    /**
+     * Constructor.
+     */
+    AdditionalData(
+      const double       relaxation          = 1. / (1 << dim),
+      const Number       laplace_coefficient = 1.,
+      const Number       mass_coefficient    = 0.,
+      const unsigned int dof_handler_index   = 0,
+      const std::shared_ptr<DiagonalMatrix<VectorType>> &diagonal_inverse =
+        std::shared_ptr<DiagonalMatrix<VectorType>>());
+
+    /**
+     * The damping factor of the additive Schwarz method. As each unknown in
+     * the interior of a cell is contained in up to $2^d$ patches, the
+     * default is $2^{-d}$.
+     */
+    double relaxation;
+
+    /**
+     * The coefficient of the Laplacian in the operator the patch matrices
+     * are set up for.
+     */
+    Number laplace_coefficient;
+
+    /**
+     * The coefficient of the mass term in the operator the patch matrices
+     * are set up for.
+     */
+    Number mass_coefficient;
+
+    /**
+     * The index of the DoFHandler within the MatrixFree object.
+     */
+    unsigned int dof_handler_index;
+
+    /**
+     * The inverse of the diagonal of the operator, used for the unknowns
+     * that are not inside any patch. May be empty.
+     */
+    std::shared_ptr<DiagonalMatrix<VectorType>> diagonal_inverse;
+  };
+
+  /**
+   * Constructor.
+   */
+  MGVertexPatchRelaxation() = default;
+
+  /**
+   * Build the patches and their inverses for the operator @p matrix.
+   */
+  void
+  initialize(const MatrixType &    matrix,
+             const AdditionalData &additional_data = AdditionalData());
+
+  /**
+   * Release all memory and reset the object.
+   */
+  void
+  clear();
+
+  /**
+   * Apply the preconditioner, i.e., compute the sum of the damped patch
+   * corrections to @p src.
+   */
+  void
+  vmult(VectorType &dst, const VectorType &src) const;
+
+  /**
+   * Same as vmult(), since the relaxation is symmetric.
+   */
+  void
+  Tvmult(VectorType &dst, const VectorType &src) const;
+
+  /**
+   * Perform one relaxation step, i.e., add the damped patch corrections of
+   * the residual <tt>src - A dst</tt> to @p dst.
+   */
+  void
+  step(VectorType &dst, const VectorType &src) const;
+
+  /**
+   * Same as step(), since the relaxation is symmetric.
+   */
+  void
+  Tstep(VectorType &dst, const VectorType &src) const;
+
+  /**
+   * Return the number of patches.
+   */
+  unsigned int
+  n_patches() const;
+
+  /**
+   * Return the number of colors the patches were split into.
+   */
+  unsigned int
+  n_colors() const;
+
+  /**
+   * Return the memory consumption of this object in bytes.
+   */
+  std::size_t
+  memory_consumption() const;
+
+  /**
+   * Exception.
+   */
+  DeclExceptionMsg(ExcNotImplementedForElement,
+                   "MGVertexPatchRelaxation is only implemented for scalar "
+                   "continuous elements with tensor-product shape "
+                   "functions, i.e., FE_Q.");
+
+private:
+  /**
+   * Add the damped patch corrections of @p residual to @p dst.
+   */
+  void
+  apply_patches(VectorType &dst, const VectorType &residual) const;
+
+  /**
+   * Pointer to the operator.
+   */
+  SmartPointer<const MatrixType, MGVertexPatchRelaxation> matrix;
+
+  /**
+   * The parameters passed to initialize().
+   */
+  AdditionalData additional_data;
+
+  /**
+   * The number of unknowns inside a patch, $(2k-1)^d$ for elements of
+   * degree $k$.
+   */
+  unsigned int n_dofs_per_patch;
+
+  /**
+   * The indices of the unknowns of all patches within the locally owned
+   * range of the vectors, in lexicographic order within each patch.
+   */
+  std::vector<unsigned int> patch_dof_indices;
+
+  /**
+   * The index into @p patch_inverses for each patch.
+   */
+  std::vector<unsigned int> patch_to_inverse;
+
+  /**
+   * The different patch matrices.
+   */
+  std::vector<TensorProductMatrixSymmetricSum<dim, Number>> patch_inverses;
+
+  /**
+   * The patches grouped by colors.
+   */
+  std::vector<std::vector<unsigned int>> colored_patches;
+
+  /**
+   * The locally owned unknowns not inside any patch.
+   */
+  std::vector<unsigned int> uncovered_dof_indices;
+
+  /**
+   * Temporary vector for the residual.
+   */
+  mutable VectorType residual;
+};
+
+/*@}*/
+
+
+/* ------------------------- Inline functions ------------------------- */
+
+
+#ifndef DOXYGEN
+
+template <int dim, typename MatrixType, typename VectorType>
+inline MGVertexPatchRelaxation<dim, MatrixType, VectorType>::AdditionalData::
+  AdditionalData(
+    const double       relaxation,
+    const Number       laplace_coefficient,
+    const Number       mass_coefficient,
+    const unsigned int dof_handler_index,
+    const std::shared_ptr<DiagonalMatrix<VectorType>> &diagonal_inverse)
+  : relaxation(relaxation)
+  , laplace_coefficient(laplace_coefficient)
+  , mass_coefficient(mass_coefficient)
+  , dof_handler_index(dof_handler_index)
+  , diagonal_inverse(diagonal_inverse)
+{}
+
+
+
+template <int dim, typename MatrixType, typename VectorType>
+void
+MGVertexPatchRelaxation<dim, MatrixType, VectorType>::initialize(
+  const MatrixType &    matrix,
+  const AdditionalData &additional_data)
+{
+  clear();
+  this->matrix          = &matrix;
+  this->additional_data = additional_data;
+
+  const auto &              matrix_free = *matrix.get_matrix_free();
+  const unsigned int        dof_no      = additional_data.dof_handler_index;
+  const DoFHandler<dim> &   dof_handler = matrix_free.get_dof_handler(dof_no);
+  const FiniteElement<dim> &fe          = dof_handler.get_fe();
+  const unsigned int        degree      = fe.degree;
+  AssertThrow(fe.n_components() == 1 && fe.n_dofs_per_vertex() == 1 &&
+                fe.n_dofs_per_cell() == Utilities::pow(degree + 1, dim),
+              ExcNotImplementedForElement());
+
+  const auto &shape_info = matrix_free.get_shape_info(dof_no);
+  const std::vector<unsigned int> &lexicographic =
+    shape_info.lexicographic_numbering;
+
+  // 1D mass and stiffness matrices on the unit interval
+  const auto &       shape_data = shape_info.data.front();
+  const unsigned int n_q_1d     = shape_data.n_q_points_1d;
+  Table<2, Number>   mass_1d(degree + 1, degree + 1);
+  Table<2, Number>   stiffness_1d(degree + 1, degree + 1);
+  for (unsigned int i = 0; i <= degree; ++i)
+    for (unsigned int j = 0; j <= degree; ++j)
+      for (unsigned int q = 0; q < n_q_1d; ++q)
+        {
+          const Number weight = shape_data.quadrature.weight(q);
+          mass_1d(i, j) += shape_data.shape_values[i * n_q_1d + q][0] *
+                           shape_data.shape_values[j * n_q_1d + q][0] * weight;
+          stiffness_1d(i, j) +=
+            shape_data.shape_gradients[i * n_q_1d + q][0] *
+            shape_data.shape_gradients[j * n_q_1d + q][0] * weight;
+        }
+
+  // collect the cells around each vertex along with the position of the
+  // cell within the patch, which follows from the local index of the vertex
+  // within the cell
+  const unsigned int level = matrix_free.get_mg_level();
+  constexpr unsigned int n_cells_per_patch =
+    GeometryInfo<dim>::vertices_per_cell;
+  std::map<unsigned int,
+           std::vector<std::pair<typename DoFHandler<dim>::cell_iterator,
+                                 unsigned int>>>
+    vertex_to_cells;
+  const auto add_cell = [&](const auto &cell, const bool is_locally_owned) {
+    for (const unsigned int v : cell->vertex_indices())
+      {
+        auto &cells = vertex_to_cells[cell->vertex_index(v)];
+        // mark the patch invalid if any of its cells is not locally owned
+        if (is_locally_owned == false)
+          cells.resize(n_cells_per_patch + 1);
+        else if (cells.size() < n_cells_per_patch + 1)
+          cells.emplace_back(cell, n_cells_per_patch - 1 - v);
+      }
+  };
+  if (level == numbers::invalid_unsigned_int)
+    for (const auto &cell : dof_handler.active_cell_iterators())
+      {
+        if (cell->is_artificial() == false)
+          add_cell(cell, cell->is_locally_owned());
+      }
+  else
+    for (const auto &cell : dof_handler.mg_cell_iterators_on_level(level))
+      if (cell->is_artificial_on_level() == false)
+        add_cell(cell, cell->is_locally_owned_on_level());
+
+  const auto partitioner = matrix_free.get_vector_partitioner(dof_no);
+  const unsigned int n_1d = 2 * degree - 1;
+  n_dofs_per_patch        = Utilities::pow(n_1d, dim);
+
+  std::map<std::array<double, 2 * dim>, unsigned int> inverse_indices;
+  std::vector<types::global_dof_index> dof_indices(fe.n_dofs_per_cell());
+  std::vector<bool> is_covered(partitioner->locally_owned_size(), false);
+  std::vector<unsigned int> local_indices(n_dofs_per_patch);
+  for (const auto &vertex_and_cells : vertex_to_cells)
+    {
+      const auto &cells = vertex_and_cells.second;
+      if (cells.size() != n_cells_per_patch)
+        continue;
+
+      // check that the cells around the vertex fill the patch, i.e., they
+      // are in the standard orientation
+      std::array<typename DoFHandler<dim>::cell_iterator, n_cells_per_patch>
+                                              patch_cells;
+      std::array<bool, n_cells_per_patch> found = {};
+      for (const auto &cell_and_position : cells)
+        {
+          found[cell_and_position.second]       = true;
+          patch_cells[cell_and_position.second] = cell_and_position.first;
+        }
+      if (std::find(found.begin(), found.end(), false) != found.end())
+        continue;
+
+      // on adaptively refined meshes, the cells around a vertex can be on
+      // different levels, in which case unknowns inside the patch are
+      // constrained by hanging nodes. skip such patches
+      bool same_level = true;
+      for (unsigned int c = 1; c < n_cells_per_patch; ++c)
+        if (patch_cells[c]->level() != patch_cells[0]->level())
+          same_level = false;
+      if (same_level == false)
+        continue;
+
+      // extract the unknowns inside the patch. the patch is skipped if any
+      // of them is not locally owned, as the correction is only added to
+      // the locally owned entries of the vector
+      bool is_locally_owned = true;
+      for (unsigned int c = 0; c < n_cells_per_patch; ++c)
+        {
+          if (level == numbers::invalid_unsigned_int)
+            patch_cells[c]->get_dof_indices(dof_indices);
+          else
+            patch_cells[c]->get_mg_dof_indices(dof_indices);
+
+          for (unsigned int i = 0; i < dof_indices.size(); ++i)
+            {
+              unsigned int index_within_patch = 0;
+              bool         is_inside          = true;
+              for (unsigned int d = 0, stride = 1; d < dim; ++d)
+                {
+                  const unsigned int i_d =
+                    (i / Utilities::pow(degree + 1, d)) % (degree + 1);
+                  const unsigned int index_1d = ((c >> d) & 1) * degree + i_d;
+                  if (index_1d == 0 || index_1d == 2 * degree)
+                    {
+                      is_inside = false;
+                      break;
+                    }
+                  index_within_patch += (index_1d - 1) * stride;
+                  stride *= n_1d;
+                }
+              if (is_inside == false)
+                continue;
+
+              const types::global_dof_index dof_index =
+                dof_indices[lexicographic[i]];
+              if (partitioner->in_local_range(dof_index))
+                local_indices[index_within_patch] =
+                  partitioner->global_to_local(dof_index);
+              else
+                is_locally_owned = false;
+            }
+        }
+      if (is_locally_owned == false)
+        continue;
+
+      for (const unsigned int index : local_indices)
+        {
+          AssertIndexRange(index, is_covered.size());
+          is_covered[index] = true;
+        }
+      patch_dof_indices.insert(patch_dof_indices.end(),
+                               local_indices.begin(),
+                               local_indices.end());
+
+      // set up the 1D patch matrices from the extents of the cells in the
+      // coordinate directions, or re-use the inverse of a patch with the
+      // same extents
+      std::array<double, 2 * dim> extents;
+      for (unsigned int d = 0; d < dim; ++d)
+        {
+          extents[2 * d]     = patch_cells[0]->extent_in_direction(d);
+          extents[2 * d + 1] = patch_cells[1 << d]->extent_in_direction(d);
+        }
+      const auto entry =
+        inverse_indices.emplace(extents, patch_inverses.size());
+      patch_to_inverse.push_back(entry.first->second);
+      if (entry.second == false)
+        continue;
+
+      std::array<Table<2, Number>, dim> mass_matrices;
+      std::array<Table<2, Number>, dim> derivative_matrices;
+      for (unsigned int d = 0; d < dim; ++d)
+        {
+          mass_matrices[d].reinit(n_1d, n_1d);
+          derivative_matrices[d].reinit(n_1d, n_1d);
+          for (unsigned int c = 0; c < 2; ++c)
+            {
+              const Number h = extents[2 * d + c];
+              for (unsigned int i = 0; i <= degree; ++i)
+                for (unsigned int j = 0; j <= degree; ++j)
+                  {
+                    const unsigned int i_patch = c * degree + i;
+                    const unsigned int j_patch = c * degree + j;
+                    if (i_patch == 0 || i_patch == 2 * degree ||
+                        j_patch == 0 || j_patch == 2 * degree)
+                      continue;
+                    mass_matrices[d](i_patch - 1, j_patch - 1) +=
+                      h * mass_1d(i, j);
+                    derivative_matrices[d](i_patch - 1, j_patch - 1) +=
+                      additional_data.laplace_coefficient / h *
+                        stiffness_1d(i, j) +
+                      additional_data.mass_coefficient / dim * h *
+                        mass_1d(i, j);
+                  }
+            }
+        }
+      patch_inverses.emplace_back(mass_matrices, derivative_matrices);
+    }
+
+  for (unsigned int i = 0; i < is_covered.size(); ++i)
+    if (is_covered[i] == false)
+      uncovered_dof_indices.push_back(i);
+
+  // color the patches such that patches with the same color do not share
+  // any unknowns
+  if (patch_to_inverse.size() > 0)
+    {
+      std::vector<unsigned int> patches(patch_to_inverse.size());
+      for (unsigned int p = 0; p < patches.size(); ++p)
+        patches[p] = p;
+      using Iterator   = std::vector<unsigned int>::const_iterator;
+      const auto begin = patches.cbegin();
+      const auto colors =
+        GraphColoring::make_graph_coloring<Iterator>(
+          begin, patches.cend(), [&](const Iterator &it) {
+            return std::vector<types::global_dof_index>(
+              patch_dof_indices.begin() + *it * n_dofs_per_patch,
+              patch_dof_indices.begin() + (*it + 1) * n_dofs_per_patch);
+          });
+      colored_patches.resize(colors.size());
+      for (unsigned int c = 0; c < colors.size(); ++c)
+        for (const Iterator &it : colors[c])
+          colored_patches[c].push_back(*it);
+    }
+
+  matrix.initialize_dof_vector(residual);
+}
+
+
+
+template <int dim, typename MatrixType, typename VectorType>
+void
+MGVertexPatchRelaxation<dim, MatrixType, VectorType>::clear()
+{
+  matrix           = nullptr;
+  n_dofs_per_patch = 0;
+  patch_dof_indices.clear();
+  patch_to_inverse.clear();
+  patch_inverses.clear();
+  colored_patches.clear();
+  uncovered_dof_indices.clear();
+  residual.reinit(0);
+}
+
+
+
+template <int dim, typename MatrixType, typename VectorType>
+void
+MGVertexPatchRelaxation<dim, MatrixType, VectorType>::apply_patches(
+  VectorType &      dst,
+  const VectorType &residual) const
+{
+  const Number relaxation = additional_data.relaxation;
+
+  for (const std::vector<unsigned int> &patches : colored_patches)
+    parallel::apply_to_subranges(
+      0U,
+      static_cast<unsigned int>(patches.size()),
+      [&](const unsigned int begin, const unsigned int end) {
+        std::vector<Number> src_patch(n_dofs_per_patch);
+        std::vector<Number> dst_patch(n_dofs_per_patch);
+        for (unsigned int p = begin; p < end; ++p)
+          {
+            const unsigned int *indices =
+              patch_dof_indices.data() + patches[p] * n_dofs_per_patch;
+            for (unsigned int i = 0; i < n_dofs_per_patch; ++i)
+              src_patch[i] = residual.local_element(indices[i]);
+            patch_inverses[patch_to_inverse[patches[p]]].apply_inverse(
+              make_array_view(dst_patch), make_array_view(src_patch));
+            for (unsigned int i = 0; i < n_dofs_per_patch; ++i)
+              dst.local_element(indices[i]) += relaxation * dst_patch[i];
+          }
+      },
+      64);
+
+  if (additional_data.diagonal_inverse != nullptr)
+    {
+      const VectorType &diagonal =
+        additional_data.diagonal_inverse->get_vector();
+      for (const unsigned int i : uncovered_dof_indices)
+        dst.local_element(i) +=
+          relaxation * diagonal.local_element(i) * residual.local_element(i);
+    }
+}
+
+
+
+template <int dim, typename MatrixType, typename VectorType>
+void
+MGVertexPatchRelaxation<dim, MatrixType, VectorType>::vmult(
+  VectorType &      dst,
+  const VectorType &src) const
+{
+  Assert(matrix != nullptr, ExcNotInitialized());
+  dst = Number();
+  apply_patches(dst, src);
+}
+
+
+
+template <int dim, typename MatrixType, typename VectorType>
+void
+MGVertexPatchRelaxation<dim, MatrixType, VectorType>::Tvmult(
+  VectorType &      dst,
+  const VectorType &src) const
+{
+  vmult(dst, src);
+}
+
+
+
+template <int dim, typename MatrixType, typename VectorType>
+void
+MGVertexPatchRelaxation<dim, MatrixType, VectorType>::step(
+  VectorType &      dst,
+  const VectorType &src) const
+{
+  Assert(matrix != nullptr, ExcNotInitialized());
+  matrix->vmult(residual, dst);
+  residual.sadd(-1., 1., src);
+  apply_patches(dst, residual);
+}
+
+
+
+template <int dim, typename MatrixType, typename VectorType>
+void
+MGVertexPatchRelaxation<dim, MatrixType, VectorType>::Tstep(
+  VectorType &      dst,
+  const VectorType &src) const
+{
+  step(dst, src);
+}
+
+
+
+template <int dim, typename MatrixType, typename VectorType>
+inline unsigned int
+MGVertexPatchRelaxation<dim, MatrixType, VectorType>::n_patches() const
+{
+  return patch_to_inverse.size();
+}
+
+
+
+template <int dim, typename MatrixType, typename VectorType>
+inline unsigned int
+MGVertexPatchRelaxation<dim, MatrixType, VectorType>::n_colors() const
+{
+  return colored_patches.size();
+}
+
+
+
+template <int dim, typename MatrixType, typename VectorType>
+std::size_t
+MGVertexPatchRelaxation<dim, MatrixType, VectorType>::memory_consumption()
+  const
+{
+  return MemoryConsumption::memory_consumption(patch_dof_indices) +
+         MemoryConsumption::memory_consumption(patch_to_inverse) +
+         patch_inverses.size() *
+           (sizeof(TensorProductMatrixSymmetricSum<dim, Number>) +
+            static_cast<std::size_t>(3 * dim *
+                                     std::pow(n_dofs_per_patch, 2. / dim)) *
+              sizeof(Number)) +
+         MemoryConsumption::memory_consumption(colored_patches) +
+         MemoryConsumption::memory_consumption(uncovered_dof_indices) +
+         residual.memory_consumption();
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -156,6 +156,31 @@ namespace mg
  * vector. This is a nontrivial operation, usually initiated automatically by
  * the class PreconditionMG and performed by the classes derived from
  * MGTransferBase.
+ *
+ * <h3>Additive cycles</h3>
+ *
+ * Besides the multiplicative V-, W-, and F-cycles, where the correction on a
+ * level is only computed after the corrections on all coarser levels have
+ * been finished, this class implements two additive cycles, selected by
+ * #additive_cycle and #afacx_cycle. There, the defect of the finest level is
+ * restricted to all levels first, then the corrections of the levels are
+ * computed independently of each other, and finally the corrections are
+ * interpolated to the finest level and summed up. Additive cycles typically
+ * need more iterations of the outer solver than multiplicative ones, but the
+ * level corrections can be computed at the same time: As the coarse levels
+ * contain little work, a multiplicative cycle leaves most cores idle
+ * while it works on them, whereas an additive cycle can use the idle cores
+ * on the coarse levels while the fine levels are processed. This is enabled
+ * by set_concurrent_level_corrections(), which runs the level corrections
+ * as separate tasks.
+ *
+ * The BPX cycle is symmetric as long as the smoother and the coarse grid
+ * solver are symmetric, and can hence be used as a preconditioner for
+ * SolverCG. The AFACx cycle is not symmetric in general and should be
+ * combined with SolverGMRES or SolverFGMRES.
+ *
+ * @note The additive cycles do not support edge matrices, i.e., they are
+ * restricted to global coarsening or uniformly refined meshes.
  */
 template <typename VectorType>
 class Multigrid : public Subscriptor
@@ -171,7 +196,26 @@ public:
     /// The W-cycle
     w_cycle,
     /// The F-cycle
-    f_cycle
+    f_cycle,
+    /**
+     * The additive cycle of Bramble, Pasciak, and Xu (BPX). The correction
+     * on each level is one application of the pre-smoother to the defect
+     * restricted to that level, except for the coarsest level where the
+     * coarse grid solver is used. The corrections are interpolated to the
+     * finest level and added.
+     */
+    additive_cycle,
+    /**
+     * The additive cycle with multiplicative smoothing by Vassilevski and
+     * McCormick (AFACx). The correction on each level but the coarsest is
+     * computed from the restricted defect in two steps: the pre-smoother is
+     * applied to the defect on the next coarser level, and the post-smoother
+     * is applied to the defect on the level itself remaining after that
+     * coarse approximation. Only the latter part enters the result. This
+     * removes the error components shared by neighboring levels that make
+     * BPX converge slower than a multiplicative cycle.
+     */
+    afacx_cycle
   };
 
   using vector_type       = VectorType;
@@ -305,6 +349,26 @@ public:
    */
   void set_cycle(Cycle);
 
+  /**
+   * Select whether the level corrections of the additive cycles
+   * #additive_cycle and #afacx_cycle are computed concurrently, with one
+   * task per level, or one after the other. The default is false. The
+   * transfer between levels is always done sequentially, and the setting
+   * has no effect on the multiplicative cycles.
+   *
+   * Enabling this function requires that the smoother, the coarse grid
+   * solver, and the level matrices can be applied on different levels at
+   * the same time, which is the case as long as they do not share
+   * temporary data between the levels. The signals of this class are then
+   * triggered from several threads at the same time. In parallel
+   * computations with MPI, the level vectors and operators additionally
+   * need to communicate on separate communicators, e.g. obtained by
+   * Utilities::MPI::duplicate_communicator() for each level, and MPI needs
+   * to be initialized with support for MPI_THREAD_MULTIPLE.
+   */
+  void
+  set_concurrent_level_corrections(const bool concurrent);
+
   /**
    * Connect a function to mg::Signals::pre_smoother_step.
    */
@@ -379,11 +443,24 @@ private:
   void
   level_step(const unsigned int level, Cycle cycle);
 
+  /**
+   * The additive cycles #additive_cycle and #afacx_cycle, operating on all
+   * levels at once.
+   */
+  void
+  additive_step();
+
   /**
    * Cycle type performed by the method cycle().
    */
   Cycle cycle_type;
 
+  /**
+   * Whether the level corrections of the additive cycles are computed
+   * concurrently, see set_concurrent_level_corrections().
+   */
+  bool concurrent_level_corrections;
+
   /**
    * Level for coarse grid solution.
    */
@@ -413,10 +490,18 @@ private:
   MGLevelObject<VectorType> t;
 
   /**
-   * Auxiliary vector for W- and F-cycles. Left uninitialized in V-cycle.
+   * Auxiliary vector for W- and F-cycles and the additive cycles. Left
+   * uninitialized in V-cycle.
    */
   MGLevelObject<VectorType> defect2;
 
+  /**
+   * Auxiliary vectors for the coarse approximation in the AFACx cycle. Left
+   * uninitialized in the other cycles.
+   */
+  MGLevelObject<VectorType> aux_defect;
+  MGLevelObject<VectorType> aux_solution;
+
 
   /**
    * The matrix for each level.
@@ -659,6 +744,7 @@ Multigrid<VectorType>::Multigrid(const MGMatrixBase<VectorType> &    matrix,
                                  const unsigned int                max_level,
                                  Cycle                             cycle)
   : cycle_type(cycle)
+  , concurrent_level_corrections(false)
   , matrix(&matrix, typeid(*this).name())
   , coarse(&coarse, typeid(*this).name())
   , transfer(&transfer, typeid(*this).name())
@@ -20,9 +20,11 @@
 #include <deal.II/base/config.h>
 
 #include <deal.II/base/logstream.h>
+#include <deal.II/base/thread_management.h>
 
 #include <deal.II/multigrid/multigrid.h>
 
+#include <functional>
 #include <iostream>
 
 DEAL_II_NAMESPACE_OPEN
@@ -40,7 +42,7 @@ Multigrid<VectorType>::reinit(const unsigned int min_level,
          ExcLowerRangeType<unsigned int>(max_level, min_level));
   minlevel = min_level;
   maxlevel = max_level;
-  // solution, t and defect2 are resized in cycle()
+  // solution, t, defect2 and the auxiliary vectors are resized in cycle()
   defect.resize(minlevel, maxlevel);
 }
 
@@ -74,6 +76,15 @@ Multigrid<VectorType>::set_cycle(typename Multigrid<VectorType>::Cycle c)
 
 
 
+template <typename VectorType>
+void
+Multigrid<VectorType>::set_concurrent_level_corrections(const bool concurrent)
+{
+  concurrent_level_corrections = concurrent;
+}
+
+
+
 template <typename VectorType>
 void
 Multigrid<VectorType>::set_edge_matrices(
@@ -265,6 +276,121 @@ Multigrid<VectorType>::level_step(const unsigned int level, Cycle cycle)
 
 
 
+template <typename VectorType>
+void
+Multigrid<VectorType>::additive_step()
+{
+  Assert(edge_out == nullptr && edge_in == nullptr && edge_down == nullptr &&
+           edge_up == nullptr,
+         ExcMessage("The additive cycles do not support edge matrices."));
+
+  // Restrict the defect to all levels and combine it with the defect from
+  // the initial copy_to_mg. For AFACx, the part restricted from the next
+  // finer level is also kept separately, as it is the right hand side of the
+  // coarse approximation. The transfer is done level by level because
+  // implementations of MGTransferBase may share ghosted vectors between
+  // neighboring levels.
+  defect2[maxlevel] = defect[maxlevel];
+  for (unsigned int level = maxlevel; level > minlevel; --level)
+    {
+      this->signals.restriction(true, level);
+      if (cycle_type == afacx_cycle)
+        {
+          aux_defect[level - 1] = typename VectorType::value_type(0.);
+          transfer->restrict_and_add(level,
+                                     aux_defect[level - 1],
+                                     defect2[level]);
+          defect2[level - 1] = defect[level - 1];
+          defect2[level - 1] += aux_defect[level - 1];
+        }
+      else
+        {
+          defect2[level - 1] = defect[level - 1];
+          transfer->restrict_and_add(level, defect2[level - 1], defect2[level]);
+        }
+      this->signals.restriction(false, level);
+    }
+
+  // Each task below only works on the vectors of a single level and uses
+  // the smoothers, matrices, and the coarse grid solver of a single level,
+  // with different tasks using different levels between two calls to
+  // join_all(), so the tasks can run concurrently. For AFACx, the coarse
+  // approximation of level minlevel+1 is computed by smoothing on minlevel,
+  // the level of the coarse grid solver, so these two are run one after
+  // the other within the same task.
+  Threads::TaskGroup<void> tasks;
+  const auto               run = [&](const std::function<void()> &work) {
+    if (concurrent_level_corrections)
+      tasks += Threads::new_task(work);
+    else
+      work();
+  };
+
+  const auto smooth_level_correction = [&](const unsigned int level) {
+    // BPX smooths the restricted defect, whereas AFACx computes the coarse
+    // approximation on the next coarser level
+    const unsigned int smooth_level =
+      (cycle_type == afacx_cycle) ? level - 1 : level;
+    VectorType &dst =
+      (cycle_type == afacx_cycle) ? aux_solution[level - 1] : solution[level];
+    const VectorType &src =
+      (cycle_type == afacx_cycle) ? aux_defect[level - 1] : defect2[level];
+
+    this->signals.pre_smoother_step(true, smooth_level);
+    pre_smooth->apply(smooth_level, dst, src);
+    this->signals.pre_smoother_step(false, smooth_level);
+  };
+
+  run([&]() {
+    this->signals.coarse_solve(true, minlevel);
+    (*coarse)(minlevel, solution[minlevel], defect2[minlevel]);
+    this->signals.coarse_solve(false, minlevel);
+
+    if (cycle_type == afacx_cycle && minlevel < maxlevel)
+      smooth_level_correction(minlevel + 1);
+  });
+  for (unsigned int level = minlevel + (cycle_type == afacx_cycle ? 2 : 1);
+       level <= maxlevel;
+       ++level)
+    run([&, level]() { smooth_level_correction(level); });
+  tasks.join_all();
+
+  if (cycle_type == afacx_cycle)
+    {
+      for (unsigned int level = minlevel + 1; level <= maxlevel; ++level)
+        {
+          this->signals.prolongation(true, level);
+          transfer->prolongate(level, t[level], aux_solution[level - 1]);
+          this->signals.prolongation(false, level);
+        }
+
+      // smooth the defect remaining after the coarse approximation; only
+      // this part enters the correction of the level
+      for (unsigned int level = minlevel + 1; level <= maxlevel; ++level)
+        run([&, level]() {
+          this->signals.residual_step(true, level);
+          matrix->vmult(level, aux_defect[level], t[level]);
+          aux_defect[level].sadd(-1.0, 1.0, defect2[level]);
+          this->signals.residual_step(false, level);
+
+          this->signals.post_smoother_step(true, level);
+          post_smooth->apply(level, solution[level], aux_defect[level]);
+          this->signals.post_smoother_step(false, level);
+        });
+      tasks.join_all();
+    }
+
+  // sum up the corrections from the coarsest to the finest level
+  for (unsigned int level = minlevel + 1; level <= maxlevel; ++level)
+    {
+      this->signals.prolongation(true, level);
+      transfer->prolongate_and_add(level, solution[level], solution[level - 1]);
+      this->signals.prolongation(false, level);
+    }
+}
+
+
+
 template <typename VectorType>
 void
 Multigrid<VectorType>::cycle()
@@ -279,6 +405,13 @@ Multigrid<VectorType>::cycle()
   if (cycle_type != v_cycle &&
       (defect2.min_level() != minlevel || defect2.max_level() != maxlevel))
     defect2.resize(minlevel, maxlevel);
+  if (cycle_type == afacx_cycle &&
+      (aux_defect.min_level() != minlevel ||
+       aux_defect.max_level() != maxlevel))
+    {
+      aux_defect.resize(minlevel, maxlevel);
+      aux_solution.resize(minlevel, maxlevel);
+    }
 
   // And now we go and reinit the vectors on the levels.
   for (unsigned int level = minlevel; level <= maxlevel; ++level)
@@ -289,10 +422,18 @@ Multigrid<VectorType>::cycle()
       t[level].reinit(defect[level], level > minlevel);
       if (cycle_type != v_cycle)
         defect2[level].reinit(defect[level]);
+      // the auxiliary vectors are always overwritten
+      if (cycle_type == afacx_cycle)
+        {
+          aux_defect[level].reinit(defect[level], true);
+          aux_solution[level].reinit(defect[level], true);
+        }
     }
 
   if (cycle_type == v_cycle)
     level_v_step(maxlevel);
+  else if (cycle_type == additive_cycle || cycle_type == afacx_cycle)
+    additive_step();
   else
     level_step(maxlevel, cycle_type);
 }
@@ -0,0 +1,137 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/parallel.h>
+#include <deal.II/base/utilities.h>
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef DEAL_II_HAVE_MADVISE
+#  include <sys/mman.h>
+#endif
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace internal
+{
+  namespace AlignedVectorImplementation
+  {
+    // the policy given to newly created objects. the constructor is
+    // constexpr, so this object is initialized before any static
+    // AlignedVector object asks for it
+    AlignedVectorAllocationPolicy default_allocation_policy;
+
+    // the size of transparent huge pages on x86-64 and on ARM64 with 4 kB
+    // base pages, which is also the alignment we use when requesting them
+    constexpr std::size_t huge_page_size = 2097152;
+
+    // the granularity of the first touch. the operating system places memory
+    // in units of (base) pages, so ranges given to different threads should
+    // not share a page
+    constexpr std::size_t page_size = 4096;
+
+
+
+    // write zeros into an array with a parallel loop over contiguous ranges
+    // of whole pages, splitting the pages evenly among the threads
+    class FirstTouch : private parallel::ParallelForInteger
+    {
+    public:
+      FirstTouch(char *const data, const std::size_t size)
+        : data(data)
+        , size(size)
+      {
+        const std::size_t n_pages   = (size + page_size - 1) / page_size;
+        const std::size_t n_threads = MultithreadInfo::n_threads();
+        if (n_threads == 1)
+          FirstTouch::apply_to_subrange(0, n_pages);
+        else
+          apply_parallel(0,
+                         n_pages,
+                         std::max<std::size_t>((n_pages + n_threads - 1) /
+                                                 n_threads,
+                                               1));
+      }
+
+      virtual void
+      apply_to_subrange(const std::size_t begin,
+                        const std::size_t end) const override
+      {
+        const std::size_t begin_byte = begin * page_size;
+        const std::size_t end_byte   = std::min(end * page_size, size);
+        if (end_byte > begin_byte)
+          std::memset(data + begin_byte, 0, end_byte - begin_byte);
+      }
+
+    private:
+      char *const       data;
+      const std::size_t size;
+    };
+  } // namespace AlignedVectorImplementation
+} // namespace internal
+
+
+
+void
+AlignedVectorAllocationPolicy::allocate(void **           memptr,
+                                        const std::size_t size) const
+{
+  const bool        is_large = size > 0 && size >= minimum_size;
+  const std::size_t alignment =
+    (use_huge_pages && is_large) ?
+      internal::AlignedVectorImplementation::huge_page_size :
+      64;
+
+  Utilities::System::posix_memalign(memptr, alignment, size);
+  if (is_large == false)
+    return;
+
+#if defined(DEAL_II_HAVE_MADVISE) && defined(MADV_HUGEPAGE)
+  // this is only a hint to the operating system that fails if transparent
+  // huge pages are not available, in which case we simply keep the memory
+  // as is
+  if (use_huge_pages)
+    {
+      const int ierr = madvise(*memptr, size, MADV_HUGEPAGE);
+      (void)ierr;
+    }
+#endif
+
+  if (parallel_first_touch)
+    internal::AlignedVectorImplementation::FirstTouch(
+      static_cast<char *>(*memptr), size);
+}
+
+
+
+void
+AlignedVectorAllocationPolicy::set_default(
+  const AlignedVectorAllocationPolicy &policy)
+{
+  internal::AlignedVectorImplementation::default_allocation_policy = policy;
+}
+
+
+
+const AlignedVectorAllocationPolicy &
+AlignedVectorAllocationPolicy::get_default()
+{
+  return internal::AlignedVectorImplementation::default_allocation_policy;
+}
+
+DEAL_II_NAMESPACE_CLOSE
@@ -34,6 +34,8 @@ namespace Utilities
       , n_procs(1)
       , communicator(MPI_COMM_SELF)
       , have_ghost_indices(false)
+      , use_persistent_requests(false)
+      , use_reduced_precision_communication(false)
     {}
 
 
@@ -50,6 +52,8 @@ namespace Utilities
       , n_procs(1)
       , communicator(MPI_COMM_SELF)
       , have_ghost_indices(false)
+      , use_persistent_requests(false)
+      , use_reduced_precision_communication(false)
     {
       locally_owned_range_data.add_range(0, size);
       locally_owned_range_data.compress();
@@ -72,6 +76,8 @@ namespace Utilities
       , n_procs(Utilities::MPI::n_mpi_processes(communicator))
       , communicator(communicator)
       , have_ghost_indices(true)
+      , use_persistent_requests(false)
+      , use_reduced_precision_communication(false)
     {
       types::global_dof_index prefix_sum = 0;
 
@@ -106,6 +112,8 @@ namespace Utilities
       , n_procs(1)
       , communicator(communicator_in)
       , have_ghost_indices(false)
+      , use_persistent_requests(false)
+      , use_reduced_precision_communication(false)
     {
       set_owned_indices(locally_owned_indices);
       set_ghost_indices(ghost_indices_in);
@@ -124,6 +132,8 @@ namespace Utilities
       , n_procs(1)
       , communicator(communicator_in)
       , have_ghost_indices(false)
+      , use_persistent_requests(false)
+      , use_reduced_precision_communication(false)
     {
       set_owned_indices(locally_owned_indices);
     }
@@ -466,6 +476,116 @@ namespace Utilities
 
 
 
+    void
+    Partitioner::enable_persistent_requests(const bool enable)
+    {
+      use_persistent_requests = enable;
+    }
+
+
+
+    void
+    Partitioner::enable_reduced_precision_communication(const bool enable)
+    {
+      use_reduced_precision_communication = enable;
+    }
+
+
+
+#ifdef DEAL_II_WITH_MPI
+    void
+    Partitioner::PersistentRequests::clear()
+    {
+      for (auto &request : requests)
+        {
+          const int ierr = MPI_Request_free(&request);
+          AssertThrowMPI(ierr);
+        }
+      requests.clear();
+      receive_buffer = nullptr;
+      send_buffer    = nullptr;
+      number_size    = 0;
+      mpi_tag        = 0;
+    }
+
+
+
+    void
+    Partitioner::initialize_persistent_requests(
+      PersistentRequests &persistent_requests,
+      const std::vector<std::pair<unsigned int, unsigned int>>
+        &                receive_targets,
+      void *             receive_buffer,
+      const std::vector<std::pair<unsigned int, unsigned int>>
+        &                send_targets,
+      const void *       send_buffer,
+      const unsigned int number_size,
+      const int          mpi_tag) const
+    {
+      const unsigned int n_requests =
+        receive_targets.size() + send_targets.size();
+      if (persistent_requests.requests.size() == n_requests &&
+          persistent_requests.receive_buffer == receive_buffer &&
+          persistent_requests.send_buffer == send_buffer &&
+          persistent_requests.number_size == number_size &&
+          persistent_requests.mpi_tag == mpi_tag)
+        return;
+
+      persistent_requests.clear();
+      persistent_requests.requests.resize(n_requests);
+
+      const auto check_message_size = [number_size](const unsigned int size) {
+        (void)size;
+        (void)number_size;
+        AssertThrow(
+          static_cast<std::size_t>(size) * number_size <
+            static_cast<std::size_t>(std::numeric_limits<int>::max()),
+          ExcMessage("Index overflow: Maximum message size in MPI is 2GB. "
+                     "The number of ghost entries times the size of 'Number' "
+                     "exceeds this value. This is not supported."));
+      };
+
+      char *receive_ptr = static_cast<char *>(receive_buffer);
+      for (unsigned int i = 0; i < receive_targets.size(); ++i)
+        {
+          check_message_size(receive_targets[i].second);
+          const int ierr =
+            MPI_Recv_init(receive_ptr,
+                          receive_targets[i].second * number_size,
+                          MPI_BYTE,
+                          receive_targets[i].first,
+                          mpi_tag,
+                          communicator,
+                          &persistent_requests.requests[i]);
+          AssertThrowMPI(ierr);
+          receive_ptr += receive_targets[i].second * number_size;
+        }
+
+      const char *send_ptr = static_cast<const char *>(send_buffer);
+      for (unsigned int i = 0; i < send_targets.size(); ++i)
+        {
+          check_message_size(send_targets[i].second);
+          const int ierr = MPI_Send_init(
+            send_ptr,
+            send_targets[i].second * number_size,
+            MPI_BYTE,
+            send_targets[i].first,
+            mpi_tag,
+            communicator,
+            &persistent_requests.requests[receive_targets.size() + i]);
+          AssertThrowMPI(ierr);
+          send_ptr += send_targets[i].second * number_size;
+        }
+
+      persistent_requests.receive_buffer = receive_buffer;
+      persistent_requests.send_buffer    = send_buffer;
+      persistent_requests.number_size    = number_size;
+      persistent_requests.mpi_tag        = mpi_tag;
+    }
+#endif
+
+
+
     bool
     Partitioner::is_compatible(const Partitioner &part) const
     {
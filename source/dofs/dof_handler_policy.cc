@@ -16,6 +16,8 @@
 
 #include <deal.II/base/geometry_info.h>
 #include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/partitioner.h>
 #include <deal.II/base/thread_management.h>
 #include <deal.II/base/types.h>
@@ -36,6 +38,7 @@
 #include <deal.II/grid/tria_iterator.h>
 
 #include <algorithm>
+#include <atomic>
 #include <limits>
 #include <memory>
 #include <numeric>
@@ -249,6 +252,112 @@ namespace internal
 
           return identities;
         }
+
+
+
+        /**
+         * A wrapper around the DoFIndexProcessor of the DoF accessors that
+         * only hands the DoF indices on objects owned by a given active cell
+         * to the DoF processor, and skips the DoF indices on all other
+         * objects. A vertex, line, or quad is owned by the active cell with
+         * the smallest active_cell_index() among the cells it belongs to,
+         * as recorded in the given arrays. The interior DoFs of a cell are
+         * always owned by the cell itself.
+         */
+        template <int dim, int spacedim>
+        struct OwnedObjectsDoFIndexProcessor
+        {
+          using Processor = dealii::internal::DoFAccessorImplementation::
+            Implementation::DoFIndexProcessor<dim, spacedim, false>;
+
+          OwnedObjectsDoFIndexProcessor(
+            const unsigned int                            cell_index,
+            const std::vector<std::atomic<unsigned int>> &vertex_owners,
+            const std::vector<std::atomic<unsigned int>> &line_owners,
+            const std::vector<std::atomic<unsigned int>> &quad_owners)
+            : cell_index(cell_index)
+            , vertex_owners(vertex_owners)
+            , line_owners(line_owners)
+            , quad_owners(quad_owners)
+          {}
+
+          template <int structdim, typename ArrayType, typename DoFProcessor>
+          void
+          process_vertex_dofs(
+            const dealii::DoFAccessor<structdim, dim, spacedim, false>
+              &                 accessor,
+            const unsigned int  vertex,
+            unsigned int &      index,
+            ArrayType &         index_value,
+            const unsigned int  fe_index,
+            const DoFProcessor &dof_processor) const
+          {
+            if (vertex_owners[accessor.vertex_index(vertex)] == cell_index)
+              Processor().process_vertex_dofs(
+                accessor, vertex, index, index_value, fe_index, dof_processor);
+            else
+              Processor().process_vertex_dofs(accessor,
+                                              vertex,
+                                              index,
+                                              index_value,
+                                              fe_index,
+                                              [](auto &, auto &) {});
+          }
+
+          template <int structdim,
+                    typename DoFMapping,
+                    typename ArrayType,
+                    typename DoFProcessor>
+          void
+          process_dofs(
+            const dealii::DoFAccessor<structdim, dim, spacedim, false>
+              &                 accessor,
+            const DoFMapping &  mapping,
+            unsigned int &      index,
+            ArrayType &         index_value,
+            const unsigned int  fe_index,
+            const DoFProcessor &dof_processor) const
+          {
+            const bool is_owned =
+              (structdim == dim) ||
+              ((structdim == 1 ? line_owners :
+                                 quad_owners)[accessor.index()] == cell_index);
+            if (is_owned)
+              Processor().process_dofs(
+                accessor, mapping, index, index_value, fe_index, dof_processor);
+            else
+              Processor().process_dofs(accessor,
+                                       mapping,
+                                       index,
+                                       index_value,
+                                       fe_index,
+                                       [](auto &, auto &) {});
+          }
+
+          template <int structdim,
+                    typename DoFMapping,
+                    typename ArrayType,
+                    typename DoFProcessor>
+          void
+          process_dofs(
+            const dealii::DoFInvalidAccessor<structdim, dim, spacedim>
+              &                 accessor,
+            const DoFMapping &  mapping,
+            unsigned int &      index,
+            ArrayType &         index_value,
+            const unsigned int  fe_index,
+            const DoFProcessor &dof_processor) const
+          {
+            Processor().process_dofs(
+              accessor, mapping, index, index_value, fe_index, dof_processor);
+          }
+
+        private:
+          const unsigned int                            cell_index;
+          const std::vector<std::atomic<unsigned int>> &vertex_owners;
+          const std::vector<std::atomic<unsigned int>> &line_owners;
+          const std::vector<std::atomic<unsigned int>> &quad_owners;
+        };
       } // namespace
 
 
@@ -1741,6 +1850,176 @@ namespace internal
 
 
 
+        /**
+         * The number of consecutive active cells processed by one task in
+         * distribute_dofs_in_parallel().
+         */
+        static const unsigned int parallel_enumeration_chunk_size = 1024;
+
+        /**
+         * Multithreaded variant of distribute_dofs() for DoFHandler objects
+         * without hp-capabilities. It produces exactly the same numbering as
+         * the sequential algorithm, which enumerates the DoFs in the order
+         * in which they are first encountered when looping over the active
+         * cells and over the DoFs of each cell.
+         *
+         * The work is split into chunks of consecutive active cells that are
+         * processed by separate tasks in three phases:
+         * <ol>
+         * <li> Each vertex, line, and quad is assigned to the active cell
+         * with the smallest active_cell_index() it belongs to, using an
+         * atomic minimum.
+         * <li> Each cell counts the DoFs on the objects it owns, including
+         * its interior DoFs. An exclusive prefix sum over the cells in the
+         * order of active_cell_index() gives the first DoF index of each
+         * cell.
+         * <li> Each cell enumerates the DoFs on its owned objects starting
+         * from its first index, in the same order as the sequential
+         * algorithm.
+         * </ol>
+         * Since each DoF is written by exactly one cell, no synchronization
+         * is necessary in the last phase.
+         */
+        template <int dim, int spacedim>
+        static types::global_dof_index
+        distribute_dofs_in_parallel(const types::subdomain_id  subdomain_id,
+                                    DoFHandler<dim, spacedim> &dof_handler)
+        {
+          Assert(dof_handler.hp_capability_enabled == false,
+                 ExcInternalError());
+
+          const dealii::Triangulation<dim, spacedim> &tria =
+            dof_handler.get_triangulation();
+
+          // record the first cell of each chunk of active cells
+          std::vector<typename DoFHandler<dim, spacedim>::active_cell_iterator>
+            chunk_begin;
+          {
+            unsigned int n_cells = 0;
+            for (const auto &cell : dof_handler.active_cell_iterators())
+              if (n_cells++ % parallel_enumeration_chunk_size == 0)
+                chunk_begin.push_back(cell);
+          }
+
+          // run the given function on all cells we need to work on, with one
+          // task per chunk
+          const auto for_all_cells = [&](const auto &function) {
+            dealii::parallel::apply_to_subranges(
+              0U,
+              static_cast<unsigned int>(chunk_begin.size()),
+              [&](const unsigned int begin, const unsigned int end) {
+                std::vector<types::global_dof_index> dof_indices(
+                  dof_handler.get_fe().n_dofs_per_cell());
+                for (unsigned int chunk = begin; chunk < end; ++chunk)
+                  {
+                    auto cell = chunk_begin[chunk];
+                    for (unsigned int i = 0;
+                         i < parallel_enumeration_chunk_size &&
+                         cell != dof_handler.end();
+                         ++i, ++cell)
+                      if (!cell->is_artificial() &&
+                          ((subdomain_id == numbers::invalid_subdomain_id) ||
+                           (cell->subdomain_id() == subdomain_id)))
+                        function(cell, dof_indices);
+                  }
+              },
+              1);
+          };
+
+          // Phase 1: determine the owning cell of each object
+          std::vector<std::atomic<unsigned int>> vertex_owners(
+            tria.n_vertices());
+          std::vector<std::atomic<unsigned int>> line_owners(
+            dim > 1 ? tria.n_raw_lines() : 0);
+          std::vector<std::atomic<unsigned int>> quad_owners(
+            dim > 2 ? tria.n_raw_quads() : 0);
+          for (auto *owners : {&vertex_owners, &line_owners, &quad_owners})
+            for (auto &owner : *owners)
+              owner.store(numbers::invalid_unsigned_int,
+                          std::memory_order_relaxed);
+
+          for_all_cells([&](const auto &cell, auto &) {
+            const unsigned int cell_index = cell->active_cell_index();
+            const auto claim = [cell_index](std::atomic<unsigned int> &owner) {
+              unsigned int current = owner.load(std::memory_order_relaxed);
+              while (cell_index < current &&
+                     !owner.compare_exchange_weak(current,
+                                                  cell_index,
+                                                  std::memory_order_relaxed))
+                ;
+            };
+
+            for (const unsigned int v : cell->vertex_indices())
+              claim(vertex_owners[cell->vertex_index(v)]);
+            if (dim > 1)
+              for (const unsigned int l : cell->line_indices())
+                claim(line_owners[cell->line(l)->index()]);
+            if (dim > 2)
+              for (const unsigned int f : cell->face_indices())
+                claim(quad_owners[cell->quad(f)->index()]);
+          });
+
+          // Phase 2: count the DoFs owned by each cell and compute the first
+          // index of each cell by a prefix sum
+          std::vector<types::global_dof_index> first_dof_index(
+            tria.n_active_cells() + 1, 0);
+          for_all_cells([&](const auto &cell, auto &dof_indices) {
+            types::global_dof_index n_owned_dofs = 0;
+            DoFAccessorImplementation::Implementation::process_dof_indices(
+              *cell,
+              dof_indices,
+              cell->active_fe_index(),
+              OwnedObjectsDoFIndexProcessor<dim, spacedim>(
+                cell->active_cell_index(),
+                vertex_owners,
+                line_owners,
+                quad_owners),
+              [&n_owned_dofs](auto &, auto &) { ++n_owned_dofs; },
+              false);
+            first_dof_index[cell->active_cell_index() + 1] = n_owned_dofs;
+          });
+
+          for (unsigned int i = 0; i < tria.n_active_cells(); ++i)
+            {
+              first_dof_index[i + 1] += first_dof_index[i];
+              Assert(first_dof_index[i + 1] >= first_dof_index[i],
+                     ExcMessage(
+                       "You have reached the maximal number of degrees of "
+                       "freedom that can be stored in the chosen data type. "
+                       "You will have to re-compile deal.II with the "
+                       "`DEAL_II_WITH_64BIT_INDICES' flag set to `ON'."));
+            }
+
+          // Phase 3: enumerate the DoFs on the owned objects of each cell
+          for_all_cells([&](const auto &cell, auto &dof_indices) {
+            types::global_dof_index next_free_dof =
+              first_dof_index[cell->active_cell_index()];
+            DoFAccessorImplementation::Implementation::process_dof_indices(
+              *cell,
+              dof_indices,
+              cell->active_fe_index(),
+              OwnedObjectsDoFIndexProcessor<dim, spacedim>(
+                cell->active_cell_index(),
+                vertex_owners,
+                line_owners,
+                quad_owners),
+              [&next_free_dof](auto &stored_index, auto &) {
+                Assert(stored_index == numbers::invalid_dof_index,
+                       ExcInternalError());
+                stored_index = next_free_dof;
+                ++next_free_dof;
+              },
+              false);
+            Assert(next_free_dof ==
+                     first_dof_index[cell->active_cell_index() + 1],
+                   ExcInternalError());
+          });
+
+          return first_dof_index.back();
+        }
+
+
+
         /**
          * Distribute degrees of freedom on all cells, or on cells with the
          * correct subdomain_id if the corresponding argument is not equal to
@@ -1755,6 +2034,12 @@ namespace internal
           Assert(dof_handler.get_triangulation().n_levels() > 0,
                  ExcMessage("Empty triangulation"));
 
+          if (dof_handler.hp_capability_enabled == false &&
+              MultithreadInfo::n_threads() > 1 &&
+              dof_handler.get_triangulation().n_active_cells() >=
+                8 * parallel_enumeration_chunk_size)
+            return distribute_dofs_in_parallel(subdomain_id, dof_handler);
+
           // distribute dofs on all cells excluding artificial ones
           types::global_dof_index next_free_dof = 0;
 
@@ -39,6 +39,8 @@
 #include <deal.II/lac/sparsity_pattern.h>
 #include <deal.II/lac/sparsity_tools.h>
 
+#include <deal.II/matrix_free/matrix_free.h>
+
 #include <deal.II/multigrid/mg_constrained_dofs.h>
 #include <deal.II/multigrid/mg_tools.h>
 
@@ -676,6 +678,96 @@ namespace DoFRenumbering
 
 
 
+  template <int dim, int spacedim>
+  void
+  nested_dissection(DoFHandler<dim, spacedim> &dof_handler,
+                    const bool                 use_constraints,
+                    const unsigned int         min_subgraph_size)
+  {
+    std::vector<types::global_dof_index> renumbering(
+      dof_handler.locally_owned_dofs().n_elements(),
+      numbers::invalid_dof_index);
+    compute_nested_dissection(renumbering,
+                              dof_handler,
+                              use_constraints,
+                              min_subgraph_size);
+
+    dof_handler.renumber_dofs(renumbering);
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  compute_nested_dissection(
+    std::vector<types::global_dof_index> &new_indices,
+    const DoFHandler<dim, spacedim> &     dof_handler,
+    const bool                            use_constraints,
+    const unsigned int                    min_subgraph_size)
+  {
+    const IndexSet &locally_owned_dofs = dof_handler.locally_owned_dofs();
+    AssertDimension(new_indices.size(), locally_owned_dofs.n_elements());
+    if (locally_owned_dofs.n_elements() == 0)
+      return;
+
+    IndexSet locally_relevant_dofs;
+    DoFTools::extract_locally_relevant_dofs(dof_handler, locally_relevant_dofs);
+
+    AffineConstraints<double> constraints;
+    if (use_constraints)
+      {
+        constraints.reinit(locally_relevant_dofs);
+        DoFTools::make_hanging_node_constraints(dof_handler, constraints);
+      }
+    constraints.close();
+
+    // see if we can get away with the sequential algorithm
+    if (locally_owned_dofs.n_elements() == locally_owned_dofs.size())
+      {
+        DynamicSparsityPattern dsp(locally_owned_dofs.size(),
+                                   locally_owned_dofs.size());
+        DoFTools::make_sparsity_pattern(dof_handler, dsp, constraints);
+
+        SparsityTools::reorder_nested_dissection(dsp,
+                                                 new_indices,
+                                                 min_subgraph_size);
+      }
+    else
+      {
+        // in the parallel case, renumber the locally owned DoFs based on
+        // the couplings among them, in the local index space
+        DynamicSparsityPattern dsp(locally_owned_dofs.size(),
+                                   locally_owned_dofs.size(),
+                                   locally_owned_dofs);
+        DoFTools::make_sparsity_pattern(dof_handler, dsp, constraints);
+
+        DynamicSparsityPattern local_sparsity(locally_owned_dofs.n_elements(),
+                                              locally_owned_dofs.n_elements());
+        std::vector<types::global_dof_index> row_entries;
+        for (unsigned int i = 0; i < locally_owned_dofs.n_elements(); ++i)
+          {
+            const types::global_dof_index row =
+              locally_owned_dofs.nth_index_in_set(i);
+            row_entries.clear();
+            for (auto entry = dsp.begin(row); entry != dsp.end(row); ++entry)
+              if (locally_owned_dofs.is_element(entry->column()))
+                row_entries.push_back(
+                  locally_owned_dofs.index_within_set(entry->column()));
+            local_sparsity.add_entries(i,
+                                       row_entries.begin(),
+                                       row_entries.end());
+          }
+
+        SparsityTools::reorder_nested_dissection(local_sparsity,
+                                                 new_indices,
+                                                 min_subgraph_size);
+        for (types::global_dof_index &new_index : new_indices)
+          new_index = locally_owned_dofs.nth_index_in_set(new_index);
+      }
+  }
+
+
+
   template <int dim, int spacedim>
   void
   component_wise(DoFHandler<dim, spacedim> &      dof_handler,
@@ -2252,6 +2344,147 @@ namespace DoFRenumbering
 
 
 
+  template <int dim, typename Number, typename VectorizedArrayType>
+  void
+  matrix_free_data_locality(
+    DoFHandler<dim> &                                   dof_handler,
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free)
+  {
+    const unsigned int level = matrix_free.get_mg_level();
+
+    std::vector<types::global_dof_index> renumbering(
+      level == numbers::invalid_unsigned_int ?
+        dof_handler.n_locally_owned_dofs() :
+        dof_handler.locally_owned_mg_dofs(level).n_elements(),
+      numbers::invalid_dof_index);
+    compute_matrix_free_data_locality(renumbering, dof_handler, matrix_free);
+
+    if (level == numbers::invalid_unsigned_int)
+      dof_handler.renumber_dofs(renumbering);
+    else
+      dof_handler.renumber_dofs(level, renumbering);
+  }
+
+
+
+  template <int dim, typename Number, typename VectorizedArrayType>
+  void
+  compute_matrix_free_data_locality(
+    std::vector<types::global_dof_index> &              new_dof_indices,
+    const DoFHandler<dim> &                             dof_handler,
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free)
+  {
+    unsigned int dof_handler_index = numbers::invalid_unsigned_int;
+    for (unsigned int i = 0; i < matrix_free.n_components(); ++i)
+      if (&matrix_free.get_dof_handler(i) == &dof_handler)
+        {
+          dof_handler_index = i;
+          break;
+        }
+    Assert(dof_handler_index != numbers::invalid_unsigned_int,
+           ExcMessage("The given DoFHandler has not been used to set up "
+                      "the MatrixFree object."));
+
+    const unsigned int level = matrix_free.get_mg_level();
+    const IndexSet &   owned_dofs =
+      level == numbers::invalid_unsigned_int ?
+        dof_handler.locally_owned_dofs() :
+        dof_handler.locally_owned_mg_dofs(level);
+    const types::global_dof_index n_owned_dofs = owned_dofs.n_elements();
+    AssertDimension(new_dof_indices.size(), n_owned_dofs);
+
+    // Step 1: find the lowest rank of the processes each locally owned DoF
+    // is sent to in the ghost exchange. The import indices of the
+    // partitioner are given as ranges within the list of all indices sent,
+    // which is ordered by the receiving processes as listed in the import
+    // targets
+    const Utilities::MPI::Partitioner &partitioner =
+      *matrix_free.get_vector_partitioner(dof_handler_index);
+    std::vector<unsigned int> export_rank(n_owned_dofs,
+                                          numbers::invalid_unsigned_int);
+    const std::vector<std::pair<unsigned int, unsigned int>> &targets =
+      partitioner.import_targets();
+    unsigned int target = 0, n_sent = 0;
+    for (const auto &range : partitioner.import_indices())
+      for (unsigned int i = range.first; i < range.second; ++i)
+        {
+          while (n_sent == targets[target].second)
+            {
+              ++target;
+              n_sent = 0;
+            }
+          export_rank[i] = std::min(export_rank[i], targets[target].first);
+          ++n_sent;
+        }
+
+    // Step 2: traverse the cells in the order of the cell loop of the
+    // MatrixFree object and record the order of first access, separately for
+    // the DoFs sent to other processes and the purely local ones
+    std::vector<types::global_dof_index> exported_order, local_order;
+    local_order.reserve(n_owned_dofs);
+    std::vector<bool>                    touched(n_owned_dofs, false);
+    std::vector<types::global_dof_index> dof_indices;
+    for (unsigned int batch = 0; batch < matrix_free.n_cell_batches(); ++batch)
+      for (unsigned int v = 0;
+           v < matrix_free.n_active_entries_per_cell_batch(batch);
+           ++v)
+        {
+          const auto cell =
+            matrix_free.get_cell_iterator(batch, v, dof_handler_index);
+          if (level == numbers::invalid_unsigned_int)
+            {
+              dof_indices.resize(cell->get_fe().n_dofs_per_cell());
+              cell->get_dof_indices(dof_indices);
+            }
+          else
+            {
+              dof_indices.resize(dof_handler.get_fe().n_dofs_per_cell());
+              cell->get_mg_dof_indices(dof_indices);
+            }
+
+          for (const types::global_dof_index dof : dof_indices)
+            if (owned_dofs.is_element(dof))
+              {
+                const types::global_dof_index local_index =
+                  owned_dofs.index_within_set(dof);
+                if (touched[local_index] == false)
+                  {
+                    touched[local_index] = true;
+                    if (export_rank[local_index] !=
+                        numbers::invalid_unsigned_int)
+                      exported_order.push_back(local_index);
+                    else
+                      local_order.push_back(local_index);
+                  }
+              }
+        }
+
+    // DoFs not touched by any cell batch keep their relative order at the
+    // end
+    for (types::global_dof_index i = 0; i < n_owned_dofs; ++i)
+      if (touched[i] == false)
+        local_order.push_back(i);
+
+    // Step 3: place the exported DoFs first, grouped by the receiving
+    // process and in the order of first access within each group, followed
+    // by the purely local DoFs
+    std::stable_sort(exported_order.begin(),
+                     exported_order.end(),
+                     [&](const types::global_dof_index a,
+                         const types::global_dof_index b) {
+                       return export_rank[a] < export_rank[b];
+                     });
+
+    types::global_dof_index next_index = 0;
+    for (const types::global_dof_index i : exported_order)
+      new_dof_indices[i] = owned_dofs.nth_index_in_set(next_index++);
+    for (const types::global_dof_index i : local_order)
+      new_dof_indices[i] = owned_dofs.nth_index_in_set(next_index++);
+    Assert(next_index == n_owned_dofs, ExcInternalError());
+  }
+
+
+
   template <int dim, int spacedim>
   void
   support_point_wise(DoFHandler<dim, spacedim> &dof_handler)
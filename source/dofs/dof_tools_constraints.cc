@@ -13,6 +13,8 @@
 //
 // ---------------------------------------------------------------------
 
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/table.h>
 #include <deal.II/base/template_constraints.h>
 #include <deal.II/base/utilities.h>
@@ -44,8 +46,10 @@
 
 #include <algorithm>
 #include <array>
+#include <map>
 #include <memory>
 #include <numeric>
+#include <tuple>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -482,14 +486,17 @@ namespace DoFTools
        *
        * It also suppresses very small entries in the AffineConstraints object
        * to avoid making the sparsity pattern fuller than necessary.
+       *
+       * The last argument is either an AffineConstraints object or a
+       * ConstraintLineBuffer.
        */
-      template <typename number1, typename number2>
+      template <typename number1, typename ConstraintsType>
       void
       filter_constraints(
         const std::vector<types::global_dof_index> &primary_dofs,
         const std::vector<types::global_dof_index> &dependent_dofs,
         const FullMatrix<number1> &                 face_constraints,
-        AffineConstraints<number2> &                constraints)
+        ConstraintsType &                           constraints)
       {
         Assert(face_constraints.n() == primary_dofs.size(),
                ExcDimensionMismatch(primary_dofs.size(), face_constraints.n()));
@@ -572,6 +579,99 @@ namespace DoFTools
             }
       }
 
+
+
+      /**
+       * A buffer for the constraint lines that filter_constraints() computes
+       * for a chunk of cells, for use when several threads compute the
+       * constraints of different chunks at the same time. It offers the
+       * functions of AffineConstraints that filter_constraints() uses, and
+       * copy_to() later enters the buffered lines into the AffineConstraints
+       * object. Since the lines of all chunks are copied in the order of the
+       * chunks, and lines for degrees of freedom that are already constrained
+       * are skipped at that point, the result is the same as if
+       * filter_constraints() had written into the AffineConstraints object
+       * directly.
+       */
+      template <typename number>
+      class ConstraintLineBuffer
+      {
+      public:
+        /**
+         * Constructor. Degrees of freedom already constrained in
+         * @p constraints are skipped right away.
+         */
+        ConstraintLineBuffer(const AffineConstraints<number> &constraints)
+          : constraints(&constraints)
+        {}
+
+        bool
+        is_constrained(const types::global_dof_index index) const
+        {
+          return constraints->is_constrained(index);
+        }
+
+        void
+        add_line(const types::global_dof_index line)
+        {
+          lines.emplace_back(line, entries.size());
+        }
+
+        void
+        add_entry(const types::global_dof_index line,
+                  const types::global_dof_index column,
+                  const number                  value)
+        {
+          (void)line;
+          Assert(lines.size() > 0 && lines.back().first == line,
+                 ExcInternalError());
+          entries.emplace_back(column, value);
+        }
+
+        void
+        set_inhomogeneity(const types::global_dof_index line,
+                          const number                  value)
+        {
+          (void)line;
+          (void)value;
+          Assert(value == number(), ExcInternalError());
+        }
+
+        /**
+         * Enter the buffered lines into @p constraints, skipping those for
+         * degrees of freedom that are constrained already.
+         */
+        void
+        copy_to(AffineConstraints<number> &constraints) const
+        {
+          for (unsigned int l = 0; l < lines.size(); ++l)
+            {
+              const types::global_dof_index line = lines[l].first;
+              if (constraints.is_constrained(line))
+                continue;
+
+              constraints.add_line(line);
+              const std::size_t end =
+                (l + 1 < lines.size() ? lines[l + 1].second : entries.size());
+              for (std::size_t e = lines[l].second; e < end; ++e)
+                constraints.add_entry(line,
+                                      entries[e].first,
+                                      entries[e].second);
+            }
+        }
+
+      private:
+        const AffineConstraints<number> *constraints;
+
+        /**
+         * The constrained degrees of freedom and the start of their entries
+         * in the array below.
+         */
+        std::vector<std::pair<types::global_dof_index, std::size_t>> lines;
+
+        std::vector<std::pair<types::global_dof_index, number>> entries;
+      };
+
     } // namespace
 
 
@@ -1029,12 +1129,136 @@ namespace DoFTools
 
 
 
+    namespace
+    {
+      /**
+       * A variant of make_hp_hanging_node_constraints() for DoFHandlers
+       * without hp-capabilities on meshes of hypercube cells, which computes
+       * the constraints with several threads. The active cells are split into
+       * chunks of consecutive cells, and the constraint lines of each chunk
+       * are collected in a ConstraintLineBuffer. The buffers are then copied
+       * into the AffineConstraints object in the order of the chunks, which
+       * gives the same constraints as the sequential loop.
+       *
+       * With only one finite element, the interpolation matrices from a face
+       * to its children only depend on the number of the child, so they are
+       * computed once up front and shared by all threads.
+       */
+      template <int dim, int spacedim, typename number>
+      void
+      make_hanging_node_constraints_in_parallel(
+        const DoFHandler<dim, spacedim> &dof_handler,
+        AffineConstraints<number> &      constraints)
+      {
+        Assert(dof_handler.has_hp_capabilities() == false, ExcInternalError());
+
+        const FiniteElement<dim, spacedim> &fe = dof_handler.get_fe();
+        if (fe.n_dofs_per_face() == 0 ||
+            fe.compare_for_domination(fe, /*codim=*/1) ==
+              FiniteElementDomination::no_requirements)
+          return;
+
+        std::array<std::unique_ptr<FullMatrix<double>>,
+                   GeometryInfo<dim>::max_children_per_face>
+          subface_interpolation_matrices;
+        for (unsigned int c = 0; c < GeometryInfo<dim>::max_children_per_face;
+             ++c)
+          ensure_existence_of_subface_matrix(fe,
+                                             fe,
+                                             c,
+                                             subface_interpolation_matrices[c]);
+
+        // artificial cells can at best neighbor ghost cells, but we're not
+        // interested in these interfaces
+        std::vector<typename DoFHandler<dim, spacedim>::active_cell_iterator>
+          cells;
+        cells.reserve(dof_handler.get_triangulation().n_active_cells());
+        for (const auto &cell : dof_handler.active_cell_iterators())
+          if (cell->is_artificial() == false)
+            cells.push_back(cell);
+
+        const unsigned int chunk_size = 64;
+        const unsigned int n_chunks =
+          (cells.size() + chunk_size - 1) / chunk_size;
+        std::vector<ConstraintLineBuffer<number>> buffers(
+          n_chunks, ConstraintLineBuffer<number>(constraints));
+
+        // the threads call constraints.is_constrained(), which looks up the
+        // index in the set of locally stored lines. compress that set here,
+        // as compressing it from within several threads at once is not safe
+        constraints.get_local_lines().compress();
+
+        dealii::parallel::apply_to_subranges(
+          0U,
+          n_chunks,
+          [&](const unsigned int begin, const unsigned int end) {
+            std::vector<types::global_dof_index> primary_dofs(
+              fe.n_dofs_per_face());
+            std::vector<types::global_dof_index> dependent_dofs(
+              fe.n_dofs_per_face());
+            for (unsigned int chunk = begin; chunk < end; ++chunk)
+              for (unsigned int i = chunk * chunk_size;
+                   i < std::min<std::size_t>((chunk + 1) * chunk_size,
+                                             cells.size());
+                   ++i)
+                {
+                  const auto &cell = cells[i];
+                  for (const unsigned int face : cell->face_indices())
+                    if (cell->face(face)->has_children())
+                      {
+                        Assert(cell->face(face)->refinement_case() ==
+                                 RefinementCase<dim - 1>::isotropic_refinement,
+                               ExcNotImplemented());
+
+                        // constrain the DoFs on the face children against
+                        // the DoFs on the face itself, like case 1 in
+                        // make_hp_hanging_node_constraints()
+                        cell->face(face)->get_dof_indices(primary_dofs);
+                        for (unsigned int c = 0;
+                             c < cell->face(face)->n_children();
+                             ++c)
+                          {
+                            if (cell->neighbor_child_on_subface(face, c)
+                                  ->is_artificial())
+                              continue;
+
+                            cell->face(face)->child(c)->get_dof_indices(
+                              dependent_dofs);
+                            filter_constraints(
+                              primary_dofs,
+                              dependent_dofs,
+                              *subface_interpolation_matrices[c],
+                              buffers[chunk]);
+                          }
+                      }
+                }
+          },
+          1);
+
+        for (const ConstraintLineBuffer<number> &buffer : buffers)
+          buffer.copy_to(constraints);
+      }
+    } // namespace
+
+
+
     template <int dim, int spacedim, typename number>
     void
     make_hp_hanging_node_constraints(
       const DoFHandler<dim, spacedim> &dof_handler,
       AffineConstraints<number> &      constraints)
     {
+      // large meshes without hp-capabilities are worked on with several
+      // threads
+      const auto &tria = dof_handler.get_triangulation();
+      if (dof_handler.has_hp_capabilities() == false &&
+          tria.all_reference_cells_are_hyper_cube() &&
+          tria.n_active_cells() >= 1024 && MultithreadInfo::n_threads() > 1)
+        {
+          make_hanging_node_constraints_in_parallel(dof_handler, constraints);
+          return;
+        }
+
       // note: this function is going to be hard to understand if you haven't
       // read the hp-paper. however, we try to follow the notation laid out
       // there, so go read the paper before you try to understand what is going
@@ -1808,6 +2032,81 @@ namespace DoFTools
 
   namespace
   {
+    template <int dim, int spacedim>
+    FullMatrix<double>
+    compute_transformation(
+      const FiniteElement<dim, spacedim> &fe,
+      const FullMatrix<double> &          matrix,
+      const std::vector<unsigned int> &   first_vector_components);
+
+
+
+    // Internally used in make_periodicity_constraints.
+    //
+    // The matrices set_periodicity_constraints works with only depend on the
+    // finite element and the user supplied matrix, not on the face. This
+    // class computes them the first time they are needed and keeps them for
+    // all the faces a call to make_periodicity_constraints works on.
+    template <int dim, int spacedim>
+    class PeriodicityMatrixCache
+    {
+    public:
+      // Return the interpolation matrix from a face of the given element to
+      // the given child of the face.
+      const FullMatrix<double> &
+      get_subface_interpolation_matrix(const FiniteElement<dim, spacedim> &fe,
+                                       const unsigned int subface)
+      {
+        FullMatrix<double> &matrix =
+          subface_interpolation_matrices[std::make_pair(&fe, subface)];
+        if (matrix.m() == 0 && fe.n_dofs_per_face(0) > 0)
+          {
+            matrix.reinit(fe.n_dofs_per_face(0), fe.n_dofs_per_face(0));
+            fe.get_subface_interpolation_matrix(fe, subface, matrix, 0);
+          }
+        return matrix;
+      }
+
+      // Return the matrix computed by compute_transformation, or its inverse.
+      const FullMatrix<double> &
+      get_transformation(
+        const FiniteElement<dim, spacedim> &fe,
+        const FullMatrix<double> &          matrix,
+        const std::vector<unsigned int> &   first_vector_components,
+        const bool                          inverse)
+      {
+        std::vector<double> matrix_entries(matrix.begin(), matrix.end());
+        auto &transformation = transformations[std::make_tuple(
+          &fe, std::move(matrix_entries), first_vector_components, inverse)];
+        if (transformation == nullptr)
+          {
+            transformation = std::make_unique<FullMatrix<double>>(
+              compute_transformation(fe, matrix, first_vector_components));
+            if (inverse)
+              {
+                FullMatrix<double> inverse_matrix(transformation->m());
+                inverse_matrix.invert(*transformation);
+                *transformation = inverse_matrix;
+              }
+          }
+        return *transformation;
+      }
+
+    private:
+      std::map<std::pair<const FiniteElement<dim, spacedim> *, unsigned int>,
+               FullMatrix<double>>
+        subface_interpolation_matrices;
+
+      std::map<std::tuple<const FiniteElement<dim, spacedim> *,
+                          std::vector<double>,
+                          std::vector<unsigned int>,
+                          bool>,
+               std::unique_ptr<FullMatrix<double>>>
+        transformations;
+    };
+
+
+
     /**
      * @internal
      *
@@ -1844,7 +2143,10 @@ namespace DoFTools
       const bool                                   face_orientation,
       const bool                                   face_flip,
       const bool                                   face_rotation,
-      const number                                 periodicity_factor)
+      const number                                 periodicity_factor,
+      PeriodicityMatrixCache<FaceIterator::AccessorType::dimension,
+                             FaceIterator::AccessorType::space_dimension>
+        &cache)
     {
       static const int dim      = FaceIterator::AccessorType::dimension;
       static const int spacedim = FaceIterator::AccessorType::space_dimension;
@@ -1875,8 +2177,6 @@ namespace DoFTools
             face_1->get_fe(face_1->nth_active_fe_index(0))
               .n_dofs_per_face(face_no);
           FullMatrix<double> child_transformation(dofs_per_face, dofs_per_face);
-          FullMatrix<double> subface_interpolation(dofs_per_face,
-                                                   dofs_per_face);
 
           for (unsigned int c = 0; c < face_2->n_children(); ++c)
             {
@@ -1884,11 +2184,8 @@ namespace DoFTools
               // interpolated from face_1 to face_2 by multiplying from the left
               // with the one that interpolates from face_2 to its child
               const auto &fe = face_1->get_fe(face_1->nth_active_fe_index(0));
-              fe.get_subface_interpolation_matrix(fe,
-                                                  c,
-                                                  subface_interpolation,
-                                                  face_no);
-              subface_interpolation.mmult(child_transformation, transformation);
+              cache.get_subface_interpolation_matrix(fe, c).mmult(
+                child_transformation, transformation);
 
               set_periodicity_constraints(face_1,
                                           face_2->child(c),
@@ -1898,7 +2195,8 @@ namespace DoFTools
                                           face_orientation,
                                           face_flip,
                                           face_rotation,
-                                          periodicity_factor);
+                                          periodicity_factor,
+                                          cache);
             }
           return;
         }
@@ -2284,246 +2582,291 @@ namespace DoFTools
   // Low level interface:
 
 
-  template <typename FaceIterator, typename number>
-  void
-  make_periodicity_constraints(
-    const FaceIterator &                         face_1,
-    const typename identity<FaceIterator>::type &face_2,
-    AffineConstraints<number> &                  affine_constraints,
-    const ComponentMask &                        component_mask,
-    const bool                                   face_orientation,
-    const bool                                   face_flip,
-    const bool                                   face_rotation,
-    const FullMatrix<double> &                   matrix,
-    const std::vector<unsigned int> &            first_vector_components,
-    const number                                 periodicity_factor)
+  namespace
   {
-    // TODO: the implementation makes the assumption that all faces have the
-    // same number of dofs
-    AssertDimension(
-      face_1->get_fe(face_1->nth_active_fe_index(0)).n_unique_faces(), 1);
-    AssertDimension(
-      face_2->get_fe(face_2->nth_active_fe_index(0)).n_unique_faces(), 1);
-    const unsigned int face_no = 0;
-
-    static const int dim      = FaceIterator::AccessorType::dimension;
-    static const int spacedim = FaceIterator::AccessorType::space_dimension;
-
-    Assert((dim != 1) || (face_orientation == true && face_flip == false &&
-                          face_rotation == false),
-           ExcMessage("The supplied orientation "
-                      "(face_orientation, face_flip, face_rotation) "
-                      "is invalid for 1D"));
-
-    Assert((dim != 2) || (face_orientation == true && face_rotation == false),
-           ExcMessage("The supplied orientation "
-                      "(face_orientation, face_flip, face_rotation) "
-                      "is invalid for 2D"));
-
-    Assert(face_1 != face_2,
-           ExcMessage("face_1 and face_2 are equal! Cannot constrain DoFs "
-                      "on the very same face"));
-
-    Assert(face_1->at_boundary() && face_2->at_boundary(),
-           ExcMessage("Faces for periodicity constraints must be on the "
-                      "boundary"));
-
-    Assert(matrix.m() == matrix.n(),
-           ExcMessage("The supplied (rotation or interpolation) matrix must "
-                      "be a square matrix"));
-
-    Assert(first_vector_components.empty() || matrix.m() == spacedim,
-           ExcMessage("first_vector_components is nonempty, so matrix must "
-                      "be a rotation matrix exactly of size spacedim"));
+    // Implementation of the low level interface below, with a cache for the
+    // matrices that only depend on the finite element.
+    template <typename FaceIterator, typename number>
+    void
+    make_periodicity_constraints(
+      const FaceIterator &                         face_1,
+      const typename identity<FaceIterator>::type &face_2,
+      AffineConstraints<number> &                  affine_constraints,
+      const ComponentMask &                        component_mask,
+      const bool                                   face_orientation,
+      const bool                                   face_flip,
+      const bool                                   face_rotation,
+      const FullMatrix<double> &                   matrix,
+      const std::vector<unsigned int> &            first_vector_components,
+      const number                                 periodicity_factor,
+      PeriodicityMatrixCache<FaceIterator::AccessorType::dimension,
+                             FaceIterator::AccessorType::space_dimension>
+        &cache)
+    {
+      // TODO: the implementation makes the assumption that all faces have the
+      // same number of dofs
+      AssertDimension(
+        face_1->get_fe(face_1->nth_active_fe_index(0)).n_unique_faces(), 1);
+      AssertDimension(
+        face_2->get_fe(face_2->nth_active_fe_index(0)).n_unique_faces(), 1);
+      const unsigned int face_no = 0;
 
-#ifdef DEBUG
-    if (!face_1->has_children())
-      {
-        Assert(face_1->n_active_fe_indices() == 1, ExcInternalError());
-        const unsigned int n_dofs_per_face =
-          face_1->get_fe(face_1->nth_active_fe_index(0))
-            .n_dofs_per_face(face_no);
-
-        Assert(matrix.m() == 0 ||
-                 (first_vector_components.empty() &&
-                  matrix.m() == n_dofs_per_face) ||
-                 (!first_vector_components.empty() && matrix.m() == spacedim),
-               ExcMessage(
-                 "The matrix must have either size 0 or spacedim "
-                 "(if first_vector_components is nonempty) "
-                 "or the size must be equal to the # of DoFs on the face "
-                 "(if first_vector_components is empty)."));
-      }
+      static const int dim      = FaceIterator::AccessorType::dimension;
+      static const int spacedim = FaceIterator::AccessorType::space_dimension;
 
-    if (!face_2->has_children())
-      {
-        Assert(face_2->n_active_fe_indices() == 1, ExcInternalError());
-        const unsigned int n_dofs_per_face =
-          face_2->get_fe(face_2->nth_active_fe_index(0))
-            .n_dofs_per_face(face_no);
-
-        Assert(matrix.m() == 0 ||
-                 (first_vector_components.empty() &&
-                  matrix.m() == n_dofs_per_face) ||
-                 (!first_vector_components.empty() && matrix.m() == spacedim),
-               ExcMessage(
-                 "The matrix must have either size 0 or spacedim "
-                 "(if first_vector_components is nonempty) "
-                 "or the size must be equal to the # of DoFs on the face "
-                 "(if first_vector_components is empty)."));
-      }
-#endif
+      Assert((dim != 1) || (face_orientation == true && face_flip == false &&
+                            face_rotation == false),
+             ExcMessage("The supplied orientation "
+                        "(face_orientation, face_flip, face_rotation) "
+                        "is invalid for 1D"));
 
-    // A lookup table on how to go through the child faces depending on the
-    // orientation:
+      Assert((dim != 2) || (face_orientation == true && face_rotation == false),
+             ExcMessage("The supplied orientation "
+                        "(face_orientation, face_flip, face_rotation) "
+                        "is invalid for 2D"));
 
-    static const int lookup_table_2d[2][2] = {
-      //          flip:
-      {0, 1}, //  false
-      {1, 0}, //  true
-    };
+      Assert(face_1 != face_2,
+             ExcMessage("face_1 and face_2 are equal! Cannot constrain DoFs "
+                        "on the very same face"));
 
-    static const int lookup_table_3d[2][2][2][4] = {
-      //                    orientation flip  rotation
-      {
+      Assert(face_1->at_boundary() && face_2->at_boundary(),
+             ExcMessage("Faces for periodicity constraints must be on the "
+                        "boundary"));
+
+      Assert(matrix.m() == matrix.n(),
+             ExcMessage("The supplied (rotation or interpolation) matrix must "
+                        "be a square matrix"));
+
+      Assert(first_vector_components.empty() || matrix.m() == spacedim,
+             ExcMessage("first_vector_components is nonempty, so matrix must "
+                        "be a rotation matrix exactly of size spacedim"));
+
+#ifdef DEBUG
+      if (!face_1->has_children())
         {
-          {0, 2, 1, 3}, //  false       false false
-          {2, 3, 0, 1}, //  false       false true
-        },
+          Assert(face_1->n_active_fe_indices() == 1, ExcInternalError());
+          const unsigned int n_dofs_per_face =
+            face_1->get_fe(face_1->nth_active_fe_index(0))
+              .n_dofs_per_face(face_no);
+
+          Assert(matrix.m() == 0 ||
+                   (first_vector_components.empty() &&
+                    matrix.m() == n_dofs_per_face) ||
+                   (!first_vector_components.empty() && matrix.m() == spacedim),
+                 ExcMessage(
+                   "The matrix must have either size 0 or spacedim "
+                   "(if first_vector_components is nonempty) "
+                   "or the size must be equal to the # of DoFs on the face "
+                   "(if first_vector_components is empty)."));
+        }
+
+      if (!face_2->has_children())
         {
-          {3, 1, 2, 0}, //  false       true  false
-          {1, 0, 3, 2}, //  false       true  true
-        },
-      },
-      {
+          Assert(face_2->n_active_fe_indices() == 1, ExcInternalError());
+          const unsigned int n_dofs_per_face =
+            face_2->get_fe(face_2->nth_active_fe_index(0))
+              .n_dofs_per_face(face_no);
+
+          Assert(matrix.m() == 0 ||
+                   (first_vector_components.empty() &&
+                    matrix.m() == n_dofs_per_face) ||
+                   (!first_vector_components.empty() && matrix.m() == spacedim),
+                 ExcMessage(
+                   "The matrix must have either size 0 or spacedim "
+                   "(if first_vector_components is nonempty) "
+                   "or the size must be equal to the # of DoFs on the face "
+                   "(if first_vector_components is empty)."));
+        }
+#endif
+
+      // A lookup table on how to go through the child faces depending on the
+      // orientation:
+
+      static const int lookup_table_2d[2][2] = {
+        //          flip:
+        {0, 1}, //  false
+        {1, 0}, //  true
+      };
+
+      static const int lookup_table_3d[2][2][2][4] = {
+        //                    orientation flip  rotation
         {
-          {0, 1, 2, 3}, //  true        false false
-          {1, 3, 0, 2}, //  true        false true
+          {
+            {0, 2, 1, 3}, //  false       false false
+            {2, 3, 0, 1}, //  false       false true
+          },
+          {
+            {3, 1, 2, 0}, //  false       true  false
+            {1, 0, 3, 2}, //  false       true  true
+          },
         },
         {
-          {3, 2, 1, 0}, //  true        true  false
-          {2, 0, 3, 1}, //  true        true  true
+          {
+            {0, 1, 2, 3}, //  true        false false
+            {1, 3, 0, 2}, //  true        false true
+          },
+          {
+            {3, 2, 1, 0}, //  true        true  false
+            {2, 0, 3, 1}, //  true        true  true
+          },
         },
-      },
-    };
+      };
 
-    if (face_1->has_children() && face_2->has_children())
-      {
-        // In the case that both faces have children, we loop over all children
-        // and apply make_periodicty_constrains recursively:
+      if (face_1->has_children() && face_2->has_children())
+        {
+          // In the case that both faces have children, we loop over all
+          // children and apply make_periodicty_constrains recursively:
 
-        Assert(face_1->n_children() ==
-                   GeometryInfo<dim>::max_children_per_face &&
-                 face_2->n_children() ==
-                   GeometryInfo<dim>::max_children_per_face,
-               ExcNotImplemented());
+          Assert(face_1->n_children() ==
+                     GeometryInfo<dim>::max_children_per_face &&
+                   face_2->n_children() ==
+                     GeometryInfo<dim>::max_children_per_face,
+                 ExcNotImplemented());
 
-        for (unsigned int i = 0; i < GeometryInfo<dim>::max_children_per_face;
-             ++i)
-          {
-            // Lookup the index for the second face
-            unsigned int j;
-            switch (dim)
-              {
-                case 2:
-                  j = lookup_table_2d[face_flip][i];
-                  break;
-                case 3:
-                  j = lookup_table_3d[face_orientation][face_flip]
-                                     [face_rotation][i];
-                  break;
-                default:
-                  AssertThrow(false, ExcNotImplemented());
-              }
+          for (unsigned int i = 0; i < GeometryInfo<dim>::max_children_per_face;
+               ++i)
+            {
+              // Lookup the index for the second face
+              unsigned int j;
+              switch (dim)
+                {
+                  case 2:
+                    j = lookup_table_2d[face_flip][i];
+                    break;
+                  case 3:
+                    j = lookup_table_3d[face_orientation][face_flip]
+                                       [face_rotation][i];
+                    break;
+                  default:
+                    AssertThrow(false, ExcNotImplemented());
+                }
 
-            make_periodicity_constraints(face_1->child(i),
-                                         face_2->child(j),
-                                         affine_constraints,
-                                         component_mask,
-                                         face_orientation,
-                                         face_flip,
-                                         face_rotation,
-                                         matrix,
-                                         first_vector_components,
-                                         periodicity_factor);
-          }
-      }
-    else
-      {
-        // Otherwise at least one of the two faces is active and we need to do
-        // some work and enter the constraints!
+              make_periodicity_constraints(face_1->child(i),
+                                           face_2->child(j),
+                                           affine_constraints,
+                                           component_mask,
+                                           face_orientation,
+                                           face_flip,
+                                           face_rotation,
+                                           matrix,
+                                           first_vector_components,
+                                           periodicity_factor,
+                                           cache);
+            }
+        }
+      else
+        {
+          // Otherwise at least one of the two faces is active and we need to do
+          // some work and enter the constraints!
 
-        // The finite element that matters is the one on the active face:
-        const FiniteElement<dim, spacedim> &fe =
-          face_1->has_children() ?
-            face_2->get_fe(face_2->nth_active_fe_index(0)) :
-            face_1->get_fe(face_1->nth_active_fe_index(0));
+          // The finite element that matters is the one on the active face:
+          const FiniteElement<dim, spacedim> &fe =
+            face_1->has_children() ?
+              face_2->get_fe(face_2->nth_active_fe_index(0)) :
+              face_1->get_fe(face_1->nth_active_fe_index(0));
 
-        const unsigned int n_dofs_per_face = fe.n_dofs_per_face(face_no);
+          const unsigned int n_dofs_per_face = fe.n_dofs_per_face(face_no);
 
-        // Sometimes we just have nothing to do (for all finite elements, or
-        // systems which accidentally don't have any dofs on the boundary).
-        if (n_dofs_per_face == 0)
-          return;
+          // Sometimes we just have nothing to do (for all finite elements, or
+          // systems which accidentally don't have any dofs on the boundary).
+          if (n_dofs_per_face == 0)
+            return;
 
-        const FullMatrix<double> transformation =
-          compute_transformation(fe, matrix, first_vector_components);
+          const FullMatrix<double> &transformation = cache.get_transformation(
+            fe, matrix, first_vector_components, false);
 
-        if (!face_2->has_children())
-          {
-            // Performance hack: We do not need to compute an inverse if the
-            // matrix is the identity matrix.
-            if (first_vector_components.empty() && matrix.m() == 0)
-              {
-                set_periodicity_constraints(face_2,
-                                            face_1,
-                                            transformation,
-                                            affine_constraints,
-                                            component_mask,
-                                            face_orientation,
-                                            face_flip,
-                                            face_rotation,
-                                            periodicity_factor);
-              }
-            else
-              {
-                FullMatrix<double> inverse(transformation.m());
-                inverse.invert(transformation);
-
-                set_periodicity_constraints(face_2,
-                                            face_1,
-                                            inverse,
-                                            affine_constraints,
-                                            component_mask,
-                                            face_orientation,
+          if (!face_2->has_children())
+            {
+              // Performance hack: We do not need to compute an inverse if the
+              // matrix is the identity matrix.
+              if (first_vector_components.empty() && matrix.m() == 0)
+                {
+                  set_periodicity_constraints(face_2,
+                                              face_1,
+                                              transformation,
+                                              affine_constraints,
+                                              component_mask,
+                                              face_orientation,
+                                              face_flip,
+                                              face_rotation,
+                                              periodicity_factor,
+                                              cache);
+                }
+              else
+                {
+                  set_periodicity_constraints(
+                    face_2,
+                    face_1,
+                    cache.get_transformation(fe,
+                                             matrix,
+                                             first_vector_components,
+                                             true),
+                    affine_constraints,
+                    component_mask,
+                    face_orientation,
+                    face_flip,
+                    face_rotation,
+                    periodicity_factor,
+                    cache);
+                }
+            }
+          else
+            {
+              Assert(!face_1->has_children(), ExcInternalError());
+
+              // Important note:
+              // In 3D we have to take care of the fact that face_rotation
+              // gives the relative rotation of face_1 to face_2, i.e. we have
+              // to invert the rotation when constraining face_2 to face_1.
+              // Therefore face_flip has to be toggled if face_rotation is
+              // true: In case of inverted orientation, nothing has to be done.
+              set_periodicity_constraints(face_1,
+                                          face_2,
+                                          transformation,
+                                          affine_constraints,
+                                          component_mask,
+                                          face_orientation,
+                                          face_orientation ?
+                                            face_rotation ^ face_flip :
                                             face_flip,
-                                            face_rotation,
-                                            periodicity_factor);
-              }
-          }
-        else
-          {
-            Assert(!face_1->has_children(), ExcInternalError());
-
-            // Important note:
-            // In 3D we have to take care of the fact that face_rotation gives
-            // the relative rotation of face_1 to face_2, i.e. we have to invert
-            // the rotation when constraining face_2 to face_1. Therefore
-            // face_flip has to be toggled if face_rotation is true: In case of
-            // inverted orientation, nothing has to be done.
-            set_periodicity_constraints(face_1,
-                                        face_2,
-                                        transformation,
-                                        affine_constraints,
-                                        component_mask,
-                                        face_orientation,
-                                        face_orientation ?
-                                          face_rotation ^ face_flip :
-                                          face_flip,
-                                        face_rotation,
-                                        periodicity_factor);
-          }
-      }
+                                          face_rotation,
+                                          periodicity_factor,
+                                          cache);
+            }
+        }
+    }
+  } // namespace
+
+
+
+  template <typename FaceIterator, typename number>
+  void
+  make_periodicity_constraints(
+    const FaceIterator &                         face_1,
+    const typename identity<FaceIterator>::type &face_2,
+    AffineConstraints<number> &                  affine_constraints,
+    const ComponentMask &                        component_mask,
+    const bool                                   face_orientation,
+    const bool                                   face_flip,
+    const bool                                   face_rotation,
+    const FullMatrix<double> &                   matrix,
+    const std::vector<unsigned int> &            first_vector_components,
+    const number                                 periodicity_factor)
+  {
+    PeriodicityMatrixCache<FaceIterator::AccessorType::dimension,
+                           FaceIterator::AccessorType::space_dimension>
+      cache;
+    make_periodicity_constraints(face_1,
+                                 face_2,
+                                 affine_constraints,
+                                 component_mask,
+                                 face_orientation,
+                                 face_flip,
+                                 face_rotation,
+                                 matrix,
+                                 first_vector_components,
+                                 periodicity_factor,
+                                 cache);
   }
 
 
@@ -2538,6 +2881,10 @@ namespace DoFTools
     const std::vector<unsigned int> &first_vector_components,
     const number                     periodicity_factor)
   {
+    // the matrices that only depend on the finite element are shared by all
+    // pairs of faces
+    PeriodicityMatrixCache<dim, spacedim> cache;
+
     // Loop over all periodic faces...
     for (auto &pair : periodic_faces)
       {
@@ -2561,7 +2908,8 @@ namespace DoFTools
                                      pair.orientation[2],
                                      pair.matrix,
                                      first_vector_components,
-                                     periodicity_factor);
+                                     periodicity_factor,
+                                     cache);
       }
   }
 
@@ -0,0 +1,29 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+#include <deal.II/lac/assembly_scatter_plan.templates.h>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+template class AssemblyScatterPlan<double>;
+template class AssemblyScatterPlan<float>;
+#ifdef DEAL_II_WITH_COMPLEX_VALUES
+template class AssemblyScatterPlan<std::complex<double>>;
+template class AssemblyScatterPlan<std::complex<float>>;
+#endif
+
+DEAL_II_NAMESPACE_CLOSE
@@ -0,0 +1,87 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2002 - 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+#include <deal.II/lac/precondition_smoothed_aggregation.templates.h>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+// explicit instantiations for double and float hierarchies
+template class PreconditionSmoothedAggregation<double>;
+template void
+PreconditionSmoothedAggregation<double>::initialize<double>(
+  const SparseMatrix<double> &,
+  const AdditionalData &);
+template void
+PreconditionSmoothedAggregation<double>::initialize<float>(
+  const SparseMatrix<float> &,
+  const AdditionalData &);
+template void
+PreconditionSmoothedAggregation<double>::update_matrix_values<double>(
+  const SparseMatrix<double> &);
+template void
+PreconditionSmoothedAggregation<double>::update_matrix_values<float>(
+  const SparseMatrix<float> &);
+template void
+PreconditionSmoothedAggregation<double>::vmult<double>(
+  Vector<double> &,
+  const Vector<double> &) const;
+template void
+PreconditionSmoothedAggregation<double>::vmult<float>(
+  Vector<float> &,
+  const Vector<float> &) const;
+template void
+PreconditionSmoothedAggregation<double>::Tvmult<double>(
+  Vector<double> &,
+  const Vector<double> &) const;
+template void
+PreconditionSmoothedAggregation<double>::Tvmult<float>(
+  Vector<float> &,
+  const Vector<float> &) const;
+
+template class PreconditionSmoothedAggregation<float>;
+template void
+PreconditionSmoothedAggregation<float>::initialize<double>(
+  const SparseMatrix<double> &,
+  const AdditionalData &);
+template void
+PreconditionSmoothedAggregation<float>::initialize<float>(
+  const SparseMatrix<float> &,
+  const AdditionalData &);
+template void
+PreconditionSmoothedAggregation<float>::update_matrix_values<double>(
+  const SparseMatrix<double> &);
+template void
+PreconditionSmoothedAggregation<float>::update_matrix_values<float>(
+  const SparseMatrix<float> &);
+template void
+PreconditionSmoothedAggregation<float>::vmult<double>(
+  Vector<double> &,
+  const Vector<double> &) const;
+template void
+PreconditionSmoothedAggregation<float>::vmult<float>(
+  Vector<float> &,
+  const Vector<float> &) const;
+template void
+PreconditionSmoothedAggregation<float>::Tvmult<double>(
+  Vector<double> &,
+  const Vector<double> &) const;
+template void
+PreconditionSmoothedAggregation<float>::Tvmult<float>(
+  Vector<float> &,
+  const Vector<float> &) const;
+
+DEAL_II_NAMESPACE_CLOSE
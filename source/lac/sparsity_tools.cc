@@ -15,6 +15,8 @@
 
 
 #include <deal.II/base/exceptions.h>
+#include <deal.II/base/parallel.h>
+#include <deal.II/base/thread_management.h>
 
 #include <deal.II/lac/exceptions.h>
 #include <deal.II/lac/sparsity_pattern.h>
@@ -23,6 +25,7 @@
 #include <algorithm>
 #include <functional>
 #include <memory>
+#include <numeric>
 #include <set>
 
 #ifdef DEAL_II_WITH_MPI
@@ -528,16 +531,15 @@ namespace SparsityTools
      * invalid_size_type indicates that a node has not been numbered yet),
      * pick a valid starting index among the as-yet unnumbered one.
      */
-    DynamicSparsityPattern::size_type
+    template <typename SparsityPatternType>
+    types::global_dof_index
     find_unnumbered_starting_index(
-      const DynamicSparsityPattern &                        sparsity,
-      const std::vector<DynamicSparsityPattern::size_type> &new_indices)
+      const SparsityPatternType &                 sparsity,
+      const std::vector<types::global_dof_index> &new_indices)
     {
-      DynamicSparsityPattern::size_type starting_point =
-        numbers::invalid_size_type;
-      DynamicSparsityPattern::size_type min_coordination = sparsity.n_rows();
-      for (DynamicSparsityPattern::size_type row = 0; row < sparsity.n_rows();
-           ++row)
+      types::global_dof_index starting_point   = numbers::invalid_size_type;
+      types::global_dof_index min_coordination = sparsity.n_rows();
+      for (types::global_dof_index row = 0; row < sparsity.n_rows(); ++row)
         // look over all as-yet unnumbered indices
         if (new_indices[row] == numbers::invalid_size_type)
           {
@@ -557,8 +559,7 @@ namespace SparsityTools
       // starting point, e.g. the first unnumbered one
       if (starting_point == numbers::invalid_size_type)
         {
-          for (DynamicSparsityPattern::size_type i = 0; i < new_indices.size();
-               ++i)
+          for (types::global_dof_index i = 0; i < new_indices.size(); ++i)
             if (new_indices[i] == numbers::invalid_size_type)
               {
                 starting_point = i;
@@ -571,6 +572,174 @@ namespace SparsityTools
 
       return starting_point;
     }
+
+
+
+    template <typename SparsityPatternType>
+    void
+    reorder_Cuthill_McKee(
+      const SparsityPatternType &                 sparsity,
+      std::vector<types::global_dof_index> &      new_indices,
+      const std::vector<types::global_dof_index> &starting_indices)
+    {
+      using size_type = types::global_dof_index;
+
+      Assert(sparsity.n_rows() == sparsity.n_cols(),
+             ExcDimensionMismatch(sparsity.n_rows(), sparsity.n_cols()));
+      Assert(sparsity.n_rows() == new_indices.size(),
+             ExcDimensionMismatch(sparsity.n_rows(), new_indices.size()));
+      Assert(starting_indices.size() <= sparsity.n_rows(),
+             ExcMessage(
+               "You can't specify more starting indices than there are rows"));
+      for (const auto starting_index : starting_indices)
+        {
+          (void)starting_index;
+          Assert(starting_index < sparsity.n_rows(),
+                 ExcMessage("Invalid starting index: All starting indices need "
+                            "to be between zero and the number of rows in the "
+                            "sparsity pattern."));
+        }
+
+      // cache the coordination numbers, which we need to sort the dofs of
+      // each round
+      std::vector<size_type> coordination(sparsity.n_rows());
+      dealii::parallel::apply_to_subranges(
+        size_type(0),
+        sparsity.n_rows(),
+        [&](const size_type begin, const size_type end) {
+          for (size_type row = begin; row < end; ++row)
+            coordination[row] = sparsity.row_length(row);
+        },
+        4096);
+
+      // store the indices of the dofs renumbered in the last round. Default to
+      // starting points
+      std::vector<size_type> last_round_dofs(starting_indices);
+
+      // initialize the new_indices array with invalid values
+      std::fill(new_indices.begin(),
+                new_indices.end(),
+                numbers::invalid_size_type);
+
+      // if no starting indices were given: find dof with lowest coordination
+      // number
+      if (last_round_dofs.empty())
+        last_round_dofs.push_back(
+          find_unnumbered_starting_index(sparsity, new_indices));
+
+      // store next free dof index
+      size_type next_free_number = 0;
+
+      // enumerate the first round dofs
+      for (size_type i = 0; i != last_round_dofs.size(); ++i)
+        new_indices[last_round_dofs[i]] = next_free_number++;
+
+      // the neighbors of the dofs of the last round are collected in chunks
+      // of this many dofs, which are worked on in parallel. the new numbers
+      // are only assigned after all chunks have been collected, so the
+      // result does not depend on the number of threads
+      const size_type                     chunk_size = 512;
+      std::vector<std::vector<size_type>> chunk_dofs;
+      std::vector<size_type>              next_round_dofs;
+
+      // now do as many steps as needed to renumber all dofs
+      while (true)
+        {
+          // find all as-yet unnumbered neighbors of the dofs numbered in the
+          // last round, sorted and without multiple entries
+          const size_type n_chunks =
+            (last_round_dofs.size() + chunk_size - 1) / chunk_size;
+          chunk_dofs.resize(n_chunks);
+          dealii::parallel::apply_to_subranges(
+            size_type(0),
+            n_chunks,
+            [&](const size_type begin, const size_type end) {
+              for (size_type c = begin; c < end; ++c)
+                {
+                  std::vector<size_type> &dofs = chunk_dofs[c];
+                  dofs.clear();
+                  const size_type last =
+                    std::min<size_type>((c + 1) * chunk_size,
+                                        last_round_dofs.size());
+                  for (size_type i = c * chunk_size; i < last; ++i)
+                    for (auto j = sparsity.begin(last_round_dofs[i]);
+                         j != sparsity.end(last_round_dofs[i]);
+                         ++j)
+                      if (new_indices[j->column()] ==
+                          numbers::invalid_size_type)
+                        dofs.push_back(j->column());
+                  std::sort(dofs.begin(), dofs.end());
+                  dofs.erase(std::unique(dofs.begin(), dofs.end()),
+                             dofs.end());
+                }
+            },
+            1);
+
+          next_round_dofs.clear();
+          for (const std::vector<size_type> &dofs : chunk_dofs)
+            next_round_dofs.insert(next_round_dofs.end(),
+                                   dofs.begin(),
+                                   dofs.end());
+          if (n_chunks > 1)
+            {
+              std::sort(next_round_dofs.begin(), next_round_dofs.end());
+              next_round_dofs.erase(std::unique(next_round_dofs.begin(),
+                                                next_round_dofs.end()),
+                                    next_round_dofs.end());
+            }
+
+          // check whether there are any new dofs in the list. if there are
+          // none, then we have completely numbered the current component of
+          // the graph. check if there are as yet unnumbered components of the
+          // graph that we would then have to do next
+          if (next_round_dofs.empty())
+            {
+              if (std::find(new_indices.begin(),
+                            new_indices.end(),
+                            numbers::invalid_size_type) == new_indices.end())
+                // no unnumbered indices, so we can leave now
+                break;
+
+              // otherwise find a valid starting point for the next component
+              // of the graph and continue with numbering that one. we only do
+              // so if no starting indices were provided by the user (see the
+              // documentation of this function) so produce an error if we got
+              // here and starting indices were given
+              Assert(starting_indices.empty(),
+                     ExcMessage("The input graph appears to have more than one "
+                                "component, but as stated in the documentation "
+                                "we only want to reorder such graphs if no "
+                                "starting indices are given. The function was "
+                                "called with starting indices, however."))
+
+                next_round_dofs.push_back(
+                  find_unnumbered_starting_index(sparsity, new_indices));
+            }
+
+          // assign new DoF numbers to the elements of the present front in
+          // the order of their coordination numbers. dofs with the same
+          // coordination number keep their order by index
+          std::stable_sort(next_round_dofs.begin(),
+                           next_round_dofs.end(),
+                           [&](const size_type a, const size_type b) {
+                             return coordination[a] < coordination[b];
+                           });
+          for (const size_type dof : next_round_dofs)
+            new_indices[dof] = next_free_number++;
+
+          // after that: copy this round's dofs for the next round
+          last_round_dofs.swap(next_round_dofs);
+        }
+
+      // test for all indices numbered. this mostly tests whether the
+      // front-marching-algorithm (which Cuthill-McKee actually is) has reached
+      // all points.
+      Assert((std::find(new_indices.begin(),
+                        new_indices.end(),
+                        numbers::invalid_size_type) == new_indices.end()) &&
+               (next_free_number == sparsity.n_rows()),
+             ExcInternalError());
+    }
   } // namespace internal
 
 
@@ -581,143 +750,23 @@ namespace SparsityTools
     std::vector<DynamicSparsityPattern::size_type> &      new_indices,
     const std::vector<DynamicSparsityPattern::size_type> &starting_indices)
   {
-    Assert(sparsity.n_rows() == sparsity.n_cols(),
-           ExcDimensionMismatch(sparsity.n_rows(), sparsity.n_cols()));
-    Assert(sparsity.n_rows() == new_indices.size(),
-           ExcDimensionMismatch(sparsity.n_rows(), new_indices.size()));
-    Assert(starting_indices.size() <= sparsity.n_rows(),
-           ExcMessage(
-             "You can't specify more starting indices than there are rows"));
     Assert(sparsity.row_index_set().size() == 0 ||
              sparsity.row_index_set().size() == sparsity.n_rows(),
            ExcMessage(
              "Only valid for sparsity patterns which store all rows."));
-    for (const auto starting_index : starting_indices)
-      {
-        (void)starting_index;
-        Assert(starting_index < sparsity.n_rows(),
-               ExcMessage("Invalid starting index: All starting indices need "
-                          "to be between zero and the number of rows in the "
-                          "sparsity pattern."));
-      }
-
-    // store the indices of the dofs renumbered in the last round. Default to
-    // starting points
-    std::vector<DynamicSparsityPattern::size_type> last_round_dofs(
-      starting_indices);
-
-    // initialize the new_indices array with invalid values
-    std::fill(new_indices.begin(),
-              new_indices.end(),
-              numbers::invalid_size_type);
-
-    // if no starting indices were given: find dof with lowest coordination
-    // number
-    if (last_round_dofs.empty())
-      last_round_dofs.push_back(
-        internal::find_unnumbered_starting_index(sparsity, new_indices));
-
-    // store next free dof index
-    DynamicSparsityPattern::size_type next_free_number = 0;
-
-    // enumerate the first round dofs
-    for (DynamicSparsityPattern::size_type i = 0; i != last_round_dofs.size();
-         ++i)
-      new_indices[last_round_dofs[i]] = next_free_number++;
-
-    // now do as many steps as needed to renumber all dofs
-    while (true)
-      {
-        // store the indices of the dofs to be renumbered in the next round
-        std::vector<DynamicSparsityPattern::size_type> next_round_dofs;
-
-        // find all neighbors of the dofs numbered in the last round
-        for (const auto dof : last_round_dofs)
-          for (DynamicSparsityPattern::iterator j = sparsity.begin(dof);
-               j < sparsity.end(dof);
-               ++j)
-            next_round_dofs.push_back(j->column());
-
-        // sort dof numbers
-        std::sort(next_round_dofs.begin(), next_round_dofs.end());
-
-        // delete multiple entries
-        std::vector<DynamicSparsityPattern::size_type>::iterator end_sorted;
-        end_sorted =
-          std::unique(next_round_dofs.begin(), next_round_dofs.end());
-        next_round_dofs.erase(end_sorted, next_round_dofs.end());
-
-        // eliminate dofs which are already numbered
-        for (int s = next_round_dofs.size() - 1; s >= 0; --s)
-          if (new_indices[next_round_dofs[s]] != numbers::invalid_size_type)
-            next_round_dofs.erase(next_round_dofs.begin() + s);
-
-        // check whether there are any new dofs in the list. if there are
-        // none, then we have completely numbered the current component of the
-        // graph. check if there are as yet unnumbered components of the graph
-        // that we would then have to do next
-        if (next_round_dofs.empty())
-          {
-            if (std::find(new_indices.begin(),
-                          new_indices.end(),
-                          numbers::invalid_size_type) == new_indices.end())
-              // no unnumbered indices, so we can leave now
-              break;
-
-            // otherwise find a valid starting point for the next component of
-            // the graph and continue with numbering that one. we only do so
-            // if no starting indices were provided by the user (see the
-            // documentation of this function) so produce an error if we got
-            // here and starting indices were given
-            Assert(starting_indices.empty(),
-                   ExcMessage("The input graph appears to have more than one "
-                              "component, but as stated in the documentation "
-                              "we only want to reorder such graphs if no "
-                              "starting indices are given. The function was "
-                              "called with starting indices, however."))
-
-              next_round_dofs.push_back(
-                internal::find_unnumbered_starting_index(sparsity,
-                                                         new_indices));
-          }
-
-
-
-        // store for each coordination number the dofs with these coordination
-        // number
-        std::multimap<DynamicSparsityPattern::size_type, int>
-          dofs_by_coordination;
-
-        // find coordination number for each of these dofs
-        for (const types::global_dof_index next_round_dof : next_round_dofs)
-          {
-            const DynamicSparsityPattern::size_type coordination =
-              sparsity.row_length(next_round_dof);
 
-            // insert this dof at its coordination number
-            const std::pair<const DynamicSparsityPattern::size_type, int>
-              new_entry(coordination, next_round_dof);
-            dofs_by_coordination.insert(new_entry);
-          }
+    internal::reorder_Cuthill_McKee(sparsity, new_indices, starting_indices);
+  }
 
-        // assign new DoF numbers to the elements of the present front:
-        std::multimap<DynamicSparsityPattern::size_type, int>::iterator i;
-        for (i = dofs_by_coordination.begin(); i != dofs_by_coordination.end();
-             ++i)
-          new_indices[i->second] = next_free_number++;
 
-        // after that: copy this round's dofs for the next round
-        last_round_dofs = next_round_dofs;
-      }
 
-    // test for all indices numbered. this mostly tests whether the
-    // front-marching-algorithm (which Cuthill-McKee actually is) has reached
-    // all points.
-    Assert((std::find(new_indices.begin(),
-                      new_indices.end(),
-                      numbers::invalid_size_type) == new_indices.end()) &&
-             (next_free_number == sparsity.n_rows()),
-           ExcInternalError());
+  void
+  reorder_Cuthill_McKee(
+    const SparsityPattern &                        sparsity,
+    std::vector<SparsityPattern::size_type> &      new_indices,
+    const std::vector<SparsityPattern::size_type> &starting_indices)
+  {
+    internal::reorder_Cuthill_McKee(sparsity, new_indices, starting_indices);
   }
 
 
@@ -910,6 +959,338 @@ namespace SparsityTools
 
 
 
+  namespace internal
+  {
+    /**
+     * The recursive bisection of reorder_nested_dissection(). The subgraphs
+     * that are worked on at the same time are only connected through nodes
+     * that have already been numbered, so the tasks working on them never
+     * touch the same entries of the arrays of this class.
+     */
+    template <typename SparsityPatternType>
+    class NestedDissection
+    {
+    public:
+      using size_type = types::global_dof_index;
+
+      NestedDissection(const SparsityPatternType &sparsity,
+                       std::vector<size_type> &   new_indices,
+                       const unsigned int         min_subgraph_size)
+        : sparsity(sparsity)
+        , new_indices(new_indices)
+        , min_subgraph_size(min_subgraph_size)
+        , subgraph(sparsity.n_rows(), 0)
+        , level(sparsity.n_rows(), numbers::invalid_size_type)
+      {}
+
+      /**
+       * Give the nodes of a subgraph the new indices starting at @p
+       * first_index: split the subgraph into its connected components, or
+       * split a connected subgraph into two parts and a separator, number
+       * the separator last and recurse into the other parts. Subgraphs with
+       * at most min_subgraph_size nodes are numbered in the given order.
+       */
+      void
+      bisect(std::vector<size_type> &nodes, const size_type first_index)
+      {
+        const size_type n_nodes = nodes.size();
+        if (n_nodes <= min_subgraph_size)
+          {
+            number(nodes, first_index);
+            return;
+          }
+
+        // find a pseudo-peripheral node with the algorithm of George and
+        // Liu: start at a node with minimal coordination number and move to
+        // a node of minimal coordination number in the last level of the
+        // breadth-first search as long as this increases the number of
+        // levels
+        size_type start = nodes[0];
+        for (const size_type node : nodes)
+          if (sparsity.row_length(node) < sparsity.row_length(start))
+            start = node;
+
+        std::vector<size_type> order, level_start;
+        breadth_first_search(start, order, level_start);
+
+        std::vector<size_type> candidate_order, candidate_level_start;
+        while (true)
+          {
+            size_type candidate = order[level_start[level_start.size() - 2]];
+            for (size_type i = level_start[level_start.size() - 2];
+                 i < order.size();
+                 ++i)
+              if (sparsity.row_length(order[i]) <
+                  sparsity.row_length(candidate))
+                candidate = order[i];
+
+            breadth_first_search(candidate,
+                                 candidate_order,
+                                 candidate_level_start);
+            if (candidate_level_start.size() <= level_start.size())
+              break;
+            order.swap(candidate_order);
+            level_start.swap(candidate_level_start);
+          }
+
+        if (order.size() < n_nodes)
+          {
+            // the subgraph is not connected. find all of its components and
+            // work on them independently
+            std::vector<std::vector<size_type>> components;
+            for (const size_type node : nodes)
+              if (level[node] == numbers::invalid_size_type)
+                {
+                  components.emplace_back();
+                  breadth_first_search(node, components.back(), level_start);
+                  for (const size_type i : components.back())
+                    level[i] = 0;
+                }
+            nodes.clear();
+            nodes.shrink_to_fit();
+
+            std::vector<size_type> first_indices(components.size());
+            size_type              next_index = first_index;
+            for (unsigned int c = 0; c < components.size(); ++c)
+              {
+                first_indices[c] = next_index;
+                for (const size_type i : components[c])
+                  {
+                    level[i]    = numbers::invalid_size_type;
+                    subgraph[i] = next_index;
+                  }
+                next_index += components[c].size();
+              }
+
+            dealii::parallel::apply_to_subranges(
+              0U,
+              static_cast<unsigned int>(components.size()),
+              [&](const unsigned int begin, const unsigned int end) {
+                for (unsigned int c = begin; c < end; ++c)
+                  bisect(components[c], first_indices[c]);
+              },
+              1);
+            return;
+          }
+
+        // subgraphs that are too thin to be split are numbered in the order
+        // of the breadth-first search
+        const size_type n_levels = level_start.size() - 1;
+        if (n_levels < 3)
+          {
+            number(order, first_index);
+            return;
+          }
+
+        // use the level that contains the median node as separator, but
+        // move the nodes of that level that are not connected to the next
+        // level into the first part
+        size_type separator_level = 1;
+        while (separator_level < n_levels - 2 &&
+               level_start[separator_level + 1] < n_nodes / 2)
+          ++separator_level;
+
+        for (size_type i = level_start[separator_level + 1];
+             i < level_start[separator_level + 2];
+             ++i)
+          level[order[i]] = 0;
+
+        std::vector<size_type> part_1(order.begin(),
+                                      order.begin() +
+                                        level_start[separator_level]);
+        std::vector<size_type> separator;
+        for (size_type i = level_start[separator_level];
+             i < level_start[separator_level + 1];
+             ++i)
+          {
+            bool is_separator = false;
+            for (auto j = sparsity.begin(order[i]);
+                 j != sparsity.end(order[i]);
+                 ++j)
+              if (level[j->column()] == 0)
+                {
+                  is_separator = true;
+                  break;
+                }
+            (is_separator ? separator : part_1).push_back(order[i]);
+          }
+
+        for (size_type i = level_start[separator_level + 1];
+             i < level_start[separator_level + 2];
+             ++i)
+          level[order[i]] = numbers::invalid_size_type;
+
+        std::vector<size_type> part_2(order.begin() +
+                                        level_start[separator_level + 1],
+                                      order.end());
+        order.clear();
+        order.shrink_to_fit();
+        nodes.clear();
+        nodes.shrink_to_fit();
+
+        const size_type first_index_2 = first_index + part_1.size();
+        number(separator, first_index_2 + part_2.size());
+        for (const size_type node : part_2)
+          subgraph[node] = first_index_2;
+
+        // work on large parts in parallel
+        if (n_nodes > 8192)
+          {
+            Threads::Task<void> task =
+              Threads::new_task([&]() { bisect(part_1, first_index); });
+            bisect(part_2, first_index_2);
+            task.join();
+          }
+        else
+          {
+            bisect(part_1, first_index);
+            bisect(part_2, first_index_2);
+          }
+      }
+
+    private:
+      /**
+       * Give the nodes the consecutive new indices starting at @p
+       * first_index and remove them from their subgraph.
+       */
+      void
+      number(const std::vector<size_type> &nodes, const size_type first_index)
+      {
+        for (size_type i = 0; i < nodes.size(); ++i)
+          {
+            new_indices[nodes[i]] = first_index + i;
+            subgraph[nodes[i]]    = numbers::invalid_size_type;
+          }
+      }
+
+      /**
+       * Do a breadth-first search from @p start within the subgraph of @p
+       * start. On return, @p order contains the nodes that were reached in
+       * the order in which they were reached, and the nodes of level @p l
+       * are the ones between the entries @p l and <tt>l+1</tt> of @p
+       * level_start.
+       */
+      void
+      breadth_first_search(const size_type         start,
+                           std::vector<size_type> &order,
+                           std::vector<size_type> &level_start)
+      {
+        const size_type id = subgraph[start];
+
+        order.clear();
+        level_start.clear();
+        order.push_back(start);
+        level_start.push_back(0);
+        level[start] = 0;
+        while (true)
+          {
+            const size_type begin = level_start.back();
+            const size_type end   = order.size();
+            for (size_type i = begin; i < end; ++i)
+              for (auto j = sparsity.begin(order[i]);
+                   j != sparsity.end(order[i]);
+                   ++j)
+                if (subgraph[j->column()] == id &&
+                    level[j->column()] == numbers::invalid_size_type)
+                  {
+                    level[j->column()] = level_start.size();
+                    order.push_back(j->column());
+                  }
+            level_start.push_back(end);
+            if (order.size() == end)
+              break;
+          }
+
+        // the levels are only used as markers during the search
+        for (const size_type node : order)
+          level[node] = numbers::invalid_size_type;
+      }
+
+      const SparsityPatternType &sparsity;
+
+      std::vector<size_type> &new_indices;
+
+      const unsigned int min_subgraph_size;
+
+      /**
+       * For each node, the first new index of the subgraph it belongs to, or
+       * invalid_size_type once the node has been numbered.
+       */
+      std::vector<size_type> subgraph;
+
+      /**
+       * Markers for the breadth-first searches.
+       */
+      std::vector<size_type> level;
+    };
+
+
+
+    template <typename SparsityPatternType>
+    void
+    reorder_nested_dissection(
+      const SparsityPatternType &           sparsity,
+      std::vector<types::global_dof_index> &new_indices,
+      const unsigned int                    min_subgraph_size)
+    {
+      AssertDimension(sparsity.n_rows(), sparsity.n_cols());
+      AssertDimension(sparsity.n_rows(), new_indices.size());
+      Assert(min_subgraph_size > 0,
+             ExcMessage("The minimal size of the subgraphs must be positive."));
+
+      std::fill(new_indices.begin(),
+                new_indices.end(),
+                numbers::invalid_size_type);
+      if (sparsity.n_rows() == 0)
+        return;
+
+      std::vector<types::global_dof_index> nodes(sparsity.n_rows());
+      std::iota(nodes.begin(), nodes.end(), types::global_dof_index(0));
+
+      NestedDissection<SparsityPatternType> nested_dissection(
+        sparsity, new_indices, min_subgraph_size);
+      nested_dissection.bisect(nodes, 0);
+
+      Assert(std::find(new_indices.begin(),
+                       new_indices.end(),
+                       numbers::invalid_size_type) == new_indices.end(),
+             ExcInternalError());
+    }
+  } // namespace internal
+
+
+
+  void
+  reorder_nested_dissection(
+    const DynamicSparsityPattern &                  sparsity,
+    std::vector<DynamicSparsityPattern::size_type> &new_indices,
+    const unsigned int                              min_subgraph_size)
+  {
+    Assert(sparsity.row_index_set().size() == 0 ||
+             sparsity.row_index_set().size() == sparsity.n_rows(),
+           ExcMessage(
+             "Only valid for sparsity patterns which store all rows."));
+
+    internal::reorder_nested_dissection(sparsity,
+                                        new_indices,
+                                        min_subgraph_size);
+  }
+
+
+
+  void
+  reorder_nested_dissection(
+    const SparsityPattern &                  sparsity,
+    std::vector<SparsityPattern::size_type> &new_indices,
+    const unsigned int                       min_subgraph_size)
+  {
+    internal::reorder_nested_dissection(sparsity,
+                                        new_indices,
+                                        min_subgraph_size);
+  }
+
+
+
 #ifdef DEAL_II_WITH_MPI
 
   void
@@ -20,6 +20,7 @@
 
 #include <deal.II/matrix_free/dof_info.templates.h>
 
+#include <cmath>
 #include <iostream>
 
 DEAL_II_NAMESPACE_OPEN
@@ -54,6 +55,10 @@ namespace internal
       row_starts_plain_indices.clear();
       plain_dof_indices.clear();
       dof_indices_interleaved.clear();
+      dof_indices_compressed.clear();
+      dof_indices_compressed_start.clear();
+      compressed_dof_groups.clear();
+      compressed_dof_offsets.clear();
       for (unsigned int i = 0; i < 3; ++i)
         {
           index_storage_variants[i].clear();
@@ -843,6 +848,137 @@ namespace internal
                 interleaved_dof_indices[k * vectorization_length + j] =
                   dof_indices[j * ndofs + k];
           }
+
+      // Step 5: Compress the interleaved indices by geometric entities
+      compute_compressed_interleaved_indices();
+    }
+
+
+
+    void
+    DoFInfo::compute_compressed_interleaved_indices()
+    {
+      dof_indices_compressed.clear();
+      dof_indices_compressed_start.clear();
+      compressed_dof_groups.clear();
+      compressed_dof_offsets.clear();
+
+      // only implemented for a single element with the same number of
+      // degrees of freedom in each component, assuming a lexicographic
+      // arrangement of the unknowns as for FE_Q or FE_DGQ. A different
+      // arrangement is caught by the check of the cell indices below.
+      if (dofs_per_cell.size() != 1 || dimension < 1 || dimension > 3)
+        return;
+      const unsigned int n_components = start_components.back();
+      const unsigned int ndofs        = dofs_per_cell[0];
+      if (n_components == 0 || ndofs % n_components != 0)
+        return;
+      const unsigned int dofs_per_component = ndofs / n_components;
+      const unsigned int n_points_1d        = static_cast<unsigned int>(
+        std::round(std::pow(dofs_per_component, 1. / dimension)));
+      if (n_points_1d < 2 ||
+          Utilities::pow(n_points_1d, dimension) != dofs_per_component)
+        return;
+
+      // Group the degrees of freedom by the geometric entity they are
+      // located on, identified by the position along each coordinate
+      // direction: the lower end, the interior, or the upper end
+      const unsigned int        n_entities = Utilities::pow(3, dimension);
+      std::vector<unsigned int> entity_to_group(n_components * n_entities,
+                                                numbers::invalid_unsigned_int);
+      std::vector<unsigned int> dof_groups(ndofs);
+      unsigned int              n_groups = 0;
+      for (unsigned int c = 0; c < n_components; ++c)
+        for (unsigned int i = 0; i < dofs_per_component; ++i)
+          {
+            unsigned int entity = c * n_entities;
+            for (unsigned int d = 0, index = i, stride = 1; d < dimension;
+                 ++d, index /= n_points_1d, stride *= 3)
+              {
+                const unsigned int position = index % n_points_1d;
+                entity += stride * (position == 0 ?
+                                      0 :
+                                      (position == n_points_1d - 1 ? 2 : 1));
+              }
+            if (entity_to_group[entity] == numbers::invalid_unsigned_int)
+              entity_to_group[entity] = n_groups++;
+            dof_groups[c * dofs_per_component + i] = entity_to_group[entity];
+          }
+
+      // nothing to gain if each entity holds a single degree of freedom
+      if (n_groups >= ndofs)
+        return;
+
+      std::vector<unsigned int> first_dof_of_group(
+        n_groups, numbers::invalid_unsigned_int);
+      for (unsigned int i = 0; i < ndofs; ++i)
+        if (first_dof_of_group[dof_groups[i]] == numbers::invalid_unsigned_int)
+          first_dof_of_group[dof_groups[i]] = i;
+
+      const unsigned int n_cells =
+        index_storage_variants[dof_access_cell].size();
+      std::vector<unsigned int> dof_offsets;
+      std::vector<unsigned int> group_starts(n_groups * vectorization_length);
+      dof_indices_compressed_start.resize(n_cells,
+                                          numbers::invalid_unsigned_int);
+      for (unsigned int cell = 0; cell < n_cells; ++cell)
+        if (index_storage_variants[dof_access_cell][cell] ==
+            IndexStorageVariants::interleaved)
+          {
+            const unsigned int *indices =
+              dof_indices_interleaved.data() +
+              row_starts[cell * vectorization_length * n_components].first;
+
+            // the first cell defines the offsets within the entities, which
+            // all other cells are checked against
+            if (dof_offsets.empty())
+              {
+                std::vector<unsigned int> group_min(
+                  n_groups, numbers::invalid_unsigned_int);
+                for (unsigned int i = 0; i < ndofs; ++i)
+                  group_min[dof_groups[i]] =
+                    std::min(group_min[dof_groups[i]],
+                             indices[i * vectorization_length]);
+                dof_offsets.resize(ndofs);
+                for (unsigned int i = 0; i < ndofs; ++i)
+                  dof_offsets[i] = indices[i * vectorization_length] -
+                                   group_min[dof_groups[i]];
+              }
+
+            for (unsigned int g = 0; g < n_groups; ++g)
+              for (unsigned int v = 0; v < vectorization_length; ++v)
+                group_starts[g * vectorization_length + v] =
+                  indices[first_dof_of_group[g] * vectorization_length + v] -
+                  dof_offsets[first_dof_of_group[g]];
+
+            bool matches_pattern = true;
+            for (unsigned int i = 0; i < ndofs && matches_pattern; ++i)
+              for (unsigned int v = 0; v < vectorization_length; ++v)
+                if (indices[i * vectorization_length + v] !=
+                    group_starts[dof_groups[i] * vectorization_length + v] +
+                      dof_offsets[i])
+                  {
+                    matches_pattern = false;
+                    break;
+                  }
+
+            if (matches_pattern)
+              {
+                dof_indices_compressed_start[cell] =
+                  dof_indices_compressed.size();
+                dof_indices_compressed.insert(dof_indices_compressed.end(),
+                                              group_starts.begin(),
+                                              group_starts.end());
+              }
+          }
+
+      if (dof_indices_compressed.empty())
+        dof_indices_compressed_start.clear();
+      else
+        {
+          compressed_dof_groups.swap(dof_groups);
+          compressed_dof_offsets.swap(dof_offsets);
+        }
     }
 
 
@@ -1488,6 +1624,12 @@ namespace internal
       memory +=
         (row_starts.capacity() * sizeof(std::pair<unsigned int, unsigned int>));
       memory += MemoryConsumption::memory_consumption(dof_indices);
+      memory += MemoryConsumption::memory_consumption(dof_indices_interleaved);
+      memory += MemoryConsumption::memory_consumption(dof_indices_compressed);
+      memory +=
+        MemoryConsumption::memory_consumption(dof_indices_compressed_start);
+      memory += MemoryConsumption::memory_consumption(compressed_dof_groups);
+      memory += MemoryConsumption::memory_consumption(compressed_dof_offsets);
       memory +=
         MemoryConsumption::memory_consumption(hanging_node_constraint_masks);
       memory += MemoryConsumption::memory_consumption(row_starts_plain_indices);
@@ -0,0 +1,155 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// test the allocation policy of AlignedVector: the alignment for huge pages,
+// the parallel first touch, how the policy is passed on between objects, and
+// that dealii::Vector and LinearAlgebra::distributed::Vector are still
+// zeroed correctly with the policy set as default
+
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/multithread_info.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/vector.h>
+
+#include <cstdint>
+#include <numeric>
+
+#include "../tests.h"
+
+
+bool
+is_aligned(const void *ptr, const std::size_t alignment)
+{
+  return reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0;
+}
+
+
+
+void
+test_aligned_vector()
+{
+  const AlignedVectorAllocationPolicy &default_policy =
+    AlignedVectorAllocationPolicy::get_default();
+  deallog << "Default policy: " << default_policy.use_huge_pages << ' '
+          << default_policy.parallel_first_touch << ' '
+          << default_policy.minimum_size << std::endl;
+
+  AlignedVector<double> large, small;
+  large.set_allocation_policy(AlignedVectorAllocationPolicy(true, true));
+  small.set_allocation_policy(AlignedVectorAllocationPolicy(true, true));
+
+  // the first touch writes zeros into the memory, which is the only
+  // situation where resize_fast() gives defined values
+  large.resize_fast(1000000);
+  small.resize_fast(1000);
+  deallog << "Large vector aligned to huge pages: "
+          << is_aligned(large.data(), 2097152) << std::endl;
+  deallog << "Small vector aligned to 64 bytes: "
+          << is_aligned(small.data(), 64) << std::endl;
+  bool all_zero = true;
+  for (const double value : large)
+    all_zero = all_zero && value == 0.;
+  deallog << "Large vector zero after first touch: " << all_zero << std::endl;
+
+  for (unsigned int i = 0; i < large.size(); ++i)
+    large[i] = i;
+
+  // growing the vector keeps the entries
+  large.resize(3000000);
+  bool entries_kept = is_aligned(large.data(), 2097152);
+  for (unsigned int i = 0; i < 1000000; ++i)
+    entries_kept = entries_kept && large[i] == i;
+  deallog << "Entries kept after growing: " << entries_kept << std::endl;
+
+  // a copy takes over the policy, an assignment keeps the policy of the
+  // target, and swap exchanges them. the same holds for the move variants,
+  // which take over the memory of the other vector as it is
+  AlignedVector<double> copy(large), assigned;
+  assigned = large;
+  deallog << "Policy of copy: " << copy.get_allocation_policy().use_huge_pages
+          << ", of assigned vector: "
+          << assigned.get_allocation_policy().use_huge_pages << std::endl;
+
+  AlignedVector<double> moved(std::move(small)), move_assigned;
+  move_assigned = std::move(large);
+  deallog << "Policy of moved vector: "
+          << moved.get_allocation_policy().use_huge_pages
+          << ", of move-assigned vector: "
+          << move_assigned.get_allocation_policy().use_huge_pages
+          << ", memory taken over: "
+          << (move_assigned.size() == 3000000 &&
+              is_aligned(move_assigned.data(), 2097152))
+          << std::endl;
+  assigned.swap(copy);
+  deallog << "Policy after swap: "
+          << copy.get_allocation_policy().use_huge_pages << ' '
+          << assigned.get_allocation_policy().use_huge_pages << std::endl;
+}
+
+
+
+void
+test_vectors()
+{
+  AlignedVectorAllocationPolicy::set_default(
+    AlignedVectorAllocationPolicy(true, true, 1000));
+  deallog << "New default policy: "
+          << AlignedVectorAllocationPolicy::get_default().use_huge_pages << ' '
+          << AlignedVectorAllocationPolicy::get_default().parallel_first_touch
+          << ' ' << AlignedVectorAllocationPolicy::get_default().minimum_size
+          << std::endl;
+
+  AlignedVector<float> aligned_vector(10000, 1.f);
+  deallog << "Policy of new AlignedVector: "
+          << aligned_vector.get_allocation_policy().use_huge_pages << ", size "
+          << aligned_vector.size() << ", l1 norm "
+          << std::accumulate(aligned_vector.begin(), aligned_vector.end(), 0.f)
+          << std::endl;
+
+  Vector<double> vector(100000);
+  deallog << "Vector aligned to huge pages: "
+          << is_aligned(vector.begin(), 2097152)
+          << ", l1 norm: " << vector.l1_norm() << std::endl;
+  vector = 1.;
+  vector.reinit(50000);
+  deallog << "Vector after reinit, size: " << vector.size()
+          << ", l1 norm: " << vector.l1_norm() << std::endl;
+  Vector<double> other(40000);
+  vector = 1.;
+  vector.reinit(other);
+  deallog << "Vector after reinit from other vector, l1 norm: "
+          << vector.l1_norm() << std::endl;
+
+  LinearAlgebra::distributed::Vector<double> distributed_vector(100000);
+  deallog << "Distributed vector aligned to huge pages: "
+          << is_aligned(distributed_vector.begin(), 2097152)
+          << ", l1 norm: " << distributed_vector.l1_norm() << std::endl;
+
+  AlignedVectorAllocationPolicy::set_default(AlignedVectorAllocationPolicy());
+}
+
+
+
+int
+main()
+{
+  initlog();
+  MultithreadInfo::set_thread_limit(testing_max_num_threads());
+
+  test_aligned_vector();
+  test_vectors();
+}
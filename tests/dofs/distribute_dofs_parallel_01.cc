@@ -0,0 +1,121 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// DoFHandler::distribute_dofs() enumerates the DoFs of large meshes with
+// several threads. Check that the result is the same as for the sequential
+// algorithm, i.e., the DoFs are numbered in the order in which they are
+// first encountered when looping over the active cells, and that it agrees
+// with the numbering computed with a single thread, also for meshes with
+// hanging nodes and with lines in non-standard orientation
+
+#include <deal.II/base/multithread_info.h>
+
+#include <deal.II/dofs/dof_accessor.h>
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include "../tests.h"
+
+
+template <int dim, int spacedim>
+void
+check(const Triangulation<dim, spacedim> &tria,
+      const FiniteElement<dim, spacedim> &fe)
+{
+  // the threaded enumeration is only used with more than one thread
+  DoFHandler<dim, spacedim> serial_dof_handler(tria);
+  MultithreadInfo::set_thread_limit(1);
+  serial_dof_handler.distribute_dofs(fe);
+
+  DoFHandler<dim, spacedim> dof_handler(tria);
+  MultithreadInfo::set_thread_limit(4);
+  dof_handler.distribute_dofs(fe);
+
+  std::vector<bool>                    touched(dof_handler.n_dofs(), false);
+  std::vector<types::global_dof_index> dof_indices(fe.n_dofs_per_cell());
+  std::vector<types::global_dof_index> serial_dof_indices(
+    fe.n_dofs_per_cell());
+  types::global_dof_index next_dof         = 0;
+  bool                    agrees           = true;
+  bool                    agrees_to_serial = true;
+  auto                    serial_cell      = serial_dof_handler.begin_active();
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    {
+      cell->get_dof_indices(dof_indices);
+      serial_cell->get_dof_indices(serial_dof_indices);
+      ++serial_cell;
+      if (dof_indices != serial_dof_indices)
+        agrees_to_serial = false;
+      for (const types::global_dof_index i : dof_indices)
+        if (touched[i] == false)
+          {
+            if (i != next_dof)
+              agrees = false;
+            touched[i] = true;
+            ++next_dof;
+          }
+    }
+
+  deallog << fe.get_name() << " on " << tria.n_active_cells()
+          << " cells: " << dof_handler.n_dofs() << " DoFs, "
+          << "numbering agrees with sequential enumeration: "
+          << (agrees && next_dof == dof_handler.n_dofs())
+          << ", with numbering on one thread: "
+          << (agrees_to_serial &&
+              serial_dof_handler.n_dofs() == dof_handler.n_dofs())
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  {
+    Triangulation<2> tria;
+    GridGenerator::hyper_cube(tria);
+    tria.refine_global(7);
+    for (const auto &cell : tria.active_cell_iterators())
+      if (cell->center()[0] < 0.3 && cell->center()[1] < 0.6)
+        cell->set_refine_flag();
+    tria.execute_coarsening_and_refinement();
+
+    check(tria, FE_Q<2>(1));
+    check(tria, FESystem<2>(FE_Q<2>(3), 2));
+  }
+
+  {
+    Triangulation<2, 3> tria;
+    GridGenerator::hyper_sphere(tria);
+    tria.refine_global(6);
+    check(tria, FE_Q<2, 3>(2));
+  }
+
+  {
+    Triangulation<3> tria;
+    GridGenerator::moebius(tria, 20, 1, 1., 0.2);
+    tria.refine_global(3);
+    check(tria, FE_Q<3>(2));
+  }
+}
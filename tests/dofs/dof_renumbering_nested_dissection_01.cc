@@ -0,0 +1,111 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Check that DoFRenumbering::compute_nested_dissection() returns the
+// numbering of SparsityTools::reorder_nested_dissection() on the sparsity
+// pattern of the DoFs, with and without taking into account hanging node
+// constraints, and that DoFRenumbering::nested_dissection() applies it
+
+#include <deal.II/dofs/dof_accessor.h>
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_renumbering.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/sparsity_tools.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+test(const bool use_constraints)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_ball(tria);
+  tria.refine_global(dim == 2 ? 4 : 2);
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->center()[0] > 0.2)
+      cell->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  FE_Q<dim>       fe(2);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  AffineConstraints<double> constraints;
+  if (use_constraints)
+    DoFTools::make_hanging_node_constraints(dof_handler, constraints);
+  constraints.close();
+  DynamicSparsityPattern dsp(dof_handler.n_dofs());
+  DoFTools::make_sparsity_pattern(dof_handler, dsp, constraints);
+
+  std::vector<types::global_dof_index> reference(dof_handler.n_dofs());
+  SparsityTools::reorder_nested_dissection(dsp, reference);
+
+  std::vector<types::global_dof_index> renumbering(dof_handler.n_dofs());
+  DoFRenumbering::compute_nested_dissection(renumbering,
+                                            dof_handler,
+                                            use_constraints);
+
+  std::vector<types::global_dof_index> old_indices(fe.n_dofs_per_cell()),
+    new_indices(fe.n_dofs_per_cell());
+  std::vector<std::vector<types::global_dof_index>> cell_indices;
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    {
+      cell->get_dof_indices(old_indices);
+      for (auto &index : old_indices)
+        index = renumbering[index];
+      cell_indices.push_back(old_indices);
+    }
+
+  DoFRenumbering::nested_dissection(dof_handler, use_constraints);
+
+  bool renumbered = true;
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    {
+      cell->get_dof_indices(new_indices);
+      renumbered =
+        renumbered && new_indices == cell_indices[cell->active_cell_index()];
+    }
+
+  deallog << dim << "d, " << dof_handler.n_dofs() << " DoFs, "
+          << (use_constraints ? "with" : "without") << " constraints"
+          << std::endl;
+  deallog << "Same as SparsityTools: " << (renumbering == reference)
+          << std::endl;
+  deallog << "DoFs renumbered: " << renumbered << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>(false);
+  test<2>(true);
+  test<3>(false);
+  test<3>(true);
+}
@@ -0,0 +1,146 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Check that DoFTools::make_hanging_node_constraints() gives the same
+// constraints when computed with one thread and with several threads on
+// meshes that are large enough to use the threaded code path, and that
+// DoFTools::make_periodicity_constraints() for a vector of face pairs, which
+// shares the interpolation matrices between all pairs, gives the same
+// constraints as the function for a single pair of faces
+
+#include <deal.II/base/multithread_info.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+
+#include "../tests.h"
+
+
+bool
+compare(const AffineConstraints<double> &constraints_1,
+        const AffineConstraints<double> &constraints_2)
+{
+  if (constraints_1.n_constraints() != constraints_2.n_constraints())
+    return false;
+
+  for (const auto &line : constraints_1.get_lines())
+    {
+      if (constraints_2.is_constrained(line.index) == false)
+        return false;
+      const auto *entries = constraints_2.get_constraint_entries(line.index);
+      if (entries->size() != line.entries.size())
+        return false;
+      for (unsigned int i = 0; i < line.entries.size(); ++i)
+        if ((*entries)[i].first != line.entries[i].first ||
+            std::abs((*entries)[i].second - line.entries[i].second) > 1e-12)
+          return false;
+    }
+  return true;
+}
+
+
+
+template <int dim>
+void
+test(const unsigned int n_global_refinements, const FiniteElement<dim> &fe)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria, 0., 1., true);
+  tria.refine_global(n_global_refinements);
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->center().norm() < 0.75)
+      cell->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  deallog << dim << "d, " << fe.get_name() << ", " << tria.n_active_cells()
+          << " cells, " << dof_handler.n_dofs() << " DoFs" << std::endl;
+
+  AffineConstraints<double> serial_constraints;
+  MultithreadInfo::set_thread_limit(1);
+  DoFTools::make_hanging_node_constraints(dof_handler, serial_constraints);
+  serial_constraints.close();
+
+  // the threaded code path is only used with more than one thread, so set
+  // the limit explicitly rather than relying on the testing environment
+  AffineConstraints<double> parallel_constraints;
+  MultithreadInfo::set_thread_limit(4);
+  DoFTools::make_hanging_node_constraints(dof_handler, parallel_constraints);
+  parallel_constraints.close();
+
+  deallog << "Number of hanging node constraints: "
+          << parallel_constraints.n_constraints() << std::endl;
+  deallog << "Serial and parallel constraints agree: "
+          << (compare(serial_constraints, parallel_constraints) ? "OK" :
+                                                                  "FAIL")
+          << std::endl;
+
+  std::vector<GridTools::PeriodicFacePair<
+    typename DoFHandler<dim>::cell_iterator>>
+    periodic_faces;
+  for (unsigned int d = 0; d < dim; ++d)
+    GridTools::collect_periodic_faces(
+      dof_handler, 2 * d, 2 * d + 1, d, periodic_faces);
+
+  AffineConstraints<double> periodicity_constraints;
+  DoFTools::make_periodicity_constraints<dim, dim>(periodic_faces,
+                                                   periodicity_constraints);
+  periodicity_constraints.close();
+
+  AffineConstraints<double> reference_constraints;
+  for (const auto &pair : periodic_faces)
+    DoFTools::make_periodicity_constraints(
+      pair.cell[0]->face(pair.face_idx[0]),
+      pair.cell[1]->face(pair.face_idx[1]),
+      reference_constraints,
+      ComponentMask(),
+      pair.orientation[0],
+      pair.orientation[1],
+      pair.orientation[2],
+      pair.matrix);
+  reference_constraints.close();
+
+  deallog << "Number of periodicity constraints: "
+          << periodicity_constraints.n_constraints() << std::endl;
+  deallog << "Periodicity constraints agree: "
+          << (compare(reference_constraints, periodicity_constraints) ? "OK" :
+                                                                        "FAIL")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>(5, FE_Q<2>(3));
+  test<2>(5, FESystem<2>(FE_Q<2>(2), 2));
+  test<3>(3, FE_Q<3>(2));
+}
@@ -0,0 +1,255 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Check that AssemblyScatterPlan gives the same matrices and vectors as
+// AffineConstraints::distribute_local_to_global(), both in the first
+// assembly that records the plan and in later assemblies that replay it,
+// for hanging node constraints and inhomogeneous boundary constraints. Check
+// SparseMatrix and BlockSparseMatrix, which are written through the value
+// array, and ChunkSparseMatrix, which is written row by row like the
+// matrices of the PETSc and Trilinos wrappers
+
+#include <deal.II/dofs/dof_accessor.h>
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/assembly_scatter_plan.h>
+#include <deal.II/lac/block_sparse_matrix.h>
+#include <deal.II/lac/block_sparsity_pattern.h>
+#include <deal.II/lac/block_vector.h>
+#include <deal.II/lac/chunk_sparse_matrix.h>
+#include <deal.II/lac/chunk_sparsity_pattern.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+// assemble random local matrices and vectors, scaled by the given factor,
+// once with AffineConstraints and once with the scatter plan
+template <int dim, typename MatrixType, typename VectorType>
+void
+assemble(const DoFHandler<dim> &          dof_handler,
+         const AffineConstraints<double> &constraints,
+         AssemblyScatterPlan<double> &    scatter_plan,
+         const double                     factor,
+         MatrixType &                     reference_matrix,
+         VectorType &                     reference_vector,
+         MatrixType &                     matrix,
+         VectorType &                     vector)
+{
+  const unsigned int dofs_per_cell = dof_handler.get_fe().n_dofs_per_cell();
+  FullMatrix<double> local_matrix(dofs_per_cell, dofs_per_cell);
+  Vector<double>     local_vector(dofs_per_cell);
+  std::vector<types::global_dof_index> local_dof_indices(dofs_per_cell);
+
+  reference_matrix = 0.;
+  reference_vector = 0.;
+  matrix           = 0.;
+  vector           = 0.;
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    {
+      for (unsigned int i = 0; i < dofs_per_cell; ++i)
+        {
+          for (unsigned int j = 0; j < dofs_per_cell; ++j)
+            local_matrix(i, j) = factor * random_value<double>();
+          local_matrix(i, i) += factor * dofs_per_cell;
+          local_vector(i) = factor * random_value<double>();
+        }
+      cell->get_dof_indices(local_dof_indices);
+
+      constraints.distribute_local_to_global(local_matrix,
+                                             local_vector,
+                                             local_dof_indices,
+                                             reference_matrix,
+                                             reference_vector,
+                                             true);
+      scatter_plan.distribute_local_to_global(cell->active_cell_index(),
+                                              local_matrix,
+                                              local_vector,
+                                              local_dof_indices,
+                                              matrix,
+                                              vector,
+                                              true);
+    }
+}
+
+
+
+// compare two matrices through their product with a random vector
+template <typename MatrixType, typename VectorType>
+void
+compare(const std::string &name,
+        const MatrixType & reference_matrix,
+        const VectorType & reference_vector,
+        const MatrixType & matrix,
+        const VectorType & vector)
+{
+  VectorType x(reference_vector), y(reference_vector), z(reference_vector);
+  for (unsigned int i = 0; i < x.size(); ++i)
+    x(i) = random_value<double>();
+  reference_matrix.vmult(y, x);
+  matrix.vmult(z, x);
+  z -= y;
+  const bool matrix_ok = z.l2_norm() < 1e-13 * y.l2_norm();
+
+  z = vector;
+  z -= reference_vector;
+  const bool vector_ok = z.l2_norm() < 1e-13 * reference_vector.l2_norm();
+
+  deallog << name << ": matrix " << (matrix_ok ? "OK" : "FAIL") << ", vector "
+          << (vector_ok ? "OK" : "FAIL") << std::endl;
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(2);
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->center()[0] < 0.5)
+      cell->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  FE_Q<dim>       fe(2);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+  const types::global_dof_index n_dofs = dof_handler.n_dofs();
+
+  AffineConstraints<double> constraints;
+  DoFTools::make_hanging_node_constraints(dof_handler, constraints);
+  const IndexSet boundary_dofs = DoFTools::extract_boundary_dofs(dof_handler);
+  for (const auto i : boundary_dofs)
+    if (constraints.is_constrained(i) == false)
+      {
+        constraints.add_line(i);
+        constraints.set_inhomogeneity(i, 1. + 0.01 * i);
+      }
+  constraints.close();
+
+  DynamicSparsityPattern dsp(n_dofs);
+  DoFTools::make_sparsity_pattern(dof_handler, dsp, constraints, false);
+
+  deallog << dim << "d, " << n_dofs << " DoFs" << std::endl;
+
+  AssemblyScatterPlan<double> scatter_plan;
+
+  {
+    SparsityPattern sparsity;
+    sparsity.copy_from(dsp);
+    SparseMatrix<double> reference_matrix(sparsity), matrix(sparsity);
+    Vector<double>       reference_vector(n_dofs), vector(n_dofs);
+
+    scatter_plan.reinit(constraints, sparsity, tria.n_active_cells());
+    for (const double factor : {1., 2.})
+      {
+        assemble(dof_handler,
+                 constraints,
+                 scatter_plan,
+                 factor,
+                 reference_matrix,
+                 reference_vector,
+                 matrix,
+                 vector);
+        compare("SparseMatrix",
+                reference_matrix,
+                reference_vector,
+                matrix,
+                vector);
+      }
+  }
+
+  {
+    const std::vector<types::global_dof_index> block_sizes = {
+      n_dofs / 3, n_dofs - n_dofs / 3};
+    BlockDynamicSparsityPattern block_dsp(block_sizes, block_sizes);
+    for (types::global_dof_index i = 0; i < n_dofs; ++i)
+      for (auto entry = dsp.begin(i); entry != dsp.end(i); ++entry)
+        block_dsp.add(i, entry->column());
+    BlockSparsityPattern sparsity;
+    sparsity.copy_from(block_dsp);
+    BlockSparseMatrix<double> reference_matrix(sparsity), matrix(sparsity);
+    BlockVector<double> reference_vector(block_sizes), vector(block_sizes);
+
+    scatter_plan.reinit(constraints, sparsity, tria.n_active_cells());
+    for (const double factor : {1., 2.})
+      {
+        assemble(dof_handler,
+                 constraints,
+                 scatter_plan,
+                 factor,
+                 reference_matrix,
+                 reference_vector,
+                 matrix,
+                 vector);
+        compare("BlockSparseMatrix",
+                reference_matrix,
+                reference_vector,
+                matrix,
+                vector);
+      }
+  }
+
+  {
+    ChunkSparsityPattern sparsity;
+    sparsity.copy_from(dsp, 2);
+    ChunkSparseMatrix<double> reference_matrix(sparsity), matrix(sparsity);
+    Vector<double>            reference_vector(n_dofs), vector(n_dofs);
+
+    scatter_plan.reinit(constraints, tria.n_active_cells());
+    for (const double factor : {1., 2.})
+      {
+        assemble(dof_handler,
+                 constraints,
+                 scatter_plan,
+                 factor,
+                 reference_matrix,
+                 reference_vector,
+                 matrix,
+                 vector);
+        compare("ChunkSparseMatrix",
+                reference_matrix,
+                reference_vector,
+                matrix,
+                vector);
+      }
+  }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>();
+  test<3>();
+}
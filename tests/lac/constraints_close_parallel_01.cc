@@ -0,0 +1,138 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Check that AffineConstraints::close() resolves chains of inhomogeneous
+// constraints both for small sets of constraints, whose chains are resolved
+// sequentially, and for large ones, whose chains are resolved with several
+// threads, and that distribute() and distribute_local_to_global() read the
+// resolved constraints from the compressed storage correctly
+
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+void
+test(const unsigned int n)
+{
+  // the DoFs 0,...,n-1 are unconstrained, followed by three groups of
+  // constrained DoFs, where the second group is constrained to the first one
+  // and the third group to the second one. add the lines in reverse order.
+  const unsigned int first_1 = n;
+  const unsigned int first_2 = first_1 + n - 1;
+  const unsigned int first_3 = first_2 + n - 2;
+  const unsigned int n_dofs  = first_3 + n - 2;
+
+  AffineConstraints<double> constraints;
+  for (unsigned int i = 0; i < n - 2; ++i)
+    {
+      constraints.add_line(first_3 + i);
+      constraints.add_entry(first_3 + i, first_2 + i, 1.);
+    }
+  for (unsigned int i = 0; i < n - 2; ++i)
+    {
+      constraints.add_line(first_2 + i);
+      constraints.add_entry(first_2 + i, first_1 + i, 0.5);
+      constraints.add_entry(first_2 + i, first_1 + i + 1, 0.25);
+      constraints.add_entry(first_2 + i, i, 0.25);
+      constraints.set_inhomogeneity(first_2 + i, -1.);
+    }
+  for (unsigned int i = 0; i < n - 1; ++i)
+    {
+      constraints.add_line(first_1 + i);
+      constraints.add_entry(first_1 + i, i, 0.5);
+      constraints.add_entry(first_1 + i, i + 1, 0.5);
+      constraints.set_inhomogeneity(first_1 + i, 1.);
+    }
+  constraints.close();
+
+  // evaluate the constraints group by group as a reference
+  Vector<double> reference(n_dofs);
+  for (unsigned int i = 0; i < n; ++i)
+    reference(i) = random_value<double>();
+  for (unsigned int i = 0; i < n - 1; ++i)
+    reference(first_1 + i) = 0.5 * reference(i) + 0.5 * reference(i + 1) + 1.;
+  for (unsigned int i = 0; i < n - 2; ++i)
+    reference(first_2 + i) = 0.5 * reference(first_1 + i) +
+                             0.25 * reference(first_1 + i + 1) +
+                             0.25 * reference(i) - 1.;
+  for (unsigned int i = 0; i < n - 2; ++i)
+    reference(first_3 + i) = reference(first_2 + i);
+
+  Vector<double> solution(n_dofs);
+  for (unsigned int i = 0; i < n; ++i)
+    solution(i) = reference(i);
+  constraints.distribute(solution);
+  solution -= reference;
+
+  bool entries_resolved = true;
+  for (const auto &line : constraints.get_lines())
+    for (unsigned int q = 0; q < line.entries.size(); ++q)
+      if (constraints.is_constrained(line.entries[q].first) ||
+          (q > 0 && line.entries[q].first <= line.entries[q - 1].first))
+        entries_resolved = false;
+
+  // distribute_local_to_global() applies the transpose of the homogeneous
+  // part of the constraints, so the product of its result with the
+  // unconstrained values must match the product of the local values with
+  // the homogeneous part of the distributed values
+  Vector<double>                       local_vector(n_dofs);
+  std::vector<types::global_dof_index> local_dof_indices(n_dofs);
+  for (unsigned int i = 0; i < n_dofs; ++i)
+    {
+      local_vector(i)      = random_value<double>();
+      local_dof_indices[i] = i;
+    }
+  Vector<double> global_vector(n_dofs);
+  constraints.distribute_local_to_global(local_vector,
+                                         local_dof_indices,
+                                         global_vector);
+
+  double product_local = 0., product_global = 0.;
+  for (unsigned int i = 0; i < n_dofs; ++i)
+    {
+      product_global +=
+        constraints.is_constrained(i) ? 0. : global_vector(i) * reference(i);
+      product_local += local_vector(i) *
+                       (reference(i) - constraints.get_inhomogeneity(i));
+    }
+
+  deallog << "Number of constraints: " << constraints.n_constraints()
+          << std::endl;
+  deallog << "Entries resolved and sorted: " << entries_resolved << std::endl;
+  deallog << "Error distribute: "
+          << (solution.linfty_norm() < 1e-12 ? "OK" : "FAIL") << std::endl;
+  deallog << "Error distribute_local_to_global: "
+          << (std::abs(product_local - product_global) <
+                  1e-12 * std::abs(product_local) ?
+                "OK" :
+                "FAIL")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test(100);
+  test(4000);
+}
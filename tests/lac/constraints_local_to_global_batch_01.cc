@@ -0,0 +1,161 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Check that the batched AffineConstraints::distribute_local_to_global(),
+// which writes the local matrices and vectors of several cells at once,
+// gives the same result as calling the function cell by cell, for hanging
+// node constraints and inhomogeneous boundary constraints
+
+#include <deal.II/dofs/dof_accessor.h>
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+test(const unsigned int batch_size)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(2);
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->center()[0] < 0.5)
+      cell->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  FE_Q<dim>       fe(2);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  AffineConstraints<double> constraints;
+  DoFTools::make_hanging_node_constraints(dof_handler, constraints);
+  const IndexSet boundary_dofs = DoFTools::extract_boundary_dofs(dof_handler);
+  for (const auto i : boundary_dofs)
+    if (constraints.is_constrained(i) == false)
+      {
+        constraints.add_line(i);
+        constraints.set_inhomogeneity(i, 1. + 0.01 * i);
+      }
+  constraints.close();
+
+  DynamicSparsityPattern dsp(dof_handler.n_dofs());
+  DoFTools::make_sparsity_pattern(dof_handler, dsp, constraints, false);
+  SparsityPattern sparsity;
+  sparsity.copy_from(dsp);
+
+  // random local matrices with a dominant diagonal and random local vectors
+  const unsigned int n_cells = tria.n_active_cells();
+
+  std::vector<FullMatrix<double>>                   local_matrices(n_cells);
+  std::vector<Vector<double>>                       local_vectors(n_cells);
+  std::vector<std::vector<types::global_dof_index>> local_dof_indices(n_cells);
+  unsigned int                                      c = 0;
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    {
+      local_matrices[c].reinit(fe.n_dofs_per_cell(), fe.n_dofs_per_cell());
+      local_vectors[c].reinit(fe.n_dofs_per_cell());
+      local_dof_indices[c].resize(fe.n_dofs_per_cell());
+      for (unsigned int i = 0; i < fe.n_dofs_per_cell(); ++i)
+        {
+          for (unsigned int j = 0; j < fe.n_dofs_per_cell(); ++j)
+            local_matrices[c](i, j) = random_value<double>();
+          local_matrices[c](i, i) += fe.n_dofs_per_cell();
+          local_vectors[c](i) = random_value<double>();
+        }
+      cell->get_dof_indices(local_dof_indices[c]);
+      ++c;
+    }
+
+  SparseMatrix<double> reference_matrix(sparsity), matrix(sparsity),
+    matrix_only(sparsity);
+  Vector<double> reference_vector(dof_handler.n_dofs()),
+    vector(dof_handler.n_dofs());
+  for (unsigned int c = 0; c < n_cells; ++c)
+    constraints.distribute_local_to_global(local_matrices[c],
+                                           local_vectors[c],
+                                           local_dof_indices[c],
+                                           reference_matrix,
+                                           reference_vector,
+                                           true);
+
+  for (unsigned int c = 0; c < n_cells; c += batch_size)
+    {
+      const unsigned int n = std::min(batch_size, n_cells - c);
+      constraints.distribute_local_to_global(
+        make_array_view(local_matrices.cbegin() + c,
+                        local_matrices.cbegin() + c + n),
+        make_array_view(local_vectors.cbegin() + c,
+                        local_vectors.cbegin() + c + n),
+        make_array_view(local_dof_indices.cbegin() + c,
+                        local_dof_indices.cbegin() + c + n),
+        matrix,
+        vector,
+        true);
+      constraints.distribute_local_to_global(
+        make_array_view(local_matrices.cbegin() + c,
+                        local_matrices.cbegin() + c + n),
+        make_array_view(local_dof_indices.cbegin() + c,
+                        local_dof_indices.cbegin() + c + n),
+        matrix_only);
+    }
+
+  const double matrix_norm = reference_matrix.frobenius_norm();
+  const double vector_norm = reference_vector.l2_norm();
+  matrix.add(-1., reference_matrix);
+  matrix_only.add(-1., reference_matrix);
+  vector -= reference_vector;
+
+  deallog << dim << "d, " << n_cells << " cells in batches of " << batch_size
+          << std::endl;
+  deallog << "Error matrix: "
+          << (matrix.frobenius_norm() < 1e-14 * matrix_norm ? "OK" : "FAIL")
+          << std::endl;
+  deallog << "Error matrix only: "
+          << (matrix_only.frobenius_norm() < 1e-14 * matrix_norm ? "OK" :
+                                                                   "FAIL")
+          << std::endl;
+  deallog << "Error vector: "
+          << (vector.l2_norm() < 1e-14 * vector_norm ? "OK" : "FAIL")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>(1);
+  test<2>(8);
+  test<3>(5);
+  test<3>(64);
+}
@@ -0,0 +1,108 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Check that PackagedOperation collects linear combinations of vectors of
+// type Vector and LinearAlgebra::distributed::Vector into a single
+// combination, also when mixed with LinearOperator objects, and that apply()
+// and apply_add() of the resulting operations and the scaled vmult_add() of
+// LinearOperator give the correct results
+
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/linear_operator.h>
+#include <deal.II/lac/packaged_operation.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+template <typename VectorType>
+void
+check(const std::string &                        description,
+      const PackagedOperation<VectorType> &      expr,
+      const std::function<double(unsigned int)> &reference)
+{
+  VectorType result = expr;
+  double     error  = 0.;
+  for (unsigned int i = 0; i < result.size(); ++i)
+    error = std::max(error, std::abs(result(i) - reference(i)));
+
+  for (unsigned int i = 0; i < result.size(); ++i)
+    result(i) = 1.;
+  expr.apply_add(result);
+  for (unsigned int i = 0; i < result.size(); ++i)
+    error = std::max(error, std::abs(result(i) - 1. - reference(i)));
+
+  deallog << description << ": " << expr.linear_combination.size()
+          << " terms, " << (error < 1e-12 ? "OK" : "FAIL") << std::endl;
+}
+
+
+
+template <typename VectorType>
+void
+test(const std::string &name)
+{
+  deallog.push(name);
+
+  const unsigned int n = 10000;
+  VectorType         u(n), v(n), w(n);
+  for (unsigned int i = 0; i < n; ++i)
+    {
+      u(i) = std::sin(1. * i);
+      v(i) = std::cos(2. * i);
+      w(i) = 0.001 * i;
+    }
+
+  check<VectorType>("2u + 3v - w", 2. * u + 3. * v - w, [&](unsigned int i) {
+    return 2. * u(i) + 3. * v(i) - w(i);
+  });
+  check<VectorType>("u - 0.5(v + w)",
+                    u - 0.5 * (v + w),
+                    [&](unsigned int i) { return u(i) - 0.5 * (v(i) + w(i)); });
+  check<VectorType>("(u - v) * 4 + u",
+                    (u - v) * 4. + u,
+                    [&](unsigned int i) { return 5. * u(i) - 4. * v(i); });
+
+  const auto reinit = [n](VectorType &x, bool omit_zeroing_entries) {
+    x.reinit(n, omit_zeroing_entries);
+  };
+  const auto id = identity_operator<VectorType>(reinit);
+  const auto S  = 2. * id - 0.5 * id;
+
+  check<VectorType>("w - S u", w - S * u, [&](unsigned int i) {
+    return w(i) - 1.5 * u(i);
+  });
+  check<VectorType>("S u - w", S * u - w, [&](unsigned int i) {
+    return 1.5 * u(i) - w(i);
+  });
+  check<VectorType>("2 (S u) + v", 2. * (S * u) + v, [&](unsigned int i) {
+    return 3. * u(i) + v(i);
+  });
+
+  deallog.pop();
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<Vector<double>>("Vector");
+  test<LinearAlgebra::distributed::Vector<double>>("distributed::Vector");
+}
@@ -0,0 +1,134 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Check PreconditionSmoothedAggregation as a preconditioner for SolverCG,
+// the reuse of the aggregates with update_matrix_values(), a hierarchy in
+// single precision, and the use within MGCoarseGridIterativeSolver
+
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/precondition_smoothed_aggregation.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/multigrid/mg_coarse.h>
+
+#include "../tests.h"
+
+#include "../testmatrix.h"
+
+
+template <typename PreconditionerType>
+unsigned int
+solve(const SparseMatrix<double> &A,
+      const Vector<double> &      f,
+      const PreconditionerType &  preconditioner)
+{
+  SolverControl control(1000, 1e-10 * f.l2_norm());
+  control.log_history(false);
+  control.log_result(false);
+  SolverCG<Vector<double>> solver(control);
+  Vector<double>           u(f.size());
+  solver.solve(A, u, f, preconditioner);
+
+  Vector<double> residual(f.size());
+  A.residual(residual, u, f);
+  deallog << "Residual converged: "
+          << (residual.l2_norm() < 2e-10 * f.l2_norm()) << std::endl;
+  return control.last_step();
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  const unsigned int size = 64;
+  const unsigned int dim  = (size - 1) * (size - 1);
+
+  FDMatrix        testproblem(size, size);
+  SparsityPattern structure(dim, dim, 5);
+  testproblem.five_point_structure(structure);
+  structure.compress();
+  SparseMatrix<double> A(structure);
+  testproblem.five_point(A);
+
+  Vector<double> f(dim);
+  for (unsigned int i = 0; i < dim; ++i)
+    f(i) = random_value<double>();
+
+  PreconditionSmoothedAggregation<double> amg;
+  amg.initialize(A);
+  deallog << "Number of levels: " << amg.n_levels() << std::endl;
+  for (unsigned int l = 0; l < amg.n_levels(); ++l)
+    deallog << "Level " << l << ": " << amg.n_rows(l) << " rows" << std::endl;
+  deallog << "Operator complexity below 1.5: "
+          << (amg.operator_complexity() < 1.5) << std::endl;
+
+  PreconditionJacobi<SparseMatrix<double>> jacobi;
+  jacobi.initialize(A);
+  const unsigned int n_jacobi = solve(A, f, jacobi);
+  const unsigned int n_amg    = solve(A, f, amg);
+  deallog << "Iterations AMG: " << n_amg << std::endl;
+  deallog << "AMG needs fewer than a third of the iterations of Jacobi: "
+          << (3 * n_amg < n_jacobi) << std::endl;
+
+  // add a variable reaction term to the matrix and update the values of the
+  // hierarchy, then go back to the original matrix and compare against the
+  // initial setup
+  SparseMatrix<double> B(structure);
+  B.copy_from(A);
+  for (unsigned int i = 0; i < dim; ++i)
+    B.diag_element(i) += 0.5 * (i % 5);
+
+  Vector<double> dst(dim), dst_ref(dim);
+  amg.vmult(dst_ref, f);
+  amg.update_matrix_values(B);
+  amg.vmult(dst, f);
+  deallog << "Hierarchy changed by update: "
+          << (dst.linfty_norm() != dst_ref.linfty_norm()) << std::endl;
+  const unsigned int n_amg_update = solve(B, f, amg);
+  deallog << "Iterations AMG after update: " << n_amg_update << std::endl;
+
+  amg.update_matrix_values(A);
+  amg.vmult(dst, f);
+  dst -= dst_ref;
+  deallog << "Update with original matrix matches initial setup: "
+          << (dst.linfty_norm() < 1e-12 * dst_ref.linfty_norm()) << std::endl;
+
+  // a hierarchy in single precision used on vectors in double precision
+  PreconditionSmoothedAggregation<float> amg_float;
+  amg_float.initialize(A);
+  const unsigned int n_amg_float = solve(A, f, amg_float);
+  deallog << "Iterations AMG float: " << n_amg_float << std::endl;
+
+  // as coarse solver of geometric multigrid
+  SolverControl            coarse_control(1000, 1e-10 * f.l2_norm());
+  SolverCG<Vector<double>> coarse_solver(coarse_control);
+  MGCoarseGridIterativeSolver<Vector<double>,
+                              SolverCG<Vector<double>>,
+                              SparseMatrix<double>,
+                              PreconditionSmoothedAggregation<double>>
+    coarse_grid_solver(coarse_solver, A, amg);
+  Vector<double> u(dim);
+  coarse_grid_solver(0, u, f);
+  deallog << "Coarse solver iterations: " << coarse_control.last_step()
+          << std::endl;
+}
@@ -0,0 +1,173 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+
+// Check the classical Gram-Schmidt orthogonalization in SolverGMRES and
+// SolverFGMRES against the modified Gram-Schmidt algorithm for the generic
+// vector interface of Vector and the block operations of
+// LinearAlgebra::distributed::Vector
+
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/solver_gmres.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+#include "../testmatrix.h"
+
+
+// print the number of iterations, the residual seen by the convergence test
+// and the residual computed from the final solution
+template <typename SolverType, typename VectorType>
+void
+check(const std::string &         name,
+      SolverType &                solver,
+      SolverControl &             control,
+      const SparseMatrix<double> &A,
+      const VectorType &          f)
+{
+  VectorType u(f);
+  u = 0.;
+  solver.solve(A, u, f, PreconditionIdentity());
+
+  VectorType residual(f);
+  A.vmult(residual, u);
+  residual -= f;
+  deallog << name << ": " << control.last_step() << " steps, residual "
+          << control.last_value() << ", true residual " << residual.l2_norm()
+          << std::endl;
+}
+
+
+
+template <typename VectorType>
+void
+test(const SparseMatrix<double> &A)
+{
+  using Strategy = LinearAlgebra::OrthogonalizationStrategy;
+
+  VectorType f(A.m());
+  for (unsigned int i = 0; i < f.size(); ++i)
+    f(i) = random_value<double>();
+
+  SolverControl control(1000, 1e-10 * f.l2_norm());
+  control.log_result(false);
+
+  for (const bool force_re_orthogonalization : {false, true})
+    {
+      deallog << "GMRES, force re-orthogonalization: "
+              << force_re_orthogonalization << std::endl;
+      typename SolverGMRES<VectorType>::AdditionalData data(
+        40, false, true, force_re_orthogonalization);
+      {
+        SolverGMRES<VectorType> solver(control, data);
+        check("Modified Gram-Schmidt", solver, control, A, f);
+      }
+
+      data.orthogonalization_strategy = Strategy::classical_gram_schmidt;
+      SolverGMRES<VectorType> solver(control, data);
+      check("Classical Gram-Schmidt", solver, control, A, f);
+    }
+
+  deallog << "FGMRES" << std::endl;
+  {
+    SolverFGMRES<VectorType> solver(control);
+    check("Modified Gram-Schmidt", solver, control, A, f);
+  }
+
+  SolverFGMRES<VectorType> solver(
+    control,
+    typename SolverFGMRES<VectorType>::AdditionalData(
+      30, Strategy::classical_gram_schmidt));
+  check("Classical Gram-Schmidt", solver, control, A, f);
+}
+
+
+
+// the matrix of gmres_reorthogonalize_01 with strongly varying diagonal
+// entries and a long Arnoldi basis, for which the classical Gram-Schmidt
+// algorithm must detect the loss of orthogonality. (The diagonal matrix with
+// entries 1, ..., 200 of gmres_reorthogonalize_02 is not suitable: there,
+// no orthogonalization step reduces the norm of the new vector by more than
+// a factor of three, far from the threshold of 10 sqrt(eps), and that test
+// does not enable re-orthogonalization for the modified algorithm either.)
+void
+test_reorthogonalization()
+{
+  const unsigned int n = 64;
+  Vector<double>     rhs(n), sol(n);
+  rhs = 1.;
+
+  FullMatrix<double> matrix(n, n);
+  for (unsigned int i = 0; i < n; ++i)
+    for (unsigned int j = 0; j < n; ++j)
+      matrix(i, j) = random_value<double>(-.1, .1);
+  for (unsigned int i = 0; i < n; ++i)
+    matrix(i, i) = (i + 1) * (i + 1) * (i + 1) * (i + 1);
+
+  SolverControl control(1000, 1e2 * std::numeric_limits<double>::epsilon());
+  control.log_result(false);
+  typename SolverGMRES<Vector<double>>::AdditionalData data;
+  data.max_n_tmp_vectors = 80;
+  data.orthogonalization_strategy =
+    LinearAlgebra::OrthogonalizationStrategy::classical_gram_schmidt;
+
+  SolverGMRES<Vector<double>> solver(control, data);
+  bool                        re_orthogonalized = false;
+  solver.connect_re_orthogonalization_slot(
+    [&](int) { re_orthogonalized = true; });
+  solver.solve(matrix, sol, rhs, PreconditionIdentity());
+
+  Vector<double> residual(n);
+  matrix.vmult(residual, sol);
+  residual -= rhs;
+  deallog << "Re-orthogonalization enabled: " << re_orthogonalized
+          << ", residual small: " << (residual.l2_norm() < 1e-8) << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+  deallog << std::setprecision(3);
+
+  const unsigned int size = 32;
+  const unsigned int dim  = (size - 1) * (size - 1);
+
+  FDMatrix        testproblem(size, size);
+  SparsityPattern structure(dim, dim, 5);
+  testproblem.five_point_structure(structure);
+  structure.compress();
+  SparseMatrix<double> A(structure);
+  testproblem.five_point(A, true);
+
+  deallog.push("Vector");
+  test<Vector<double>>(A);
+  deallog.pop();
+
+  deallog.push("LinearAlgebra::distributed::Vector");
+  test<LinearAlgebra::distributed::Vector<double>>(A);
+  deallog.pop();
+
+  test_reorthogonalization();
+}
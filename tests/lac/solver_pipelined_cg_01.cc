@@ -0,0 +1,132 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Compare SolverPipelinedCG and SolverSStepCG with SolverCG for the
+// generic vector interface of Vector and the optimized operations of
+// LinearAlgebra::distributed::Vector
+
+#include <deal.II/lac/diagonal_matrix.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/solver_pipelined_cg.h>
+#include <deal.II/lac/solver_s_step_cg.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+#include "../testmatrix.h"
+
+
+// print the number of iterations, the residual seen by the convergence test
+// and the residual computed from the final solution
+template <typename VectorType, typename SolverType, typename PreconditionerType>
+void
+check(const std::string &         name,
+      SolverType &                solver,
+      SolverControl &             control,
+      const SparseMatrix<double> &A,
+      const VectorType &          f,
+      const PreconditionerType &  preconditioner)
+{
+  VectorType u(f);
+  u = 0.;
+  solver.solve(A, u, f, preconditioner);
+
+  VectorType residual(f);
+  A.vmult(residual, u);
+  residual -= f;
+  deallog << name << ": " << control.last_step() << " steps, residual "
+          << control.last_value() << ", true residual " << residual.l2_norm()
+          << std::endl;
+}
+
+
+
+template <typename VectorType>
+DiagonalMatrix<VectorType>
+make_jacobi(const SparseMatrix<double> &A)
+{
+  DiagonalMatrix<VectorType> jacobi;
+  jacobi.get_vector().reinit(A.m());
+  for (unsigned int i = 0; i < A.m(); ++i)
+    jacobi.get_vector()(i) = 1. / A.diag_element(i);
+  return jacobi;
+}
+
+
+
+template <typename VectorType, typename PreconditionerType>
+void
+test(const SparseMatrix<double> &A, const PreconditionerType &preconditioner)
+{
+  VectorType f(A.m());
+  for (unsigned int i = 0; i < f.size(); ++i)
+    f(i) = random_value<double>();
+
+  SolverControl control(500, 1e-10 * f.l2_norm());
+  control.log_result(false);
+  {
+    SolverCG<VectorType> solver(control);
+    check("SolverCG", solver, control, A, f, preconditioner);
+  }
+  {
+    SolverPipelinedCG<VectorType> solver(control);
+    check("SolverPipelinedCG", solver, control, A, f, preconditioner);
+  }
+  for (const unsigned int s : {1, 2, 4})
+    {
+      SolverSStepCG<VectorType> solver(
+        control, typename SolverSStepCG<VectorType>::AdditionalData(s));
+      check("SolverSStepCG(" + std::to_string(s) + ")",
+            solver,
+            control,
+            A,
+            f,
+            preconditioner);
+    }
+}
+
+
+
+int
+main()
+{
+  initlog();
+  deallog << std::setprecision(3);
+
+  const unsigned int size = 32;
+  const unsigned int dim  = (size - 1) * (size - 1);
+
+  FDMatrix        testproblem(size, size);
+  SparsityPattern structure(dim, dim, 5);
+  testproblem.five_point_structure(structure);
+  structure.compress();
+  SparseMatrix<double> A(structure);
+  testproblem.five_point(A);
+
+  deallog << "Vector" << std::endl;
+  test<Vector<double>>(A, PreconditionIdentity());
+  test<Vector<double>>(A, make_jacobi<Vector<double>>(A));
+
+  deallog << "LinearAlgebra::distributed::Vector" << std::endl;
+  test<LinearAlgebra::distributed::Vector<double>>(A, PreconditionIdentity());
+  test<LinearAlgebra::distributed::Vector<double>>(
+    A, make_jacobi<LinearAlgebra::distributed::Vector<double>>(A));
+}
@@ -0,0 +1,114 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Check the triangular solves of SparseILU and SparseMIC: the level
+// scheduled solves must give exactly the result of the sequential ones, the
+// Jacobi approximation must give it with enough iterations, and with only a
+// few iterations it must still be usable as a preconditioner
+
+#include <deal.II/base/multithread_info.h>
+
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/solver_gmres.h>
+#include <deal.II/lac/sparse_ilu.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparse_mic.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+#include "../testmatrix.h"
+
+
+template <typename PreconditionerType>
+void
+test(const std::string &         name,
+     const SparseMatrix<double> &A,
+     const Vector<double> &      src)
+{
+  using TriangularSolve = SparseLUDecomposition<double>::TriangularSolve;
+
+  Vector<double> reference(src.size()), dst(src.size());
+
+  PreconditionerType sequential;
+  sequential.initialize(A);
+  sequential.vmult(reference, src);
+
+  PreconditionerType level_scheduled;
+  level_scheduled.initialize(
+    A,
+    typename PreconditionerType::AdditionalData(
+      0, 0, false, nullptr, TriangularSolve::level_scheduled));
+  level_scheduled.vmult(dst, src);
+  dst -= reference;
+  deallog << name << " level scheduled, difference: " << dst.linfty_norm()
+          << std::endl;
+
+  PreconditionerType jacobi_exact;
+  jacobi_exact.initialize(
+    A,
+    typename PreconditionerType::AdditionalData(
+      0, 0, false, nullptr, TriangularSolve::jacobi_approximation, 500));
+  jacobi_exact.vmult(dst, src);
+  dst -= reference;
+  deallog << name << " Jacobi with 500 iterations, difference small: "
+          << (dst.linfty_norm() < 1e-12 * reference.linfty_norm())
+          << std::endl;
+
+  PreconditionerType jacobi;
+  jacobi.initialize(
+    A,
+    typename PreconditionerType::AdditionalData(
+      0, 0, false, nullptr, TriangularSolve::jacobi_approximation));
+  for (const PreconditionerType *preconditioner : {&sequential, &jacobi})
+    {
+      SolverControl               control(1000, 1e-8 * src.l2_norm());
+      SolverGMRES<Vector<double>> solver(control);
+      dst = 0;
+      solver.solve(A, dst, src, *preconditioner);
+      deallog << name
+              << (preconditioner == &sequential ? " sequential" :
+                                                  " Jacobi with 3 iterations")
+              << ", GMRES iterations: " << control.last_step() << std::endl;
+    }
+}
+
+
+
+int
+main()
+{
+  initlog();
+  MultithreadInfo::set_thread_limit(testing_max_num_threads());
+
+  const unsigned int size = 128;
+  const unsigned int dim  = (size - 1) * (size - 1);
+
+  FDMatrix        testproblem(size, size);
+  SparsityPattern structure(dim, dim, 9);
+  testproblem.nine_point_structure(structure);
+  structure.compress();
+  SparseMatrix<double> A(structure);
+  testproblem.nine_point(A);
+
+  Vector<double> src(dim);
+  for (unsigned int i = 0; i < dim; ++i)
+    src(i) = random_value<double>();
+
+  test<SparseILU<double>>("ILU", A, src);
+  test<SparseMIC<double>>("MIC", A, src);
+}
@@ -0,0 +1,137 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Check GrowingVectorMemory with thread-local pools: vectors are reused in
+// the reverse order of their release, the statistics count hits and misses,
+// and solvers running concurrently on several tasks with their own
+// GrowingVectorMemory objects give the same results as with the global pool
+
+#include <deal.II/base/thread_management.h>
+
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+#include <deal.II/lac/vector_memory.h>
+
+#include "../tests.h"
+
+#include "../testmatrix.h"
+
+
+void
+test_reuse()
+{
+  using Statistics = GrowingVectorMemory<Vector<double>>::Statistics;
+
+  GrowingVectorMemory<Vector<double>> mem(0, true, true);
+  Vector<double> *                    v1 = mem.alloc();
+  Vector<double> *                    v2 = mem.alloc();
+  Vector<double> *                    v3 = mem.alloc();
+  v1->reinit(10);
+  v2->reinit(20);
+  v3->reinit(30);
+  mem.free(v1);
+  mem.free(v3);
+  mem.free(v2);
+
+  const Statistics after_first = mem.get_statistics();
+  deallog << "Hits: " << after_first.n_hits
+          << ", misses: " << after_first.n_misses
+          << ", peak bytes positive: " << (after_first.peak_bytes > 0)
+          << std::endl;
+  deallog << "Memory of the pool larger than the vector data: "
+          << (mem.memory_consumption() > 60 * sizeof(double)) << std::endl;
+
+  v1 = mem.alloc();
+  v2 = mem.alloc();
+  deallog << "Sizes of reused vectors: " << v1->size() << ' ' << v2->size()
+          << std::endl;
+  mem.free(v2);
+  mem.free(v1);
+
+  const Statistics after_second = mem.get_statistics();
+  deallog << "Hits: " << after_second.n_hits
+          << ", misses: " << after_second.n_misses << std::endl;
+}
+
+
+
+Vector<double>
+solve(const SparseMatrix<double> &A,
+      const Vector<double> &      rhs,
+      const bool                  use_thread_local_pool)
+{
+  GrowingVectorMemory<Vector<double>> mem(0, false, use_thread_local_pool);
+  SolverControl                       control(1000, 1e-10, false, false);
+  SolverCG<Vector<double>>            solver(control, mem);
+  Vector<double>                      solution(rhs.size());
+  solver.solve(A, solution, rhs, PreconditionIdentity());
+  return solution;
+}
+
+
+
+void
+test_tasks()
+{
+  const unsigned int size = 16;
+  const unsigned int dim  = (size - 1) * (size - 1);
+
+  FDMatrix        testproblem(size, size);
+  SparsityPattern structure(dim, dim, 5);
+  testproblem.five_point_structure(structure);
+  structure.compress();
+  SparseMatrix<double> A(structure);
+  testproblem.five_point(A);
+
+  std::vector<Vector<double>> rhs(8, Vector<double>(dim));
+  std::vector<Vector<double>> reference(rhs.size());
+  for (unsigned int i = 0; i < rhs.size(); ++i)
+    {
+      for (unsigned int j = 0; j < dim; ++j)
+        rhs[i](j) = random_value<double>();
+      reference[i] = solve(A, rhs[i], false);
+    }
+
+  std::vector<Vector<double>> solutions(rhs.size());
+  Threads::TaskGroup<void>    tasks;
+  for (unsigned int i = 0; i < rhs.size(); ++i)
+    tasks += Threads::new_task(
+      [&, i]() { solutions[i] = solve(A, rhs[i], true); });
+  tasks.join_all();
+
+  for (unsigned int i = 0; i < rhs.size(); ++i)
+    {
+      solutions[i] -= reference[i];
+      deallog << "Solve " << i << ": "
+              << (solutions[i].linfty_norm() == 0. ? "OK" : "FAIL")
+              << std::endl;
+    }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test_reuse();
+  test_tasks();
+}
@@ -0,0 +1,185 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+
+// Tests MatrixFreeTools::CellwiseBlockJacobi for a DG operator with a
+// nonsymmetric cell term and face terms that only couple the unknowns of a
+// cell with themselves. As the resulting operator is block-diagonal, the
+// block-Jacobi preconditioner must reproduce its inverse.
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/mapping_q1.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+#include <deal.II/matrix_free/tools.h>
+
+#include "../tests.h"
+
+
+
+template <int dim, typename FEEvalType>
+void
+cell_operation(FEEvalType &phi)
+{
+  Tensor<1, dim> beta;
+  for (unsigned int d = 0; d < dim; ++d)
+    beta[d] = 1. + d;
+
+  phi.evaluate(EvaluationFlags::values | EvaluationFlags::gradients);
+  for (unsigned int q = 0; q < phi.n_q_points; ++q)
+    {
+      const auto value    = phi.get_value(q);
+      const auto gradient = phi.get_gradient(q);
+      phi.submit_value(value + beta * gradient, q);
+      phi.submit_gradient(0.1 * gradient, q);
+    }
+  phi.integrate(EvaluationFlags::values | EvaluationFlags::gradients);
+}
+
+
+
+template <typename FEFaceEvalType>
+void
+face_operation(FEFaceEvalType &phi)
+{
+  phi.evaluate(EvaluationFlags::values);
+  for (unsigned int q = 0; q < phi.n_q_points; ++q)
+    phi.submit_value(10. * phi.get_value(q), q);
+  phi.integrate(EvaluationFlags::values);
+}
+
+
+
+template <int dim, int fe_degree>
+void
+test(const unsigned int n_refinements)
+{
+  using Number     = double;
+  using VectorType = LinearAlgebra::distributed::Vector<Number>;
+
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(n_refinements);
+  GridTools::distort_random(0.2, tria);
+
+  FE_DGQ<dim>     fe(fe_degree);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  AffineConstraints<Number> constraints;
+  constraints.close();
+
+  MatrixFree<dim, Number>                          matrix_free;
+  typename MatrixFree<dim, Number>::AdditionalData data;
+  data.mapping_update_flags = update_values | update_gradients |
+                              update_JxW_values | update_quadrature_points;
+  data.mapping_update_flags_inner_faces = update_values | update_JxW_values;
+  data.mapping_update_flags_boundary_faces =
+    update_values | update_JxW_values;
+  data.mapping_update_flags_faces_by_cells =
+    update_values | update_JxW_values;
+  matrix_free.reinit(MappingQ1<dim>(),
+                     dof_handler,
+                     constraints,
+                     QGauss<1>(fe_degree + 1),
+                     data);
+
+  using FEEvalType = FEEvaluation<dim, fe_degree, fe_degree + 1, 1, Number>;
+  using FEFaceEvalType =
+    FEFaceEvaluation<dim, fe_degree, fe_degree + 1, 1, Number>;
+
+  MatrixFreeTools::CellwiseBlockJacobi<dim, fe_degree> block_jacobi;
+  block_jacobi.initialize(matrix_free,
+                          cell_operation<dim, FEEvalType>,
+                          face_operation<FEFaceEvalType>);
+
+  VectorType src, dst, result;
+  matrix_free.initialize_dof_vector(src);
+  matrix_free.initialize_dof_vector(dst);
+  matrix_free.initialize_dof_vector(result);
+  for (unsigned int i = 0; i < src.locally_owned_size(); ++i)
+    src.local_element(i) = random_value<Number>();
+
+  block_jacobi.vmult(dst, src);
+
+  // apply the global operator, where the face terms only act on the values
+  // of the respective side
+  matrix_free.template loop<VectorType, VectorType>(
+    [](const auto &data, auto &dst, const auto &src, const auto range) {
+      FEEvalType phi(data);
+      for (unsigned int cell = range.first; cell < range.second; ++cell)
+        {
+          phi.reinit(cell);
+          phi.read_dof_values(src);
+          cell_operation<dim>(phi);
+          phi.distribute_local_to_global(dst);
+        }
+    },
+    [](const auto &data, auto &dst, const auto &src, const auto range) {
+      FEFaceEvalType phi_m(data, true), phi_p(data, false);
+      for (unsigned int face = range.first; face < range.second; ++face)
+        for (FEFaceEvalType *phi : {&phi_m, &phi_p})
+          {
+            phi->reinit(face);
+            phi->read_dof_values(src);
+            face_operation(*phi);
+            phi->distribute_local_to_global(dst);
+          }
+    },
+    [](const auto &data, auto &dst, const auto &src, const auto range) {
+      FEFaceEvalType phi(data, true);
+      for (unsigned int face = range.first; face < range.second; ++face)
+        {
+          phi.reinit(face);
+          phi.read_dof_values(src);
+          face_operation(phi);
+          phi.distribute_local_to_global(dst);
+        }
+    },
+    result,
+    dst,
+    true);
+
+  result -= src;
+  deallog << "Testing " << fe.get_name() << ": error "
+          << (result.linfty_norm() < 1e-10 * src.linfty_norm() ? "OK" : "FAIL")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2, 1>(3);
+  test<2, 3>(2);
+  test<3, 2>(1);
+}
@@ -0,0 +1,132 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// tests the compressed storage of the interleaved dof indices by geometric
+// entities in DoFInfo: the result of a matrix-free mass operator must match
+// the sparse matrix for scalar and vector-valued elements
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/mapping_q1.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include <deal.II/numerics/matrix_creator.h>
+
+#include "../tests.h"
+
+
+template <int dim, int n_components>
+void
+test(const unsigned int n_refinements)
+{
+  constexpr int degree = 3;
+
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(n_refinements);
+
+  FESystem<dim>   fe(FE_Q<dim>(degree), n_components);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  AffineConstraints<double> constraints;
+  constraints.close();
+
+  const QGauss<1>                          quad(degree + 1);
+  MappingQ1<dim>                           mapping;
+  MatrixFree<dim>                          matrix_free;
+  typename MatrixFree<dim>::AdditionalData additional_data;
+  additional_data.tasks_parallel_scheme =
+    MatrixFree<dim>::AdditionalData::none;
+  additional_data.mapping_update_flags = update_values | update_JxW_values;
+  matrix_free.reinit(mapping, dof_handler, constraints, quad, additional_data);
+
+  const auto &dof_info = matrix_free.get_dof_info();
+  deallog << "Compressed storage in use: "
+          << (dof_info.dof_indices_compressed_start.empty() == false)
+          << std::endl;
+
+  Vector<double> src(dof_handler.n_dofs()), dst(src), ref(src);
+  for (unsigned int i = 0; i < src.size(); ++i)
+    src(i) = random_value<double>();
+
+  matrix_free.template cell_loop<Vector<double>, Vector<double>>(
+    [](const MatrixFree<dim> &                     data,
+       Vector<double> &                            dst,
+       const Vector<double> &                      src,
+       const std::pair<unsigned int, unsigned int> range) {
+      FEEvaluation<dim, degree, degree + 1, n_components> phi(data);
+      for (unsigned int cell = range.first; cell < range.second; ++cell)
+        {
+          phi.reinit(cell);
+          phi.gather_evaluate(src, EvaluationFlags::values);
+          for (unsigned int q = 0; q < phi.n_q_points; ++q)
+            phi.submit_value(phi.get_value(q), q);
+          phi.integrate_scatter(EvaluationFlags::values, dst);
+        }
+    },
+    dst,
+    src,
+    true);
+
+  DynamicSparsityPattern dsp(dof_handler.n_dofs());
+  DoFTools::make_sparsity_pattern(dof_handler, dsp);
+  SparsityPattern sparsity;
+  sparsity.copy_from(dsp);
+  SparseMatrix<double> matrix(sparsity);
+  MatrixCreator::create_mass_matrix(mapping,
+                                    dof_handler,
+                                    QGauss<dim>(degree + 1),
+                                    matrix);
+  matrix.vmult(ref, src);
+
+  ref -= dst;
+  deallog << "Error n_components=" << n_components << ": "
+          << (ref.linfty_norm() < 1e-12 * dst.linfty_norm() ? "OK" : "FAIL")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.push("2d");
+  test<2, 1>(3);
+  test<2, 2>(3);
+  deallog.pop();
+  deallog.push("3d");
+  test<3, 1>(2);
+  test<3, 3>(2);
+  deallog.pop();
+}
@@ -0,0 +1,139 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Check DoFRenumbering::matrix_free_data_locality: after renumbering a
+// randomly numbered DoFHandler, the DoFs are numbered in the order of first
+// access by the cell batches of MatrixFree, which is verified by computing
+// the renumbering again on the renumbered DoFHandler
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_renumbering.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include <algorithm>
+#include <numeric>
+
+#include "../tests.h"
+
+
+// average over the cell batches of the difference between the largest and
+// smallest DoF index within a batch
+template <int dim>
+double
+average_index_spread(const MatrixFree<dim, double> &matrix_free)
+{
+  const FiniteElement<dim> &fe = matrix_free.get_dof_handler().get_fe();
+  std::vector<types::global_dof_index> dof_indices(fe.n_dofs_per_cell());
+  double                               spread = 0;
+  for (unsigned int batch = 0; batch < matrix_free.n_cell_batches(); ++batch)
+    {
+      types::global_dof_index min_index = numbers::invalid_dof_index;
+      types::global_dof_index max_index = 0;
+      for (unsigned int v = 0;
+           v < matrix_free.n_active_entries_per_cell_batch(batch);
+           ++v)
+        {
+          matrix_free.get_cell_iterator(batch, v)->get_dof_indices(
+            dof_indices);
+          for (const auto i : dof_indices)
+            {
+              min_index = std::min(min_index, i);
+              max_index = std::max(max_index, i);
+            }
+        }
+      spread += max_index - min_index;
+    }
+  return spread / matrix_free.n_cell_batches();
+}
+
+
+
+template <int dim>
+void
+test(const unsigned int n_refinements)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_ball(tria);
+  tria.refine_global(n_refinements);
+
+  FE_Q<dim>       fe(2);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+  DoFRenumbering::random(dof_handler);
+
+  AffineConstraints<double> constraints;
+  constraints.close();
+
+  MappingQ<dim>                                  mapping(1);
+  typename MatrixFree<dim, double>::AdditionalData data;
+  data.tasks_parallel_scheme = MatrixFree<dim, double>::AdditionalData::none;
+
+  MatrixFree<dim, double> matrix_free;
+  matrix_free.reinit(mapping, dof_handler, constraints, QGauss<1>(3), data);
+  const double spread_before = average_index_spread(matrix_free);
+
+  std::vector<types::global_dof_index> renumbering(dof_handler.n_dofs());
+  DoFRenumbering::compute_matrix_free_data_locality(renumbering,
+                                                    dof_handler,
+                                                    matrix_free);
+  std::vector<types::global_dof_index> sorted = renumbering;
+  std::sort(sorted.begin(), sorted.end());
+  bool is_permutation = true;
+  for (types::global_dof_index i = 0; i < sorted.size(); ++i)
+    if (sorted[i] != i)
+      is_permutation = false;
+  deallog << "Renumbering is a permutation: " << is_permutation << std::endl;
+
+  DoFRenumbering::matrix_free_data_locality(dof_handler, matrix_free);
+  matrix_free.reinit(mapping, dof_handler, constraints, QGauss<1>(3), data);
+
+  DoFRenumbering::compute_matrix_free_data_locality(renumbering,
+                                                    dof_handler,
+                                                    matrix_free);
+  bool is_identity = true;
+  for (types::global_dof_index i = 0; i < renumbering.size(); ++i)
+    if (renumbering[i] != i)
+      is_identity = false;
+  deallog << "DoFs numbered in order of first access: " << is_identity
+          << std::endl;
+
+  deallog << "Index spread within cell batches reduced: "
+          << (average_index_spread(matrix_free) < 0.5 * spread_before)
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>(3);
+  test<3>(2);
+}
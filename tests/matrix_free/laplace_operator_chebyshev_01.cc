@@ -0,0 +1,216 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Tests the matrix-vector product of MatrixFreeOperators::LaplaceOperator
+// with operations on sub-ranges of the vectors and its use inside
+// PreconditionChebyshev, comparing against an operator that only provides
+// the plain vmult()
+
+#include <deal.II/base/function.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/precondition.h>
+
+#include <deal.II/matrix_free/operators.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include "../tests.h"
+
+
+
+// wrapper around an operator that hides the vmult() variant with additional
+// std::function arguments
+template <typename Operator, typename VectorType>
+class PlainOperator : public Subscriptor
+{
+public:
+  PlainOperator(const Operator &op)
+    : op(op)
+  {}
+
+  void
+  vmult(VectorType &dst, const VectorType &src) const
+  {
+    op.vmult(dst, src);
+  }
+
+  types::global_dof_index
+  m() const
+  {
+    return op.m();
+  }
+
+  types::global_dof_index
+  n() const
+  {
+    return op.n();
+  }
+
+  typename VectorType::value_type
+  el(const unsigned int row, const unsigned int col) const
+  {
+    return op.el(row, col);
+  }
+
+  void
+  initialize_dof_vector(VectorType &vec) const
+  {
+    op.initialize_dof_vector(vec);
+  }
+
+private:
+  const Operator &op;
+};
+
+
+
+template <int dim, int fe_degree>
+void
+test()
+{
+  using number     = double;
+  using VectorType = LinearAlgebra::distributed::Vector<number>;
+
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(2);
+  tria.begin_active()->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+  tria.refine_global(1);
+
+  FE_Q<dim>       fe(fe_degree);
+  DoFHandler<dim> dof(tria);
+  dof.distribute_dofs(fe);
+
+  AffineConstraints<double> constraints;
+  DoFTools::make_hanging_node_constraints(dof, constraints);
+  VectorTools::interpolate_boundary_values(dof,
+                                           0,
+                                           Functions::ZeroFunction<dim>(),
+                                           constraints);
+  constraints.close();
+
+  deallog << "Testing " << dof.get_fe().get_name() << std::endl;
+
+  std::shared_ptr<MatrixFree<dim, number>> mf_data(
+    new MatrixFree<dim, number>());
+  {
+    const QGauss<1>                                  quad(fe_degree + 1);
+    typename MatrixFree<dim, number>::AdditionalData data;
+    data.tasks_parallel_scheme = MatrixFree<dim, number>::AdditionalData::none;
+    mf_data->reinit(MappingQ1<dim>{}, dof, constraints, quad, data);
+  }
+
+  using Operator =
+    MatrixFreeOperators::LaplaceOperator<dim, fe_degree, fe_degree + 1, 1>;
+  Operator mf;
+  mf.initialize(mf_data);
+  mf.compute_diagonal();
+
+  VectorType in, out, ref;
+  mf_data->initialize_dof_vector(in);
+  out.reinit(in);
+  ref.reinit(in);
+  for (unsigned int i = 0; i < in.locally_owned_size(); ++i)
+    if (constraints.is_constrained(i) == false)
+      in.local_element(i) = random_value<double>();
+
+  // the ranges passed to the two functions must cover the locally owned
+  // range exactly once
+  mf.vmult(ref, in);
+  out = 1.;
+  unsigned int n_before = 0, n_after = 0;
+  mf.vmult(
+    out,
+    in,
+    [&](const unsigned int start, const unsigned int end) {
+      n_before += end - start;
+    },
+    [&](const unsigned int start, const unsigned int end) {
+      n_after += end - start;
+    });
+  deallog << "Ranges cover vector: "
+          << (n_before == in.locally_owned_size() &&
+              n_after == in.locally_owned_size())
+          << std::endl;
+  out -= ref;
+  deallog << "Error vmult: "
+          << (out.linfty_norm() < 1e-12 * ref.linfty_norm() ? "OK" : "FAIL")
+          << std::endl;
+
+  // compare the Chebyshev iteration with merged vector updates to the one
+  // with separate vector updates, using the same fixed eigenvalue bound for
+  // both
+  using Preconditioner = DiagonalMatrix<VectorType>;
+  PreconditionChebyshev<Operator, VectorType, Preconditioner> chebyshev;
+  typename PreconditionChebyshev<Operator, VectorType, Preconditioner>::
+    AdditionalData additional_data;
+  additional_data.degree              = 4;
+  additional_data.eig_cg_n_iterations = 0;
+  additional_data.max_eigenvalue      = 2.;
+  additional_data.preconditioner      = mf.get_matrix_diagonal_inverse();
+  chebyshev.initialize(mf, additional_data);
+
+  using Plain = PlainOperator<Operator, VectorType>;
+  Plain                                                    plain(mf);
+  PreconditionChebyshev<Plain, VectorType, Preconditioner> chebyshev_plain;
+  typename PreconditionChebyshev<Plain, VectorType, Preconditioner>::
+    AdditionalData additional_data_plain;
+  additional_data_plain.degree              = 4;
+  additional_data_plain.eig_cg_n_iterations = 0;
+  additional_data_plain.max_eigenvalue      = 2.;
+  additional_data_plain.preconditioner = mf.get_matrix_diagonal_inverse();
+  chebyshev_plain.initialize(plain, additional_data_plain);
+
+  chebyshev.vmult(out, in);
+  chebyshev_plain.vmult(ref, in);
+  out -= ref;
+  deallog << "Error Chebyshev vmult: "
+          << (out.linfty_norm() < 1e-12 * ref.linfty_norm() ? "OK" : "FAIL")
+          << std::endl;
+
+  out = in;
+  ref = in;
+  chebyshev.step(out, in);
+  chebyshev_plain.step(ref, in);
+  out -= ref;
+  deallog << "Error Chebyshev step: "
+          << (out.linfty_norm() < 1e-12 * ref.linfty_norm() ? "OK" : "FAIL")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2, 1>();
+  test<2, 3>();
+  test<3, 2>();
+}
@@ -0,0 +1,219 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Same as laplace_operator_chebyshev_01, but for the level operators of
+// geometric multigrid on an adaptively refined mesh, where the
+// matrix-vector product with operations on sub-ranges also needs to treat
+// the indices at the refinement edge
+
+#include <deal.II/base/function.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/precondition.h>
+
+#include <deal.II/matrix_free/operators.h>
+
+#include <deal.II/multigrid/mg_constrained_dofs.h>
+
+#include "../tests.h"
+
+
+
+// wrapper around an operator that hides the vmult() variant with additional
+// std::function arguments
+template <typename Operator, typename VectorType>
+class PlainOperator : public Subscriptor
+{
+public:
+  PlainOperator(const Operator &op)
+    : op(op)
+  {}
+
+  void
+  vmult(VectorType &dst, const VectorType &src) const
+  {
+    op.vmult(dst, src);
+  }
+
+  types::global_dof_index
+  m() const
+  {
+    return op.m();
+  }
+
+  types::global_dof_index
+  n() const
+  {
+    return op.n();
+  }
+
+  typename VectorType::value_type
+  el(const unsigned int row, const unsigned int col) const
+  {
+    return op.el(row, col);
+  }
+
+  void
+  initialize_dof_vector(VectorType &vec) const
+  {
+    op.initialize_dof_vector(vec);
+  }
+
+private:
+  const Operator &op;
+};
+
+
+
+template <int dim, int fe_degree>
+void
+test()
+{
+  using number     = double;
+  using VectorType = LinearAlgebra::distributed::Vector<number>;
+
+  Triangulation<dim> tria(
+    Triangulation<dim>::limit_level_difference_at_vertices);
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(1);
+  tria.begin_active()->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+  tria.begin_active(2)->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  FE_Q<dim>       fe(fe_degree);
+  DoFHandler<dim> dof(tria);
+  dof.distribute_dofs(fe);
+  dof.distribute_mg_dofs();
+
+  MGConstrainedDoFs mg_constrained_dofs;
+  mg_constrained_dofs.initialize(dof);
+  mg_constrained_dofs.make_zero_boundary_constraints(dof, {0});
+
+  deallog << "Testing " << dof.get_fe().get_name() << std::endl;
+
+  using Operator =
+    MatrixFreeOperators::LaplaceOperator<dim, fe_degree, fe_degree + 1, 1>;
+  using Preconditioner = DiagonalMatrix<VectorType>;
+  using Plain          = PlainOperator<Operator, VectorType>;
+
+  for (unsigned int level = 0; level < tria.n_global_levels(); ++level)
+    {
+      AffineConstraints<double> level_constraints;
+      level_constraints.add_lines(
+        mg_constrained_dofs.get_boundary_indices(level));
+      level_constraints.close();
+
+      std::shared_ptr<MatrixFree<dim, number>> mf_data(
+        new MatrixFree<dim, number>());
+      {
+        const QGauss<1>                                  quad(fe_degree + 1);
+        typename MatrixFree<dim, number>::AdditionalData data;
+        data.tasks_parallel_scheme =
+          MatrixFree<dim, number>::AdditionalData::none;
+        data.mg_level = level;
+        mf_data->reinit(MappingQ1<dim>{}, dof, level_constraints, quad, data);
+      }
+
+      Operator mf;
+      mf.initialize(mf_data, mg_constrained_dofs, level);
+      mf.compute_diagonal();
+
+      VectorType in, out, ref;
+      mf_data->initialize_dof_vector(in);
+      out.reinit(in);
+      ref.reinit(in);
+      for (unsigned int i = 0; i < in.locally_owned_size(); ++i)
+        if (level_constraints.is_constrained(i) == false)
+          in.local_element(i) = random_value<double>();
+      const VectorType in_copy = in;
+
+      deallog << "Level " << level << ", refinement edge indices: "
+              << mg_constrained_dofs.get_refinement_edge_indices(level)
+                   .n_elements()
+              << std::endl;
+
+      // the vmult() variant with additional functions must give the same
+      // result as the plain vmult() and leave the values of the source
+      // vector at the refinement edge untouched
+      mf.vmult(ref, in);
+      out = 1.;
+      mf.vmult(
+        out,
+        in,
+        [](const unsigned int, const unsigned int) {},
+        [](const unsigned int, const unsigned int) {});
+      out -= ref;
+      VectorType in_diff = in;
+      in_diff -= in_copy;
+      // on the coarsest level of FE_Q<2>(1), all entries are constrained
+      // and the result is zero
+      const bool vmult_ok = out.linfty_norm() <= 1e-12 * ref.linfty_norm();
+      deallog << "Error vmult: " << (vmult_ok ? "OK" : "FAIL")
+              << ", source unchanged: " << (in_diff.linfty_norm() == 0.)
+              << std::endl;
+
+      PreconditionChebyshev<Operator, VectorType, Preconditioner> chebyshev;
+      typename PreconditionChebyshev<Operator, VectorType, Preconditioner>::
+        AdditionalData additional_data;
+      additional_data.degree              = 4;
+      additional_data.eig_cg_n_iterations = 0;
+      additional_data.max_eigenvalue      = 2.;
+      additional_data.preconditioner      = mf.get_matrix_diagonal_inverse();
+      chebyshev.initialize(mf, additional_data);
+
+      Plain                                                    plain(mf);
+      PreconditionChebyshev<Plain, VectorType, Preconditioner> chebyshev_plain;
+      typename PreconditionChebyshev<Plain, VectorType, Preconditioner>::
+        AdditionalData additional_data_plain;
+      additional_data_plain.degree              = 4;
+      additional_data_plain.eig_cg_n_iterations = 0;
+      additional_data_plain.max_eigenvalue      = 2.;
+      additional_data_plain.preconditioner = mf.get_matrix_diagonal_inverse();
+      chebyshev_plain.initialize(plain, additional_data_plain);
+
+      out = in;
+      ref = in;
+      chebyshev.step(out, in);
+      chebyshev_plain.step(ref, in);
+      out -= ref;
+      const bool step_ok = out.linfty_norm() <= 1e-12 * ref.linfty_norm();
+      deallog << "Error Chebyshev step: " << (step_ok ? "OK" : "FAIL")
+              << std::endl;
+    }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2, 1>();
+  test<2, 3>();
+  test<3, 2>();
+}
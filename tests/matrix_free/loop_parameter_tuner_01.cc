@@ -0,0 +1,153 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// tests MatrixFreeTools::LoopParameterTuner, including the cache file and
+// the tuning of the cell vectorization categories
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q1.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+#include <deal.II/matrix_free/tools.h>
+
+#include <cstdio>
+
+#include "../tests.h"
+
+
+template <typename AdditionalData>
+bool
+same_parameters(const AdditionalData &a, const AdditionalData &b)
+{
+  return a.tasks_parallel_scheme == b.tasks_parallel_scheme &&
+         a.tasks_block_size == b.tasks_block_size &&
+         a.overlap_communication_computation ==
+           b.overlap_communication_computation &&
+         a.cell_vectorization_categories_strict ==
+           b.cell_vectorization_categories_strict &&
+         a.cell_vectorization_category == b.cell_vectorization_category;
+}
+
+
+
+template <int dim>
+void
+test(const bool use_categories)
+{
+  using VectorType = LinearAlgebra::distributed::Vector<double>;
+
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(3);
+
+  FE_Q<dim>       fe(2);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  AffineConstraints<double> constraints;
+  constraints.close();
+
+  MatrixFree<dim, double> matrix_free;
+  VectorType              src, dst;
+
+  const auto reinit =
+    [&](const typename MatrixFree<dim, double>::AdditionalData &data) {
+      matrix_free.reinit(
+        MappingQ1<dim>{}, dof_handler, constraints, QGauss<1>(3), data);
+      matrix_free.initialize_dof_vector(src);
+      matrix_free.initialize_dof_vector(dst);
+      src = 1.;
+    };
+
+  const auto run = [&]() {
+    matrix_free.template cell_loop<VectorType, VectorType>(
+      [](const auto &data, auto &dst, const auto &src, const auto range) {
+        FEEvaluation<dim, 2, 3, 1, double> phi(data);
+        for (unsigned int cell = range.first; cell < range.second; ++cell)
+          {
+            phi.reinit(cell);
+            phi.gather_evaluate(src, EvaluationFlags::gradients);
+            for (unsigned int q = 0; q < phi.n_q_points; ++q)
+              phi.submit_gradient(phi.get_gradient(q), q);
+            phi.integrate_scatter(EvaluationFlags::gradients, dst);
+          }
+      },
+      dst,
+      src,
+      true);
+  };
+
+  const std::string cache_file = "loop_parameter_tuner_cache.txt";
+  std::remove(cache_file.c_str());
+
+  typename MatrixFree<dim, double>::AdditionalData additional_data;
+  additional_data.mapping_update_flags = update_gradients | update_JxW_values;
+  if (use_categories)
+    for (const auto &cell : tria.active_cell_iterators())
+      additional_data.cell_vectorization_category.push_back(
+        cell->center()[0] < 0.5 ? 0 : 1);
+
+  MatrixFreeTools::LoopParameterTuner<dim, double> tuner(MPI_COMM_SELF, 3);
+  tuner.add_default_candidates(additional_data, {0, 16});
+  deallog << "Number of candidates: " << tuner.get_candidates().size()
+          << std::endl;
+  const std::string problem_key =
+    "n_dofs=" + std::to_string(dof_handler.n_dofs());
+  const auto result = tuner.tune(reinit, run, cache_file, problem_key);
+
+  deallog << "Number of timings: " << tuner.get_timings().size() << std::endl;
+
+  bool found = false;
+  for (const auto &candidate : tuner.get_candidates())
+    found |= same_parameters(candidate, result);
+  deallog << "Result is a candidate: " << found << std::endl;
+
+  // the second run must pick up the result from the cache without timing
+  const auto cached = tuner.tune(reinit, run, cache_file, problem_key);
+  deallog << "Number of timings: " << tuner.get_timings().size() << std::endl;
+  deallog << "Cached result matches: " << same_parameters(cached, result)
+          << std::endl;
+
+  std::remove(cache_file.c_str());
+}
+
+
+
+int
+main()
+{
+  initlog();
+  MultithreadInfo::set_thread_limit(1);
+
+  deallog.push("2d");
+  test<2>(false);
+  test<2>(true);
+  deallog.pop();
+  deallog.push("3d");
+  test<3>(false);
+  test<3>(true);
+  deallog.pop();
+}
@@ -0,0 +1,133 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// check that update_ghost_values() and compress() give the same results with
+// persistent MPI requests enabled in the partitioner as without, also when
+// the exchange is repeated, the vectors are swapped, and a vector is
+// reinitialized
+
+#include <deal.II/base/index_set.h>
+#include <deal.II/base/partitioner.h>
+#include <deal.II/base/utilities.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include "../tests.h"
+
+
+using VectorType = LinearAlgebra::distributed::Vector<double>;
+
+
+// fill the locally owned entries with values depending on the iteration,
+// update the ghosts, and check the ghost values. then add something into
+// the ghost entries and compare the result of compress() with the
+// reference vector
+bool
+check(VectorType &v, VectorType &reference, const unsigned int iteration)
+{
+  const IndexSet &owned = v.get_partitioner()->locally_owned_range();
+  for (const auto i : owned)
+    {
+      v(i)         = 1. * i + iteration;
+      reference(i) = v(i);
+    }
+
+  v.update_ghost_values();
+  bool ghosts_correct = true;
+  for (const auto i : v.get_partitioner()->ghost_indices())
+    ghosts_correct = ghosts_correct && v(i) == 1. * i + iteration;
+  v.zero_out_ghost_values();
+
+  for (const auto i : v.get_partitioner()->ghost_indices())
+    {
+      v(i)         = 1. + iteration;
+      reference(i) = 1. + iteration;
+    }
+  v.compress(VectorOperation::add);
+  reference.compress(VectorOperation::add);
+  bool compress_correct = true;
+  for (const auto i : owned)
+    compress_correct = compress_correct && v(i) == reference(i);
+
+  return Utilities::MPI::min(static_cast<int>(ghosts_correct &&
+                                              compress_correct),
+                             MPI_COMM_WORLD) == 1;
+}
+
+
+
+void
+test()
+{
+  const unsigned int myid    = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+  const unsigned int numproc = Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD);
+
+  // each process owns 100 entries and has the first and last 10 entries of
+  // each other process as ghosts
+  IndexSet owned(100 * numproc);
+  owned.add_range(100 * myid, 100 * (myid + 1));
+  IndexSet ghosts(100 * numproc);
+  for (unsigned int p = 0; p < numproc; ++p)
+    if (p != myid)
+      {
+        ghosts.add_range(100 * p, 100 * p + 10);
+        ghosts.add_range(100 * p + 90, 100 * (p + 1));
+      }
+
+  const auto partitioner =
+    std::make_shared<Utilities::MPI::Partitioner>(owned,
+                                                  ghosts,
+                                                  MPI_COMM_WORLD);
+  partitioner->enable_persistent_requests();
+  const auto reference_partitioner =
+    std::make_shared<Utilities::MPI::Partitioner>(owned,
+                                                  ghosts,
+                                                  MPI_COMM_WORLD);
+
+  deallog << "Persistent requests enabled: "
+          << partitioner->persistent_requests_enabled() << ' '
+          << reference_partitioner->persistent_requests_enabled()
+          << std::endl;
+
+  VectorType v(partitioner), w(partitioner), reference(reference_partitioner);
+  for (unsigned int iteration = 0; iteration < 3; ++iteration)
+    deallog << "Iteration " << iteration << ": "
+            << (check(v, reference, iteration) ? "OK" : "FAILED")
+            << std::endl;
+
+  v.swap(w);
+  deallog << "After swap: "
+          << (check(v, reference, 3) && check(w, reference, 4) ? "OK" :
+                                                                 "FAILED")
+          << std::endl;
+
+  v.reinit(partitioner);
+  deallog << "After reinit: " << (check(v, reference, 5) ? "OK" : "FAILED")
+          << std::endl;
+}
+
+
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(
+    argc, argv, testing_max_num_threads());
+  MPILogInitAll                    log;
+
+  test();
+}
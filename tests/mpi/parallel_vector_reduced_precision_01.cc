@@ -0,0 +1,179 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// check the ghost exchange of LinearAlgebra::distributed::Vector<double> in
+// reduced precision: the errors of update_ghost_values() and compress() must
+// be within the documented bounds, and a conjugate gradient solver with a
+// well-conditioned operator must converge like with the full precision
+
+#include <deal.II/base/index_set.h>
+#include <deal.II/base/partitioner.h>
+#include <deal.II/base/utilities.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_control.h>
+
+#include "../tests.h"
+
+
+using VectorType = LinearAlgebra::distributed::Vector<double>;
+
+
+// the matrix tridiag(-1, 3, -1), with the neighbors on other processes
+// accessed as ghost entries
+class ShiftedLaplacian
+{
+public:
+  void
+  vmult(VectorType &dst, const VectorType &src) const
+  {
+    src.update_ghost_values();
+    for (const auto i : dst.get_partitioner()->locally_owned_range())
+      {
+        double value = 3. * src(i);
+        if (i > 0)
+          value -= src(i - 1);
+        if (i + 1 < src.size())
+          value -= src(i + 1);
+        dst(i) = value;
+      }
+    src.zero_out_ghost_values();
+  }
+};
+
+
+
+std::shared_ptr<Utilities::MPI::Partitioner>
+create_partitioner(const bool use_reduced_precision)
+{
+  const unsigned int myid    = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+  const unsigned int numproc = Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD);
+  const unsigned int local_size = 50;
+
+  IndexSet owned(local_size * numproc);
+  owned.add_range(local_size * myid, local_size * (myid + 1));
+  IndexSet ghosts(local_size * numproc);
+  if (myid > 0)
+    ghosts.add_index(local_size * myid - 1);
+  if (myid + 1 < numproc)
+    ghosts.add_index(local_size * (myid + 1));
+
+  const auto partitioner =
+    std::make_shared<Utilities::MPI::Partitioner>(owned,
+                                                  ghosts,
+                                                  MPI_COMM_WORLD);
+  partitioner->enable_reduced_precision_communication(use_reduced_precision);
+  return partitioner;
+}
+
+
+
+void
+check_error_bounds()
+{
+  const double unit_roundoff = std::pow(2., -24);
+
+  const auto partitioner = create_partitioner(true);
+  deallog << "Reduced precision enabled: "
+          << partitioner->reduced_precision_communication_enabled()
+          << std::endl;
+
+  // entries of very different magnitude that are not representable as float
+  const auto value = [](const types::global_dof_index i) {
+    return std::sin(1. * i + 0.5) * std::pow(10., 1. * (i % 13) - 6.);
+  };
+
+  VectorType v(partitioner);
+  for (const auto i : partitioner->locally_owned_range())
+    v(i) = value(i);
+  v.update_ghost_values();
+  bool within_bound = true, exact = true;
+  for (const auto i : partitioner->ghost_indices())
+    {
+      within_bound = within_bound && std::abs(v(i) - value(i)) <=
+                                       unit_roundoff * std::abs(value(i));
+      exact = exact && v(i) == value(i);
+    }
+  deallog << "update_ghost_values within bound: " << within_bound
+          << ", exact: " << exact << std::endl;
+
+  // add the same contribution from the ghost entries of all neighbors and
+  // compare with the contributions added in full precision
+  v.zero_out_ghost_values();
+  for (const auto i : partitioner->ghost_indices())
+    v(i) = value(i + 1);
+  v.compress(VectorOperation::add);
+  within_bound = true;
+  for (const auto i : partitioner->locally_owned_range())
+    {
+      unsigned int n_contributions = 0;
+      if (i > 0 && !partitioner->in_local_range(i - 1))
+        ++n_contributions;
+      if (i + 1 < v.size() && !partitioner->in_local_range(i + 1))
+        ++n_contributions;
+      const double exact_value = value(i) + n_contributions * value(i + 1);
+      within_bound =
+        within_bound && std::abs(v(i) - exact_value) <=
+                          unit_roundoff * n_contributions *
+                            std::abs(value(i + 1));
+    }
+  deallog << "compress within bound: " << within_bound << std::endl;
+}
+
+
+
+void
+check_solver(const bool use_reduced_precision)
+{
+  const auto partitioner = create_partitioner(use_reduced_precision);
+
+  VectorType rhs(partitioner), solution(partitioner);
+  rhs = 1.;
+
+  const ShiftedLaplacian laplacian;
+  SolverControl          control(1000, 1e-8 * rhs.l2_norm(), false, false);
+  SolverCG<VectorType>   solver(control);
+  solver.solve(laplacian, solution, rhs, PreconditionIdentity());
+
+  // compute the residual with a partitioner using full precision
+  VectorType exact_solution(create_partitioner(false)),
+    exact_residual(exact_solution);
+  exact_solution.copy_locally_owned_data_from(solution);
+  laplacian.vmult(exact_residual, exact_solution);
+  exact_residual -= rhs;
+
+  deallog << (use_reduced_precision ? "Reduced" : "Full")
+          << " precision, CG iterations: " << control.last_step()
+          << ", relative residual below 1e-6: "
+          << (exact_residual.l2_norm() < 1e-6 * rhs.l2_norm()) << std::endl;
+}
+
+
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(
+    argc, argv, testing_max_num_threads());
+  MPILogInitAll                    log;
+
+  check_error_bounds();
+  check_solver(false);
+  check_solver(true);
+}
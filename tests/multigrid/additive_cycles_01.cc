@@ -0,0 +1,229 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Check the additive cycles of Multigrid (BPX and AFACx) as preconditioners
+// for a finite difference Laplacian with bilinear interpolation between the
+// levels, and check that computing the level corrections concurrently gives
+// the same result as computing them one after the other
+
+#include <deal.II/base/mg_level_object.h>
+
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/solver_gmres.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/multigrid/mg_base.h>
+#include <deal.II/multigrid/mg_coarse.h>
+#include <deal.II/multigrid/mg_matrix.h>
+#include <deal.II/multigrid/mg_smoother.h>
+#include <deal.II/multigrid/multigrid.h>
+
+#include "../tests.h"
+
+#include "../testmatrix.h"
+
+
+using VectorType = Vector<double>;
+
+// transfer based on the bilinear interpolation from level-1 to level
+class Transfer : public MGTransferBase<VectorType>
+{
+public:
+  Transfer(const MGLevelObject<SparseMatrix<double>> &prolongation)
+    : prolongation(prolongation)
+  {}
+
+  virtual void
+  prolongate(const unsigned int to_level,
+             VectorType &       dst,
+             const VectorType & src) const override
+  {
+    prolongation[to_level].vmult(dst, src);
+  }
+
+  virtual void
+  restrict_and_add(const unsigned int from_level,
+                   VectorType &       dst,
+                   const VectorType & src) const override
+  {
+    prolongation[from_level].Tvmult_add(dst, src);
+  }
+
+private:
+  const MGLevelObject<SparseMatrix<double>> &prolongation;
+};
+
+
+
+// run the multigrid cycle with the right hand side on the finest level
+class Preconditioner
+{
+public:
+  Preconditioner(Multigrid<VectorType> &mg)
+    : mg(mg)
+  {}
+
+  void
+  vmult(VectorType &dst, const VectorType &src) const
+  {
+    for (unsigned int l = mg.get_minlevel(); l < mg.get_maxlevel(); ++l)
+      mg.defect[l] = 0.;
+    mg.defect[mg.get_maxlevel()] = src;
+    mg.cycle();
+    dst = mg.solution[mg.get_maxlevel()];
+  }
+
+private:
+  Multigrid<VectorType> &mg;
+};
+
+
+
+unsigned int
+n_intervals(const unsigned int level)
+{
+  return 4 << level;
+}
+
+
+
+double
+weight(const unsigned int fine, const unsigned int coarse)
+{
+  if (fine == 2 * coarse)
+    return 1.;
+  else if (fine + 1 == 2 * coarse || fine == 2 * coarse + 1)
+    return 0.5;
+  else
+    return 0.;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  const unsigned int n_levels = 5;
+
+  MGLevelObject<SparsityPattern>      sparsity(0, n_levels - 1);
+  MGLevelObject<SparseMatrix<double>> matrices(0, n_levels - 1);
+  MGLevelObject<SparsityPattern>      prolongation_sparsity(1, n_levels - 1);
+  MGLevelObject<SparseMatrix<double>> prolongation(1, n_levels - 1);
+  for (unsigned int l = 0; l < n_levels; ++l)
+    {
+      const unsigned int n = n_intervals(l);
+      FDMatrix           testproblem(n, n);
+      sparsity[l].reinit((n - 1) * (n - 1), (n - 1) * (n - 1), 5);
+      testproblem.five_point_structure(sparsity[l]);
+      sparsity[l].compress();
+      matrices[l].reinit(sparsity[l]);
+      testproblem.five_point(matrices[l]);
+
+      if (l == 0)
+        continue;
+
+      // the fine point (i,j) is interpolated from the coarse points with
+      // indices i/2 and (i+1)/2 in each direction
+      const unsigned int nc = n_intervals(l - 1);
+      prolongation_sparsity[l].reinit((n - 1) * (n - 1),
+                                      (nc - 1) * (nc - 1),
+                                      4);
+      for (unsigned int j = 1; j < n; ++j)
+        for (unsigned int i = 1; i < n; ++i)
+          for (unsigned int cj = j / 2; cj <= (j + 1) / 2; ++cj)
+            for (unsigned int ci = i / 2; ci <= (i + 1) / 2; ++ci)
+              if (ci > 0 && ci < nc && cj > 0 && cj < nc)
+                prolongation_sparsity[l].add((i - 1) + (n - 1) * (j - 1),
+                                             (ci - 1) + (nc - 1) * (cj - 1));
+      prolongation_sparsity[l].compress();
+      prolongation[l].reinit(prolongation_sparsity[l]);
+      for (unsigned int j = 1; j < n; ++j)
+        for (unsigned int i = 1; i < n; ++i)
+          for (unsigned int cj = j / 2; cj <= (j + 1) / 2; ++cj)
+            for (unsigned int ci = i / 2; ci <= (i + 1) / 2; ++ci)
+              if (ci > 0 && ci < nc && cj > 0 && cj < nc)
+                prolongation[l].set((i - 1) + (n - 1) * (j - 1),
+                                    (ci - 1) + (nc - 1) * (cj - 1),
+                                    weight(i, ci) * weight(j, cj));
+    }
+
+  mg::Matrix<VectorType> mg_matrix(matrices);
+  Transfer               transfer(prolongation);
+
+  FullMatrix<double> coarse_matrix;
+  coarse_matrix.copy_from(matrices[0]);
+  MGCoarseGridHouseholder<double, VectorType> coarse(&coarse_matrix);
+
+  using Smoother = PreconditionJacobi<SparseMatrix<double>>;
+  mg::SmootherRelaxation<Smoother, VectorType> smoother;
+  smoother.initialize(matrices, Smoother::AdditionalData(0.6));
+  smoother.set_steps(2);
+  smoother.set_symmetric(true);
+
+  Multigrid<VectorType> mg(
+    mg_matrix, coarse, transfer, smoother, smoother, 0, n_levels - 1);
+  for (unsigned int l = 0; l < n_levels; ++l)
+    mg.defect[l].reinit(matrices[l].m());
+  Preconditioner preconditioner(mg);
+
+  const SparseMatrix<double> &A = matrices[n_levels - 1];
+  VectorType                  f(A.m());
+  for (unsigned int i = 0; i < f.size(); ++i)
+    f(i) = random_value<double>();
+
+  const std::vector<std::pair<Multigrid<VectorType>::Cycle, std::string>>
+    cycles = {{Multigrid<VectorType>::v_cycle, "V-cycle"},
+              {Multigrid<VectorType>::additive_cycle, "BPX"},
+              {Multigrid<VectorType>::afacx_cycle, "AFACx"}};
+  for (const auto &cycle : cycles)
+    {
+      mg.set_cycle(cycle.first);
+
+      std::vector<VectorType> solutions(2, VectorType(A.m()));
+      for (unsigned int concurrent = 0; concurrent < 2; ++concurrent)
+        {
+          mg.set_concurrent_level_corrections(concurrent == 1);
+
+          SolverControl control(100, 1e-10 * f.l2_norm());
+          control.log_result(false);
+          if (cycle.first == Multigrid<VectorType>::afacx_cycle)
+            {
+              SolverGMRES<VectorType> solver(control);
+              solver.solve(A, solutions[concurrent], f, preconditioner);
+            }
+          else
+            {
+              SolverCG<VectorType> solver(control);
+              solver.solve(A, solutions[concurrent], f, preconditioner);
+            }
+          if (concurrent == 0)
+            deallog << cycle.second << " iterations: " << control.last_step()
+                    << std::endl;
+        }
+
+      solutions[1] -= solutions[0];
+      deallog << cycle.second << " concurrent result identical: "
+              << (solutions[1].linfty_norm() == 0.) << std::endl;
+    }
+}
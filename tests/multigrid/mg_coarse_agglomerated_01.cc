@@ -0,0 +1,117 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Check MGCoarseGridAgglomeratedDirect against a direct solve of the complete
+// matrix, for the automatically selected agglomeration factor and for
+// explicitly given factors
+
+#include <deal.II/base/index_set.h>
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/sparse_direct.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/multigrid/mg_coarse_agglomerated.h>
+
+#include "../tests.h"
+
+#include "../testmatrix.h"
+
+
+void
+test(const SparseMatrix<double> &A,
+     const unsigned int          n_dofs_per_solver_process,
+     const unsigned int          agglomeration_factor)
+{
+  const MPI_Comm     comm    = MPI_COMM_WORLD;
+  const unsigned int n_procs = Utilities::MPI::n_mpi_processes(comm);
+  const unsigned int my_rank = Utilities::MPI::this_mpi_process(comm);
+
+  // split the rows into contiguous ranges of roughly equal size
+  const unsigned int n = A.m();
+  IndexSet           locally_owned(n);
+  locally_owned.add_range(n * my_rank / n_procs, n * (my_rank + 1) / n_procs);
+
+  MGCoarseGridAgglomeratedDirect<double> coarse;
+  coarse.initialize(
+    A,
+    locally_owned,
+    comm,
+    MGCoarseGridAgglomeratedDirect<double>::AdditionalData(
+      n_dofs_per_solver_process, agglomeration_factor));
+
+  Vector<double> rhs(n), reference(n);
+  for (unsigned int i = 0; i < n; ++i)
+    rhs(i) = static_cast<double>(i % 7) - 3.;
+  SparseDirectUMFPACK direct;
+  direct.initialize(A);
+  direct.vmult(reference, rhs);
+
+  LinearAlgebra::distributed::Vector<double> src(locally_owned, comm), dst;
+  dst.reinit(src);
+  for (const auto i : locally_owned)
+    src(i) = rhs(i);
+
+  // apply twice to check the reuse of the factorization
+  for (unsigned int repetition = 0; repetition < 2; ++repetition)
+    {
+      dst = 0.;
+      coarse(0, dst, src);
+      double error = 0.;
+      for (const auto i : locally_owned)
+        error = std::max(error, std::abs(dst(i) - reference(i)));
+      error = Utilities::MPI::max(error, comm);
+      deallog << "Error: "
+              << (error < 1e-12 * reference.linfty_norm() ? "OK" : "FAIL")
+              << std::endl;
+    }
+
+  deallog << "Agglomeration factor covers all processes: "
+          << (coarse.get_agglomeration_factor() *
+                coarse.n_solver_processes() >=
+              n_procs)
+          << std::endl;
+}
+
+
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  MPILogInitAll                    log;
+
+  const unsigned int size = 32;
+  const unsigned int dim  = (size - 1) * (size - 1);
+
+  FDMatrix        testproblem(size, size);
+  SparsityPattern structure(dim, dim, 5);
+  testproblem.five_point_structure(structure);
+  structure.compress();
+  SparseMatrix<double> A(structure);
+  testproblem.five_point(A);
+
+  // the problem is small enough to be gathered on a single process
+  test(A, 20000, 0);
+
+  // force several solver processes
+  test(A, 100, 0);
+  test(A, 20000, 1);
+  test(A, 20000, 2);
+}
@@ -0,0 +1,175 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+
+// Tests MGVertexPatchRelaxation with a matrix-free Laplace operator: on a
+// mesh with a single interior vertex, the patch inverse must be the exact
+// inverse of the operator. On finer meshes, the relaxation is checked as a
+// preconditioner for CG and as a smoother within mg::SmootherRelaxation, also
+// on an adaptively refined mesh where the patches next to hanging nodes are
+// skipped.
+
+#include <deal.II/base/function.h>
+#include <deal.II/base/mg_level_object.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q1.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/diagonal_matrix.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_control.h>
+
+#include <deal.II/matrix_free/matrix_free.h>
+#include <deal.II/matrix_free/operators.h>
+
+#include <deal.II/multigrid/mg_smoother.h>
+#include <deal.II/multigrid/mg_vertex_patch_relaxation.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include "../tests.h"
+
+
+
+template <int dim, int fe_degree>
+void
+test(const unsigned int n_refinements, const bool adaptive = false)
+{
+  using Number     = double;
+  using VectorType = LinearAlgebra::distributed::Vector<Number>;
+  using Operator =
+    MatrixFreeOperators::LaplaceOperator<dim, fe_degree, fe_degree + 1>;
+  using Relaxation = MGVertexPatchRelaxation<dim, Operator, VectorType>;
+
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(n_refinements);
+  if (adaptive)
+    {
+      for (const auto &cell : tria.active_cell_iterators())
+        if (cell->center()[0] < 0.5)
+          cell->set_refine_flag();
+      tria.execute_coarsening_and_refinement();
+    }
+
+  FE_Q<dim>       fe(fe_degree);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  AffineConstraints<Number> constraints;
+  DoFTools::make_hanging_node_constraints(dof_handler, constraints);
+  VectorTools::interpolate_boundary_values(dof_handler,
+                                           0,
+                                           Functions::ZeroFunction<dim>(),
+                                           constraints);
+  constraints.close();
+
+  const auto matrix_free = std::make_shared<MatrixFree<dim, Number>>();
+  typename MatrixFree<dim, Number>::AdditionalData data;
+  data.mapping_update_flags = update_gradients | update_JxW_values;
+  matrix_free->reinit(MappingQ1<dim>(),
+                      dof_handler,
+                      constraints,
+                      QGauss<1>(fe_degree + 1),
+                      data);
+
+  Operator laplace;
+  laplace.initialize(matrix_free);
+  laplace.compute_diagonal();
+
+  VectorType src, dst, tmp;
+  laplace.initialize_dof_vector(src);
+  laplace.initialize_dof_vector(dst);
+  laplace.initialize_dof_vector(tmp);
+  for (unsigned int i = 0; i < src.locally_owned_size(); ++i)
+    if (constraints.is_constrained(i) == false)
+      src.local_element(i) = random_value<Number>();
+
+  deallog << "Testing " << fe.get_name() << " on " << tria.n_active_cells()
+          << " cells" << std::endl;
+
+  if (n_refinements == 1)
+    {
+      Relaxation relaxation;
+      relaxation.initialize(laplace, typename Relaxation::AdditionalData(1.));
+      deallog << "Number of patches: " << relaxation.n_patches() << std::endl;
+
+      relaxation.vmult(dst, src);
+      laplace.vmult(tmp, dst);
+      tmp -= src;
+      deallog << "Patch inverse exact: "
+              << (tmp.linfty_norm() < 1e-10 * src.linfty_norm() ? "OK" : "FAIL")
+              << std::endl;
+      return;
+    }
+
+  typename Relaxation::AdditionalData relaxation_data;
+  relaxation_data.diagonal_inverse = laplace.get_matrix_diagonal_inverse();
+  Relaxation relaxation;
+  relaxation.initialize(laplace, relaxation_data);
+  deallog << "Number of patches: " << relaxation.n_patches() << std::endl;
+
+  SolverControl control(200, 1e-10 * src.l2_norm());
+  control.log_result(false);
+  SolverCG<VectorType> solver(control);
+  dst = 0;
+  solver.solve(laplace, dst, src, relaxation);
+  const unsigned int n_iterations_patch = control.last_step();
+  dst = 0;
+  solver.solve(laplace, dst, src, *laplace.get_matrix_diagonal_inverse());
+  deallog << "CG iterations with patch relaxation lower than with Jacobi: "
+          << (n_iterations_patch < control.last_step()) << std::endl;
+
+  // smooth the error of the homogeneous problem
+  MGLevelObject<Operator> matrices(0, 0);
+  matrices[0].initialize(matrix_free);
+  matrices[0].compute_diagonal();
+  MGLevelObject<typename Relaxation::AdditionalData> smoother_data(0, 0);
+  smoother_data[0].diagonal_inverse =
+    matrices[0].get_matrix_diagonal_inverse();
+  mg::SmootherRelaxation<Relaxation, VectorType> smoother(2);
+  smoother.initialize(matrices, smoother_data);
+
+  const double initial_error = src.l2_norm();
+  tmp                        = 0;
+  smoother.smooth(0, src, tmp);
+  deallog << "Error reduced by smoothing: "
+          << (src.l2_norm() < initial_error) << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2, 3>(1);
+  test<2, 3>(4);
+  test<2, 3>(3, true);
+  test<3, 2>(1);
+  test<3, 2>(3);
+}
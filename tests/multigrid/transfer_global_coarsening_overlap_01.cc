@@ -0,0 +1,142 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Check that MGTwoLevelTransfer::prolongate_and_add() gives the same result
+// when the ghost exchange of the coarse vector is overlapped with the cell
+// work as when the ghost values are already set on entry. The cells at the
+// boundaries between the subdomains read ghosted coarse degrees of freedom,
+// so their cell batches are deferred until the exchange has finished.
+
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/multigrid/mg_transfer_global_coarsening.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+test(const unsigned int fe_degree_fine, const unsigned int fe_degree_coarse)
+{
+  using VectorType = LinearAlgebra::distributed::Vector<double>;
+
+  const unsigned int n_procs = Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD);
+
+  parallel::shared::Triangulation<dim> tria(
+    MPI_COMM_WORLD,
+    Triangulation<dim>::none,
+    true,
+    parallel::shared::Triangulation<dim>::partition_custom_signal);
+  tria.signals.post_refinement.connect([&tria, n_procs]() {
+    GridTools::partition_triangulation_zorder(n_procs, tria);
+  });
+
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(3);
+  for (auto &cell : tria.active_cell_iterators())
+    if (cell->center()[0] < 0.5)
+      cell->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  DoFHandler<dim> dof_handler_fine(tria);
+  dof_handler_fine.distribute_dofs(FE_Q<dim>(fe_degree_fine));
+
+  DoFHandler<dim> dof_handler_coarse(tria);
+  dof_handler_coarse.distribute_dofs(FE_Q<dim>(fe_degree_coarse));
+
+  AffineConstraints<double> constraint_fine;
+  DoFTools::make_hanging_node_constraints(dof_handler_fine, constraint_fine);
+  constraint_fine.close();
+
+  AffineConstraints<double> constraint_coarse;
+  DoFTools::make_hanging_node_constraints(dof_handler_coarse,
+                                          constraint_coarse);
+  constraint_coarse.close();
+
+  MGTwoLevelTransfer<dim, VectorType> transfer;
+  transfer.reinit(dof_handler_fine,
+                  dof_handler_coarse,
+                  constraint_fine,
+                  constraint_coarse);
+
+  IndexSet relevant_fine, relevant_coarse;
+  DoFTools::extract_locally_relevant_dofs(dof_handler_fine, relevant_fine);
+  DoFTools::extract_locally_relevant_dofs(dof_handler_coarse,
+                                          relevant_coarse);
+
+  VectorType src(dof_handler_coarse.locally_owned_dofs(),
+                 relevant_coarse,
+                 MPI_COMM_WORLD);
+  VectorType dst(dof_handler_fine.locally_owned_dofs(),
+                 relevant_fine,
+                 MPI_COMM_WORLD);
+  VectorType dst_reference(dst);
+
+  // read from and write into the given vectors directly, such that the
+  // state of the ghost values of src is seen by the transfer
+  transfer.enable_inplace_operations_if_possible(src.get_partitioner(),
+                                                 dst.get_partitioner());
+
+  for (const auto i : src.locally_owned_elements())
+    src(i) = std::sin(0.1 * i) + 0.5;
+
+  // overlap the ghost exchange with the cell work
+  transfer.prolongate_and_add(dst, src);
+  const bool ghosts_released = src.has_ghost_elements() == false;
+
+  // set the ghost values in advance, no exchange in the transfer
+  src.update_ghost_values();
+  transfer.prolongate_and_add(dst_reference, src);
+  const bool ghosts_kept = src.has_ghost_elements();
+
+  deallog << "FE_Q<" << dim << ">(" << fe_degree_fine << ") <- FE_Q<" << dim
+          << ">(" << fe_degree_coarse << ")" << std::endl;
+  deallog << "ghost values released: " << ghosts_released
+          << ", kept: " << ghosts_kept << std::endl;
+
+  const double reference_norm = dst_reference.linfty_norm();
+  dst -= dst_reference;
+  deallog << "Difference with and without overlap: "
+          << (dst.linfty_norm() < 1e-14 * reference_norm ? "OK" : "FAIL")
+          << std::endl;
+}
+
+
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  MPILogInitAll                    all;
+
+  test<2>(2, 1);
+  test<2>(4, 2);
+  test<3>(2, 1);
+}
@@ -0,0 +1,231 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Test the triangle-times-line factorization of ShapeInfo for FE_WedgeP
+// and QGaussWedge against the dense shape values and gradients, and check
+// that evaluate() and integrate() of FEEvaluation, which use the factorized
+// kernels on wedges, give the same result as the generic dense kernels for
+// tensor_none elements
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_pyramid_p.h>
+#include <deal.II/fe/fe_wedge_p.h>
+#include <deal.II/fe/mapping_fe.h>
+
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+#include <deal.II/matrix_free/shape_info.h>
+
+#include "../tests.h"
+
+#include "./simplex_grids.h"
+
+using namespace dealii;
+
+template <typename Number>
+void
+test(const FiniteElement<3> &fe, const Quadrature<3> &quad)
+{
+  internal::MatrixFreeFunctions::ShapeInfo<Number> shape_info(quad, fe);
+
+  const auto &wedge_data = shape_info.wedge_data;
+
+  deallog << fe.get_name() << " n_dofs_triangle=" << wedge_data.n_dofs_triangle
+          << " n_dofs_line=" << wedge_data.n_dofs_line
+          << " n_q_points_triangle=" << wedge_data.n_q_points_triangle
+          << " n_q_points_line=" << wedge_data.n_q_points_line << std::endl;
+
+  if (wedge_data.n_dofs_line == 0)
+    return;
+
+  const unsigned int n_dofs     = shape_info.dofs_per_component_on_cell;
+  const unsigned int n_q_points = shape_info.n_q_points;
+  const unsigned int n_t        = wedge_data.n_dofs_triangle;
+  const unsigned int n_qt       = wedge_data.n_q_points_triangle;
+  const unsigned int n_ql       = wedge_data.n_q_points_line;
+
+  const auto &data = shape_info.data[0];
+
+  double error = 0;
+  for (unsigned int l = 0; l < wedge_data.n_dofs_line; ++l)
+    for (unsigned int t = 0; t < n_t; ++t)
+      for (unsigned int ql = 0; ql < n_ql; ++ql)
+        for (unsigned int qt = 0; qt < n_qt; ++qt)
+          {
+            const unsigned int i = wedge_data.dof_numbering[l * n_t + t];
+            const unsigned int q = ql * n_qt + qt;
+
+            const Number tv  = wedge_data.triangle_values[t * n_qt + qt];
+            const Number tdx = wedge_data.triangle_gradients[t * n_qt + qt];
+            const Number tdy =
+              wedge_data.triangle_gradients[(n_t + t) * n_qt + qt];
+            const Number lv = wedge_data.line_values[l * n_ql + ql];
+            const Number ld = wedge_data.line_gradients[l * n_ql + ql];
+
+            const unsigned int index = i * n_q_points + q;
+            const unsigned int size  = n_dofs * n_q_points;
+            error = std::max<double>(
+              error, std::abs(data.shape_values[index] - tv * lv));
+            error = std::max<double>(
+              error, std::abs(data.shape_gradients[index] - tdx * lv));
+            error = std::max<double>(
+              error, std::abs(data.shape_gradients[size + index] - tdy * lv));
+            error = std::max<double>(
+              error,
+              std::abs(data.shape_gradients[2 * size + index] - tv * ld));
+          }
+
+  deallog << "Maximal error: "
+          << (error < 100 * std::numeric_limits<Number>::epsilon() ? "OK" :
+                                                                     "FAIL")
+          << std::endl;
+}
+
+// apply the dense matrices of the generic tensor_none kernels to the
+// unknowns and compare with the result of the factorized kernels used by
+// FEEvaluation
+void
+test_kernels(const unsigned int degree)
+{
+  Triangulation<3> tria;
+  GridGenerator::subdivided_hyper_cube_with_wedges(tria, 2);
+
+  const FE_WedgeP<3>   fe(degree);
+  const MappingFE<3>   mapping(FE_WedgeP<3>(1));
+  const QGaussWedge<3> quad(degree + 1);
+
+  DoFHandler<3> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  AffineConstraints<double> constraints;
+  constraints.close();
+
+  typename MatrixFree<3, double>::AdditionalData additional_data;
+  additional_data.mapping_update_flags = update_values | update_gradients;
+
+  MatrixFree<3, double> matrix_free;
+  matrix_free.reinit(mapping, dof_handler, constraints, quad, additional_data);
+
+  const auto &       shape_info = matrix_free.get_shape_info();
+  const auto &       data       = shape_info.data[0];
+  const unsigned int n_dofs     = shape_info.dofs_per_component_on_cell;
+  const unsigned int n_q_points = shape_info.n_q_points;
+  const unsigned int size       = n_dofs * n_q_points;
+
+  FEEvaluation<3, -1, 0, 1, double> phi(matrix_free);
+
+  const auto max_difference = [](const VectorizedArray<double> a,
+                                 const VectorizedArray<double> b,
+                                 double &                      error) {
+    for (unsigned int v = 0; v < VectorizedArray<double>::size(); ++v)
+      error = std::max(error, std::abs(a[v] - b[v]));
+  };
+
+  double error_evaluate = 0, error_integrate = 0;
+  for (unsigned int cell = 0; cell < matrix_free.n_cell_batches(); ++cell)
+    {
+      phi.reinit(cell);
+
+      std::vector<VectorizedArray<double>> dof_values(n_dofs);
+      for (auto &value : dof_values)
+        for (unsigned int v = 0; v < VectorizedArray<double>::size(); ++v)
+          value[v] = random_value<double>();
+
+      for (unsigned int i = 0; i < dof_values.size(); ++i)
+        phi.begin_dof_values()[i] = dof_values[i];
+      phi.evaluate(EvaluationFlags::values | EvaluationFlags::gradients);
+
+      for (unsigned int q = 0; q < n_q_points; ++q)
+        {
+          VectorizedArray<double> value       = 0.;
+          VectorizedArray<double> gradient[3] = {0., 0., 0.};
+          for (unsigned int i = 0; i < n_dofs; ++i)
+            {
+              const auto u = dof_values[i];
+              value += data.shape_values[i * n_q_points + q] * u;
+              for (unsigned int d = 0; d < 3; ++d)
+                gradient[d] +=
+                  data.shape_gradients[d * size + i * n_q_points + q] * u;
+            }
+          max_difference(value, phi.begin_values()[q], error_evaluate);
+          for (unsigned int d = 0; d < 3; ++d)
+            max_difference(gradient[d],
+                           phi.begin_gradients()[d * n_q_points + q],
+                           error_evaluate);
+        }
+
+      std::vector<VectorizedArray<double>> values(n_q_points);
+      std::vector<VectorizedArray<double>> gradients(3 * values.size());
+      for (auto &value : values)
+        for (unsigned int v = 0; v < VectorizedArray<double>::size(); ++v)
+          value[v] = random_value<double>();
+      for (auto &gradient : gradients)
+        for (unsigned int v = 0; v < VectorizedArray<double>::size(); ++v)
+          gradient[v] = random_value<double>();
+
+      for (unsigned int i = 0; i < values.size(); ++i)
+        phi.begin_values()[i] = values[i];
+      for (unsigned int i = 0; i < gradients.size(); ++i)
+        phi.begin_gradients()[i] = gradients[i];
+      phi.integrate(EvaluationFlags::values | EvaluationFlags::gradients);
+
+      for (unsigned int i = 0; i < n_dofs; ++i)
+        {
+          VectorizedArray<double> result = 0.;
+          for (unsigned int q = 0; q < n_q_points; ++q)
+            {
+              result += data.shape_values[i * n_q_points + q] * values[q];
+              for (unsigned int d = 0; d < 3; ++d)
+                result += data.shape_gradients[d * size + i * n_q_points + q] *
+                          gradients[d * n_q_points + q];
+            }
+          max_difference(result, phi.begin_dof_values()[i], error_integrate);
+        }
+    }
+
+  deallog << fe.get_name() << " evaluate: "
+          << (error_evaluate < 1e-12 ? "OK" : "FAIL")
+          << ", integrate: " << (error_integrate < 1e-12 ? "OK" : "FAIL")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  for (unsigned int degree = 1; degree <= 2; ++degree)
+    {
+      test<double>(FE_WedgeP<3>(degree), QGaussWedge<3>(degree + 1));
+      test<float>(FE_WedgeP<3>(degree), QGaussWedge<3>(degree + 2));
+    }
+
+  // no product structure
+  test<double>(FE_PyramidP<3>(1), QGaussPyramid<3>(2));
+
+  for (unsigned int degree = 1; degree <= 2; ++degree)
+    test_kernels(degree);
+}
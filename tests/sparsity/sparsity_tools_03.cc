@@ -0,0 +1,159 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Check SparsityTools::reorder_Cuthill_McKee and
+// SparsityTools::reorder_nested_dissection on the graphs of finite
+// difference stencils with an additional unconnected component: the results
+// must not depend on the number of threads nor on whether a
+// DynamicSparsityPattern or a SparsityPattern is given, and the nested
+// dissection numbering must produce less fill-in in a Cholesky factorization
+// than the reverse Cuthill-McKee numbering
+
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/utilities.h>
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/sparsity_tools.h>
+
+#include "../tests.h"
+
+
+// the number of entries in the lower triangle of the Cholesky factor of a
+// matrix with the given sparsity pattern after the given renumbering,
+// computed from the elimination tree
+std::size_t
+count_fill(const DynamicSparsityPattern &              dsp,
+           const std::vector<types::global_dof_index> &new_indices)
+{
+  const unsigned int n = dsp.n_rows();
+  const std::vector<types::global_dof_index> old_indices =
+    Utilities::invert_permutation(new_indices);
+
+  std::vector<unsigned int> parent(n, numbers::invalid_unsigned_int);
+  std::vector<unsigned int> marker(n, numbers::invalid_unsigned_int);
+  std::size_t               n_entries = 0;
+  for (unsigned int i = 0; i < n; ++i)
+    {
+      marker[i] = i;
+      ++n_entries;
+      for (auto entry = dsp.begin(old_indices[i]);
+           entry != dsp.end(old_indices[i]);
+           ++entry)
+        for (unsigned int j = new_indices[entry->column()];
+             j < i && marker[j] != i;
+             j = parent[j])
+          {
+            if (parent[j] == numbers::invalid_unsigned_int)
+              parent[j] = i;
+            marker[j] = i;
+            ++n_entries;
+          }
+    }
+  return n_entries;
+}
+
+
+
+void
+test(const unsigned int dim, const unsigned int n)
+{
+  const unsigned int stride[3] = {1, n, n * n};
+  const unsigned int n_grid    = dim == 2 ? n * n : n * n * n;
+
+  // a grid with a 9 or 27 point stencil, followed by a path of 50 nodes
+  DynamicSparsityPattern dsp(n_grid + 50, n_grid + 50);
+  for (unsigned int i = 0; i < n_grid; ++i)
+    {
+      const unsigned int index[3] = {i % n, (i / n) % n, i / (n * n)};
+      for (unsigned int k = 0; k < (dim == 3 ? 27 : 9); ++k)
+        {
+          const int    offset[3] = {int(k % 3) - 1,
+                                 int((k / 3) % 3) - 1,
+                                 int(k / 9) - 1};
+          bool         inside    = true;
+          unsigned int neighbor  = 0;
+          for (unsigned int d = 0; d < dim; ++d)
+            {
+              const int c = int(index[d]) + offset[d];
+              inside      = inside && c >= 0 && c < int(n);
+              neighbor += c * stride[d];
+            }
+          if (inside)
+            dsp.add(i, neighbor);
+        }
+    }
+  for (unsigned int i = n_grid; i < n_grid + 50; ++i)
+    {
+      dsp.add(i, i);
+      if (i > n_grid)
+        dsp.add(i, i - 1);
+      if (i + 1 < n_grid + 50)
+        dsp.add(i, i + 1);
+    }
+  SparsityPattern sparsity;
+  sparsity.copy_from(dsp);
+
+  deallog << dim << "d, " << dsp.n_rows() << " nodes" << std::endl;
+
+  std::vector<types::global_dof_index> cm_serial(dsp.n_rows()),
+    cm_parallel(dsp.n_rows()), cm_sparsity(dsp.n_rows()),
+    nd_serial(dsp.n_rows()), nd_parallel(dsp.n_rows()),
+    nd_sparsity(dsp.n_rows());
+
+  MultithreadInfo::set_thread_limit(1);
+  SparsityTools::reorder_Cuthill_McKee(dsp, cm_serial);
+  SparsityTools::reorder_nested_dissection(dsp, nd_serial);
+
+  MultithreadInfo::set_thread_limit(testing_max_num_threads());
+  SparsityTools::reorder_Cuthill_McKee(dsp, cm_parallel);
+  SparsityTools::reorder_nested_dissection(dsp, nd_parallel);
+  SparsityTools::reorder_Cuthill_McKee(sparsity, cm_sparsity);
+  SparsityTools::reorder_nested_dissection(sparsity, nd_sparsity);
+
+  deallog << "Cuthill-McKee independent of threads and pattern: "
+          << (cm_serial == cm_parallel && cm_serial == cm_sparsity)
+          << std::endl;
+  deallog << "Nested dissection independent of threads and pattern: "
+          << (nd_serial == nd_parallel && nd_serial == nd_sparsity)
+          << std::endl;
+
+  std::vector<types::global_dof_index> sorted(nd_serial);
+  std::sort(sorted.begin(), sorted.end());
+  bool is_permutation = true;
+  for (unsigned int i = 0; i < sorted.size(); ++i)
+    is_permutation = is_permutation && sorted[i] == i;
+  deallog << "Nested dissection is a permutation: " << is_permutation
+          << std::endl;
+
+  const std::size_t fill_rcm =
+    count_fill(dsp, Utilities::reverse_permutation(cm_serial));
+  const std::size_t fill_nd = count_fill(dsp, nd_serial);
+  deallog << "Fill-in reverse Cuthill-McKee: " << fill_rcm << std::endl;
+  deallog << "Fill-in nested dissection: " << fill_nd << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test(2, 150);
+  test(3, 24);
+}